@@ -7,6 +7,12 @@ include(ExternalProject)
 
 # -------------------------------
 
+# Threads: used by the parallel Monte Carlo campaign runner.
+
+find_package(Threads REQUIRED)
+
+# -------------------------------
+
 # SML: https://github.com/openastro/sml
 
 if(NOT BUILD_DEPENDENCIES)
@@ -45,9 +51,8 @@ endif(NOT APPLE)
 # -------------------------------
 
 # Catch: https://github.com/philsquared/Catch
-# Eigen: http://eigen.tuxfamily.org
 
-if(BUILD_TESTS)
+if(BUILD_TESTS OR BUILD_PERFORMANCE_TESTS)
   if(NOT BUILD_DEPENDENCIES)
     find_package(CATCH)
   endif(NOT BUILD_DEPENDENCIES)
@@ -81,41 +86,112 @@ if(BUILD_TESTS)
     set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -isystem \"${CATCH_INCLUDE_DIRS}\"")
   endif(NOT APPLE)
 
-  if(BUILD_TESTS_WITH_EIGEN)
-    if(NOT BUILD_DEPENDENCIES)
-      find_package(Eigen3)
-    endif(NOT BUILD_DEPENDENCIES)
-
-    if(NOT EIGEN3_FOUND)
-      message(STATUS "Eigen will be downloaded when ${CMAKE_PROJECT_NAME} is built")
-      ExternalProject_Add(eigen-lib
-        DEPENDS catch-lib
-        PREFIX ${EXTERNAL_PATH}/Eigen
-        #--Download step--------------
-        URL https://bitbucket.org/eigen/eigen/get/3.2.9.zip
-        TIMEOUT 60
-        #--Update/Patch step----------
-        UPDATE_COMMAND ""
-        PATCH_COMMAND ""
-        #--Configure step-------------
-        CONFIGURE_COMMAND ""
-        #--Build step-----------------
-        BUILD_COMMAND ""
-        #--Install step---------------
-        INSTALL_COMMAND ""
-        #--Output logging-------------
-        LOG_DOWNLOAD ON
-      )
-      ExternalProject_Get_Property(eigen-lib source_dir)
-      set(EIGEN3_INCLUDE_DIR ${source_dir} CACHE INTERNAL "Path to include folder for Eigen")
-    endif(NOT EIGEN3_FOUND)
+endif(BUILD_TESTS OR BUILD_PERFORMANCE_TESTS)
+
+# -------------------------------
 
+# Eigen: http://eigen.tuxfamily.org
+
+if(BUILD_TESTS_WITH_EIGEN OR BUILD_BENCHMARKS)
+  if(NOT BUILD_DEPENDENCIES)
+    find_package(Eigen3)
+  endif(NOT BUILD_DEPENDENCIES)
+
+  # Eigen is optional for the benchmarks: it is only downloaded for the tests, or if the local
+  # build of dependencies is forced.
+  if(NOT EIGEN3_FOUND AND (BUILD_TESTS_WITH_EIGEN OR BUILD_DEPENDENCIES))
+    message(STATUS "Eigen will be downloaded when ${CMAKE_PROJECT_NAME} is built")
+    if(TARGET catch-lib)
+      set(EIGEN_DEPENDS DEPENDS catch-lib)
+    endif(TARGET catch-lib)
+    ExternalProject_Add(eigen-lib
+      ${EIGEN_DEPENDS}
+      PREFIX ${EXTERNAL_PATH}/Eigen
+      #--Download step--------------
+      URL https://bitbucket.org/eigen/eigen/get/3.2.9.zip
+      TIMEOUT 60
+      #--Update/Patch step----------
+      UPDATE_COMMAND ""
+      PATCH_COMMAND ""
+      #--Configure step-------------
+      CONFIGURE_COMMAND ""
+      #--Build step-----------------
+      BUILD_COMMAND ""
+      #--Install step---------------
+      INSTALL_COMMAND ""
+      #--Output logging-------------
+      LOG_DOWNLOAD ON
+    )
+    ExternalProject_Get_Property(eigen-lib source_dir)
+    set(EIGEN3_INCLUDE_DIR ${source_dir} CACHE INTERNAL "Path to include folder for Eigen")
+  endif(NOT EIGEN3_FOUND AND (BUILD_TESTS_WITH_EIGEN OR BUILD_DEPENDENCIES))
+
+  if(EIGEN3_FOUND OR TARGET eigen-lib)
     if(NOT APPLE)
       include_directories(SYSTEM AFTER "${EIGEN3_INCLUDE_DIR}")
     else(APPLE)
       set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -isystem \"${EIGEN3_INCLUDE_DIR}\"")
     endif(NOT APPLE)
-  endif(BUILD_TESTS_WITH_EIGEN)
-endif(BUILD_TESTS)
+  endif(EIGEN3_FOUND OR TARGET eigen-lib)
+endif(BUILD_TESTS_WITH_EIGEN OR BUILD_BENCHMARKS)
+
+# Eigen is optional for the explicit instantiations library: the instantiations for Eigen 3-vectors
+# are only compiled if Eigen is found.
+
+if(BUILD_LIBRARY AND NOT (BUILD_TESTS_WITH_EIGEN OR BUILD_BENCHMARKS))
+  find_package(Eigen3 QUIET)
+
+  if(EIGEN3_FOUND)
+    include_directories(SYSTEM AFTER "${EIGEN3_INCLUDE_DIR}")
+  endif(EIGEN3_FOUND)
+endif(BUILD_LIBRARY AND NOT (BUILD_TESTS_WITH_EIGEN OR BUILD_BENCHMARKS))
+
+# -------------------------------
+
+# Google Benchmark: https://github.com/google/benchmark
+
+if(BUILD_BENCHMARKS)
+  if(NOT BUILD_DEPENDENCIES)
+    find_package(benchmark QUIET)
+  endif(NOT BUILD_DEPENDENCIES)
+
+  if(benchmark_FOUND)
+    set(BENCHMARK_FOUND TRUE)
+    set(BENCHMARK_LIBRARIES benchmark::benchmark)
+  else(benchmark_FOUND)
+    message(STATUS "Google Benchmark will be downloaded when ${CMAKE_PROJECT_NAME} is built")
+    ExternalProject_Add(benchmark-lib
+      PREFIX ${EXTERNAL_PATH}/GoogleBenchmark
+      #--Download step--------------
+      URL https://github.com/google/benchmark/archive/v1.7.1.zip
+      TIMEOUT 30
+      #--Update/Patch step----------
+      UPDATE_COMMAND ""
+      PATCH_COMMAND ""
+      #--Configure step-------------
+      CMAKE_ARGS -DCMAKE_INSTALL_PREFIX=<INSTALL_DIR>
+                 -DCMAKE_INSTALL_LIBDIR=lib
+                 -DCMAKE_BUILD_TYPE=Release
+                 -DBENCHMARK_ENABLE_TESTING=OFF
+                 -DBENCHMARK_ENABLE_GTEST_TESTS=OFF
+      #--Output logging-------------
+      LOG_DOWNLOAD ON
+      LOG_CONFIGURE ON
+      LOG_BUILD ON
+    )
+    ExternalProject_Get_Property(benchmark-lib install_dir)
+    set(BENCHMARK_INCLUDE_DIRS ${install_dir}/include CACHE INTERNAL
+        "Path to include folder for Google Benchmark")
+    set(BENCHMARK_LIBRARIES
+        "${install_dir}/lib/${CMAKE_STATIC_LIBRARY_PREFIX}benchmark${CMAKE_STATIC_LIBRARY_SUFFIX}")
+    add_definitions(-DBENCHMARK_STATIC_DEFINE)
+
+    if(NOT APPLE)
+      include_directories(SYSTEM AFTER "${BENCHMARK_INCLUDE_DIRS}")
+    else(APPLE)
+      set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -isystem \"${BENCHMARK_INCLUDE_DIRS}\"")
+    endif(NOT APPLE)
+  endif(benchmark_FOUND)
+endif(BUILD_BENCHMARKS)
 
 # -------------------------------
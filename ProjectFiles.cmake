@@ -2,8 +2,58 @@
 # Distributed under the MIT License.
 # See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
 
+# Set project library source files.
+set(LIBRARY_SRC
+  "${SRC_PATH}/explicitInstantiations.cpp"
+)
+
+# Set project C ABI source files.
+set(C_API_SRC
+  "${SRC_PATH}/controlApi.cpp"
+)
+
 # Set project test source files.
 set(TEST_SRC
+  "${TEST_SRC_PATH}/testAllocationCounter.cpp"
+  "${TEST_SRC_PATH}/testClosedLoopTrajectory.cpp"
   "${TEST_SRC_PATH}/testControl.cpp"
+  "${TEST_SRC_PATH}/testControlApi.cpp"
+  "${TEST_SRC_PATH}/testEventDrivenOptimalGuidanceController.cpp"
+  "${TEST_SRC_PATH}/testExplicitInstantiations.cpp"
+  "${TEST_SRC_PATH}/testFormationGuidance.cpp"
+  "${TEST_SRC_PATH}/testFrameArena.cpp"
+  "${TEST_SRC_PATH}/testGainTuner.cpp"
+  "${TEST_SRC_PATH}/testGeneralizedOptimalGuidanceController.cpp"
+  "${TEST_SRC_PATH}/testGravityModels.cpp"
+  "${TEST_SRC_PATH}/testGuidanceService.cpp"
+  "${TEST_SRC_PATH}/testInstrumentation.cpp"
+  "${TEST_SRC_PATH}/testLinearQuadraticRegulator.cpp"
+  "${TEST_SRC_PATH}/testModelPredictiveGuidance.cpp"
+  "${TEST_SRC_PATH}/testMonteCarloCampaign.cpp"
+  "${TEST_SRC_PATH}/testOptimalGuidanceController.cpp"
   "${TEST_SRC_PATH}/testOptimalGuidanceLaw.cpp"
+  "${TEST_SRC_PATH}/testOptimalGuidancePrecision.cpp"
+  "${TEST_SRC_PATH}/testOptimalGuidanceSchedule.cpp"
+  "${TEST_SRC_PATH}/testParallel.cpp"
+  "${TEST_SRC_PATH}/testPidController.cpp"
+  "${TEST_SRC_PATH}/testRandomNumberGenerator.cpp"
+  "${TEST_SRC_PATH}/testRingBuffer.cpp"
+  "${TEST_SRC_PATH}/testSeqlockSlot.cpp"
+  "${TEST_SRC_PATH}/testSlidingModeGuidance.cpp"
+  "${TEST_SRC_PATH}/testStatistics.cpp"
+  "${TEST_SRC_PATH}/testThrustSaturation.cpp"
+  "${TEST_SRC_PATH}/testTimeToGoSolver.cpp"
+  "${TEST_SRC_PATH}/testTrajectoryLogger.cpp"
+)
+
+# Set project performance test source files.
+set(PERFORMANCE_TEST_SRC
+  "${TEST_SRC_PATH}/testAllocationCounter.cpp"
+  "${TEST_SRC_PATH}/testControl.cpp"
+  "${PERFORMANCE_TEST_SRC_PATH}/testGuidancePerformance.cpp"
+)
+
+# Set project benchmark source files.
+set(BENCHMARK_SRC
+  "${BENCHMARK_SRC_PATH}/benchmarkOptimalGuidanceLaw.cpp"
 )
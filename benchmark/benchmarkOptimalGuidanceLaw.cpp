@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+// The benchmarks for Eigen 3-vectors are only compiled if CONTROL_BENCHMARK_EIGEN is defined, which
+// is done by CMake if Eigen is available.
+#if defined( CONTROL_BENCHMARK_EIGEN )
+#include <Eigen/Core>
+#endif
+
+#include "control/optimalGuidanceLaw.hpp"
+
+namespace control
+{
+namespace benchmarks
+{
+
+typedef std::vector< float > StlVector3f;
+typedef std::vector< double > StlVector3d;
+#if defined( CONTROL_BENCHMARK_EIGEN )
+typedef Eigen::Matrix< float, Eigen::Dynamic, 1 > EigenDynamicVector3f;
+typedef Eigen::Matrix< double, Eigen::Dynamic, 1 > EigenDynamicVector3d;
+typedef Eigen::Matrix< float, 3, 1 > EigenFixedVector3f;
+typedef Eigen::Matrix< double, 3, 1 > EigenFixedVector3d;
+#endif
+typedef std::array< float, 3 > ArrayVector3f;
+typedef std::array< double, 3 > ArrayVector3d;
+
+//! Create 3-vector for generic 3-vector types.
+template< typename Vector3 >
+Vector3 createVector( std::false_type )
+{
+    return Vector3( 3 );
+}
+
+//! Create 3-vector for fixed-size 3-vector types.
+template< typename Vector3 >
+Vector3 createVector( std::true_type )
+{
+    return Vector3( );
+}
+
+//! Create 3-vector with given components.
+template< typename Real, typename Vector3 >
+Vector3 createVector( const Real x, const Real y, const Real z )
+{
+    Vector3 vector = createVector< Vector3 >( IsFixedSizeVector3< Vector3 >( ) );
+    vector[ 0 ] = x;
+    vector[ 1 ] = y;
+    vector[ 2 ] = z;
+    return vector;
+}
+
+//! Benchmark single call to OGL, returning control authority.
+template< typename Real, typename Vector3 >
+void benchmarkOptimalGuidanceLaw( benchmark::State& state )
+{
+    Vector3 zeroEffortMiss = createVector< Real, Vector3 >( -21.163, 9.887, -0.613 );
+    Vector3 zeroEffortVelocity = createVector< Real, Vector3 >( -1.244, -0.112, 3.119 );
+    Real timeToGo = 12.516;
+
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( zeroEffortMiss );
+        benchmark::DoNotOptimize( zeroEffortVelocity );
+        benchmark::DoNotOptimize( timeToGo );
+        Vector3 controlEffort
+            = computeOptimalGuidanceLaw( zeroEffortMiss, zeroEffortVelocity, timeToGo );
+        benchmark::DoNotOptimize( controlEffort );
+    }
+
+    state.SetItemsProcessed( state.iterations( ) );
+}
+
+//! Benchmark single call to OGL, writing control authority in place.
+template< typename Real, typename Vector3 >
+void benchmarkOptimalGuidanceLawInPlace( benchmark::State& state )
+{
+    Vector3 zeroEffortMiss = createVector< Real, Vector3 >( -21.163, 9.887, -0.613 );
+    Vector3 zeroEffortVelocity = createVector< Real, Vector3 >( -1.244, -0.112, 3.119 );
+    Vector3 controlEffort = createVector< Real, Vector3 >( 0.0, 0.0, 0.0 );
+    Real timeToGo = 12.516;
+
+    for ( auto _ : state )
+    {
+        benchmark::DoNotOptimize( zeroEffortMiss );
+        benchmark::DoNotOptimize( zeroEffortVelocity );
+        benchmark::DoNotOptimize( timeToGo );
+        computeOptimalGuidanceLaw( zeroEffortMiss, zeroEffortVelocity, timeToGo, controlEffort );
+        benchmark::DoNotOptimize( controlEffort );
+        benchmark::ClobberMemory( );
+    }
+
+    state.SetItemsProcessed( state.iterations( ) );
+}
+
+//! Benchmark batched OGL, for given batch size and SIMD instruction set.
+template< typename Real >
+void benchmarkBatchedOptimalGuidanceLaw( benchmark::State& state )
+{
+    const std::size_t numberOfSamples = static_cast< std::size_t >( state.range( 0 ) );
+    const SimdInstructionSet instructionSet = static_cast< SimdInstructionSet >( state.range( 1 ) );
+
+    const SimdInstructionSet defaultInstructionSet = getSimdInstructionSet( );
+    if ( !setSimdInstructionSet( instructionSet ) )
+    {
+        state.SkipWithError( "SIMD instruction set not supported" );
+        return;
+    }
+
+    std::vector< Real > input( 7 * numberOfSamples );
+    std::vector< Real > output( 3 * numberOfSamples );
+    for ( std::size_t i = 0; i < numberOfSamples; ++i )
+    {
+        input[ i ] = Real( -21.163 );
+        input[ numberOfSamples + i ] = Real( 9.887 );
+        input[ 2 * numberOfSamples + i ] = Real( -0.613 );
+        input[ 3 * numberOfSamples + i ] = Real( -1.244 );
+        input[ 4 * numberOfSamples + i ] = Real( -0.112 );
+        input[ 5 * numberOfSamples + i ] = Real( 3.119 );
+        input[ 6 * numberOfSamples + i ] = Real( 12.516 ) + Real( i % 100 );
+    }
+
+    for ( auto _ : state )
+    {
+        computeOptimalGuidanceLaw( &input[ 0 ],
+                                   &input[ numberOfSamples ],
+                                   &input[ 2 * numberOfSamples ],
+                                   &input[ 3 * numberOfSamples ],
+                                   &input[ 4 * numberOfSamples ],
+                                   &input[ 5 * numberOfSamples ],
+                                   &input[ 6 * numberOfSamples ],
+                                   numberOfSamples,
+                                   &output[ 0 ],
+                                   &output[ numberOfSamples ],
+                                   &output[ 2 * numberOfSamples ] );
+        benchmark::DoNotOptimize( output.data( ) );
+        benchmark::ClobberMemory( );
+    }
+
+    setSimdInstructionSet( defaultInstructionSet );
+
+    state.SetItemsProcessed( state.iterations( ) * numberOfSamples );
+    state.counters[ "time_per_sample" ] = benchmark::Counter(
+        static_cast< double >( numberOfSamples ),
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert );
+}
+
+//! Set arguments for batched benchmarks: batch sizes from 1 to 10^6, for all instruction sets.
+void setBatchedArguments( benchmark::internal::Benchmark* benchmark )
+{
+    const std::size_t batchSizes[ 8 ] = { 1, 10, 100, 1000, 4096, 10000, 100000, 1000000 };
+    const SimdInstructionSet instructionSets[ 4 ] = { scalarInstructionSet,
+                                                      avx2InstructionSet,
+                                                      avx512InstructionSet,
+                                                      neonInstructionSet };
+    benchmark->ArgNames( { "samples", "simd" } );
+    for ( unsigned int i = 0; i < 4; ++i )
+    {
+        if ( !isSimdInstructionSetSupported( instructionSets[ i ] ) )
+        {
+            continue;
+        }
+
+        for ( unsigned int j = 0; j < 8; ++j )
+        {
+            benchmark->Args( { static_cast< long >( batchSizes[ j ] ),
+                               static_cast< long >( instructionSets[ i ] ) } );
+        }
+    }
+}
+
+BENCHMARK_TEMPLATE( benchmarkOptimalGuidanceLaw, float, StlVector3f );
+BENCHMARK_TEMPLATE( benchmarkOptimalGuidanceLaw, double, StlVector3d );
+#if defined( CONTROL_BENCHMARK_EIGEN )
+BENCHMARK_TEMPLATE( benchmarkOptimalGuidanceLaw, float, EigenDynamicVector3f );
+BENCHMARK_TEMPLATE( benchmarkOptimalGuidanceLaw, double, EigenDynamicVector3d );
+BENCHMARK_TEMPLATE( benchmarkOptimalGuidanceLaw, float, EigenFixedVector3f );
+BENCHMARK_TEMPLATE( benchmarkOptimalGuidanceLaw, double, EigenFixedVector3d );
+#endif
+BENCHMARK_TEMPLATE( benchmarkOptimalGuidanceLaw, float, ArrayVector3f );
+BENCHMARK_TEMPLATE( benchmarkOptimalGuidanceLaw, double, ArrayVector3d );
+
+BENCHMARK_TEMPLATE( benchmarkOptimalGuidanceLawInPlace, float, StlVector3f );
+BENCHMARK_TEMPLATE( benchmarkOptimalGuidanceLawInPlace, double, StlVector3d );
+#if defined( CONTROL_BENCHMARK_EIGEN )
+BENCHMARK_TEMPLATE( benchmarkOptimalGuidanceLawInPlace, float, EigenDynamicVector3f );
+BENCHMARK_TEMPLATE( benchmarkOptimalGuidanceLawInPlace, double, EigenDynamicVector3d );
+BENCHMARK_TEMPLATE( benchmarkOptimalGuidanceLawInPlace, float, EigenFixedVector3f );
+BENCHMARK_TEMPLATE( benchmarkOptimalGuidanceLawInPlace, double, EigenFixedVector3d );
+#endif
+BENCHMARK_TEMPLATE( benchmarkOptimalGuidanceLawInPlace, float, ArrayVector3f );
+BENCHMARK_TEMPLATE( benchmarkOptimalGuidanceLawInPlace, double, ArrayVector3d );
+
+BENCHMARK_TEMPLATE( benchmarkBatchedOptimalGuidanceLaw, float )->Apply( setBatchedArguments );
+BENCHMARK_TEMPLATE( benchmarkBatchedOptimalGuidanceLaw, double )->Apply( setBatchedArguments );
+
+} // namespace benchmarks
+} // namespace control
+
+BENCHMARK_MAIN( );
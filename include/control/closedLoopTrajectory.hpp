@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_CLOSED_LOOP_TRAJECTORY_HPP
+#define CONTROL_CLOSED_LOOP_TRAJECTORY_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "control/hostDevice.hpp"
+#include "control/monteCarloCampaign.hpp"
+#include "control/optimalGuidanceLaw.hpp"
+#include "control/randomNumberGenerator.hpp"
+
+namespace control
+{
+
+//! Fixed-size 3-vector for host and device code.
+/*!
+ * Plain 3-vector, whose subscript operators can be called from both host and device code. The
+ * vector is trivially copyable and exposes SizeAtCompileTime, such that it selects the fixed-size
+ * code paths of the OGL (see IsFixedSizeVector3).
+ *
+ * @tparam  Real Real type
+ */
+template< typename Real >
+struct DeviceVector3
+{
+    //! Size of vector, used to detect fixed-size 3-vector types.
+    static const int SizeAtCompileTime = 3;
+
+    //! Elements of vector.
+    Real elements[ 3 ];
+
+    //! Get element.
+    CONTROL_HOST_DEVICE Real& operator[ ]( const std::size_t index ) { return elements[ index ]; }
+
+    //! Get element.
+    CONTROL_HOST_DEVICE const Real& operator[ ]( const std::size_t index ) const
+    {
+        return elements[ index ];
+    }
+};
+
+//! Convert 3-vector to DeviceVector3.
+/*!
+ * @tparam  Real    Real type
+ * @tparam  Vector3 3-Vector type
+ * @param   vector  3-Vector to convert
+ * @return          Converted 3-vector
+ */
+template< typename Real, typename Vector3 >
+DeviceVector3< Real > toDeviceVector3( const Vector3& vector )
+{
+    DeviceVector3< Real > deviceVector;
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+        deviceVector[ i ] = static_cast< Real >( vector[ i ] );
+    }
+    return deviceVector;
+}
+
+//! Convert dispersion specification to DeviceVector3, e.g., to copy it to device memory.
+/*!
+ * @tparam  Real       Real type
+ * @tparam  Vector3    3-Vector type
+ * @param   dispersion Dispersion specification to convert
+ * @return             Converted dispersion specification
+ */
+template< typename Real, typename Vector3 >
+MonteCarloDispersion< Real, DeviceVector3< Real > > toDeviceDispersion(
+    const MonteCarloDispersion< Real, Vector3 >& dispersion )
+{
+    MonteCarloDispersion< Real, DeviceVector3< Real > > deviceDispersion;
+    deviceDispersion.initialPosition = toDeviceVector3< Real >( dispersion.initialPosition );
+    deviceDispersion.initialPositionStandardDeviation
+        = toDeviceVector3< Real >( dispersion.initialPositionStandardDeviation );
+    deviceDispersion.initialVelocity = toDeviceVector3< Real >( dispersion.initialVelocity );
+    deviceDispersion.initialVelocityStandardDeviation
+        = toDeviceVector3< Real >( dispersion.initialVelocityStandardDeviation );
+    deviceDispersion.gravitationalAcceleration
+        = toDeviceVector3< Real >( dispersion.gravitationalAcceleration );
+    deviceDispersion.gravitationalAccelerationStandardDeviation
+        = toDeviceVector3< Real >( dispersion.gravitationalAccelerationStandardDeviation );
+    deviceDispersion.zeroEffortMissGain = dispersion.zeroEffortMissGain;
+    deviceDispersion.zeroEffortMissGainStandardDeviation
+        = dispersion.zeroEffortMissGainStandardDeviation;
+    deviceDispersion.zeroEffortVelocityGain = dispersion.zeroEffortVelocityGain;
+    deviceDispersion.zeroEffortVelocityGainStandardDeviation
+        = dispersion.zeroEffortVelocityGainStandardDeviation;
+    deviceDispersion.positionNoiseStandardDeviation
+        = toDeviceVector3< Real >( dispersion.positionNoiseStandardDeviation );
+    deviceDispersion.velocityNoiseStandardDeviation
+        = toDeviceVector3< Real >( dispersion.velocityNoiseStandardDeviation );
+    return deviceDispersion;
+}
+
+//! Closed-loop OGL trajectory for host and device code.
+/*!
+ * State of a single closed-loop trajectory of a Monte Carlo campaign (see MonteCarloCampaign),
+ * which can be constructed, propagated and evaluated in both host and device code, e.g., by the
+ * GPU batch engine in gpuMonteCarloCampaign.cuh. The trajectory is trivially copyable and holds its
+ * own counter-based random number stream, such that it can be stored in device memory and
+ * propagated over any number of guidance steps per call: propagating in several calls yields the
+ * same state as propagating in one call.
+ *
+ * Random numbers are drawn in the same order, and all arithmetic is carried out in the same order,
+ * as in MonteCarloCampaign::simulateTrajectory( ), such that the results are bit-identical on the
+ * host. In device code, the results may differ in the last bits, due to floating-point
+ * contraction and the device implementations of the math functions.
+ *
+ * @tparam  Real Real type
+ */
+template< typename Real >
+class ClosedLoopTrajectory
+{
+public:
+
+    //! Device-compatible dispersion specification.
+    typedef MonteCarloDispersion< Real, DeviceVector3< Real > > Dispersion;
+
+    //! Construct trajectory by sampling initial state and control gains.
+    /*!
+     * @param   dispersion      Dispersion specification
+     * @param   seed            Seed of campaign
+     * @param   trajectoryIndex Index of trajectory
+     */
+    CONTROL_HOST_DEVICE ClosedLoopTrajectory( const Dispersion& dispersion,
+                                              const std::uint64_t seed,
+                                              const std::uint64_t trajectoryIndex )
+        : generator( seed, trajectoryIndex ),
+          deltaV( Real( 0.0 ) )
+    {
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            position[ i ] = generator.generateNormal(
+                dispersion.initialPosition[ i ], dispersion.initialPositionStandardDeviation[ i ] );
+            velocity[ i ] = generator.generateNormal(
+                dispersion.initialVelocity[ i ], dispersion.initialVelocityStandardDeviation[ i ] );
+            gravitationalAcceleration[ i ] = generator.generateNormal(
+                dispersion.gravitationalAcceleration[ i ],
+                dispersion.gravitationalAccelerationStandardDeviation[ i ] );
+        }
+        zeroEffortMissGain = generator.generateNormal(
+            dispersion.zeroEffortMissGain, dispersion.zeroEffortMissGainStandardDeviation );
+        zeroEffortVelocityGain = generator.generateNormal(
+            dispersion.zeroEffortVelocityGain, dispersion.zeroEffortVelocityGainStandardDeviation );
+    }
+
+    //! Propagate trajectory over range of guidance steps.
+    /*!
+     * Propagates the trajectory from the start of the first step to the start of the last step,
+     * i.e., over the steps [firstStep, lastStep). At each step, the state is measured with noise,
+     * the OGL control authority is computed with the nominal gravitational acceleration and held
+     * constant over the step, and the state is propagated exactly under the dispersed
+     * gravitational acceleration.
+     *
+     * @param   dispersion     Dispersion specification
+     * @param   targetPosition Target position
+     * @param   targetVelocity Target velocity
+     * @param   finalTime      Final time at which target state should be reached
+     * @param   numberOfSteps  Number of guidance steps of complete trajectory
+     * @param   firstStep      First guidance step to propagate
+     * @param   lastStep       Guidance step to propagate to, at most the number of steps
+     */
+    CONTROL_HOST_DEVICE void propagate( const Dispersion& dispersion,
+                                        const DeviceVector3< Real >& targetPosition,
+                                        const DeviceVector3< Real >& targetVelocity,
+                                        const Real finalTime,
+                                        const std::size_t numberOfSteps,
+                                        const std::size_t firstStep,
+                                        const std::size_t lastStep )
+    {
+        const Real stepSize = finalTime / static_cast< Real >( numberOfSteps );
+        const Real halfStepSizeSquared = Real( 0.5 ) * stepSize * stepSize;
+        DeviceVector3< Real > zeroEffortMiss;
+        DeviceVector3< Real > zeroEffortVelocity;
+        DeviceVector3< Real > controlEffort;
+
+        const DeviceVector3< Real >& nominalGravitationalAcceleration
+            = dispersion.gravitationalAcceleration;
+
+        for ( std::size_t step = firstStep; step < lastStep; ++step )
+        {
+            Real measuredPosition[ 3 ];
+            Real measuredVelocity[ 3 ];
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                measuredPosition[ i ] = generator.generateNormal(
+                    position[ i ], dispersion.positionNoiseStandardDeviation[ i ] );
+                measuredVelocity[ i ] = generator.generateNormal(
+                    velocity[ i ], dispersion.velocityNoiseStandardDeviation[ i ] );
+            }
+
+            const Real timeToGo = finalTime - static_cast< Real >( step ) * stepSize;
+            const Real halfTimeToGoSquared = Real( 0.5 ) * timeToGo * timeToGo;
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                zeroEffortMiss[ i ] = targetPosition[ i ]
+                                      - halfTimeToGoSquared * nominalGravitationalAcceleration[ i ]
+                                      - measuredPosition[ i ] - timeToGo * measuredVelocity[ i ];
+                zeroEffortVelocity[ i ] = targetVelocity[ i ]
+                                          - timeToGo * nominalGravitationalAcceleration[ i ]
+                                          - measuredVelocity[ i ];
+            }
+
+            computeOptimalGuidanceLaw( zeroEffortMiss,
+                                       zeroEffortVelocity,
+                                       timeToGo,
+                                       controlEffort,
+                                       zeroEffortMissGain,
+                                       zeroEffortVelocityGain );
+
+            Real controlEffortSquared = Real( 0.0 );
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                const Real acceleration = controlEffort[ i ] + gravitationalAcceleration[ i ];
+                position[ i ] += stepSize * velocity[ i ] + halfStepSizeSquared * acceleration;
+                velocity[ i ] += stepSize * acceleration;
+                controlEffortSquared += controlEffort[ i ] * controlEffort[ i ];
+            }
+            deltaV += stepSize * std::sqrt( controlEffortSquared );
+        }
+    }
+
+    //! Compute result of trajectory.
+    /*!
+     * Computes the terminal miss and Delta-V of the trajectory, which must have been propagated
+     * over all guidance steps.
+     *
+     * @param   targetPosition Target position
+     * @param   targetVelocity Target velocity
+     * @return                 Result of trajectory
+     */
+    CONTROL_HOST_DEVICE MonteCarloTrajectoryResult< Real > computeResult(
+        const DeviceVector3< Real >& targetPosition,
+        const DeviceVector3< Real >& targetVelocity ) const
+    {
+        Real positionMissSquared = Real( 0.0 );
+        Real velocityMissSquared = Real( 0.0 );
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            const Real positionMiss = position[ i ] - targetPosition[ i ];
+            const Real velocityMiss = velocity[ i ] - targetVelocity[ i ];
+            positionMissSquared += positionMiss * positionMiss;
+            velocityMissSquared += velocityMiss * velocityMiss;
+        }
+
+        MonteCarloTrajectoryResult< Real > result;
+        result.positionMiss = std::sqrt( positionMissSquared );
+        result.velocityMiss = std::sqrt( velocityMissSquared );
+        result.deltaV = deltaV;
+        return result;
+    }
+
+    //! Get current position.
+    /*!
+     * @return Current position
+     */
+    CONTROL_HOST_DEVICE const DeviceVector3< Real >& getPosition( ) const { return position; }
+
+    //! Get current velocity.
+    /*!
+     * @return Current velocity
+     */
+    CONTROL_HOST_DEVICE const DeviceVector3< Real >& getVelocity( ) const { return velocity; }
+
+private:
+
+    //! Random number stream of trajectory.
+    CounterBasedRandomNumberGenerator< Real > generator;
+
+    //! Current position.
+    DeviceVector3< Real > position;
+
+    //! Current velocity.
+    DeviceVector3< Real > velocity;
+
+    //! Dispersed gravitational acceleration.
+    DeviceVector3< Real > gravitationalAcceleration;
+
+    //! Dispersed control gain for ZEM term.
+    Real zeroEffortMissGain;
+
+    //! Dispersed control gain for ZEV term.
+    Real zeroEffortVelocityGain;
+
+    //! Accumulated Delta-V.
+    Real deltaV;
+};
+
+} // namespace control
+
+#endif // CONTROL_CLOSED_LOOP_TRAJECTORY_HPP
@@ -7,6 +7,36 @@
 #ifndef CONTROL_HPP
 #define CONTROL_HPP
 
+#include "control/closedLoopTrajectory.hpp"
+#include "control/eventDrivenOptimalGuidanceController.hpp"
+#include "control/formationGuidance.hpp"
+#include "control/frameArena.hpp"
+#include "control/gainTuner.hpp"
+#include "control/generalizedOptimalGuidanceController.hpp"
+#include "control/gravityModels.hpp"
+#include "control/guidanceService.hpp"
+#include "control/hostDevice.hpp"
+#include "control/instrumentation.hpp"
+#include "control/linearQuadraticRegulator.hpp"
+#include "control/modelPredictiveGuidance.hpp"
+#include "control/monteCarloCampaign.hpp"
+#include "control/optimalGuidanceController.hpp"
 #include "control/optimalGuidanceLaw.hpp"
+#include "control/optimalGuidanceSchedule.hpp"
+#include "control/parallel.hpp"
+#include "control/pidController.hpp"
+#include "control/pidControllerSimd.hpp"
+#include "control/randomNumberGenerator.hpp"
+#include "control/ringBuffer.hpp"
+#include "control/seqlockSlot.hpp"
+#include "control/slidingModeGuidance.hpp"
+#include "control/statistics.hpp"
+#include "control/thrustSaturation.hpp"
+#include "control/timeToGoSolver.hpp"
+#include "control/trajectoryLogger.hpp"
+
+#if defined( CONTROL_USE_EXPLICIT_INSTANTIATIONS )
+#include "control/explicitInstantiations.hpp"
+#endif
 
 #endif // CONTROL_HPP
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_API_H
+#define CONTROL_API_H
+
+/*
+ * C ABI of the control library.
+ *
+ * The C ABI exposes the batched guidance laws through functions with C linkage that operate on raw
+ * pointers with strides, such that arrays owned by other languages (e.g., NumPy arrays) can be
+ * passed without copying. All strides are given in bytes, as for NumPy arrays, and may be negative.
+ * Strides of inputs may be zero to broadcast a single value to all samples, whereas strides of
+ * outputs must be nonzero. The ABI is versioned: existing structs and functions are not changed,
+ * and new controllers are added as new functions.
+ *
+ * The functions do not throw exceptions and do not allocate memory, apart from the worker threads.
+ * The GIL of Python callers can therefore be released for the duration of each call, which is
+ * done by the ctypes bindings in python/openastro_control.
+ */
+
+#include <stddef.h>
+
+#if defined( CONTROL_API_STATIC )
+#define CONTROL_API
+#elif defined( _WIN32 )
+#if defined( CONTROL_API_EXPORTS )
+#define CONTROL_API __declspec( dllexport )
+#else
+#define CONTROL_API __declspec( dllimport )
+#endif
+#else
+#define CONTROL_API __attribute__( ( visibility( "default" ) ) )
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*! Version of the C ABI, incremented when functions are added. */
+#define CONTROL_API_VERSION 1
+
+/*! Status codes returned by the functions of the C ABI. */
+typedef enum controlStatus
+{
+    /*! Function completed successfully. */
+    controlSuccess = 0,
+
+    /*! Function was called with a null pointer or an invalid value. */
+    controlInvalidArgument = 1,
+
+    /*! Function failed internally, e.g., because worker threads could not be created. */
+    controlInternalError = 2
+} controlStatus;
+
+/*! Strided array of scalars, e.g., a 1-D NumPy array. */
+typedef struct controlStridedArray
+{
+    /*! Pointer to first element. */
+    const void* data;
+
+    /*! Stride between consecutive samples in bytes; zero to broadcast the first element. */
+    ptrdiff_t sampleStride;
+} controlStridedArray;
+
+/*! Strided array of 3-vectors, e.g., a NumPy array of shape (N, 3) or (3, N). */
+typedef struct controlStridedVector3Array
+{
+    /*! Pointer to first component of first vector. */
+    const void* data;
+
+    /*! Stride between consecutive samples in bytes. */
+    ptrdiff_t sampleStride;
+
+    /*! Stride between the components of a vector in bytes. */
+    ptrdiff_t componentStride;
+} controlStridedVector3Array;
+
+/*! Writable strided array of 3-vectors. */
+typedef struct controlMutableStridedVector3Array
+{
+    /*! Pointer to first component of first vector. */
+    void* data;
+
+    /*! Stride between consecutive samples in bytes, which must be nonzero. */
+    ptrdiff_t sampleStride;
+
+    /*! Stride between the components of a vector in bytes, which must be nonzero. */
+    ptrdiff_t componentStride;
+} controlMutableStridedVector3Array;
+
+/*!
+ * Get version of the C ABI.
+ *
+ * @return Value of CONTROL_API_VERSION that the library was compiled with
+ */
+CONTROL_API int controlGetApiVersion( void );
+
+/*!
+ * Compute control authority for Optimal Guidance Law (OGL) for a batch of samples in double
+ * precision.
+ *
+ * Evaluates the batched OGL (see computeOptimalGuidanceLaw( ) in optimalGuidanceLaw.hpp) across
+ * the given number of threads. The samples are processed in blocks: blocks whose components are
+ * stored contiguously are evaluated in place, and other blocks are gathered to and scattered from
+ * buffers on the stack that stay in the L1 cache. If the TTG floor is strictly positive, the OGL
+ * with terminal-phase handling is evaluated (see computeTerminalOptimalGuidanceLaw( )).
+ *
+ * @param   zeroEffortMiss          ZEM vectors
+ * @param   zeroEffortVelocity      ZEV vectors
+ * @param   timeToGo                TTGs to reach target
+ * @param   numberOfSamples         Number of samples
+ * @param   zeroEffortMissGain      Control gains for ZEM term (stride zero for a shared gain)
+ * @param   zeroEffortVelocityGain  Control gains for ZEV term (stride zero for a shared gain)
+ * @param   minimumTimeToGo         TTG floor of terminal phase; zero to disable terminal-phase
+ *                                  handling
+ * @param   numberOfThreads         Number of threads; if zero, the number of hardware threads is
+ *                                  used
+ * @param   controlEffort           Computed control authority, which must not overlap the inputs,
+ *                                  with nonzero strides
+ * @return                          Status code
+ */
+CONTROL_API controlStatus controlComputeOptimalGuidanceLawDouble(
+    const controlStridedVector3Array* zeroEffortMiss,
+    const controlStridedVector3Array* zeroEffortVelocity,
+    const controlStridedArray* timeToGo,
+    size_t numberOfSamples,
+    const controlStridedArray* zeroEffortMissGain,
+    const controlStridedArray* zeroEffortVelocityGain,
+    double minimumTimeToGo,
+    unsigned int numberOfThreads,
+    const controlMutableStridedVector3Array* controlEffort );
+
+/*!
+ * Compute control authority for Optimal Guidance Law (OGL) for a batch of samples in single
+ * precision.
+ *
+ * @sa controlComputeOptimalGuidanceLawDouble( )
+ */
+CONTROL_API controlStatus controlComputeOptimalGuidanceLawFloat(
+    const controlStridedVector3Array* zeroEffortMiss,
+    const controlStridedVector3Array* zeroEffortVelocity,
+    const controlStridedArray* timeToGo,
+    size_t numberOfSamples,
+    const controlStridedArray* zeroEffortMissGain,
+    const controlStridedArray* zeroEffortVelocityGain,
+    float minimumTimeToGo,
+    unsigned int numberOfThreads,
+    const controlMutableStridedVector3Array* controlEffort );
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* CONTROL_API_H */
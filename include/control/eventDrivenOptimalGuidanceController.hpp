@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_EVENT_DRIVEN_OPTIMAL_GUIDANCE_CONTROLLER_HPP
+#define CONTROL_EVENT_DRIVEN_OPTIMAL_GUIDANCE_CONTROLLER_HPP
+
+#include <cmath>
+
+#include "control/optimalGuidanceController.hpp"
+
+namespace control
+{
+
+//! Event-driven closed-loop Optimal Guidance Law (OGL) controller with error-bounded command hold.
+/*!
+ * Closed-loop controller that holds the last computed control authority, and only re-evaluates
+ * the OGL (see OptimalGuidanceController) once the held command may deviate from the command
+ * that the OGL would compute from the current state by more than a given tolerance.
+ *
+ * While a command \f$\vec{u}_{0}\f$, computed from \f$\vec{\text{ZEM}}_{0}\f$,
+ * \f$\vec{\text{ZEV}}_{0}\f$ and \f$T = t_{\text{go},0}\f$, is held for a time \f$s\f$ under
+ * constant gravity, the ZEM and ZEV vectors evolve as
+ * \f$\vec{\text{ZEM}}(s) = \vec{\text{ZEM}}_{0} - \vec{u}_{0} (T s - \frac{1}{2} s^{2})\f$ and
+ * \f$\vec{\text{ZEV}}(s) = \vec{\text{ZEV}}_{0} - \vec{u}_{0} s\f$. Since \f$\vec{u}_{0}\f$ is
+ * itself a linear combination of \f$\vec{\text{ZEM}}_{0}\f$ and \f$\vec{\text{ZEV}}_{0}\f$, the
+ * drift of the OGL command from the held command is
+ *
+ * \f[
+ *      \vec{u}(s) - \vec{u}_{0} = \alpha(s) \vec{\text{ZEM}}_{0} + \beta(s) \vec{\text{ZEV}}_{0}
+ * \f]
+ *
+ * with \f$\alpha(s) = k_{r} / t_{\text{go}}^{2} - c(s) k_{r} / T^{2}\f$,
+ * \f$\beta(s) = k_{v} / t_{\text{go}} - c(s) k_{v} / T\f$,
+ * \f$c(s) = 1 + k_{r} (T s - \frac{1}{2} s^{2}) / t_{\text{go}}^{2} + k_{v} s / t_{\text{go}}\f$
+ * and \f$t_{\text{go}} = T - s\f$. Its norm follows from the squared norms and the dot product of
+ * \f$\vec{\text{ZEM}}_{0}\f$ and \f$\vec{\text{ZEV}}_{0}\f$, which are cached at each evaluation,
+ * such that the bound is checked with a few scalar operations, without reading the state. If the
+ * acceleration of the vehicle deviates from the held command plus gravity by at most
+ * \f$d\f$ (e.g., due to thrust errors or gravity model errors), the drift is bounded by adding
+ *
+ * \f[
+ *      d \left( |k_{r}| \frac{T s - \frac{1}{2} s^{2}}{t_{\text{go}}^{2}}
+ *              + |k_{v}| \frac{s}{t_{\text{go}}} \right)
+ * \f]
+ *
+ * The bound grows without limit as the TTG goes to zero, such that the OGL is re-evaluated at
+ * every call in the terminal phase, while in cruise phases a command is typically held for many
+ * calls at high control rates. The bound on the error of the returned command is reported by
+ * getCommandErrorBound( ).
+ *
+ * All intermediate vectors are stored as members, such that no memory is allocated when computing
+ * the control authority.
+ *
+ * @sa OptimalGuidanceController, computeOptimalGuidanceLaw( )
+ * @tparam  Real    Real type
+ * @tparam  Vector3 3-Vector type
+ */
+template< typename Real, typename Vector3 >
+class EventDrivenOptimalGuidanceController
+{
+public:
+
+    //! Construct controller.
+    /*!
+     * Constructs controller for given target state, gravitational acceleration, final time and
+     * tolerance on the error of the held command.
+     *
+     * @param   aTargetPosition             Target position
+     * @param   aTargetVelocity             Target velocity
+     * @param   aGravitationalAcceleration  Constant gravitational acceleration
+     * @param   aFinalTime                  Final time at which target state should be reached
+     * @param   aCommandTolerance           Tolerance on norm of deviation of held command from OGL
+     *                                      command, above which the OGL is re-evaluated
+     * @param   aDisturbanceAcceleration    Bound on norm of deviation of acceleration from held
+     *                                      command plus gravitational acceleration (default=0.0)
+     * @param   aZeroEffortMissGain         Control gain for ZEM term (default=6.0)
+     * @param   aZeroEffortVelocityGain     Control gain for ZEV term (default=-2.0)
+     */
+    EventDrivenOptimalGuidanceController( const Vector3& aTargetPosition,
+                                          const Vector3& aTargetVelocity,
+                                          const Vector3& aGravitationalAcceleration,
+                                          const Real aFinalTime,
+                                          const Real aCommandTolerance,
+                                          const Real aDisturbanceAcceleration = Real( 0.0 ),
+                                          const Real aZeroEffortMissGain = Real( 6.0 ),
+                                          const Real aZeroEffortVelocityGain = Real( -2.0 ) )
+        : controller( aTargetPosition,
+                      aTargetVelocity,
+                      aGravitationalAcceleration,
+                      aFinalTime,
+                      aZeroEffortMissGain,
+                      aZeroEffortVelocityGain ),
+          commandTolerance( aCommandTolerance ),
+          disturbanceAcceleration( aDisturbanceAcceleration ),
+          zeroEffortMissGain( aZeroEffortMissGain ),
+          zeroEffortVelocityGain( aZeroEffortVelocityGain ),
+          isCommandCached( false ),
+          isHeld( false ),
+          numberOfEvaluations( 0 ),
+          evaluationTime( Real( 0.0 ) ),
+          evaluationTimeToGo( aFinalTime ),
+          zeroEffortMissNormSquared( Real( 0.0 ) ),
+          zeroEffortVelocityNormSquared( Real( 0.0 ) ),
+          zeroEffortDotProduct( Real( 0.0 ) ),
+          commandErrorBound( Real( 0.0 ) ),
+          controlEffort( aTargetPosition )
+    { }
+
+    //! Compute control authority.
+    /*!
+     * Computes the control authority for the given current time and state. The held command is
+     * returned if the bound on its deviation from the OGL command does not exceed the tolerance;
+     * otherwise, the OGL is re-evaluated from the current state. The current time must be strictly
+     * less than the final time, and must not decrease between successive calls while a command is
+     * held; otherwise, the OGL is re-evaluated.
+     *
+     * @param   currentTime Current time
+     * @param   position    Current position
+     * @param   velocity    Current velocity
+     * @return              Computed control authority
+     */
+    const Vector3& computeControl( const Real currentTime,
+                                   const Vector3& position,
+                                   const Vector3& velocity )
+    {
+        if ( isCommandCached )
+        {
+            const Real holdTime = currentTime - evaluationTime;
+            if ( holdTime >= Real( 0.0 ) && holdTime < evaluationTimeToGo )
+            {
+                const Real bound = computeCommandErrorBound( holdTime );
+                if ( bound <= commandTolerance )
+                {
+                    commandErrorBound = bound;
+                    isHeld = true;
+                    return controlEffort;
+                }
+            }
+        }
+
+        const Vector3& evaluatedControlEffort
+            = controller.computeControl( currentTime, position, velocity );
+        const Vector3& zeroEffortMiss = controller.getZeroEffortMiss( );
+        const Vector3& zeroEffortVelocity = controller.getZeroEffortVelocity( );
+
+        zeroEffortMissNormSquared = Real( 0.0 );
+        zeroEffortVelocityNormSquared = Real( 0.0 );
+        zeroEffortDotProduct = Real( 0.0 );
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            controlEffort[ i ] = evaluatedControlEffort[ i ];
+            zeroEffortMissNormSquared += zeroEffortMiss[ i ] * zeroEffortMiss[ i ];
+            zeroEffortVelocityNormSquared += zeroEffortVelocity[ i ] * zeroEffortVelocity[ i ];
+            zeroEffortDotProduct += zeroEffortMiss[ i ] * zeroEffortVelocity[ i ];
+        }
+
+        evaluationTime = currentTime;
+        evaluationTimeToGo = controller.getTimeToGo( );
+        commandErrorBound = Real( 0.0 );
+        isCommandCached = true;
+        isHeld = false;
+        ++numberOfEvaluations;
+        return controlEffort;
+    }
+
+    //! Discard held command.
+    /*!
+     * Discards held command, such that the OGL is re-evaluated from the current state at the next
+     * call to computeControl( ), e.g., after a state jump.
+     */
+    void resetCommand( ) { isCommandCached = false; }
+
+    //! Set final time.
+    /*!
+     * Sets final time at which target state should be reached, e.g., to update the final time
+     * based on a time-to-go solver. The held command is discarded.
+     *
+     * @param   aFinalTime Final time
+     */
+    void setFinalTime( const Real aFinalTime )
+    {
+        controller.setFinalTime( aFinalTime );
+        isCommandCached = false;
+    }
+
+    //! Get final time.
+    /*!
+     * @return Final time at which target state should be reached
+     */
+    Real getFinalTime( ) const { return controller.getFinalTime( ); }
+
+    //! Get bound on error of control authority returned at last call to computeControl( ).
+    /*!
+     * Gets bound on norm of deviation of the control authority returned at the last call to
+     * computeControl( ) from the OGL command for the current state, which is zero if the OGL was
+     * re-evaluated.
+     *
+     * @return Bound on command error
+     */
+    Real getCommandErrorBound( ) const { return commandErrorBound; }
+
+    //! Check if command was held at last call to computeControl( ).
+    /*!
+     * @return True if command was held, false if OGL was re-evaluated
+     */
+    bool isCommandHeld( ) const { return isHeld; }
+
+    //! Get number of OGL evaluations performed.
+    /*!
+     * @return Number of OGL evaluations performed
+     */
+    unsigned int getNumberOfEvaluations( ) const { return numberOfEvaluations; }
+
+private:
+
+    //! Compute bound on deviation of held command from OGL command after given hold time.
+    /*!
+     * @param   holdTime    Time since last evaluation, which must be less than the TTG at the
+     *                      last evaluation
+     * @return              Bound on command error
+     */
+    Real computeCommandErrorBound( const Real holdTime ) const
+    {
+        const Real timeToGo = evaluationTimeToGo - holdTime;
+        const Real positionFactor
+            = ( evaluationTimeToGo * holdTime - Real( 0.5 ) * holdTime * holdTime )
+              / ( timeToGo * timeToGo );
+        const Real velocityFactor = holdTime / timeToGo;
+
+        const Real heldCommandFactor = Real( 1.0 )
+                                       + zeroEffortMissGain * positionFactor
+                                       + zeroEffortVelocityGain * velocityFactor;
+        const Real zeroEffortMissFactor
+            = zeroEffortMissGain / ( timeToGo * timeToGo )
+              - heldCommandFactor * zeroEffortMissGain
+                / ( evaluationTimeToGo * evaluationTimeToGo );
+        const Real zeroEffortVelocityFactor
+            = zeroEffortVelocityGain / timeToGo
+              - heldCommandFactor * zeroEffortVelocityGain / evaluationTimeToGo;
+
+        const Real driftSquared
+            = zeroEffortMissFactor * zeroEffortMissFactor * zeroEffortMissNormSquared
+              + Real( 2.0 ) * zeroEffortMissFactor * zeroEffortVelocityFactor
+                * zeroEffortDotProduct
+              + zeroEffortVelocityFactor * zeroEffortVelocityFactor
+                * zeroEffortVelocityNormSquared;
+
+        using std::abs;
+        using std::sqrt;
+        return sqrt( driftSquared > Real( 0.0 ) ? driftSquared : Real( 0.0 ) )
+               + disturbanceAcceleration * ( abs( zeroEffortMissGain ) * positionFactor
+                                             + abs( zeroEffortVelocityGain ) * velocityFactor );
+    }
+
+    //! Controller used to evaluate OGL.
+    OptimalGuidanceController< Real, Vector3 > controller;
+
+    //! Tolerance on norm of deviation of held command from OGL command.
+    Real commandTolerance;
+
+    //! Bound on norm of deviation of acceleration from held command plus gravity.
+    Real disturbanceAcceleration;
+
+    //! Control gain for ZEM term.
+    Real zeroEffortMissGain;
+
+    //! Control gain for ZEV term.
+    Real zeroEffortVelocityGain;
+
+    //! Flag indicating if a command is held.
+    bool isCommandCached;
+
+    //! Flag indicating if command was held at last call to computeControl( ).
+    bool isHeld;
+
+    //! Number of OGL evaluations performed.
+    unsigned int numberOfEvaluations;
+
+    //! Time of last OGL evaluation.
+    Real evaluationTime;
+
+    //! TTG at last OGL evaluation.
+    Real evaluationTimeToGo;
+
+    //! Squared norm of ZEM vector at last OGL evaluation.
+    Real zeroEffortMissNormSquared;
+
+    //! Squared norm of ZEV vector at last OGL evaluation.
+    Real zeroEffortVelocityNormSquared;
+
+    //! Dot product of ZEM and ZEV vectors at last OGL evaluation.
+    Real zeroEffortDotProduct;
+
+    //! Bound on error of control authority returned at last call to computeControl( ).
+    Real commandErrorBound;
+
+    //! Held control authority.
+    Vector3 controlEffort;
+};
+
+} // namespace control
+
+#endif // CONTROL_EVENT_DRIVEN_OPTIMAL_GUIDANCE_CONTROLLER_HPP
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_EXPLICIT_INSTANTIATIONS_HPP
+#define CONTROL_EXPLICIT_INSTANTIATIONS_HPP
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#if defined( CONTROL_EXPLICIT_INSTANTIATIONS_EIGEN )
+#include <Eigen/Core>
+#endif
+
+#include "control/eventDrivenOptimalGuidanceController.hpp"
+#include "control/optimalGuidanceController.hpp"
+#include "control/optimalGuidanceLaw.hpp"
+#include "control/slidingModeGuidance.hpp"
+#include "control/thrustSaturation.hpp"
+
+// Explicit instantiations of the guidance templates for the common real and 3-vector types.
+//
+// This header declares the instantiations as extern templates, such that translation units that
+// include it do not instantiate the guidance templates for these types themselves, but link
+// against the instantiations compiled once in the control_instantiations library (see
+// src/explicitInstantiations.cpp). It is included by control.hpp if
+// CONTROL_USE_EXPLICIT_INSTANTIATIONS is defined, which is done for all targets that link against
+// control_instantiations. The Eigen instantiations are only declared if
+// CONTROL_EXPLICIT_INSTANTIATIONS_EIGEN is defined, which is done if the library was built with
+// Eigen.
+//
+// The instantiated functions are not inlined at the call site, since their definitions are not
+// instantiated in the including translation unit. Hot loops that evaluate the single-sample
+// functions with fixed-size 3-vectors should therefore not include this header; the batched
+// functions are not affected, since their cost is dominated by the kernels. The library and its
+// consumers must be compiled with the same CONTROL_ENABLE_INSTRUMENTATION and
+// CONTROL_ENABLE_DETERMINISTIC_MODE definitions.
+
+//! Declare or define explicit instantiations of the guidance templates for a 3-vector type.
+/*!
+ * @param   EXTERN  Either extern, to declare the instantiations, or empty, to define them
+ * @param   Real    Real type
+ * @param   ...     3-Vector type
+ */
+#define CONTROL_INSTANTIATE_VECTOR_GUIDANCE( EXTERN, Real, ... )                                   \
+    EXTERN template void computeOptimalGuidanceLaw< Real, __VA_ARGS__ >(                           \
+        const __VA_ARGS__&, const __VA_ARGS__&, const Real, __VA_ARGS__&, const Real, const Real );\
+    EXTERN template void computeTerminalOptimalGuidanceLaw< Real, __VA_ARGS__ >(                   \
+        const __VA_ARGS__&, const __VA_ARGS__&, const Real, const Real, __VA_ARGS__&,              \
+        const Real, const Real );                                                                  \
+    EXTERN template unsigned char computeSaturatedOptimalGuidanceLaw< Real, __VA_ARGS__ >(         \
+        const __VA_ARGS__&, const __VA_ARGS__&, const Real, const ThrustLimits< Real >&,           \
+        __VA_ARGS__&, const Real, const Real );                                                    \
+    EXTERN template void computeSlidingModeOptimalGuidanceLaw< Real, __VA_ARGS__ >(                \
+        const __VA_ARGS__&, const __VA_ARGS__&, const Real, const Real, const Real,                \
+        __VA_ARGS__& );                                                                            \
+    EXTERN template class OptimalGuidanceController< Real, __VA_ARGS__ >;                          \
+    EXTERN template class EventDrivenOptimalGuidanceController< Real, __VA_ARGS__ >
+
+//! Declare or define explicit instantiations of the value-returning OGL for a 3-vector type.
+/*!
+ * The value-returning OGL is not instantiated for std::array, since calls with std::array
+ * 3-vectors resolve to the constexpr overload, which is implicitly inline.
+ *
+ * @sa CONTROL_INSTANTIATE_VECTOR_GUIDANCE
+ */
+#define CONTROL_INSTANTIATE_RETURNING_GUIDANCE( EXTERN, Real, ... )                                \
+    EXTERN template __VA_ARGS__ computeOptimalGuidanceLaw< Real, __VA_ARGS__ >(                    \
+        const __VA_ARGS__&, const __VA_ARGS__&, const Real, const Real, const Real )
+
+//! Declare or define explicit instantiations of the batched guidance templates for a real type.
+/*!
+ * @param   EXTERN  Either extern, to declare the instantiations, or empty, to define them
+ * @param   Real    Real type
+ */
+#define CONTROL_INSTANTIATE_BATCHED_GUIDANCE( EXTERN, Real )                                       \
+    EXTERN template void computeOptimalGuidanceLaw< Real >(                                        \
+        const Real*, const Real*, const Real*, const Real*, const Real*, const Real*,              \
+        const Real*, const std::size_t, Real*, Real*, Real*, const Real, const Real );             \
+    EXTERN template void computeOptimalGuidanceLaw< Real >(                                        \
+        const Real*, const Real*, const Real*, const Real*, const Real*, const Real*,              \
+        const Real*, const std::size_t, Real*, Real*, Real*, const Real*, const Real* );           \
+    EXTERN template void computeTerminalOptimalGuidanceLaw< Real >(                                \
+        const Real*, const Real*, const Real*, const Real*, const Real*, const Real*,              \
+        const Real*, const std::size_t, const Real, Real*, Real*, Real*, const Real, const Real ); \
+    EXTERN template void computeTerminalOptimalGuidanceLaw< Real >(                                \
+        const Real*, const Real*, const Real*, const Real*, const Real*, const Real*,              \
+        const Real*, const std::size_t, const Real, Real*, Real*, Real*,                           \
+        const Real*, const Real* );                                                                \
+    EXTERN template std::size_t computeSaturatedOptimalGuidanceLaw< Real >(                        \
+        const Real*, const Real*, const Real*, const Real*, const Real*, const Real*,              \
+        const Real*, const std::size_t, const ThrustLimits< Real >&, Real*, Real*, Real*,          \
+        unsigned char*, const Real, const Real );                                                  \
+    EXTERN template std::size_t computeSaturatedOptimalGuidanceLaw< Real >(                        \
+        const Real*, const Real*, const Real*, const Real*, const Real*, const Real*,              \
+        const Real*, const std::size_t, const ThrustLimits< Real >&, Real*, Real*, Real*,          \
+        unsigned char*, const Real*, const Real* );                                                \
+    EXTERN template void computeSlidingModeOptimalGuidanceLaw< Real >(                             \
+        const Real*, const Real*, const Real*, const Real*, const Real*, const Real*,              \
+        const Real*, const std::size_t, const Real, const Real, Real*, Real*, Real* )
+
+#if !defined( __CUDACC__ ) && !defined( __HIPCC__ )
+
+namespace control
+{
+
+CONTROL_INSTANTIATE_BATCHED_GUIDANCE( extern, float );
+CONTROL_INSTANTIATE_BATCHED_GUIDANCE( extern, double );
+
+CONTROL_INSTANTIATE_VECTOR_GUIDANCE( extern, float, std::array< float, 3 > );
+CONTROL_INSTANTIATE_VECTOR_GUIDANCE( extern, double, std::array< double, 3 > );
+
+CONTROL_INSTANTIATE_VECTOR_GUIDANCE( extern, float, std::vector< float > );
+CONTROL_INSTANTIATE_VECTOR_GUIDANCE( extern, double, std::vector< double > );
+CONTROL_INSTANTIATE_RETURNING_GUIDANCE( extern, float, std::vector< float > );
+CONTROL_INSTANTIATE_RETURNING_GUIDANCE( extern, double, std::vector< double > );
+
+#if defined( CONTROL_EXPLICIT_INSTANTIATIONS_EIGEN )
+CONTROL_INSTANTIATE_VECTOR_GUIDANCE( extern, float, Eigen::Matrix< float, 3, 1 > );
+CONTROL_INSTANTIATE_VECTOR_GUIDANCE( extern, double, Eigen::Matrix< double, 3, 1 > );
+CONTROL_INSTANTIATE_RETURNING_GUIDANCE( extern, float, Eigen::Matrix< float, 3, 1 > );
+CONTROL_INSTANTIATE_RETURNING_GUIDANCE( extern, double, Eigen::Matrix< double, 3, 1 > );
+#endif // CONTROL_EXPLICIT_INSTANTIATIONS_EIGEN
+
+} // namespace control
+
+#endif // !__CUDACC__ && !__HIPCC__
+
+#endif // CONTROL_EXPLICIT_INSTANTIATIONS_HPP
@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_FORMATION_GUIDANCE_HPP
+#define CONTROL_FORMATION_GUIDANCE_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "control/instrumentation.hpp"
+#include "control/optimalGuidanceLaw.hpp"
+
+namespace control
+{
+
+// The target ephemerides below are policies for formation guidance. A target ephemeris is any type
+// that provides the following member function, which computes the state of the target at a given
+// time without allocating memory:
+//
+//     void computeState( const Real time, Vector3& position, Vector3& velocity ) const;
+//
+// The output vectors are pre-sized to 3 elements.
+
+//! Target ephemeris for a target with constant acceleration.
+/*!
+ * Ephemeris of a target that moves with constant acceleration, e.g., a stationary landing site
+ * (zero velocity and acceleration), a target moving in a uniform gravity field, or a target moving
+ * with constant velocity:
+ *
+ * \f[
+ *      \vec{r}(t) = \vec{r}_{0} + \vec{v}_{0} (t - t_{0}) + \frac{1}{2} \vec{a} (t - t_{0})^{2},
+ *      \quad
+ *      \vec{v}(t) = \vec{v}_{0} + \vec{a} (t - t_{0})
+ * \f]
+ *
+ * @tparam  Real    Real type
+ * @tparam  Vector3 3-Vector type
+ */
+template< typename Real, typename Vector3 >
+class ConstantAccelerationTarget
+{
+public:
+
+    //! Construct target ephemeris.
+    /*!
+     * @param   aPosition      Position of target at epoch
+     * @param   aVelocity      Velocity of target at epoch
+     * @param   anAcceleration Constant acceleration of target
+     * @param   anEpoch        Epoch (default=0.0)
+     */
+    ConstantAccelerationTarget( const Vector3& aPosition,
+                                const Vector3& aVelocity,
+                                const Vector3& anAcceleration,
+                                const Real anEpoch = Real( 0.0 ) )
+        : position( aPosition ),
+          velocity( aVelocity ),
+          acceleration( anAcceleration ),
+          epoch( anEpoch )
+    { }
+
+    //! Compute state of target.
+    /*!
+     * @param   time           Time
+     * @param   targetPosition Computed position of target
+     * @param   targetVelocity Computed velocity of target
+     */
+    void computeState( const Real time, Vector3& targetPosition, Vector3& targetVelocity ) const
+    {
+        const Real elapsedTime = time - epoch;
+        const Real halfElapsedTimeSquared = Real( 0.5 ) * elapsedTime * elapsedTime;
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            targetPosition[ i ] = position[ i ] + elapsedTime * velocity[ i ]
+                                  + halfElapsedTimeSquared * acceleration[ i ];
+            targetVelocity[ i ] = velocity[ i ] + elapsedTime * acceleration[ i ];
+        }
+    }
+
+private:
+
+    //! Position of target at epoch.
+    Vector3 position;
+
+    //! Velocity of target at epoch.
+    Vector3 velocity;
+
+    //! Constant acceleration of target.
+    Vector3 acceleration;
+
+    //! Epoch.
+    Real epoch;
+};
+
+//! Multi-vehicle formation guidance with shared target propagation.
+/*!
+ * Computes the OGL control authority for a formation of vehicles in a uniform gravity field, where
+ * each vehicle is assigned to one of a set of targets and aims at the state of its target at the
+ * final time of that target, displaced by a per-vehicle offset (e.g., its slot in the formation).
+ * The ZEM and ZEV vectors of each vehicle are computed as in OptimalGuidanceController, with the
+ * target state replaced by the propagated target state.
+ *
+ * At each call, the ephemeris of each distinct target is evaluated once at its final time, and the
+ * result is shared by all vehicles assigned to that target, such that the cost of the target
+ * propagation does not grow with the number of vehicles. The ZEM and ZEV vectors of all vehicles
+ * are assembled in structure-of-arrays (SoA) form and the OGL is evaluated for the whole formation
+ * as a single batch (see the batched computeOptimalGuidanceLaw( )), using the SIMD kernels. All
+ * buffers are allocated on construction, such that no memory is allocated when computing the
+ * control authority.
+ *
+ * For zero offsets, the control authority agrees with that of an OptimalGuidanceController per
+ * vehicle, with the propagated target state, to within round-off; for the scalar kernel in
+ * deterministic mode (see simd.hpp), it is bit-identical.
+ *
+ * @sa computeOptimalGuidanceLaw( ), OptimalGuidanceController
+ * @tparam  Real            Real type
+ * @tparam  Vector3         3-Vector type
+ * @tparam  TargetEphemeris Target ephemeris policy
+ */
+template< typename Real, typename Vector3, typename TargetEphemeris >
+class FormationGuidance
+{
+public:
+
+    //! Construct formation guidance.
+    /*!
+     * @param   aTargets                   Target ephemerides
+     * @param   aFinalTimes                Final time at which each target should be reached
+     * @param   aTargetIndices             Index of target assigned to each vehicle
+     * @param   aTargetOffsets             Offset of each vehicle from the state of its target;
+     *                                     if empty, all offsets are zero
+     * @param   aGravitationalAcceleration Constant gravitational acceleration
+     * @param   aZeroEffortMissGain        Control gain for ZEM term (default=6.0)
+     * @param   aZeroEffortVelocityGain    Control gain for ZEV term (default=-2.0)
+     * @throws  std::invalid_argument      If the number of final times differs from the number
+     *                                     of targets, the number of offsets is neither zero nor
+     *                                     the number of vehicles, or a target index is out of range
+     */
+    FormationGuidance( const std::vector< TargetEphemeris >& aTargets,
+                       const std::vector< Real >& aFinalTimes,
+                       const std::vector< std::size_t >& aTargetIndices,
+                       const std::vector< Vector3 >& aTargetOffsets,
+                       const Vector3& aGravitationalAcceleration,
+                       const Real aZeroEffortMissGain = Real( 6.0 ),
+                       const Real aZeroEffortVelocityGain = Real( -2.0 ) )
+        : targets( aTargets ),
+          finalTimes( aFinalTimes ),
+          targetIndices( aTargetIndices ),
+          gravitationalAcceleration( aGravitationalAcceleration ),
+          zeroEffortMissGain( aZeroEffortMissGain ),
+          zeroEffortVelocityGain( aZeroEffortVelocityGain ),
+          targetPosition( aGravitationalAcceleration ),
+          targetVelocity( aGravitationalAcceleration )
+    {
+        const std::size_t numberOfTargets = targets.size( );
+        const std::size_t numberOfVehicles = targetIndices.size( );
+
+        if ( finalTimes.size( ) != numberOfTargets )
+        {
+            throw std::invalid_argument( "Number of final times differs from number of targets" );
+        }
+        if ( !aTargetOffsets.empty( ) && aTargetOffsets.size( ) != numberOfVehicles )
+        {
+            throw std::invalid_argument( "Number of offsets differs from number of vehicles" );
+        }
+        for ( std::size_t j = 0; j < numberOfVehicles; ++j )
+        {
+            if ( targetIndices[ j ] >= numberOfTargets )
+            {
+                throw std::invalid_argument( "Target index out of range" );
+            }
+        }
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            targetOffsets[ i ].assign( numberOfVehicles, Real( 0.0 ) );
+            for ( std::size_t j = 0; j < aTargetOffsets.size( ); ++j )
+            {
+                targetOffsets[ i ][ j ] = static_cast< Real >( aTargetOffsets[ j ][ i ] );
+            }
+            targetFinalPositions[ i ].resize( numberOfTargets );
+            targetFinalVelocities[ i ].resize( numberOfTargets );
+            zeroEffortMisses[ i ].resize( numberOfVehicles );
+            zeroEffortVelocities[ i ].resize( numberOfVehicles );
+        }
+        targetTimesToGo.resize( numberOfTargets );
+        timesToGo.resize( numberOfVehicles );
+    }
+
+    //! Compute control authority for all vehicles.
+    /*!
+     * Computes the control authority for all vehicles for the given current time and states,
+     * stored in SoA form. The current time must be strictly less than the final times of all
+     * targets.
+     *
+     * @param   currentTime    Current time
+     * @param   positionX      Array of x-components of vehicle positions
+     * @param   positionY      Array of y-components of vehicle positions
+     * @param   positionZ      Array of z-components of vehicle positions
+     * @param   velocityX      Array of x-components of vehicle velocities
+     * @param   velocityY      Array of y-components of vehicle velocities
+     * @param   velocityZ      Array of z-components of vehicle velocities
+     * @param   controlEffortX Array of x-components of computed control authority
+     * @param   controlEffortY Array of y-components of computed control authority
+     * @param   controlEffortZ Array of z-components of computed control authority
+     */
+    void computeControl( const Real currentTime,
+                         const Real* positionX,
+                         const Real* positionY,
+                         const Real* positionZ,
+                         const Real* velocityX,
+                         const Real* velocityY,
+                         const Real* velocityZ,
+                         Real* controlEffortX,
+                         Real* controlEffortY,
+                         Real* controlEffortZ )
+    {
+        CONTROL_INSTRUMENT_SCOPE( formationGuidanceProbe );
+
+        for ( std::size_t k = 0; k < targets.size( ); ++k )
+        {
+            targets[ k ].computeState( finalTimes[ k ], targetPosition, targetVelocity );
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                targetFinalPositions[ i ][ k ] = static_cast< Real >( targetPosition[ i ] );
+                targetFinalVelocities[ i ][ k ] = static_cast< Real >( targetVelocity[ i ] );
+            }
+            targetTimesToGo[ k ] = finalTimes[ k ] - currentTime;
+        }
+
+        const Real* const positions[ 3 ] = { positionX, positionY, positionZ };
+        const Real* const velocities[ 3 ] = { velocityX, velocityY, velocityZ };
+        const std::size_t numberOfVehicles = targetIndices.size( );
+        for ( std::size_t j = 0; j < numberOfVehicles; ++j )
+        {
+            timesToGo[ j ] = targetTimesToGo[ targetIndices[ j ] ];
+        }
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            const Real gravity = static_cast< Real >( gravitationalAcceleration[ i ] );
+            const Real* const position = positions[ i ];
+            const Real* const velocity = velocities[ i ];
+            Real* const zeroEffortMiss = zeroEffortMisses[ i ].data( );
+            Real* const zeroEffortVelocity = zeroEffortVelocities[ i ].data( );
+            for ( std::size_t j = 0; j < numberOfVehicles; ++j )
+            {
+                const std::size_t k = targetIndices[ j ];
+                const Real timeToGo = timesToGo[ j ];
+                const Real halfTimeToGoSquared = Real( 0.5 ) * timeToGo * timeToGo;
+                zeroEffortMiss[ j ] = ( targetFinalPositions[ i ][ k ] + targetOffsets[ i ][ j ] )
+                                      - halfTimeToGoSquared * gravity
+                                      - position[ j ] - timeToGo * velocity[ j ];
+                zeroEffortVelocity[ j ] = targetFinalVelocities[ i ][ k ]
+                                          - timeToGo * gravity
+                                          - velocity[ j ];
+            }
+        }
+
+        computeOptimalGuidanceLaw( zeroEffortMisses[ 0 ].data( ),
+                                   zeroEffortMisses[ 1 ].data( ),
+                                   zeroEffortMisses[ 2 ].data( ),
+                                   zeroEffortVelocities[ 0 ].data( ),
+                                   zeroEffortVelocities[ 1 ].data( ),
+                                   zeroEffortVelocities[ 2 ].data( ),
+                                   timesToGo.data( ),
+                                   numberOfVehicles,
+                                   controlEffortX,
+                                   controlEffortY,
+                                   controlEffortZ,
+                                   zeroEffortMissGain,
+                                   zeroEffortVelocityGain );
+    }
+
+    //! Set final time of target.
+    /*!
+     * Sets final time at which the given target should be reached by all vehicles assigned to it,
+     * e.g., to update the final time based on a time-to-go solver.
+     *
+     * @param   targetIndex Index of target
+     * @param   aFinalTime  Final time
+     */
+    void setFinalTime( const std::size_t targetIndex, const Real aFinalTime )
+    {
+        finalTimes[ targetIndex ] = aFinalTime;
+    }
+
+    //! Get final time of target.
+    /*!
+     * @param   targetIndex Index of target
+     * @return              Final time at which target should be reached
+     */
+    Real getFinalTime( const std::size_t targetIndex ) const { return finalTimes[ targetIndex ]; }
+
+    //! Get number of targets.
+    /*!
+     * @return Number of targets
+     */
+    std::size_t getNumberOfTargets( ) const { return targets.size( ); }
+
+    //! Get number of vehicles.
+    /*!
+     * @return Number of vehicles
+     */
+    std::size_t getNumberOfVehicles( ) const { return targetIndices.size( ); }
+
+    //! Get array of TTGs of all vehicles computed at last call to computeControl( ).
+    /*!
+     * @return Array of TTGs
+     */
+    const Real* getTimesToGo( ) const { return timesToGo.data( ); }
+
+    //! Get array of ZEM components of all vehicles computed at last call to computeControl( ).
+    /*!
+     * @param   component Index of vector component
+     * @return            Array of ZEM components
+     */
+    const Real* getZeroEffortMisses( const unsigned int component ) const
+    {
+        return zeroEffortMisses[ component ].data( );
+    }
+
+    //! Get array of ZEV components of all vehicles computed at last call to computeControl( ).
+    /*!
+     * @param   component Index of vector component
+     * @return            Array of ZEV components
+     */
+    const Real* getZeroEffortVelocities( const unsigned int component ) const
+    {
+        return zeroEffortVelocities[ component ].data( );
+    }
+
+private:
+
+    //! Target ephemerides.
+    std::vector< TargetEphemeris > targets;
+
+    //! Final time at which each target should be reached.
+    std::vector< Real > finalTimes;
+
+    //! Index of target assigned to each vehicle.
+    std::vector< std::size_t > targetIndices;
+
+    //! Offset components of each vehicle from the state of its target.
+    std::vector< Real > targetOffsets[ 3 ];
+
+    //! Constant gravitational acceleration.
+    Vector3 gravitationalAcceleration;
+
+    //! Control gain for ZEM term.
+    Real zeroEffortMissGain;
+
+    //! Control gain for ZEV term.
+    Real zeroEffortVelocityGain;
+
+    //! Scratch vector for target position computed by ephemeris.
+    Vector3 targetPosition;
+
+    //! Scratch vector for target velocity computed by ephemeris.
+    Vector3 targetVelocity;
+
+    //! Position components of each target at its final time.
+    std::vector< Real > targetFinalPositions[ 3 ];
+
+    //! Velocity components of each target at its final time.
+    std::vector< Real > targetFinalVelocities[ 3 ];
+
+    //! TTG of each target.
+    std::vector< Real > targetTimesToGo;
+
+    //! TTG of each vehicle.
+    std::vector< Real > timesToGo;
+
+    //! ZEM components of each vehicle.
+    std::vector< Real > zeroEffortMisses[ 3 ];
+
+    //! ZEV components of each vehicle.
+    std::vector< Real > zeroEffortVelocities[ 3 ];
+};
+
+} // namespace control
+
+#endif // CONTROL_FORMATION_GUIDANCE_HPP
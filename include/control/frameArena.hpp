@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_FRAME_ARENA_HPP
+#define CONTROL_FRAME_ARENA_HPP
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#if defined( _MSC_VER )
+#define CONTROL_NOINLINE __declspec( noinline )
+#else
+#define CONTROL_NOINLINE __attribute__( ( noinline ) )
+#endif
+
+namespace control
+{
+
+//! Frame arena for per-step temporaries.
+/*!
+ * Monotonic (bump-pointer) arena that hands out memory from a single buffer, which is allocated
+ * on construction. The arena is meant to be reset once per simulation step (frame), such that all
+ * temporaries created during a step are released together and the memory used per step is
+ * deterministic. Allocating is a pointer increment, and releasing memory is a no-op, except for
+ * the most recent allocation, which is rolled back such that temporaries that are released in
+ * reverse order of allocation reuse the same memory within a step.
+ *
+ * The arena does not fall back on the global allocator itself: allocate( ) returns a null pointer
+ * once the buffer is exhausted, and ArenaAllocator counts such overflows (see
+ * getNumberOfOverflowAllocations( )), such that the capacity can be sized from the high-water
+ * mark. The arena is not thread-safe; each thread must use its own arena.
+ *
+ * @sa ArenaAllocator
+ */
+class FrameArena
+{
+public:
+
+    //! Construct frame arena.
+    /*!
+     * @param   aCapacity Capacity of the arena [bytes]
+     */
+    explicit FrameArena( const std::size_t aCapacity )
+        : buffer( aCapacity ),
+          size( 0 ),
+          highWaterMark( 0 ),
+          lastAllocation( 0 ),
+          numberOfOverflowAllocations( 0 )
+    { }
+
+    //! Allocate memory from the arena.
+    /*!
+     * @param   numberOfBytes Number of bytes to allocate
+     * @param   alignment     Alignment of allocated memory, which must be a power of two
+     * @return                Pointer to allocated memory, or null pointer if the arena is exhausted
+     */
+    void* allocate( const std::size_t numberOfBytes, const std::size_t alignment )
+    {
+        const std::size_t address = reinterpret_cast< std::size_t >( buffer.data( ) ) + size;
+        const std::size_t padding = ( alignment - address % alignment ) % alignment;
+        if ( numberOfBytes + padding > buffer.size( ) - size )
+        {
+            return 0;
+        }
+
+        lastAllocation = size + padding;
+        size = lastAllocation + numberOfBytes;
+        highWaterMark = size > highWaterMark ? size : highWaterMark;
+        return buffer.data( ) + lastAllocation;
+    }
+
+    //! Release memory to the arena.
+    /*!
+     * Releases memory, which only rolls back the arena if the memory is the most recent allocation.
+     *
+     * @param   pointer       Pointer to memory allocated from the arena
+     * @param   numberOfBytes Number of bytes allocated
+     */
+    void deallocate( void* pointer, const std::size_t numberOfBytes )
+    {
+        if ( static_cast< unsigned char* >( pointer ) == buffer.data( ) + lastAllocation
+             && lastAllocation + numberOfBytes == size )
+        {
+            size = lastAllocation;
+        }
+    }
+
+    //! Check if memory was allocated from the arena.
+    /*!
+     * @param   pointer Pointer to memory
+     * @return          True if the memory lies within the buffer of the arena
+     */
+    bool owns( const void* pointer ) const
+    {
+        const unsigned char* bytePointer = static_cast< const unsigned char* >( pointer );
+        return bytePointer >= buffer.data( ) && bytePointer < buffer.data( ) + buffer.size( );
+    }
+
+    //! Reset arena, releasing all memory allocated since the last reset.
+    void reset( )
+    {
+        size = 0;
+        lastAllocation = 0;
+    }
+
+    //! Get capacity.
+    /*!
+     * @return Capacity of the arena [bytes]
+     */
+    std::size_t getCapacity( ) const { return buffer.size( ); }
+
+    //! Get size of memory in use, including alignment padding.
+    /*!
+     * @return Memory in use since the last reset [bytes]
+     */
+    std::size_t getSize( ) const { return size; }
+
+    //! Get high-water mark, i.e., the maximum size of memory in use since construction.
+    /*!
+     * @return High-water mark [bytes]
+     */
+    std::size_t getHighWaterMark( ) const { return highWaterMark; }
+
+    //! Get number of allocations that did not fit in the arena.
+    /*!
+     * @return Number of allocations served by the global allocator instead of the arena
+     */
+    std::size_t getNumberOfOverflowAllocations( ) const { return numberOfOverflowAllocations; }
+
+    //! Record allocation that did not fit in the arena.
+    void recordOverflowAllocation( ) { ++numberOfOverflowAllocations; }
+
+private:
+
+    //! Copy constructor, which is private to prevent arenas from being copied.
+    FrameArena( const FrameArena& );
+
+    //! Assignment operator, which is private to prevent arenas from being copied.
+    FrameArena& operator=( const FrameArena& );
+
+    //! Buffer from which memory is allocated.
+    std::vector< unsigned char > buffer;
+
+    //! Size of memory in use [bytes].
+    std::size_t size;
+
+    //! Maximum size of memory in use [bytes].
+    std::size_t highWaterMark;
+
+    //! Offset of most recent allocation [bytes].
+    std::size_t lastAllocation;
+
+    //! Number of allocations that did not fit in the arena.
+    std::size_t numberOfOverflowAllocations;
+};
+
+namespace detail
+{
+
+//! Allocate memory that does not fit in a frame arena from the global allocator.
+/*!
+ * The overflow path is not inlined, such that the compiler does not mistake the release of
+ * overflow memory for the release of arena memory (-Wfree-nonheap-object).
+ */
+CONTROL_NOINLINE inline void* allocateArenaOverflow( const std::size_t numberOfBytes )
+{
+    return ::operator new( numberOfBytes );
+}
+
+//! Release memory allocated by allocateArenaOverflow( ).
+CONTROL_NOINLINE inline void deallocateArenaOverflow( void* pointer )
+{
+    ::operator delete( pointer );
+}
+
+} // namespace detail
+
+//! Standard-library allocator that allocates from a frame arena.
+/*!
+ * Allocator that can be used with allocator-aware containers to allocate their storage from a
+ * FrameArena, e.g., to use std::vector< Real, ArenaAllocator< Real > > (see ArenaVector) as
+ * 3-vector type in the guidance templates. The guidance templates only create generic 3-vectors by
+ * copying existing vectors, and copies of allocator-aware containers keep the allocator of the
+ * original, such that all temporaries created from arena vectors are allocated from the same
+ * arena. If the arena is exhausted, memory is allocated by the global allocator instead, and the
+ * overflow is recorded in the arena.
+ *
+ * Arena vectors must not outlive the arena, and must not be used from multiple threads, e.g., in
+ * dispersions passed to a multi-threaded MonteCarloCampaign.
+ *
+ * @tparam  T Element type
+ */
+template< typename T >
+class ArenaAllocator
+{
+public:
+
+    //! Element type.
+    typedef T value_type;
+
+    //! Construct allocator.
+    /*!
+     * @param   anArena Arena to allocate from
+     */
+    explicit ArenaAllocator( FrameArena& anArena )
+        : arena( &anArena )
+    { }
+
+    //! Construct allocator from allocator with different element type.
+    /*!
+     * @param   allocator Allocator to copy arena from
+     */
+    template< typename U >
+    ArenaAllocator( const ArenaAllocator< U >& allocator )
+        : arena( allocator.getArena( ) )
+    { }
+
+    //! Allocate memory for given number of elements.
+    /*!
+     * @param   numberOfElements Number of elements
+     * @return                   Pointer to allocated memory
+     */
+    T* allocate( const std::size_t numberOfElements )
+    {
+        void* pointer = arena->allocate( numberOfElements * sizeof( T ), alignof( T ) );
+        if ( pointer == 0 )
+        {
+            arena->recordOverflowAllocation( );
+            pointer = detail::allocateArenaOverflow( numberOfElements * sizeof( T ) );
+        }
+        return static_cast< T* >( pointer );
+    }
+
+    //! Release memory for given number of elements.
+    /*!
+     * @param   pointer          Pointer to allocated memory
+     * @param   numberOfElements Number of elements
+     */
+    void deallocate( T* pointer, const std::size_t numberOfElements )
+    {
+        if ( arena->owns( pointer ) )
+        {
+            arena->deallocate( pointer, numberOfElements * sizeof( T ) );
+        }
+        else
+        {
+            detail::deallocateArenaOverflow( pointer );
+        }
+    }
+
+    //! Get arena.
+    /*!
+     * @return Pointer to arena allocated from
+     */
+    FrameArena* getArena( ) const { return arena; }
+
+private:
+
+    //! Arena to allocate from.
+    FrameArena* arena;
+};
+
+//! Check if two arena allocators allocate from the same arena.
+template< typename T, typename U >
+bool operator==( const ArenaAllocator< T >& allocator, const ArenaAllocator< U >& otherAllocator )
+{
+    return allocator.getArena( ) == otherAllocator.getArena( );
+}
+
+//! Check if two arena allocators allocate from different arenas.
+template< typename T, typename U >
+bool operator!=( const ArenaAllocator< T >& allocator, const ArenaAllocator< U >& otherAllocator )
+{
+    return !( allocator == otherAllocator );
+}
+
+//! Dynamic vector type that allocates from a frame arena.
+template< typename Real >
+using ArenaVector = std::vector< Real, ArenaAllocator< Real > >;
+
+//! Create 3-vector that allocates from a frame arena.
+/*!
+ * @tparam  Real  Real type
+ * @param   arena Arena to allocate from
+ * @param   x     First element
+ * @param   y     Second element
+ * @param   z     Third element
+ * @return        3-Vector
+ */
+template< typename Real >
+ArenaVector< Real > createArenaVector3( FrameArena& arena,
+                                        const Real x,
+                                        const Real y,
+                                        const Real z )
+{
+    ArenaVector< Real > vector( 3, Real( 0.0 ), ArenaAllocator< Real >( arena ) );
+    vector[ 0 ] = x;
+    vector[ 1 ] = y;
+    vector[ 2 ] = z;
+    return vector;
+}
+
+} // namespace control
+
+#endif // CONTROL_FRAME_ARENA_HPP
@@ -0,0 +1,412 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_GAIN_TUNER_HPP
+#define CONTROL_GAIN_TUNER_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "control/parallel.hpp"
+
+namespace control
+{
+
+//! Scenario for tuning of OGL gains.
+/*!
+ * Scenario for tuning of OGL gains, i.e., a fixed-interval maneuver under constant gravity, from
+ * the given initial state to the given target state, with the control authority held constant
+ * over each guidance step.
+ *
+ * @tparam  Real    Real type
+ * @tparam  Vector3 3-Vector type
+ */
+template< typename Real, typename Vector3 >
+struct GainTuningScenario
+{
+    //! Initial position.
+    Vector3 initialPosition;
+
+    //! Initial velocity.
+    Vector3 initialVelocity;
+
+    //! Target position.
+    Vector3 targetPosition;
+
+    //! Target velocity.
+    Vector3 targetVelocity;
+
+    //! Constant gravitational acceleration.
+    Vector3 gravitationalAcceleration;
+
+    //! Final time at which target state should be reached, with initial time equal to zero.
+    Real finalTime;
+
+    //! Number of guidance steps.
+    std::size_t numberOfSteps;
+};
+
+//! Result of evaluation of candidate OGL gains.
+template< typename Real >
+struct GainTuningResult
+{
+    //! Control gain for ZEM term.
+    Real zeroEffortMissGain;
+
+    //! Control gain for ZEV term.
+    Real zeroEffortVelocityGain;
+
+    //! Total Delta-V over all scenarios.
+    Real deltaV;
+
+    //! Total terminal error over all scenarios: position miss plus weighted velocity miss.
+    Real terminalError;
+};
+
+//! Tuner for OGL gains.
+/*!
+ * Tuner that evaluates candidate pairs of OGL gains \f$(k_{r}, k_{v})\f$ over a set of scenarios,
+ * in terms of the total Delta-V and the total terminal error, and returns the Pareto front of
+ * non-dominated candidates.
+ *
+ * For constant gravity and control authority held constant over a guidance step of size
+ * \f$\Delta t\f$, the ZEM and ZEV vectors evolve exactly as
+ *
+ * \f[
+ *      \vec{\text{ZEM}}_{k+1} = \vec{\text{ZEM}}_{k}
+ *          - \left( t_{\text{go},k} \Delta t - \frac{1}{2} \Delta t^{2} \right) \vec{u}_{k},
+ *      \quad
+ *      \vec{\text{ZEV}}_{k+1} = \vec{\text{ZEV}}_{k} - \Delta t \vec{u}_{k}
+ * \f]
+ *
+ * Since the OGL is linear in the ZEM and ZEV vectors, the ZEM and ZEV vectors along a closed-loop
+ * trajectory remain linear combinations of the ZEM and ZEV vectors of the ballistic trajectory
+ * from the initial state, \f$\vec{\text{ZEM}}_{0}\f$ and \f$\vec{\text{ZEV}}_{0}\f$, with the same
+ * coefficients for all components. The ballistic trajectory, the TTG grid and the Gram matrix of
+ * \f$\vec{\text{ZEM}}_{0}\f$ and \f$\vec{\text{ZEV}}_{0}\f$ are therefore precomputed once per
+ * scenario and shared by all candidates; evaluating a candidate only propagates four scalar
+ * coefficients per guidance step, which yields the same result as simulating the closed-loop
+ * trajectory (up to rounding).
+ *
+ * Candidates are evaluated in parallel in two phases. In the first phase, a regularly spaced
+ * subset of the candidates is evaluated over all scenarios. In the second phase, the remaining
+ * candidates are evaluated scenario by scenario, and terminated early as soon as their partial
+ * objectives, which can only increase with further scenarios, are dominated by a candidate of the
+ * first phase. No candidate on the Pareto front is ever terminated, so the Pareto front does not
+ * depend on the number of threads.
+ *
+ * @tparam  Real    Real type
+ * @tparam  Vector3 3-Vector type
+ */
+template< typename Real, typename Vector3 >
+class GainTuner
+{
+public:
+
+    //! Construct tuner.
+    /*!
+     * Constructs tuner for given set of scenarios, precomputing the data shared by all candidates.
+     *
+     * @param   aScenarios           Scenarios over which candidates are evaluated
+     * @param   aVelocityErrorWeight Weight of velocity miss in terminal error (default=1.0)
+     */
+    explicit GainTuner( const std::vector< GainTuningScenario< Real, Vector3 > >& aScenarios,
+                        const Real aVelocityErrorWeight = Real( 1.0 ) )
+        : velocityErrorWeight( aVelocityErrorWeight ),
+          scenarios( aScenarios.size( ) ),
+          numberOfPrunedCandidates( 0 )
+    {
+        for ( std::size_t i = 0; i < aScenarios.size( ); ++i )
+        {
+            const GainTuningScenario< Real, Vector3 >& scenario = aScenarios[ i ];
+            const Real finalTime = scenario.finalTime;
+            const Real stepSize = finalTime / static_cast< Real >( scenario.numberOfSteps );
+
+            Real zeroEffortMiss[ 3 ];
+            Real zeroEffortVelocity[ 3 ];
+            for ( unsigned int j = 0; j < 3; ++j )
+            {
+                zeroEffortMiss[ j ] = scenario.targetPosition[ j ] - scenario.initialPosition[ j ]
+                                      - finalTime * scenario.initialVelocity[ j ]
+                                      - Real( 0.5 ) * finalTime * finalTime
+                                        * scenario.gravitationalAcceleration[ j ];
+                zeroEffortVelocity[ j ] = scenario.targetVelocity[ j ]
+                                          - scenario.initialVelocity[ j ]
+                                          - finalTime * scenario.gravitationalAcceleration[ j ];
+            }
+
+            ScenarioData& data = scenarios[ i ];
+            data.stepSize = stepSize;
+            data.zeroEffortMissSquared = Real( 0.0 );
+            data.zeroEffortMissDotZeroEffortVelocity = Real( 0.0 );
+            data.zeroEffortVelocitySquared = Real( 0.0 );
+            for ( unsigned int j = 0; j < 3; ++j )
+            {
+                data.zeroEffortMissSquared += zeroEffortMiss[ j ] * zeroEffortMiss[ j ];
+                data.zeroEffortMissDotZeroEffortVelocity
+                    += zeroEffortMiss[ j ] * zeroEffortVelocity[ j ];
+                data.zeroEffortVelocitySquared += zeroEffortVelocity[ j ] * zeroEffortVelocity[ j ];
+            }
+
+            data.inverseTimeToGoSquared.resize( scenario.numberOfSteps );
+            data.inverseTimeToGo.resize( scenario.numberOfSteps );
+            data.zeroEffortMissDecrement.resize( scenario.numberOfSteps );
+            for ( std::size_t k = 0; k < scenario.numberOfSteps; ++k )
+            {
+                const Real timeToGo = finalTime - static_cast< Real >( k ) * stepSize;
+                data.inverseTimeToGo[ k ] = Real( 1.0 ) / timeToGo;
+                data.inverseTimeToGoSquared[ k ]
+                    = data.inverseTimeToGo[ k ] * data.inverseTimeToGo[ k ];
+                data.zeroEffortMissDecrement[ k ]
+                    = timeToGo * stepSize - Real( 0.5 ) * stepSize * stepSize;
+            }
+        }
+    }
+
+    //! Evaluate candidate gains over all scenarios.
+    /*!
+     * @param   zeroEffortMissGain     Control gain for ZEM term
+     * @param   zeroEffortVelocityGain Control gain for ZEV term
+     * @return                         Result of evaluation
+     */
+    GainTuningResult< Real > evaluate( const Real zeroEffortMissGain,
+                                       const Real zeroEffortVelocityGain ) const
+    {
+        GainTuningResult< Real > result = createResult( zeroEffortMissGain,
+                                                        zeroEffortVelocityGain );
+        for ( std::size_t i = 0; i < scenarios.size( ); ++i )
+        {
+            evaluateScenario( scenarios[ i ], result );
+        }
+        return result;
+    }
+
+    //! Compute Pareto front of Delta-V versus terminal error.
+    /*!
+     * Evaluates the given candidate gains in parallel and returns the Pareto front, i.e., all
+     * candidates that are not dominated by another candidate, in order of increasing Delta-V.
+     *
+     * @param   zeroEffortMissGains     Control gains for ZEM term of candidates
+     * @param   zeroEffortVelocityGains Control gains for ZEV term of candidates, of same length
+     * @param   numberOfThreads         Number of threads; if zero, the number of hardware threads
+     *                                  is used (default=0)
+     * @return                          Pareto front
+     */
+    std::vector< GainTuningResult< Real > > computeParetoFront(
+        const std::vector< Real >& zeroEffortMissGains,
+        const std::vector< Real >& zeroEffortVelocityGains,
+        const unsigned int numberOfThreads = 0 )
+    {
+        const std::size_t numberOfCandidates = zeroEffortMissGains.size( );
+        std::size_t stride = static_cast< std::size_t >(
+            std::sqrt( static_cast< double >( numberOfCandidates ) ) );
+        stride = stride > 0 ? stride : 1;
+
+        std::vector< std::size_t > seedCandidates;
+        std::vector< std::size_t > otherCandidates;
+        for ( std::size_t i = 0; i < numberOfCandidates; ++i )
+        {
+            ( i % stride == 0 ? seedCandidates : otherCandidates ).push_back( i );
+        }
+
+        std::vector< GainTuningResult< Real > > results( numberOfCandidates );
+        std::vector< char > isComplete( numberOfCandidates, 0 );
+
+        // Phase 1: evaluate seed candidates over all scenarios.
+        parallelForChunks(
+            seedCandidates.size( ),
+            numberOfThreads,
+            [ this, &seedCandidates, &results, &isComplete,
+              &zeroEffortMissGains, &zeroEffortVelocityGains ]( std::size_t chunk )
+            {
+                const std::size_t candidate = seedCandidates[ chunk ];
+                results[ candidate ] = evaluate( zeroEffortMissGains[ candidate ],
+                                                 zeroEffortVelocityGains[ candidate ] );
+                isComplete[ candidate ] = 1;
+            } );
+
+        std::vector< GainTuningResult< Real > > seedResults;
+        for ( std::size_t i = 0; i < seedCandidates.size( ); ++i )
+        {
+            seedResults.push_back( results[ seedCandidates[ i ] ] );
+        }
+
+        // Phase 2: evaluate other candidates, terminating them once dominated by a seed candidate.
+        parallelForChunks(
+            otherCandidates.size( ),
+            numberOfThreads,
+            [ this, &otherCandidates, &seedResults, &results, &isComplete,
+              &zeroEffortMissGains, &zeroEffortVelocityGains ]( std::size_t chunk )
+            {
+                const std::size_t candidate = otherCandidates[ chunk ];
+                GainTuningResult< Real > result = createResult(
+                    zeroEffortMissGains[ candidate ], zeroEffortVelocityGains[ candidate ] );
+                for ( std::size_t i = 0; i < scenarios.size( ); ++i )
+                {
+                    evaluateScenario( scenarios[ i ], result );
+                    if ( isDominated( result, seedResults ) )
+                    {
+                        return;
+                    }
+                }
+                results[ candidate ] = result;
+                isComplete[ candidate ] = 1;
+            } );
+
+        std::vector< GainTuningResult< Real > > completeResults;
+        for ( std::size_t i = 0; i < numberOfCandidates; ++i )
+        {
+            if ( isComplete[ i ] )
+            {
+                completeResults.push_back( results[ i ] );
+            }
+        }
+        numberOfPrunedCandidates = numberOfCandidates - completeResults.size( );
+
+        // Sweep candidates in order of increasing Delta-V and keep those that improve the terminal
+        // error.
+        std::stable_sort( completeResults.begin( ),
+                          completeResults.end( ),
+                          []( const GainTuningResult< Real >& first,
+                              const GainTuningResult< Real >& second )
+                          {
+                              return first.deltaV < second.deltaV
+                                     || ( first.deltaV == second.deltaV
+                                          && first.terminalError < second.terminalError );
+                          } );
+
+        std::vector< GainTuningResult< Real > > paretoFront;
+        for ( std::size_t i = 0; i < completeResults.size( ); ++i )
+        {
+            if ( paretoFront.empty( )
+                 || completeResults[ i ].terminalError < paretoFront.back( ).terminalError )
+            {
+                paretoFront.push_back( completeResults[ i ] );
+            }
+        }
+        return paretoFront;
+    }
+
+    //! Get number of candidates terminated early at last call to computeParetoFront( ).
+    /*!
+     * @return Number of candidates terminated early
+     */
+    std::size_t getNumberOfPrunedCandidates( ) const { return numberOfPrunedCandidates; }
+
+private:
+
+    //! Data of scenario, shared by all candidates.
+    struct ScenarioData
+    {
+        //! Step size.
+        Real stepSize;
+
+        //! Squared norm of ballistic ZEM vector.
+        Real zeroEffortMissSquared;
+
+        //! Dot product of ballistic ZEM and ZEV vectors.
+        Real zeroEffortMissDotZeroEffortVelocity;
+
+        //! Squared norm of ballistic ZEV vector.
+        Real zeroEffortVelocitySquared;
+
+        //! Inverse of squared TTG at each step.
+        std::vector< Real > inverseTimeToGoSquared;
+
+        //! Inverse of TTG at each step.
+        std::vector< Real > inverseTimeToGo;
+
+        //! Decrement factor of ZEM vector at each step.
+        std::vector< Real > zeroEffortMissDecrement;
+    };
+
+    //! Create empty result for given candidate gains.
+    static GainTuningResult< Real > createResult( const Real zeroEffortMissGain,
+                                                  const Real zeroEffortVelocityGain )
+    {
+        GainTuningResult< Real > result;
+        result.zeroEffortMissGain = zeroEffortMissGain;
+        result.zeroEffortVelocityGain = zeroEffortVelocityGain;
+        result.deltaV = Real( 0.0 );
+        result.terminalError = Real( 0.0 );
+        return result;
+    }
+
+    //! Compute norm of linear combination of ballistic ZEM and ZEV vectors.
+    static Real computeNorm( const ScenarioData& data, const Real first, const Real second )
+    {
+        const Real normSquared = first * first * data.zeroEffortMissSquared
+                                 + Real( 2.0 ) * first * second
+                                   * data.zeroEffortMissDotZeroEffortVelocity
+                                 + second * second * data.zeroEffortVelocitySquared;
+        return std::sqrt( normSquared > Real( 0.0 ) ? normSquared : Real( 0.0 ) );
+    }
+
+    //! Evaluate candidate for scenario, adding its objectives to the given result.
+    void evaluateScenario( const ScenarioData& data, GainTuningResult< Real >& result ) const
+    {
+        // ZEM = p ZEM_0 + q ZEV_0 and ZEV = s ZEM_0 + w ZEV_0.
+        Real p = Real( 1.0 );
+        Real q = Real( 0.0 );
+        Real s = Real( 0.0 );
+        Real w = Real( 1.0 );
+        Real deltaV = Real( 0.0 );
+
+        for ( std::size_t k = 0; k < data.inverseTimeToGo.size( ); ++k )
+        {
+            const Real zeroEffortMissPremultiplier
+                = result.zeroEffortMissGain * data.inverseTimeToGoSquared[ k ];
+            const Real zeroEffortVelocityPremultiplier
+                = result.zeroEffortVelocityGain * data.inverseTimeToGo[ k ];
+
+            // Control authority u = x ZEM_0 + y ZEV_0.
+            const Real x = zeroEffortMissPremultiplier * p + zeroEffortVelocityPremultiplier * s;
+            const Real y = zeroEffortMissPremultiplier * q + zeroEffortVelocityPremultiplier * w;
+            deltaV += data.stepSize * computeNorm( data, x, y );
+
+            p -= data.zeroEffortMissDecrement[ k ] * x;
+            q -= data.zeroEffortMissDecrement[ k ] * y;
+            s -= data.stepSize * x;
+            w -= data.stepSize * y;
+        }
+
+        result.deltaV += deltaV;
+        result.terminalError += computeNorm( data, p, q )
+                                + velocityErrorWeight * computeNorm( data, s, w );
+    }
+
+    //! Check if result is dominated by any of the given results.
+    static bool isDominated( const GainTuningResult< Real >& result,
+                             const std::vector< GainTuningResult< Real > >& otherResults )
+    {
+        for ( std::size_t i = 0; i < otherResults.size( ); ++i )
+        {
+            const GainTuningResult< Real >& other = otherResults[ i ];
+            if ( other.deltaV <= result.deltaV && other.terminalError <= result.terminalError
+                 && ( other.deltaV < result.deltaV
+                      || other.terminalError < result.terminalError ) )
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    //! Weight of velocity miss in terminal error.
+    Real velocityErrorWeight;
+
+    //! Data of scenarios, shared by all candidates.
+    std::vector< ScenarioData > scenarios;
+
+    //! Number of candidates terminated early at last call to computeParetoFront( ).
+    std::size_t numberOfPrunedCandidates;
+};
+
+} // namespace control
+
+#endif // CONTROL_GAIN_TUNER_HPP
@@ -0,0 +1,397 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_GENERALIZED_OPTIMAL_GUIDANCE_CONTROLLER_HPP
+#define CONTROL_GENERALIZED_OPTIMAL_GUIDANCE_CONTROLLER_HPP
+
+#include "control/gravityModels.hpp"
+#include "control/instrumentation.hpp"
+#include "control/optimalGuidanceLaw.hpp"
+
+namespace control
+{
+
+//! Closed-loop generalized ZEM/ZEV guidance controller for non-uniform gravity fields.
+/*!
+ * Closed-loop controller that computes the control authority based on the OGL, with the
+ * Zero-Effort-Miss (ZEM) and Zero-Effort-Velocity (ZEV) vectors predicted under a non-uniform
+ * gravity field (Furfaro et al., 2011; Guo et al., 2013). The gravity field is supplied as a policy
+ * (see gravityModels.hpp).
+ *
+ * The predicted arrival state, i.e., the final state reached along the ballistic (uncontrolled)
+ * trajectory, is computed by numerical integration using a fixed-step Runge-Kutta 4 scheme. To
+ * keep the cost per call low, the prediction is cached together with the reference ballistic
+ * state from which it was computed. At each subsequent call, only the reference ballistic state is
+ * propagated over the time elapsed since the last call, and the deviation of the current state
+ * from the reference state is mapped to the arrival state using the first-order ballistic
+ * state-transition matrix, neglecting the gravity gradient:
+ *
+ * \f[
+ *      \tilde{\vec{r}}_{f} \approx \tilde{\vec{r}}_{f,\text{ref}} + \delta\vec{r}
+ *                              + t_{\text{go}} \delta\vec{v},
+ *      \quad
+ *      \tilde{\vec{v}}_{f} \approx \tilde{\vec{v}}_{f,\text{ref}} + \delta\vec{v}
+ * \f]
+ *
+ * The arrival state is re-predicted from the current state once the position or velocity deviation
+ * exceeds the given tolerances. For a uniform gravity field, the mapping is exact, and the
+ * controller reproduces the OptimalGuidanceController.
+ *
+ * All intermediate vectors are stored as members, such that no memory is allocated when computing
+ * the control authority.
+ *
+ * @sa computeOptimalGuidanceLaw( ), OptimalGuidanceController
+ * @tparam  Real         Real type
+ * @tparam  Vector3      3-Vector type
+ * @tparam  GravityModel Gravity model policy
+ */
+template< typename Real, typename Vector3, typename GravityModel >
+class GeneralizedOptimalGuidanceController
+{
+public:
+
+    //! Construct controller.
+    /*!
+     * Constructs controller for given target state, gravity model and final time.
+     *
+     * @param   aTargetPosition              Target position
+     * @param   aTargetVelocity              Target velocity
+     * @param   aGravityModel                Gravity model
+     * @param   aFinalTime                   Final time at which target state should be reached
+     * @param   aNumberOfIntegrationSteps    Number of integration steps used to predict arrival
+     *                                       state from current state up to final time
+     * @param   aPositionDeviationTolerance  Tolerance on position deviation from reference
+     *                                       ballistic state, above which arrival state is
+     *                                       re-predicted
+     * @param   aVelocityDeviationTolerance  Tolerance on velocity deviation from reference
+     *                                       ballistic state, above which arrival state is
+     *                                       re-predicted
+     * @param   aZeroEffortMissGain          Control gain for ZEM term (default=6.0)
+     * @param   aZeroEffortVelocityGain      Control gain for ZEV term (default=-2.0)
+     */
+    GeneralizedOptimalGuidanceController( const Vector3& aTargetPosition,
+                                          const Vector3& aTargetVelocity,
+                                          const GravityModel& aGravityModel,
+                                          const Real aFinalTime,
+                                          const unsigned int aNumberOfIntegrationSteps,
+                                          const Real aPositionDeviationTolerance,
+                                          const Real aVelocityDeviationTolerance,
+                                          const Real aZeroEffortMissGain = Real( 6.0 ),
+                                          const Real aZeroEffortVelocityGain = Real( -2.0 ) )
+        : targetPosition( aTargetPosition ),
+          targetVelocity( aTargetVelocity ),
+          gravityModel( aGravityModel ),
+          finalTime( aFinalTime ),
+          numberOfIntegrationSteps( aNumberOfIntegrationSteps ),
+          positionDeviationToleranceSquared( aPositionDeviationTolerance
+                                             * aPositionDeviationTolerance ),
+          velocityDeviationToleranceSquared( aVelocityDeviationTolerance
+                                             * aVelocityDeviationTolerance ),
+          zeroEffortMissGain( aZeroEffortMissGain ),
+          zeroEffortVelocityGain( aZeroEffortVelocityGain ),
+          isPredictionCached( false ),
+          numberOfPredictions( 0 ),
+          referenceTime( Real( 0.0 ) ),
+          referencePosition( aTargetPosition ),
+          referenceVelocity( aTargetVelocity ),
+          predictedPosition( aTargetPosition ),
+          predictedVelocity( aTargetVelocity ),
+          timeToGo( aFinalTime ),
+          zeroEffortMiss( aTargetPosition ),
+          zeroEffortVelocity( aTargetVelocity ),
+          controlEffort( aTargetPosition ),
+          stagePosition( aTargetPosition ),
+          stageVelocity( aTargetVelocity ),
+          stageAcceleration( aTargetPosition ),
+          positionIncrement( aTargetPosition ),
+          velocityIncrement( aTargetVelocity )
+    { }
+
+    //! Compute control authority.
+    /*!
+     * Computes the control authority for the given current time and state, by updating the ZEM
+     * and ZEV vectors and evaluating the OGL. The current time must be strictly less than the
+     * final time, and must not decrease between successive calls.
+     *
+     * @param   currentTime Current time
+     * @param   position    Current position
+     * @param   velocity    Current velocity
+     * @return              Computed control authority
+     */
+    const Vector3& computeControl( const Real currentTime,
+                                   const Vector3& position,
+                                   const Vector3& velocity )
+    {
+        CONTROL_INSTRUMENT_SCOPE( generalizedOptimalGuidanceControllerProbe );
+
+        timeToGo = finalTime - currentTime;
+
+        bool isRepredictionNeeded = !isPredictionCached;
+        if ( isPredictionCached )
+        {
+            // Only propagate reference ballistic state over time elapsed since last call.
+            propagateBallisticState( referencePosition,
+                                     referenceVelocity,
+                                     currentTime - referenceTime,
+                                     1 );
+            referenceTime = currentTime;
+
+            Real positionDeviationSquared = Real( 0.0 );
+            Real velocityDeviationSquared = Real( 0.0 );
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                const Real positionDeviation = position[ i ] - referencePosition[ i ];
+                const Real velocityDeviation = velocity[ i ] - referenceVelocity[ i ];
+                positionDeviationSquared += positionDeviation * positionDeviation;
+                velocityDeviationSquared += velocityDeviation * velocityDeviation;
+            }
+
+            isRepredictionNeeded = positionDeviationSquared > positionDeviationToleranceSquared
+                                   || velocityDeviationSquared > velocityDeviationToleranceSquared;
+        }
+
+        if ( isRepredictionNeeded )
+        {
+            predictArrivalState( currentTime, position, velocity );
+        }
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            const Real positionDeviation = position[ i ] - referencePosition[ i ];
+            const Real velocityDeviation = velocity[ i ] - referenceVelocity[ i ];
+            zeroEffortMiss[ i ] = targetPosition[ i ] - predictedPosition[ i ]
+                                  - positionDeviation - timeToGo * velocityDeviation;
+            zeroEffortVelocity[ i ] = targetVelocity[ i ] - predictedVelocity[ i ]
+                                      - velocityDeviation;
+        }
+
+        computeOptimalGuidanceLaw( zeroEffortMiss,
+                                   zeroEffortVelocity,
+                                   timeToGo,
+                                   controlEffort,
+                                   zeroEffortMissGain,
+                                   zeroEffortVelocityGain );
+        return controlEffort;
+    }
+
+    //! Discard cached arrival state prediction.
+    /*!
+     * Discards cached arrival state prediction, such that the arrival state is re-predicted from
+     * the current state at the next call to computeControl( ), e.g., after a state jump.
+     */
+    void resetPrediction( ) { isPredictionCached = false; }
+
+    //! Get number of full arrival state predictions performed.
+    /*!
+     * @return Number of full arrival state predictions performed
+     */
+    unsigned int getNumberOfPredictions( ) const { return numberOfPredictions; }
+
+    //! Get TTG computed at last call to computeControl( ).
+    /*!
+     * @return TTG
+     */
+    Real getTimeToGo( ) const { return timeToGo; }
+
+    //! Get ZEM vector computed at last call to computeControl( ).
+    /*!
+     * @return ZEM vector
+     */
+    const Vector3& getZeroEffortMiss( ) const { return zeroEffortMiss; }
+
+    //! Get ZEV vector computed at last call to computeControl( ).
+    /*!
+     * @return ZEV vector
+     */
+    const Vector3& getZeroEffortVelocity( ) const { return zeroEffortVelocity; }
+
+private:
+
+    //! Predict arrival state from current state.
+    /*!
+     * Predicts arrival state by integrating the ballistic trajectory from the current state up to
+     * the final time, and caches the current state as reference ballistic state.
+     *
+     * @param   currentTime Current time
+     * @param   position    Current position
+     * @param   velocity    Current velocity
+     */
+    void predictArrivalState( const Real currentTime,
+                              const Vector3& position,
+                              const Vector3& velocity )
+    {
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            referencePosition[ i ] = position[ i ];
+            referenceVelocity[ i ] = velocity[ i ];
+            predictedPosition[ i ] = position[ i ];
+            predictedVelocity[ i ] = velocity[ i ];
+        }
+        referenceTime = currentTime;
+
+        propagateBallisticState( predictedPosition,
+                                 predictedVelocity,
+                                 finalTime - currentTime,
+                                 numberOfIntegrationSteps );
+
+        isPredictionCached = true;
+        ++numberOfPredictions;
+    }
+
+    //! Propagate ballistic state using fixed-step Runge-Kutta 4 integration.
+    /*!
+     * @param   position      Position, propagated in place
+     * @param   velocity      Velocity, propagated in place
+     * @param   duration      Propagation duration
+     * @param   numberOfSteps Number of integration steps
+     */
+    void propagateBallisticState( Vector3& position,
+                                  Vector3& velocity,
+                                  const Real duration,
+                                  const unsigned int numberOfSteps )
+    {
+        if ( numberOfSteps == 0 || duration == Real( 0.0 ) )
+        {
+            return;
+        }
+
+        const Real stepSize = duration / numberOfSteps;
+        const Real halfStepSize = Real( 0.5 ) * stepSize;
+        const Real sixthStepSize = stepSize / Real( 6.0 );
+
+        for ( unsigned int step = 0; step < numberOfSteps; ++step )
+        {
+            // Stage 1.
+            gravityModel.computeAcceleration( position, stageAcceleration );
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                positionIncrement[ i ] = velocity[ i ];
+                velocityIncrement[ i ] = stageAcceleration[ i ];
+                stagePosition[ i ] = position[ i ] + halfStepSize * velocity[ i ];
+                stageVelocity[ i ] = velocity[ i ] + halfStepSize * stageAcceleration[ i ];
+            }
+
+            // Stage 2.
+            gravityModel.computeAcceleration( stagePosition, stageAcceleration );
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                positionIncrement[ i ] += Real( 2.0 ) * stageVelocity[ i ];
+                velocityIncrement[ i ] += Real( 2.0 ) * stageAcceleration[ i ];
+                stagePosition[ i ] = position[ i ] + halfStepSize * stageVelocity[ i ];
+                stageVelocity[ i ] = velocity[ i ] + halfStepSize * stageAcceleration[ i ];
+            }
+
+            // Stage 3.
+            gravityModel.computeAcceleration( stagePosition, stageAcceleration );
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                positionIncrement[ i ] += Real( 2.0 ) * stageVelocity[ i ];
+                velocityIncrement[ i ] += Real( 2.0 ) * stageAcceleration[ i ];
+                stagePosition[ i ] = position[ i ] + stepSize * stageVelocity[ i ];
+                stageVelocity[ i ] = velocity[ i ] + stepSize * stageAcceleration[ i ];
+            }
+
+            // Stage 4.
+            gravityModel.computeAcceleration( stagePosition, stageAcceleration );
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                positionIncrement[ i ] += stageVelocity[ i ];
+                velocityIncrement[ i ] += stageAcceleration[ i ];
+                position[ i ] += sixthStepSize * positionIncrement[ i ];
+                velocity[ i ] += sixthStepSize * velocityIncrement[ i ];
+            }
+        }
+    }
+
+    //! Target position.
+    Vector3 targetPosition;
+
+    //! Target velocity.
+    Vector3 targetVelocity;
+
+    //! Gravity model.
+    GravityModel gravityModel;
+
+    //! Final time at which target state should be reached.
+    Real finalTime;
+
+    //! Number of integration steps used to predict arrival state.
+    unsigned int numberOfIntegrationSteps;
+
+    //! Squared tolerance on position deviation from reference ballistic state.
+    Real positionDeviationToleranceSquared;
+
+    //! Squared tolerance on velocity deviation from reference ballistic state.
+    Real velocityDeviationToleranceSquared;
+
+    //! Control gain for ZEM term.
+    Real zeroEffortMissGain;
+
+    //! Control gain for ZEV term.
+    Real zeroEffortVelocityGain;
+
+    //! Flag indicating if an arrival state prediction is cached.
+    bool isPredictionCached;
+
+    //! Number of full arrival state predictions performed.
+    unsigned int numberOfPredictions;
+
+    //! Epoch of reference ballistic state.
+    Real referenceTime;
+
+    //! Position of reference ballistic state.
+    Vector3 referencePosition;
+
+    //! Velocity of reference ballistic state.
+    Vector3 referenceVelocity;
+
+    //! Arrival position predicted from reference ballistic state.
+    Vector3 predictedPosition;
+
+    //! Arrival velocity predicted from reference ballistic state.
+    Vector3 predictedVelocity;
+
+    //! TTG computed at last call to computeControl( ).
+    Real timeToGo;
+
+    //! ZEM vector computed at last call to computeControl( ).
+    Vector3 zeroEffortMiss;
+
+    //! ZEV vector computed at last call to computeControl( ).
+    Vector3 zeroEffortVelocity;
+
+    //! Control authority computed at last call to computeControl( ).
+    Vector3 controlEffort;
+
+    //! Integrator workspace: position at intermediate stage.
+    Vector3 stagePosition;
+
+    //! Integrator workspace: velocity at intermediate stage.
+    Vector3 stageVelocity;
+
+    //! Integrator workspace: acceleration at intermediate stage.
+    Vector3 stageAcceleration;
+
+    //! Integrator workspace: weighted sum of position derivatives.
+    Vector3 positionIncrement;
+
+    //! Integrator workspace: weighted sum of velocity derivatives.
+    Vector3 velocityIncrement;
+};
+
+} // namespace control
+
+#endif // CONTROL_GENERALIZED_OPTIMAL_GUIDANCE_CONTROLLER_HPP
+
+/*
+ * References
+ * Furfaro, R., Gaudet, B., Wibben, D.R. Simo, J. (2011) Development of Non-Linear Guidance
+ *  Algorithms for Asteroids Close-Proximity Operations, AIAA Guidance, Navigation, and Control
+ *  (GNC) Conference 2013, Boston, MA, doi: 10.2514/6.2013-4711.
+ * Guo, Y., Hawkins, M., Wie, B. (2013) Applications of Generalized
+ *  Zero-Effort-Miss/Zero-Effort-Velocity Feedback Guidance Algorithm, Journal of Guidance, Control,
+ *  and Dynamics, pg. 810-820, vol. 36, doi: 10.2514/1.58099.
+ */
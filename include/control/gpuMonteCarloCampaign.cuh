@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_GPU_MONTE_CARLO_CAMPAIGN_CUH
+#define CONTROL_GPU_MONTE_CARLO_CAMPAIGN_CUH
+
+#if !defined( __CUDACC__ ) && !defined( __HIPCC__ )
+#error "gpuMonteCarloCampaign.cuh must be compiled with a GPU compiler (nvcc or hipcc)"
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#if defined( __HIPCC__ )
+#include <hip/hip_runtime.h>
+#define CONTROL_GPU( name ) hip##name
+#else
+#include <cuda_runtime.h>
+#define CONTROL_GPU( name ) cuda##name
+#endif
+
+#include "control/closedLoopTrajectory.hpp"
+#include "control/monteCarloCampaign.hpp"
+
+namespace control
+{
+namespace detail
+{
+
+//! Initialize batch of closed-loop trajectories in device memory, one trajectory per thread.
+template< typename Real >
+__global__ void initializeClosedLoopTrajectoriesKernel(
+    ClosedLoopTrajectory< Real >* trajectories,
+    const std::size_t numberOfTrajectories,
+    const typename ClosedLoopTrajectory< Real >::Dispersion dispersion,
+    const std::uint64_t seed,
+    const std::uint64_t firstTrajectoryIndex )
+{
+    const std::size_t i = static_cast< std::size_t >( blockIdx.x ) * blockDim.x + threadIdx.x;
+    if ( i < numberOfTrajectories )
+    {
+        new ( trajectories + i ) ClosedLoopTrajectory< Real >(
+            dispersion, seed, firstTrajectoryIndex + i );
+    }
+}
+
+//! Propagate batch of closed-loop trajectories in device memory, one trajectory per thread.
+template< typename Real >
+__global__ void propagateClosedLoopTrajectoriesKernel(
+    ClosedLoopTrajectory< Real >* trajectories,
+    const std::size_t numberOfTrajectories,
+    const typename ClosedLoopTrajectory< Real >::Dispersion dispersion,
+    const DeviceVector3< Real > targetPosition,
+    const DeviceVector3< Real > targetVelocity,
+    const Real finalTime,
+    const std::size_t numberOfSteps,
+    const std::size_t firstStep,
+    const std::size_t lastStep )
+{
+    const std::size_t i = static_cast< std::size_t >( blockIdx.x ) * blockDim.x + threadIdx.x;
+    if ( i < numberOfTrajectories )
+    {
+        // The state is kept in registers over all steps, and loaded and stored once per launch.
+        ClosedLoopTrajectory< Real > trajectory = trajectories[ i ];
+        trajectory.propagate( dispersion,
+                              targetPosition,
+                              targetVelocity,
+                              finalTime,
+                              numberOfSteps,
+                              firstStep,
+                              lastStep );
+        trajectories[ i ] = trajectory;
+    }
+}
+
+//! Reduce chunks of consecutive closed-loop trajectories to statistics, one chunk per thread.
+template< typename Real >
+__global__ void reduceClosedLoopTrajectoriesKernel(
+    const ClosedLoopTrajectory< Real >* trajectories,
+    const std::size_t numberOfTrajectories,
+    const DeviceVector3< Real > targetPosition,
+    const DeviceVector3< Real > targetVelocity,
+    const std::size_t chunkSize,
+    MonteCarloStatistics< Real >* chunkStatistics,
+    const std::size_t numberOfChunks )
+{
+    const std::size_t chunk = static_cast< std::size_t >( blockIdx.x ) * blockDim.x + threadIdx.x;
+    if ( chunk < numberOfChunks )
+    {
+        const std::size_t begin = chunk * chunkSize;
+        const std::size_t end = begin + chunkSize < numberOfTrajectories
+                                ? begin + chunkSize : numberOfTrajectories;
+        MonteCarloStatistics< Real > statistics;
+        for ( std::size_t i = begin; i < end; ++i )
+        {
+            statistics.add( trajectories[ i ].computeResult( targetPosition, targetVelocity ) );
+        }
+        new ( chunkStatistics + chunk ) MonteCarloStatistics< Real >( statistics );
+    }
+}
+
+//! Merge pairs of partial statistics in device memory, at given stride, one pair per thread.
+template< typename Real >
+__global__ void mergeMonteCarloStatisticsKernel( MonteCarloStatistics< Real >* statistics,
+                                                 const std::size_t numberOfStatistics,
+                                                 const std::size_t stride )
+{
+    const std::size_t i
+        = 2 * stride * ( static_cast< std::size_t >( blockIdx.x ) * blockDim.x + threadIdx.x );
+    if ( i + stride < numberOfStatistics )
+    {
+        statistics[ i ].merge( statistics[ i + stride ] );
+    }
+}
+
+} // namespace detail
+
+//! GPU batch engine for Monte Carlo dispersion campaigns of closed-loop OGL trajectories.
+/*!
+ * Runs the same Monte Carlo campaigns as MonteCarloCampaign on a CUDA or HIP device. The header
+ * must be included from a translation unit compiled with nvcc (with --expt-relaxed-constexpr) or
+ * hipcc.
+ *
+ * Trajectories are processed in batches, for which the trajectory states (see
+ * ClosedLoopTrajectory) stay resident in device memory, which is allocated once on construction.
+ * Each thread propagates one trajectory, keeping its state in registers for all guidance steps of
+ * a kernel launch; the propagate-guide loop runs for all steps in a single launch, unless a
+ * smaller number of steps per launch is given, e.g., to stay below the watchdog timeout of a
+ * display GPU. Once a batch has been propagated, chunks of trajectories are reduced to partial
+ * statistics on the device, which are merged pairwise in a fixed order, such that only the
+ * statistics of each batch are transferred back to the host, where they are merged in batch
+ * order.
+ *
+ * Since each trajectory draws its random numbers from its own counter-based stream, and all
+ * reductions are carried out in a fixed order, the results only depend on the seed, the number
+ * of trajectories, the batch size and the chunk size, and are reproducible on a given device. The
+ * results of single trajectories agree with MonteCarloCampaign up to rounding, which is
+ * bit-identical if floating-point contraction is disabled (--fmad=false for nvcc) and the device
+ * math functions are correctly rounded; the merged statistics differ from MonteCarloCampaign in
+ * the last bits, since partial statistics are merged pairwise instead of sequentially.
+ *
+ * All GPU runtime errors are reported by the return value of run( ); the engine must not be used
+ * after an error has been reported.
+ *
+ * @tparam  Real Real type
+ */
+template< typename Real >
+class GpuMonteCarloCampaign
+{
+public:
+
+    //! Construct campaign and allocate device memory.
+    /*!
+     * @tparam  Vector3                 3-Vector type
+     * @param   aDispersion             Dispersion specification
+     * @param   aTargetPosition         Target position
+     * @param   aTargetVelocity         Target velocity
+     * @param   aFinalTime              Final time at which target state should be reached
+     * @param   aNumberOfSteps          Number of guidance steps per trajectory
+     * @param   aBatchSize              Number of trajectories resident in device memory
+     *                                  (default=1048576)
+     * @param   aNumberOfStepsPerLaunch Number of guidance steps per kernel launch; if zero, all
+     *                                  steps are propagated in a single launch (default=0)
+     * @param   aChunkSize              Number of trajectories per chunk of partial statistics; if
+     *                                  zero, one trajectory per chunk is used (default=64)
+     */
+    template< typename Vector3 >
+    GpuMonteCarloCampaign( const MonteCarloDispersion< Real, Vector3 >& aDispersion,
+                           const Vector3& aTargetPosition,
+                           const Vector3& aTargetVelocity,
+                           const Real aFinalTime,
+                           const std::size_t aNumberOfSteps,
+                           const std::size_t aBatchSize = 1048576,
+                           const std::size_t aNumberOfStepsPerLaunch = 0,
+                           const std::size_t aChunkSize = 64 )
+        : dispersion( toDeviceDispersion( aDispersion ) ),
+          targetPosition( toDeviceVector3< Real >( aTargetPosition ) ),
+          targetVelocity( toDeviceVector3< Real >( aTargetVelocity ) ),
+          finalTime( aFinalTime ),
+          numberOfSteps( aNumberOfSteps ),
+          batchSize( aBatchSize ),
+          numberOfStepsPerLaunch( aNumberOfStepsPerLaunch > 0
+                                  ? aNumberOfStepsPerLaunch : aNumberOfSteps ),
+          chunkSize( aChunkSize > 0 ? aChunkSize : 1 ),
+          trajectories( 0 ),
+          chunkStatistics( 0 ),
+          status( CONTROL_GPU( Success ) )
+    {
+        status = CONTROL_GPU( Malloc )( reinterpret_cast< void** >( &trajectories ),
+                                        batchSize * sizeof( ClosedLoopTrajectory< Real > ) );
+        if ( status == CONTROL_GPU( Success ) )
+        {
+            const std::size_t maximumNumberOfChunks = ( batchSize + chunkSize - 1 ) / chunkSize;
+            status = CONTROL_GPU( Malloc )(
+                reinterpret_cast< void** >( &chunkStatistics ),
+                maximumNumberOfChunks * sizeof( MonteCarloStatistics< Real > ) );
+        }
+    }
+
+    //! Free device memory.
+    ~GpuMonteCarloCampaign( )
+    {
+        CONTROL_GPU( Free )( chunkStatistics );
+        CONTROL_GPU( Free )( trajectories );
+    }
+
+    //! Run campaign.
+    /*!
+     * Runs the campaign for the given number of trajectories on the device and reduces the
+     * terminal miss and Delta-V statistics.
+     *
+     * @param   numberOfTrajectories Number of trajectories
+     * @param   seed                 Seed of campaign
+     * @param   statistics           Statistics of campaign
+     * @return                       True if the campaign ran without GPU runtime errors
+     */
+    bool run( const std::size_t numberOfTrajectories,
+              const std::uint64_t seed,
+              MonteCarloStatistics< Real >& statistics )
+    {
+        statistics = MonteCarloStatistics< Real >( );
+
+        for ( std::size_t first = 0;
+              first < numberOfTrajectories && status == CONTROL_GPU( Success );
+              first += batchSize )
+        {
+            const std::size_t batchEnd = first + batchSize < numberOfTrajectories
+                                         ? first + batchSize : numberOfTrajectories;
+            const std::size_t count = batchEnd - first;
+
+            detail::initializeClosedLoopTrajectoriesKernel< Real >
+                <<< computeNumberOfBlocks( count ), numberOfThreadsPerBlock >>>(
+                    trajectories, count, dispersion, seed, first );
+
+            for ( std::size_t firstStep = 0; firstStep < numberOfSteps;
+                  firstStep += numberOfStepsPerLaunch )
+            {
+                const std::size_t lastStep = firstStep + numberOfStepsPerLaunch < numberOfSteps
+                                             ? firstStep + numberOfStepsPerLaunch : numberOfSteps;
+                detail::propagateClosedLoopTrajectoriesKernel< Real >
+                    <<< computeNumberOfBlocks( count ), numberOfThreadsPerBlock >>>(
+                        trajectories, count, dispersion, targetPosition, targetVelocity,
+                        finalTime, numberOfSteps, firstStep, lastStep );
+            }
+
+            const std::size_t numberOfChunks = ( count + chunkSize - 1 ) / chunkSize;
+            detail::reduceClosedLoopTrajectoriesKernel< Real >
+                <<< computeNumberOfBlocks( numberOfChunks ), numberOfThreadsPerBlock >>>(
+                    trajectories, count, targetPosition, targetVelocity, chunkSize,
+                    chunkStatistics, numberOfChunks );
+
+            for ( std::size_t stride = 1; stride < numberOfChunks; stride *= 2 )
+            {
+                const std::size_t numberOfPairs
+                    = ( numberOfChunks + 2 * stride - 1 ) / ( 2 * stride );
+                detail::mergeMonteCarloStatisticsKernel< Real >
+                    <<< computeNumberOfBlocks( numberOfPairs ), numberOfThreadsPerBlock >>>(
+                        chunkStatistics, numberOfChunks, stride );
+            }
+
+            status = CONTROL_GPU( GetLastError )( );
+            if ( status == CONTROL_GPU( Success ) )
+            {
+                // The copy synchronizes with all kernels of the batch.
+                MonteCarloStatistics< Real > batchStatistics;
+                status = CONTROL_GPU( Memcpy )( &batchStatistics,
+                                                chunkStatistics,
+                                                sizeof( MonteCarloStatistics< Real > ),
+                                                CONTROL_GPU( MemcpyDeviceToHost ) );
+                statistics.merge( batchStatistics );
+            }
+        }
+
+        return status == CONTROL_GPU( Success );
+    }
+
+private:
+
+    //! Copying is disabled, since the campaign owns device memory.
+    GpuMonteCarloCampaign( const GpuMonteCarloCampaign& );
+
+    //! Assignment is disabled, since the campaign owns device memory.
+    GpuMonteCarloCampaign& operator=( const GpuMonteCarloCampaign& );
+
+    //! Number of threads per block of all kernels.
+    static const unsigned int numberOfThreadsPerBlock = 256;
+
+    //! Compute number of blocks to launch one thread per work item.
+    static unsigned int computeNumberOfBlocks( const std::size_t numberOfItems )
+    {
+        return static_cast< unsigned int >(
+            ( numberOfItems + numberOfThreadsPerBlock - 1 ) / numberOfThreadsPerBlock );
+    }
+
+    //! Dispersion specification.
+    typename ClosedLoopTrajectory< Real >::Dispersion dispersion;
+
+    //! Target position.
+    DeviceVector3< Real > targetPosition;
+
+    //! Target velocity.
+    DeviceVector3< Real > targetVelocity;
+
+    //! Final time at which target state should be reached.
+    Real finalTime;
+
+    //! Number of guidance steps per trajectory.
+    std::size_t numberOfSteps;
+
+    //! Number of trajectories resident in device memory.
+    std::size_t batchSize;
+
+    //! Number of guidance steps per kernel launch.
+    std::size_t numberOfStepsPerLaunch;
+
+    //! Number of trajectories per chunk of partial statistics.
+    std::size_t chunkSize;
+
+    //! Trajectory states in device memory.
+    ClosedLoopTrajectory< Real >* trajectories;
+
+    //! Partial statistics in device memory.
+    MonteCarloStatistics< Real >* chunkStatistics;
+
+    //! Status of last GPU runtime call.
+    CONTROL_GPU( Error_t ) status;
+};
+
+} // namespace control
+
+#undef CONTROL_GPU
+
+#endif // CONTROL_GPU_MONTE_CARLO_CAMPAIGN_CUH
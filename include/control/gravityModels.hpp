@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_GRAVITY_MODELS_HPP
+#define CONTROL_GRAVITY_MODELS_HPP
+
+#include <cmath>
+
+namespace control
+{
+
+// The gravity models below are policies for the generalized ZEM/ZEV guidance. A gravity model is
+// any type that provides the following member function, which computes the gravitational
+// acceleration at a given position without allocating memory:
+//
+//     void computeAcceleration( const Vector3& position, Vector3& acceleration ) const;
+//
+// Positions are expressed in an inertial frame centered at the attracting body.
+
+//! Constant (uniform) gravity model.
+/*!
+ * Gravity model for a uniform gravitational field, e.g., close to the surface of a large body.
+ *
+ * @tparam  Real    Real type
+ * @tparam  Vector3 3-Vector type
+ */
+template< typename Real, typename Vector3 >
+class ConstantGravity
+{
+public:
+
+    //! Construct gravity model.
+    /*!
+     * @param   aGravitationalAcceleration Constant gravitational acceleration
+     */
+    explicit ConstantGravity( const Vector3& aGravitationalAcceleration )
+        : gravitationalAcceleration( aGravitationalAcceleration )
+    { }
+
+    //! Compute gravitational acceleration.
+    /*!
+     * @param   position     Position (not used)
+     * @param   acceleration Computed gravitational acceleration
+     */
+    void computeAcceleration( const Vector3& position, Vector3& acceleration ) const
+    {
+        static_cast< void >( position );
+        acceleration[ 0 ] = gravitationalAcceleration[ 0 ];
+        acceleration[ 1 ] = gravitationalAcceleration[ 1 ];
+        acceleration[ 2 ] = gravitationalAcceleration[ 2 ];
+    }
+
+private:
+
+    //! Constant gravitational acceleration.
+    Vector3 gravitationalAcceleration;
+};
+
+//! Point-mass gravity model.
+/*!
+ * Gravity model for a point mass (or spherically symmetric body):
+ *
+ * \f[
+ *      \vec{a} = -\frac{\mu}{r^{3}} \vec{r}
+ * \f]
+ *
+ * where \f$\mu\f$ is the gravitational parameter of the attracting body.
+ *
+ * @tparam  Real    Real type
+ * @tparam  Vector3 3-Vector type
+ */
+template< typename Real, typename Vector3 >
+class PointMassGravity
+{
+public:
+
+    //! Construct gravity model.
+    /*!
+     * @param   aGravitationalParameter Gravitational parameter of attracting body
+     */
+    explicit PointMassGravity( const Real aGravitationalParameter )
+        : gravitationalParameter( aGravitationalParameter )
+    { }
+
+    //! Compute gravitational acceleration.
+    /*!
+     * @param   position     Position relative to attracting body
+     * @param   acceleration Computed gravitational acceleration
+     */
+    void computeAcceleration( const Vector3& position, Vector3& acceleration ) const
+    {
+        const Real radiusSquared = position[ 0 ] * position[ 0 ]
+                                   + position[ 1 ] * position[ 1 ]
+                                   + position[ 2 ] * position[ 2 ];
+        const Real premultiplier
+            = -gravitationalParameter / ( radiusSquared * std::sqrt( radiusSquared ) );
+
+        acceleration[ 0 ] = premultiplier * position[ 0 ];
+        acceleration[ 1 ] = premultiplier * position[ 1 ];
+        acceleration[ 2 ] = premultiplier * position[ 2 ];
+    }
+
+private:
+
+    //! Gravitational parameter of attracting body.
+    Real gravitationalParameter;
+};
+
+//! J2 gravity model.
+/*!
+ * Gravity model for an oblate body, including the point-mass and the J2 (second zonal harmonic)
+ * contributions. The z-axis of the frame is assumed to be aligned with the symmetry axis of the
+ * attracting body:
+ *
+ * \f[
+ *      a_{x,y} = -\frac{\mu}{r^{3}} x_{x,y} \left[ 1 - \frac{3}{2} J_{2}
+ *                  \left( \frac{R}{r} \right)^{2} \left( 5 \frac{z^{2}}{r^{2}} - 1 \right)
+ *                  \right],
+ *      \quad
+ *      a_{z} = -\frac{\mu}{r^{3}} z \left[ 1 - \frac{3}{2} J_{2}
+ *                  \left( \frac{R}{r} \right)^{2} \left( 5 \frac{z^{2}}{r^{2}} - 3 \right)
+ *                  \right]
+ * \f]
+ *
+ * where \f$\mu\f$ is the gravitational parameter and \f$R\f$ is the reference radius of the
+ * attracting body.
+ *
+ * @tparam  Real    Real type
+ * @tparam  Vector3 3-Vector type
+ */
+template< typename Real, typename Vector3 >
+class J2Gravity
+{
+public:
+
+    //! Construct gravity model.
+    /*!
+     * @param   aGravitationalParameter Gravitational parameter of attracting body
+     * @param   aJ2Coefficient          J2 coefficient of attracting body
+     * @param   aReferenceRadius        Reference radius of attracting body
+     */
+    J2Gravity( const Real aGravitationalParameter,
+               const Real aJ2Coefficient,
+               const Real aReferenceRadius )
+        : gravitationalParameter( aGravitationalParameter ),
+          j2Premultiplier( Real( 1.5 ) * aJ2Coefficient * aReferenceRadius * aReferenceRadius )
+    { }
+
+    //! Compute gravitational acceleration.
+    /*!
+     * @param   position     Position relative to attracting body
+     * @param   acceleration Computed gravitational acceleration
+     */
+    void computeAcceleration( const Vector3& position, Vector3& acceleration ) const
+    {
+        const Real zSquared = position[ 2 ] * position[ 2 ];
+        const Real radiusSquared = position[ 0 ] * position[ 0 ]
+                                   + position[ 1 ] * position[ 1 ]
+                                   + zSquared;
+        const Real premultiplier
+            = -gravitationalParameter / ( radiusSquared * std::sqrt( radiusSquared ) );
+        const Real j2Term = j2Premultiplier / radiusSquared;
+        const Real zRatio = Real( 5.0 ) * zSquared / radiusSquared;
+
+        const Real equatorialFactor
+            = premultiplier * ( Real( 1.0 ) - j2Term * ( zRatio - Real( 1.0 ) ) );
+        acceleration[ 0 ] = equatorialFactor * position[ 0 ];
+        acceleration[ 1 ] = equatorialFactor * position[ 1 ];
+        acceleration[ 2 ] = premultiplier * ( Real( 1.0 ) - j2Term * ( zRatio - Real( 3.0 ) ) )
+                            * position[ 2 ];
+    }
+
+private:
+
+    //! Gravitational parameter of attracting body.
+    Real gravitationalParameter;
+
+    //! Premultiplier for J2 term: 3/2 J2 R^2.
+    Real j2Premultiplier;
+};
+
+//! Callback gravity model.
+/*!
+ * Gravity model that forwards to a user-supplied callback function, e.g., to evaluate a polyhedral
+ * or spherical-harmonics gravity field. The callback is passed an opaque pointer to user data,
+ * such that it can access the field model without global state.
+ *
+ * @tparam  Real    Real type
+ * @tparam  Vector3 3-Vector type
+ */
+template< typename Real, typename Vector3 >
+class CallbackGravity
+{
+public:
+
+    //! Callback function type.
+    typedef void ( *Callback )( const Vector3& position, Vector3& acceleration, void* userData );
+
+    //! Construct gravity model.
+    /*!
+     * @param   aCallback Callback function that computes gravitational acceleration
+     * @param   aUserData Opaque pointer to user data, passed to callback (default=0)
+     */
+    explicit CallbackGravity( Callback aCallback, void* aUserData = 0 )
+        : callback( aCallback ),
+          userData( aUserData )
+    { }
+
+    //! Compute gravitational acceleration.
+    /*!
+     * @param   position     Position relative to attracting body
+     * @param   acceleration Computed gravitational acceleration
+     */
+    void computeAcceleration( const Vector3& position, Vector3& acceleration ) const
+    {
+        callback( position, acceleration, userData );
+    }
+
+private:
+
+    //! Callback function that computes gravitational acceleration.
+    Callback callback;
+
+    //! Opaque pointer to user data, passed to callback.
+    void* userData;
+};
+
+} // namespace control
+
+#endif // CONTROL_GRAVITY_MODELS_HPP
@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_GUIDANCE_SERVICE_HPP
+#define CONTROL_GUIDANCE_SERVICE_HPP
+
+#include <array>
+#include <cstddef>
+
+#include "control/instrumentation.hpp"
+#include "control/optimalGuidanceLaw.hpp"
+#include "control/ringBuffer.hpp"
+#include "control/seqlockSlot.hpp"
+
+namespace control
+{
+
+//! State estimate passed from the navigation thread to a guidance service.
+template< typename Real >
+struct GuidanceStateEstimate
+{
+    //! Time of state estimate.
+    Real time;
+
+    //! Estimated position.
+    Real position[ 3 ];
+
+    //! Estimated velocity.
+    Real velocity[ 3 ];
+};
+
+//! Command published by a guidance service to the actuator threads.
+template< typename Real >
+struct GuidanceCommand
+{
+    //! Time for which the command was computed.
+    Real time;
+
+    //! TTG to reach target.
+    Real timeToGo;
+
+    //! Time of state estimate on which the command is based.
+    Real estimateTime;
+
+    //! Commanded control authority.
+    Real controlEffort[ 3 ];
+};
+
+//! Non-blocking Optimal Guidance Law (OGL) service for decoupled sensor and actuator rates.
+/*!
+ * Guidance service that decouples the rate at which state estimates arrive from the rate at which
+ * commands are computed and read, for a vehicle under the influence of a constant gravitational
+ * acceleration (see OptimalGuidanceController). Three roles are involved, none of which ever waits
+ * for another:
+ *
+ *  - one navigation thread pushes state estimates into a lock-free single-producer,
+ *    single-consumer queue (see SingleProducerSingleConsumerRingBuffer) with pushStateEstimate( );
+ *  - one guidance thread calls update( ) at the command rate, which drains the queue, updates the
+ *    ZEM and ZEV vectors from the latest state estimate, propagates them to the current time and
+ *    publishes the OGL command in a latest-value slot (see SeqlockSlot);
+ *  - any number of actuator threads read the latest command in constant time with readCommand( ).
+ *
+ * Between state estimates, the ZEM and ZEV vectors are propagated with the last commanded control
+ * authority \f$\vec{u}\f$, which is held constant over the step \f$\Delta t\f$ from TTG
+ * \f$t_{\text{go},0}\f$ to \f$t_{\text{go},1}\f$:
+ *
+ * \f[
+ *      \vec{\text{ZEM}}_{1} = \vec{\text{ZEM}}_{0}
+ *                              - \frac{t_{\text{go},0} + t_{\text{go},1}}{2} \Delta t \vec{u},
+ *      \qquad
+ *      \vec{\text{ZEV}}_{1} = \vec{\text{ZEV}}_{0} - \Delta t \vec{u}
+ * \f]
+ *
+ * which is exact for constant gravity, such that the command only deviates from the command based
+ * on a fresh state estimate by the effect of unmodeled perturbations since the last estimate.
+ *
+ * The update( ) function never blocks, such that it can be called from a periodic task, an event
+ * loop or a coroutine step. No memory is allocated after construction.
+ *
+ * @sa computeOptimalGuidanceLaw( )
+ * @tparam  Real Real type
+ */
+template< typename Real >
+class GuidanceService
+{
+public:
+
+    //! Construct guidance service.
+    /*!
+     * Constructs guidance service for given target state, gravitational acceleration and final
+     * time. The latest-value slot initially holds a zero command, which is not counted as a
+     * published command.
+     *
+     * @tparam  Vector3                     3-Vector type
+     * @param   aTargetPosition             Target position
+     * @param   aTargetVelocity             Target velocity
+     * @param   aGravitationalAcceleration  Constant gravitational acceleration
+     * @param   aFinalTime                  Final time at which target state should be reached
+     * @param   aCapacity                   Minimum capacity of state estimate queue (default=16)
+     * @param   aMinimumTimeToGo            TTG below which commands are no longer updated, such
+     *                                      that the last command is held (default=1.0e-3)
+     * @param   aZeroEffortMissGain         Control gain for ZEM term (default=6.0)
+     * @param   aZeroEffortVelocityGain     Control gain for ZEV term (default=-2.0)
+     */
+    template< typename Vector3 >
+    GuidanceService( const Vector3& aTargetPosition,
+                     const Vector3& aTargetVelocity,
+                     const Vector3& aGravitationalAcceleration,
+                     const Real aFinalTime,
+                     const std::size_t aCapacity = 16,
+                     const Real aMinimumTimeToGo = Real( 1.0e-3 ),
+                     const Real aZeroEffortMissGain = Real( 6.0 ),
+                     const Real aZeroEffortVelocityGain = Real( -2.0 ) )
+        : finalTime( aFinalTime ),
+          minimumTimeToGo( aMinimumTimeToGo ),
+          zeroEffortMissGain( aZeroEffortMissGain ),
+          zeroEffortVelocityGain( aZeroEffortVelocityGain ),
+          stateEstimates( aCapacity ),
+          command( GuidanceCommand< Real >( ) ),
+          hasStateEstimate( false ),
+          estimateTime( Real( 0.0 ) ),
+          propagationTime( Real( 0.0 ) ),
+          numberOfStateEstimates( 0 )
+    {
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            targetPosition[ i ] = static_cast< Real >( aTargetPosition[ i ] );
+            targetVelocity[ i ] = static_cast< Real >( aTargetVelocity[ i ] );
+            gravitationalAcceleration[ i ] = static_cast< Real >( aGravitationalAcceleration[ i ] );
+            zeroEffortMiss[ i ] = Real( 0.0 );
+            zeroEffortVelocity[ i ] = Real( 0.0 );
+            controlEffort[ i ] = Real( 0.0 );
+        }
+    }
+
+    //! Push state estimate, to be called by the navigation thread only.
+    /*!
+     * @tparam  Vector3  3-Vector type
+     * @param   time     Time of state estimate
+     * @param   position Estimated position
+     * @param   velocity Estimated velocity
+     * @return           True if the state estimate was pushed, false if the queue is full
+     */
+    template< typename Vector3 >
+    bool pushStateEstimate( const Real time, const Vector3& position, const Vector3& velocity )
+    {
+        GuidanceStateEstimate< Real > estimate;
+        estimate.time = time;
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            estimate.position[ i ] = static_cast< Real >( position[ i ] );
+            estimate.velocity[ i ] = static_cast< Real >( velocity[ i ] );
+        }
+        return pushStateEstimate( estimate );
+    }
+
+    //! Push state estimate, to be called by the navigation thread only.
+    /*!
+     * @param   estimate State estimate
+     * @return           True if the state estimate was pushed, false if the queue is full
+     */
+    bool pushStateEstimate( const GuidanceStateEstimate< Real >& estimate )
+    {
+        return stateEstimates.tryPush( estimate );
+    }
+
+    //! Update and publish command, to be called by the guidance thread only.
+    /*!
+     * Drains the state estimate queue, of which only the latest state estimate is used to update
+     * the ZEM and ZEV vectors, propagates the ZEM and ZEV vectors to the current time, and
+     * computes and publishes the OGL command. No command is published before the first state
+     * estimate has been received, or once the TTG drops below the minimum TTG.
+     *
+     * @param   currentTime Current time
+     * @return              True if a command was published
+     */
+    bool update( const Real currentTime )
+    {
+        CONTROL_INSTRUMENT_SCOPE( guidanceServiceProbe );
+
+        GuidanceStateEstimate< Real > estimate = GuidanceStateEstimate< Real >( );
+        bool hasNewStateEstimate = false;
+        while ( stateEstimates.tryPop( estimate ) )
+        {
+            hasNewStateEstimate = true;
+            ++numberOfStateEstimates;
+        }
+
+        if ( hasNewStateEstimate )
+        {
+            const Real estimateTimeToGo = finalTime - estimate.time;
+            const Real halfTimeToGoSquared = Real( 0.5 ) * estimateTimeToGo * estimateTimeToGo;
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                zeroEffortMiss[ i ] = targetPosition[ i ]
+                                      - halfTimeToGoSquared * gravitationalAcceleration[ i ]
+                                      - estimate.position[ i ]
+                                      - estimateTimeToGo * estimate.velocity[ i ];
+                zeroEffortVelocity[ i ] = targetVelocity[ i ]
+                                          - estimateTimeToGo * gravitationalAcceleration[ i ]
+                                          - estimate.velocity[ i ];
+            }
+            hasStateEstimate = true;
+            estimateTime = estimate.time;
+            propagationTime = estimate.time;
+        }
+
+        const Real timeToGo = finalTime - currentTime;
+        if ( !hasStateEstimate || timeToGo < minimumTimeToGo )
+        {
+            return false;
+        }
+
+        const Real stepSize = currentTime - propagationTime;
+        const Real meanTimeToGo = Real( 0.5 ) * ( finalTime - propagationTime + timeToGo );
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            zeroEffortMiss[ i ] -= meanTimeToGo * stepSize * controlEffort[ i ];
+            zeroEffortVelocity[ i ] -= stepSize * controlEffort[ i ];
+        }
+        propagationTime = currentTime;
+
+        computeOptimalGuidanceLaw( zeroEffortMiss,
+                                   zeroEffortVelocity,
+                                   timeToGo,
+                                   controlEffort,
+                                   zeroEffortMissGain,
+                                   zeroEffortVelocityGain );
+
+        GuidanceCommand< Real > newCommand;
+        newCommand.time = currentTime;
+        newCommand.timeToGo = timeToGo;
+        newCommand.estimateTime = estimateTime;
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            newCommand.controlEffort[ i ] = controlEffort[ i ];
+        }
+        command.store( newCommand );
+        return true;
+    }
+
+    //! Read latest command, which can be called by any thread.
+    /*!
+     * @return Latest published command, or a zero command if no command has been published yet
+     */
+    GuidanceCommand< Real > readCommand( ) const { return command.load( ); }
+
+    //! Get number of published commands, which can be called by any thread.
+    /*!
+     * @return Number of commands published by update( )
+     */
+    std::size_t getNumberOfCommands( ) const { return command.getNumberOfStores( ); }
+
+    //! Get number of state estimates consumed, to be called by the guidance thread only.
+    /*!
+     * @return Number of state estimates popped from the queue, including superseded estimates
+     */
+    std::size_t getNumberOfStateEstimates( ) const { return numberOfStateEstimates; }
+
+    //! Get ZEM vector computed at last call to update( ), to be called by the guidance thread only.
+    /*!
+     * @return ZEM vector
+     */
+    const std::array< Real, 3 >& getZeroEffortMiss( ) const { return zeroEffortMiss; }
+
+    //! Get ZEV vector computed at last call to update( ), to be called by the guidance thread only.
+    /*!
+     * @return ZEV vector
+     */
+    const std::array< Real, 3 >& getZeroEffortVelocity( ) const { return zeroEffortVelocity; }
+
+    //! Get final time.
+    /*!
+     * @return Final time at which target state should be reached
+     */
+    Real getFinalTime( ) const { return finalTime; }
+
+private:
+
+    //! Copying is disabled, since the service owns the queue and slot shared between threads.
+    GuidanceService( const GuidanceService& );
+
+    //! Assignment is disabled, since the service owns the queue and slot shared between threads.
+    GuidanceService& operator=( const GuidanceService& );
+
+    //! Target position.
+    std::array< Real, 3 > targetPosition;
+
+    //! Target velocity.
+    std::array< Real, 3 > targetVelocity;
+
+    //! Constant gravitational acceleration.
+    std::array< Real, 3 > gravitationalAcceleration;
+
+    //! Final time at which target state should be reached.
+    const Real finalTime;
+
+    //! TTG below which commands are no longer updated.
+    const Real minimumTimeToGo;
+
+    //! Control gain for ZEM term.
+    const Real zeroEffortMissGain;
+
+    //! Control gain for ZEV term.
+    const Real zeroEffortVelocityGain;
+
+    //! Queue of state estimates from the navigation thread to the guidance thread.
+    SingleProducerSingleConsumerRingBuffer< GuidanceStateEstimate< Real > > stateEstimates;
+
+    //! Latest-value slot of commands from the guidance thread to the actuator threads.
+    SeqlockSlot< GuidanceCommand< Real > > command;
+
+    //! Flag indicating if a state estimate has been received.
+    bool hasStateEstimate;
+
+    //! Time of latest state estimate.
+    Real estimateTime;
+
+    //! Time to which the ZEM and ZEV vectors have been propagated.
+    Real propagationTime;
+
+    //! Number of state estimates popped from the queue.
+    std::size_t numberOfStateEstimates;
+
+    //! ZEM vector.
+    std::array< Real, 3 > zeroEffortMiss;
+
+    //! ZEV vector.
+    std::array< Real, 3 > zeroEffortVelocity;
+
+    //! Last commanded control authority.
+    std::array< Real, 3 > controlEffort;
+};
+
+} // namespace control
+
+#endif // CONTROL_GUIDANCE_SERVICE_HPP
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_HOST_DEVICE_HPP
+#define CONTROL_HOST_DEVICE_HPP
+
+// Functions marked with CONTROL_HOST_DEVICE can be called from both host and device code when the
+// headers are compiled with a GPU compiler (nvcc for CUDA, hipcc for HIP); for any other compiler
+// the macro expands to nothing. Device code additionally requires relaxed constexpr rules, i.e.,
+// --expt-relaxed-constexpr for nvcc, such that std::array and std::numeric_limits can be used.
+#if defined( __CUDACC__ ) || defined( __HIPCC__ )
+#define CONTROL_HOST_DEVICE __host__ __device__
+#else
+#define CONTROL_HOST_DEVICE
+#endif
+
+// CONTROL_DEVICE_COMPILATION is defined during the device compilation pass of a GPU compiler, in
+// which host-only features, e.g., the SIMD kernels, are disabled.
+#if defined( __CUDA_ARCH__ ) || defined( __HIP_DEVICE_COMPILE__ )
+#define CONTROL_DEVICE_COMPILATION
+#endif
+
+#endif // CONTROL_HOST_DEVICE_HPP
@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_INSTRUMENTATION_HPP
+#define CONTROL_INSTRUMENTATION_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "control/hostDevice.hpp"
+
+// Instrumentation hooks in the guidance entry points are compiled out completely, unless
+// CONTROL_ENABLE_INSTRUMENTATION is defined. If compiled in, the hooks are disabled at runtime by
+// default and cost a single predictable branch on a global flag, until enableInstrumentation( )
+// is called. The recorded statistics can be queried irrespective of CONTROL_ENABLE_INSTRUMENTATION.
+#if ( defined( __GNUC__ ) || defined( __clang__ ) ) \
+    && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#include <x86intrin.h>
+#define CONTROL_HAS_X86_TIMESTAMP_COUNTER
+#elif ( defined( __GNUC__ ) || defined( __clang__ ) ) && defined( __aarch64__ )
+#define CONTROL_HAS_ARM_TIMESTAMP_COUNTER
+#endif
+
+namespace control
+{
+
+//! Instrumented guidance entry points.
+enum InstrumentationProbe
+{
+    optimalGuidanceLawProbe,
+    batchedOptimalGuidanceLawProbe,
+    saturatedOptimalGuidanceLawProbe,
+    batchedSaturatedOptimalGuidanceLawProbe,
+    optimalGuidanceScheduleProbe,
+    optimalGuidanceControllerProbe,
+    generalizedOptimalGuidanceControllerProbe,
+    formationGuidanceProbe,
+    linearQuadraticRegulatorProbe,
+    modelPredictiveGuidanceProbe,
+    pidControllerProbe,
+    multiChannelPidControllerProbe,
+    slidingModeOptimalGuidanceLawProbe,
+    batchedSlidingModeOptimalGuidanceLawProbe,
+    guidanceServiceProbe,
+    numberOfInstrumentationProbes
+};
+
+//! Numeric events recorded by instrumented guidance entry points.
+enum InstrumentationEvent
+{
+    //! TTG below the threshold set by setNearZeroTimeToGoThreshold( ).
+    nearZeroTimeToGoEvent,
+
+    //! Control authority limited by thrust limits (see ThrustLimits).
+    thrustSaturationEvent,
+
+    numberOfInstrumentationEvents
+};
+
+//! Number of bins of latency histograms.
+/*!
+ * Bin i contains the calls with a latency in [2^i, 2^(i+1)) ticks of the timestamp counter, except
+ * for the first bin, which also contains calls with a latency of zero ticks, and the last bin,
+ * which also contains all longer calls.
+ */
+const std::size_t numberOfLatencyHistogramBins = 32;
+
+//! Read timestamp counter.
+/*!
+ * Reads the timestamp counter of the host CPU: the TSC on x86 and the virtual counter on AArch64.
+ * On other platforms, the steady clock is used, with ticks of one nanosecond.
+ *
+ * @return Current value of timestamp counter
+ */
+inline std::uint64_t readTimestampCounter( )
+{
+#if defined( CONTROL_HAS_X86_TIMESTAMP_COUNTER )
+    return __rdtsc( );
+#elif defined( CONTROL_HAS_ARM_TIMESTAMP_COUNTER )
+    std::uint64_t counter;
+    __asm__ __volatile__( "mrs %0, cntvct_el0" : "=r"( counter ) );
+    return counter;
+#else
+    return static_cast< std::uint64_t >( std::chrono::duration_cast< std::chrono::nanoseconds >(
+        std::chrono::steady_clock::now( ).time_since_epoch( ) ).count( ) );
+#endif
+}
+
+namespace detail
+{
+
+//! Statistics recorded for an instrumented entry point.
+struct InstrumentationProbeStatistics
+{
+    //! Number of calls.
+    std::atomic< std::uint64_t > callCount;
+
+    //! Total latency of all calls [ticks].
+    std::atomic< std::uint64_t > totalLatency;
+
+    //! Latency histogram.
+    std::atomic< std::uint64_t > latencyHistogram[ numberOfLatencyHistogramBins ];
+};
+
+//! Global instrumentation state.
+/*!
+ * All counters are updated with relaxed atomic operations, such that entry points can be
+ * instrumented while they are called concurrently, e.g., in a Monte Carlo campaign.
+ */
+struct InstrumentationState
+{
+    //! Flag that indicates if instrumentation is enabled at runtime.
+    std::atomic< bool > isEnabled;
+
+    //! TTG threshold below which a near-zero TTG event is recorded.
+    std::atomic< double > nearZeroTimeToGoThreshold;
+
+    //! Statistics per instrumented entry point.
+    InstrumentationProbeStatistics probes[ numberOfInstrumentationProbes ];
+
+    //! Count per numeric event.
+    std::atomic< std::uint64_t > eventCounts[ numberOfInstrumentationEvents ];
+};
+
+//! Get reference to global instrumentation state.
+inline InstrumentationState& getInstrumentationState( )
+{
+    // Static storage is zero-initialized before the first call, so all counters start at zero.
+    static InstrumentationState state;
+    return state;
+}
+
+//! Compute bin of latency histogram.
+inline std::size_t computeLatencyHistogramBin( std::uint64_t latency )
+{
+    std::size_t bin = 0;
+    while ( latency > 1 && bin < numberOfLatencyHistogramBins - 1 )
+    {
+        latency >>= 1;
+        ++bin;
+    }
+    return bin;
+}
+
+//! Record latency of call to instrumented entry point.
+inline void recordInstrumentationLatency( const InstrumentationProbe probe,
+                                          const std::uint64_t latency )
+{
+    InstrumentationProbeStatistics& statistics = getInstrumentationState( ).probes[ probe ];
+    statistics.callCount.fetch_add( 1, std::memory_order_relaxed );
+    statistics.totalLatency.fetch_add( latency, std::memory_order_relaxed );
+    statistics.latencyHistogram[ computeLatencyHistogramBin( latency ) ].fetch_add(
+        1, std::memory_order_relaxed );
+}
+
+//! Scope that records the latency and numeric events of a call to an instrumented entry point.
+/*!
+ * The runtime flag is read once at the start of the scope. If instrumentation is disabled, all
+ * members are no-ops that test the same local flag, which the compiler can fold into a single
+ * predictable branch.
+ */
+class InstrumentationScope
+{
+public:
+
+    //! Start scope, reading the timestamp counter only if instrumentation is enabled.
+    explicit InstrumentationScope( const InstrumentationProbe aProbe )
+        : probe( aProbe ),
+          isActive( getInstrumentationState( ).isEnabled.load( std::memory_order_relaxed ) ),
+          startTime( isActive ? readTimestampCounter( ) : 0 )
+    { }
+
+    //! End scope, recording the latency if instrumentation was enabled at the start.
+    ~InstrumentationScope( )
+    {
+        if ( isActive )
+        {
+            recordInstrumentationLatency( probe, readTimestampCounter( ) - startTime );
+        }
+    }
+
+    //! Record near-zero TTG event for given TTG.
+    template< typename Real >
+    void recordTimeToGo( const Real timeToGo ) const
+    {
+        if ( isActive )
+        {
+            recordTimeToGo( &timeToGo, 1 );
+        }
+    }
+
+    //! Record near-zero TTG events for batch of TTGs.
+    template< typename Real >
+    void recordTimeToGo( const Real* timeToGo, const std::size_t numberOfSamples ) const
+    {
+        if ( isActive )
+        {
+            InstrumentationState& state = getInstrumentationState( );
+            const double threshold
+                = state.nearZeroTimeToGoThreshold.load( std::memory_order_relaxed );
+            std::uint64_t count = 0;
+            for ( std::size_t i = 0; i < numberOfSamples; ++i )
+            {
+                count += static_cast< double >( timeToGo[ i ] ) < threshold ? 1 : 0;
+            }
+            state.eventCounts[ nearZeroTimeToGoEvent ].fetch_add( count,
+                                                                  std::memory_order_relaxed );
+        }
+    }
+
+    //! Record given number of numeric events.
+    void recordEvent( const InstrumentationEvent event, const std::uint64_t count ) const
+    {
+        if ( isActive )
+        {
+            getInstrumentationState( ).eventCounts[ event ].fetch_add(
+                count, std::memory_order_relaxed );
+        }
+    }
+
+private:
+
+    //! Instrumented entry point.
+    InstrumentationProbe probe;
+
+    //! Flag that indicates if instrumentation was enabled at the start of the scope.
+    bool isActive;
+
+    //! Timestamp counter at the start of the scope.
+    std::uint64_t startTime;
+};
+
+} // namespace detail
+
+//! Enable or disable instrumentation at runtime.
+/*!
+ * Enables or disables recording by the instrumentation hooks. This has no effect unless the hooks
+ * are compiled in by defining CONTROL_ENABLE_INSTRUMENTATION.
+ *
+ * @param   isEnabled Flag that indicates if instrumentation should be enabled
+ */
+inline void enableInstrumentation( const bool isEnabled )
+{
+    detail::getInstrumentationState( ).isEnabled.store( isEnabled, std::memory_order_relaxed );
+}
+
+//! Check if instrumentation is enabled at runtime.
+/*!
+ * @return True if instrumentation is enabled
+ */
+inline bool isInstrumentationEnabled( )
+{
+    return detail::getInstrumentationState( ).isEnabled.load( std::memory_order_relaxed );
+}
+
+//! Check if instrumentation hooks are compiled in.
+/*!
+ * @return True if CONTROL_ENABLE_INSTRUMENTATION is defined
+ */
+inline constexpr bool isInstrumentationCompiledIn( )
+{
+#if defined( CONTROL_ENABLE_INSTRUMENTATION )
+    return true;
+#else
+    return false;
+#endif
+}
+
+//! Set TTG threshold below which near-zero TTG events are recorded.
+/*!
+ * @param   threshold TTG threshold (default=0.0, i.e., only negative TTGs are recorded)
+ */
+inline void setNearZeroTimeToGoThreshold( const double threshold )
+{
+    detail::getInstrumentationState( ).nearZeroTimeToGoThreshold.store(
+        threshold, std::memory_order_relaxed );
+}
+
+//! Reset all recorded instrumentation statistics.
+/*!
+ * Resets all counters to zero. This function should not be called while instrumented entry points
+ * are being evaluated.
+ */
+inline void resetInstrumentation( )
+{
+    detail::InstrumentationState& state = detail::getInstrumentationState( );
+    for ( std::size_t i = 0; i < numberOfInstrumentationProbes; ++i )
+    {
+        state.probes[ i ].callCount.store( 0, std::memory_order_relaxed );
+        state.probes[ i ].totalLatency.store( 0, std::memory_order_relaxed );
+        for ( std::size_t j = 0; j < numberOfLatencyHistogramBins; ++j )
+        {
+            state.probes[ i ].latencyHistogram[ j ].store( 0, std::memory_order_relaxed );
+        }
+    }
+    for ( std::size_t i = 0; i < numberOfInstrumentationEvents; ++i )
+    {
+        state.eventCounts[ i ].store( 0, std::memory_order_relaxed );
+    }
+}
+
+//! Get number of recorded calls to instrumented entry point.
+/*!
+ * @param   probe Instrumented entry point
+ * @return        Number of calls
+ */
+inline std::uint64_t getInstrumentationCallCount( const InstrumentationProbe probe )
+{
+    return detail::getInstrumentationState( ).probes[ probe ].callCount.load(
+        std::memory_order_relaxed );
+}
+
+//! Get total recorded latency of calls to instrumented entry point.
+/*!
+ * @param   probe Instrumented entry point
+ * @return        Total latency [ticks of timestamp counter]
+ */
+inline std::uint64_t getInstrumentationTotalLatency( const InstrumentationProbe probe )
+{
+    return detail::getInstrumentationState( ).probes[ probe ].totalLatency.load(
+        std::memory_order_relaxed );
+}
+
+//! Get bin of recorded latency histogram of instrumented entry point.
+/*!
+ * @param   probe Instrumented entry point
+ * @param   bin   Bin of histogram, in [0, numberOfLatencyHistogramBins)
+ * @return        Number of calls in bin
+ */
+inline std::uint64_t getInstrumentationLatencyHistogram( const InstrumentationProbe probe,
+                                                         const std::size_t bin )
+{
+    return detail::getInstrumentationState( ).probes[ probe ].latencyHistogram[ bin ].load(
+        std::memory_order_relaxed );
+}
+
+//! Get number of recorded numeric events.
+/*!
+ * @param   event Numeric event
+ * @return        Number of events
+ */
+inline std::uint64_t getInstrumentationEventCount( const InstrumentationEvent event )
+{
+    return detail::getInstrumentationState( ).eventCounts[ event ].load(
+        std::memory_order_relaxed );
+}
+
+} // namespace control
+
+// Instrumentation hooks are host-only, and are compiled out in device code.
+#if defined( CONTROL_ENABLE_INSTRUMENTATION ) && !defined( CONTROL_DEVICE_COMPILATION )
+//! Record call count and latency of enclosing scope for given probe; at most one per scope.
+#define CONTROL_INSTRUMENT_SCOPE( probe ) \
+    const ::control::detail::InstrumentationScope controlInstrumentationScope( probe )
+//! Record near-zero TTG event for single TTG, or for array of TTGs and number of samples.
+#define CONTROL_INSTRUMENT_TIME_TO_GO( ... ) \
+    controlInstrumentationScope.recordTimeToGo( __VA_ARGS__ )
+//! Record given number of numeric events.
+#define CONTROL_INSTRUMENT_EVENT( event, count ) \
+    controlInstrumentationScope.recordEvent( event, count )
+#else
+#define CONTROL_INSTRUMENT_SCOPE( probe )
+#define CONTROL_INSTRUMENT_TIME_TO_GO( ... )
+#define CONTROL_INSTRUMENT_EVENT( event, count )
+#endif // CONTROL_ENABLE_INSTRUMENTATION
+
+#endif // CONTROL_INSTRUMENTATION_HPP
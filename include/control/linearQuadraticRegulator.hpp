@@ -0,0 +1,500 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_LINEAR_QUADRATIC_REGULATOR_HPP
+#define CONTROL_LINEAR_QUADRATIC_REGULATOR_HPP
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "control/instrumentation.hpp"
+
+namespace control
+{
+namespace detail
+{
+
+//! Multiply matrices, i.e., C = A B, with A of size Rows x Inner and B of size Inner x Columns.
+template< typename Real, std::size_t Rows, std::size_t Inner, std::size_t Columns >
+inline void multiplyMatrices( const Real* matrix,
+                              const Real* otherMatrix,
+                              Real* product )
+{
+    for ( std::size_t i = 0; i < Rows; ++i )
+    {
+        for ( std::size_t j = 0; j < Columns; ++j )
+        {
+            Real sum = Real( 0.0 );
+            for ( std::size_t k = 0; k < Inner; ++k )
+            {
+                sum += matrix[ i * Inner + k ] * otherMatrix[ k * Columns + j ];
+            }
+            product[ i * Columns + j ] = sum;
+        }
+    }
+}
+
+//! Multiply transposed matrix, i.e., C = A^T B, with A of size Inner x Rows and B of size
+//! Inner x Columns.
+template< typename Real, std::size_t Rows, std::size_t Inner, std::size_t Columns >
+inline void multiplyTransposedMatrices( const Real* matrix,
+                                        const Real* otherMatrix,
+                                        Real* product )
+{
+    for ( std::size_t i = 0; i < Rows; ++i )
+    {
+        for ( std::size_t j = 0; j < Columns; ++j )
+        {
+            Real sum = Real( 0.0 );
+            for ( std::size_t k = 0; k < Inner; ++k )
+            {
+                sum += matrix[ k * Rows + i ] * otherMatrix[ k * Columns + j ];
+            }
+            product[ i * Columns + j ] = sum;
+        }
+    }
+}
+
+//! Solve S X = T in place for symmetric positive-definite S of size Size x Size, and T of size
+//! Size x Columns, by Cholesky decomposition. Returns false if S is not positive-definite.
+template< typename Real, std::size_t Size, std::size_t Columns >
+inline bool solveSymmetricPositiveDefinite( Real* matrix, Real* rightHandSide )
+{
+    // Decompose S = L L^T, storing L in the lower triangle of S.
+    for ( std::size_t j = 0; j < Size; ++j )
+    {
+        Real diagonal = matrix[ j * Size + j ];
+        for ( std::size_t k = 0; k < j; ++k )
+        {
+            diagonal -= matrix[ j * Size + k ] * matrix[ j * Size + k ];
+        }
+        if ( !( diagonal > Real( 0.0 ) ) )
+        {
+            return false;
+        }
+        diagonal = std::sqrt( diagonal );
+        matrix[ j * Size + j ] = diagonal;
+
+        for ( std::size_t i = j + 1; i < Size; ++i )
+        {
+            Real element = matrix[ i * Size + j ];
+            for ( std::size_t k = 0; k < j; ++k )
+            {
+                element -= matrix[ i * Size + k ] * matrix[ j * Size + k ];
+            }
+            matrix[ i * Size + j ] = element / diagonal;
+        }
+    }
+
+    // Solve L Y = T and L^T X = Y for each column.
+    for ( std::size_t column = 0; column < Columns; ++column )
+    {
+        for ( std::size_t i = 0; i < Size; ++i )
+        {
+            Real element = rightHandSide[ i * Columns + column ];
+            for ( std::size_t k = 0; k < i; ++k )
+            {
+                element -= matrix[ i * Size + k ] * rightHandSide[ k * Columns + column ];
+            }
+            rightHandSide[ i * Columns + column ] = element / matrix[ i * Size + i ];
+        }
+
+        for ( std::size_t i = Size; i-- > 0; )
+        {
+            Real element = rightHandSide[ i * Columns + column ];
+            for ( std::size_t k = i + 1; k < Size; ++k )
+            {
+                element -= matrix[ k * Size + i ] * rightHandSide[ k * Columns + column ];
+            }
+            rightHandSide[ i * Columns + column ] = element / matrix[ i * Size + i ];
+        }
+    }
+
+    return true;
+}
+
+} // namespace detail
+
+//! Discrete-time Linear-Quadratic Regulator (LQR) with cached gain schedule.
+/*!
+ * Discrete-time LQR for linear time-invariant systems \f$x_{k+1} = A x_{k} + B u_{k}\f$, which
+ * minimizes the quadratic cost
+ *
+ * \f[
+ *      J = x_{N}^{T} Q_{f} x_{N} + \sum_{k=0}^{N-1} x_{k}^{T} Q x_{k} + u_{k}^{T} R u_{k}
+ * \f]
+ *
+ * The optimal control is the linear state feedback \f$u_{k} = -K_{k} x_{k}\f$, with the gains
+ * given by the backward discrete Riccati recursion, starting from \f$P_{N} = Q_{f}\f$:
+ *
+ * \f[
+ *      K_{k} = \left( R + B^{T} P_{k+1} B \right)^{-1} B^{T} P_{k+1} A,
+ *      \quad
+ *      P_{k} = Q + A^{T} P_{k+1} \left( A - B K_{k} \right)
+ * \f]
+ *
+ * The recursion is solved once, on construction, either over a finite horizon of N steps, which
+ * yields a time-varying gain schedule, or until the cost matrix converges, which yields the
+ * constant steady-state (infinite-horizon) gain. The gains are cached in a single contiguous
+ * buffer, with each gain matrix starting on a cache line, such that computing the control at a
+ * step is a single fixed-size matrix-vector product over one or a few cache lines, which the
+ * compiler fully unrolls for small systems. Memory is only allocated on construction.
+ *
+ * Tracking of a reference state, e.g., for docking or station-keeping relative to a nominal
+ * state, is obtained by regulating the deviation from the reference, i.e.,
+ * \f$u_{k} = -K_{k} \left( x_{k} - x_{\text{ref},k} \right)\f$.
+ *
+ * All matrices are stored in row-major order. The Riccati recursion reports failure, instead of
+ * producing gains, if \f$R + B^{T} P B\f$ is not positive-definite, which is the case, e.g., if R
+ * is not positive-definite; see isValid( ).
+ *
+ * @tparam  Real        Real type
+ * @tparam  StateSize   Dimension of state vector
+ * @tparam  ControlSize Dimension of control vector
+ */
+template< typename Real, std::size_t StateSize, std::size_t ControlSize >
+class LinearQuadraticRegulator
+{
+public:
+
+    //! State vector type.
+    typedef std::array< Real, StateSize > StateVector;
+
+    //! Control vector type.
+    typedef std::array< Real, ControlSize > ControlVector;
+
+    //! State matrix type, i.e., A, Q and P (StateSize x StateSize).
+    typedef std::array< Real, StateSize * StateSize > StateMatrix;
+
+    //! Input matrix type, i.e., B (StateSize x ControlSize).
+    typedef std::array< Real, StateSize * ControlSize > InputMatrix;
+
+    //! Control weight matrix type, i.e., R (ControlSize x ControlSize).
+    typedef std::array< Real, ControlSize * ControlSize > ControlWeightMatrix;
+
+    //! Gain matrix type, i.e., K (ControlSize x StateSize).
+    typedef std::array< Real, ControlSize * StateSize > GainMatrix;
+
+    //! Construct finite-horizon regulator.
+    /*!
+     * Constructs regulator with time-varying gain schedule, by solving the Riccati recursion over
+     * the given number of steps.
+     *
+     * @param   aStateMatrix              State matrix A
+     * @param   anInputMatrix             Input matrix B
+     * @param   aStateWeightMatrix        State weight matrix Q, which must be symmetric
+     * @param   aControlWeightMatrix      Control weight matrix R, which must be symmetric
+     * @param   aFinalStateWeightMatrix   Final state weight matrix Q_f, which must be symmetric
+     * @param   aNumberOfSteps            Number of steps N of horizon (at least one)
+     */
+    LinearQuadraticRegulator( const StateMatrix& aStateMatrix,
+                              const InputMatrix& anInputMatrix,
+                              const StateMatrix& aStateWeightMatrix,
+                              const ControlWeightMatrix& aControlWeightMatrix,
+                              const StateMatrix& aFinalStateWeightMatrix,
+                              const std::size_t aNumberOfSteps )
+        : numberOfGains( aNumberOfSteps > 0 ? aNumberOfSteps : 1 ),
+          gainBuffer( numberOfGains * gainStride + cacheLineSize / sizeof( Real ) ),
+          gains( computeAlignedGains( gainBuffer ) ),
+          costMatrix( aFinalStateWeightMatrix ),
+          numberOfIterations( 0 ),
+          isSolved( true )
+    {
+        for ( std::size_t k = numberOfGains; k-- > 0 && isSolved; )
+        {
+            isSolved = updateRiccatiSolution( aStateMatrix,
+                                              anInputMatrix,
+                                              aStateWeightMatrix,
+                                              aControlWeightMatrix,
+                                              gains + k * gainStride );
+            ++numberOfIterations;
+        }
+    }
+
+    //! Construct steady-state (infinite-horizon) regulator.
+    /*!
+     * Constructs regulator with constant gain, by iterating the Riccati recursion from
+     * \f$P = Q\f$ until the largest change of an element of the cost matrix, relative to the
+     * largest element of the cost matrix, drops below the given tolerance.
+     *
+     * @param   aStateMatrix                State matrix A
+     * @param   anInputMatrix               Input matrix B
+     * @param   aStateWeightMatrix          State weight matrix Q, which must be symmetric
+     * @param   aControlWeightMatrix        Control weight matrix R, which must be symmetric
+     * @param   aTolerance                  Relative tolerance on convergence of cost matrix
+     * @param   aMaximumNumberOfIterations  Maximum number of iterations of Riccati recursion
+     */
+    LinearQuadraticRegulator( const StateMatrix& aStateMatrix,
+                              const InputMatrix& anInputMatrix,
+                              const StateMatrix& aStateWeightMatrix,
+                              const ControlWeightMatrix& aControlWeightMatrix,
+                              const Real aTolerance,
+                              const unsigned int aMaximumNumberOfIterations )
+        : numberOfGains( 1 ),
+          gainBuffer( gainStride + cacheLineSize / sizeof( Real ) ),
+          gains( computeAlignedGains( gainBuffer ) ),
+          costMatrix( aStateWeightMatrix ),
+          numberOfIterations( 0 ),
+          isSolved( false )
+    {
+        while ( numberOfIterations < aMaximumNumberOfIterations )
+        {
+            const StateMatrix previousCostMatrix = costMatrix;
+            if ( !updateRiccatiSolution( aStateMatrix,
+                                         anInputMatrix,
+                                         aStateWeightMatrix,
+                                         aControlWeightMatrix,
+                                         gains ) )
+            {
+                break;
+            }
+            ++numberOfIterations;
+
+            Real maximumChange = Real( 0.0 );
+            Real maximumElement = Real( 0.0 );
+            for ( std::size_t i = 0; i < StateSize * StateSize; ++i )
+            {
+                const Real change = std::fabs( costMatrix[ i ] - previousCostMatrix[ i ] );
+                const Real element = std::fabs( costMatrix[ i ] );
+                maximumChange = change > maximumChange ? change : maximumChange;
+                maximumElement = element > maximumElement ? element : maximumElement;
+            }
+            if ( maximumChange <= aTolerance * maximumElement )
+            {
+                isSolved = true;
+                break;
+            }
+        }
+    }
+
+    //! Compute control.
+    /*!
+     * Computes the control \f$u = -K_{k} x\f$ for the given step. Steps beyond the last step of
+     * the schedule use the last gain, i.e., the steady-state regulator applies the same gain at
+     * each step.
+     *
+     * @param   step    Step k
+     * @param   state   Current state x
+     * @param   control Computed control u
+     */
+    void computeControl( const std::size_t step,
+                         const StateVector& state,
+                         ControlVector& control ) const
+    {
+        CONTROL_INSTRUMENT_SCOPE( linearQuadraticRegulatorProbe );
+
+        applyGain( getGain( step ), state.data( ), control.data( ) );
+    }
+
+    //! Compute control to track reference state.
+    /*!
+     * Computes the control \f$u = -K_{k} \left( x - x_{\text{ref}} \right)\f$ for the given step.
+     *
+     * @param   step            Step k
+     * @param   state           Current state x
+     * @param   referenceState  Reference state x_ref
+     * @param   control         Computed control u
+     */
+    void computeControl( const std::size_t step,
+                         const StateVector& state,
+                         const StateVector& referenceState,
+                         ControlVector& control ) const
+    {
+        CONTROL_INSTRUMENT_SCOPE( linearQuadraticRegulatorProbe );
+
+        StateVector stateDeviation;
+        for ( std::size_t i = 0; i < StateSize; ++i )
+        {
+            stateDeviation[ i ] = state[ i ] - referenceState[ i ];
+        }
+        applyGain( getGain( step ), stateDeviation.data( ), control.data( ) );
+    }
+
+    //! Compute controls for a batch of vehicles.
+    /*!
+     * Computes the controls for a batch of vehicles that share the regulator and are at the same
+     * step, e.g., vehicles in a formation. The states and controls are stored contiguously per
+     * vehicle, i.e., the state of vehicle j starts at states[ j * StateSize ] and its control at
+     * controls[ j * ControlSize ]. The gain matrix is loaded once and stays in cache across the
+     * batch. Results are bit-identical to computeControl( ) for each vehicle.
+     *
+     * @param   step                Step k
+     * @param   states              Current states of vehicles
+     * @param   numberOfVehicles    Number of vehicles
+     * @param   controls            Computed controls of vehicles
+     */
+    void computeControl( const std::size_t step,
+                         const Real* states,
+                         const std::size_t numberOfVehicles,
+                         Real* controls ) const
+    {
+        CONTROL_INSTRUMENT_SCOPE( linearQuadraticRegulatorProbe );
+
+        const Real* gain = getGain( step );
+        for ( std::size_t j = 0; j < numberOfVehicles; ++j )
+        {
+            applyGain( gain, states + j * StateSize, controls + j * ControlSize );
+        }
+    }
+
+    //! Get gain matrix for given step.
+    /*!
+     * @param   step Step k, whereby steps beyond the schedule map to the last gain
+     * @return       Pointer to gain matrix K_k, stored in row-major order and cache-aligned
+     */
+    const Real* getGain( const std::size_t step ) const
+    {
+        return gains + ( step < numberOfGains ? step : numberOfGains - 1 ) * gainStride;
+    }
+
+    //! Get number of gains in schedule.
+    /*!
+     * @return Number of gains, i.e., the number of steps for the finite-horizon regulator and one
+     *         for the steady-state regulator
+     */
+    std::size_t getNumberOfGains( ) const { return numberOfGains; }
+
+    //! Get cost matrix at first step.
+    /*!
+     * @return Cost matrix P_0, such that the optimal cost-to-go from state x is x^T P_0 x
+     */
+    const StateMatrix& getCostMatrix( ) const { return costMatrix; }
+
+    //! Get number of iterations of Riccati recursion.
+    /*!
+     * @return Number of iterations of Riccati recursion carried out on construction
+     */
+    unsigned int getNumberOfIterations( ) const { return numberOfIterations; }
+
+    //! Check if Riccati recursion was solved.
+    /*!
+     * @return True if all gains were computed and, for the steady-state regulator, the cost
+     *         matrix converged; false otherwise, in which case the gains must not be used
+     */
+    bool isValid( ) const { return isSolved; }
+
+private:
+
+    //! Size of cache line, used to align the gain matrices.
+    static const std::size_t cacheLineSize = 64;
+
+    //! Number of elements between consecutive gain matrices, rounded up to whole cache lines.
+    static const std::size_t gainStride
+        = ( ( ControlSize * StateSize * sizeof( Real ) + cacheLineSize - 1 ) / cacheLineSize )
+          * cacheLineSize / sizeof( Real );
+
+    //! Copy constructor, which is private since the gains point into the owned buffer.
+    LinearQuadraticRegulator( const LinearQuadraticRegulator& );
+
+    //! Assignment operator, which is private since the gains point into the owned buffer.
+    LinearQuadraticRegulator& operator=( const LinearQuadraticRegulator& );
+
+    //! Compute pointer to first cache-aligned element of buffer.
+    static Real* computeAlignedGains( std::vector< Real >& buffer )
+    {
+        const std::size_t address = reinterpret_cast< std::size_t >( buffer.data( ) );
+        const std::size_t padding = ( cacheLineSize - address % cacheLineSize ) % cacheLineSize;
+        return buffer.data( ) + padding / sizeof( Real );
+    }
+
+    //! Apply gain matrix, i.e., compute u = -K x.
+    static void applyGain( const Real* gain, const Real* state, Real* control )
+    {
+        for ( std::size_t i = 0; i < ControlSize; ++i )
+        {
+            Real sum = Real( 0.0 );
+            for ( std::size_t j = 0; j < StateSize; ++j )
+            {
+                sum += gain[ i * StateSize + j ] * state[ j ];
+            }
+            control[ i ] = -sum;
+        }
+    }
+
+    //! Carry out one step of the Riccati recursion, updating the cost matrix and writing the gain.
+    bool updateRiccatiSolution( const StateMatrix& stateMatrix,
+                                const InputMatrix& inputMatrix,
+                                const StateMatrix& stateWeightMatrix,
+                                const ControlWeightMatrix& controlWeightMatrix,
+                                Real* gain )
+    {
+        // Compute B^T P (ControlSize x StateSize).
+        GainMatrix inputCost;
+        detail::multiplyTransposedMatrices< Real, ControlSize, StateSize, StateSize >(
+            inputMatrix.data( ), costMatrix.data( ), inputCost.data( ) );
+
+        // Compute S = R + B^T P B and T = B^T P A, and solve S K = T.
+        ControlWeightMatrix innovation;
+        detail::multiplyMatrices< Real, ControlSize, StateSize, ControlSize >(
+            inputCost.data( ), inputMatrix.data( ), innovation.data( ) );
+        for ( std::size_t i = 0; i < ControlSize * ControlSize; ++i )
+        {
+            innovation[ i ] += controlWeightMatrix[ i ];
+        }
+        GainMatrix gainMatrix;
+        detail::multiplyMatrices< Real, ControlSize, StateSize, StateSize >(
+            inputCost.data( ), stateMatrix.data( ), gainMatrix.data( ) );
+        if ( !detail::solveSymmetricPositiveDefinite< Real, ControlSize, StateSize >(
+                innovation.data( ), gainMatrix.data( ) ) )
+        {
+            return false;
+        }
+
+        // Compute A - B K, and P = Q + A^T P ( A - B K ), symmetrized to limit round-off drift.
+        StateMatrix closedLoopMatrix;
+        detail::multiplyMatrices< Real, StateSize, ControlSize, StateSize >(
+            inputMatrix.data( ), gainMatrix.data( ), closedLoopMatrix.data( ) );
+        for ( std::size_t i = 0; i < StateSize * StateSize; ++i )
+        {
+            closedLoopMatrix[ i ] = stateMatrix[ i ] - closedLoopMatrix[ i ];
+        }
+        StateMatrix closedLoopCost;
+        detail::multiplyMatrices< Real, StateSize, StateSize, StateSize >(
+            costMatrix.data( ), closedLoopMatrix.data( ), closedLoopCost.data( ) );
+        detail::multiplyTransposedMatrices< Real, StateSize, StateSize, StateSize >(
+            stateMatrix.data( ), closedLoopCost.data( ), costMatrix.data( ) );
+        for ( std::size_t i = 0; i < StateSize; ++i )
+        {
+            for ( std::size_t j = 0; j <= i; ++j )
+            {
+                const Real element = Real( 0.5 ) * ( costMatrix[ i * StateSize + j ]
+                                                     + costMatrix[ j * StateSize + i ] );
+                costMatrix[ i * StateSize + j ] = element + stateWeightMatrix[ i * StateSize + j ];
+                costMatrix[ j * StateSize + i ] = element + stateWeightMatrix[ j * StateSize + i ];
+            }
+        }
+
+        for ( std::size_t i = 0; i < ControlSize * StateSize; ++i )
+        {
+            gain[ i ] = gainMatrix[ i ];
+        }
+        return true;
+    }
+
+    //! Number of gains in schedule.
+    const std::size_t numberOfGains;
+
+    //! Buffer that holds gain schedule, with padding to align the first gain.
+    std::vector< Real > gainBuffer;
+
+    //! Pointer to first gain matrix, aligned to a cache line.
+    Real* const gains;
+
+    //! Cost matrix of Riccati recursion, which is P_0 once the recursion is solved.
+    StateMatrix costMatrix;
+
+    //! Number of iterations of Riccati recursion.
+    unsigned int numberOfIterations;
+
+    //! Flag indicating if Riccati recursion was solved.
+    bool isSolved;
+};
+
+} // namespace control
+
+#endif // CONTROL_LINEAR_QUADRATIC_REGULATOR_HPP
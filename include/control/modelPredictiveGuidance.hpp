@@ -0,0 +1,546 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_MODEL_PREDICTIVE_GUIDANCE_HPP
+#define CONTROL_MODEL_PREDICTIVE_GUIDANCE_HPP
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "control/instrumentation.hpp"
+#include "control/linearQuadraticRegulator.hpp"
+#include "control/optimalGuidanceLaw.hpp"
+#include "control/vectorTraits.hpp"
+
+namespace control
+{
+
+//! Settings of model predictive guidance.
+template< typename Real >
+struct ModelPredictiveGuidanceSettings
+{
+    //! Nominal step size of prediction horizon, typically equal to the guidance period.
+    Real stepSize;
+
+    //! Maximum number of steps of prediction horizon, above which the steps are lengthened.
+    std::size_t maximumNumberOfSteps;
+
+    //! Maximum magnitude of control acceleration.
+    Real maximumControlAcceleration;
+
+    //! Weight of squared terminal ZEM, i.e., the predicted terminal position error.
+    Real zeroEffortMissWeight;
+
+    //! Weight of squared terminal ZEV, i.e., the predicted terminal velocity error.
+    Real zeroEffortVelocityWeight;
+
+    //! Weight of control effort, i.e., of the integral of the squared control acceleration.
+    Real controlWeight;
+
+    //! Maximum number of solver iterations per call, above which the OGL is used instead.
+    unsigned int maximumNumberOfIterations;
+
+    //! Tolerance on largest component of residual of terminal ZEM and ZEV.
+    Real tolerance;
+
+    //! Wall-clock time budget per call [s], above which the OGL is used instead (zero: no budget).
+    Real timeBudget;
+
+    //! TTG below which the OGL with terminal-phase handling is used instead of the solver.
+    Real minimumTimeToGo;
+};
+
+//! Status of last call to model predictive guidance.
+enum ModelPredictiveGuidanceStatus
+{
+    modelPredictiveGuidanceConverged,
+    modelPredictiveGuidanceIterationBudgetExceeded,
+    modelPredictiveGuidanceTimeBudgetExceeded,
+    modelPredictiveGuidanceTerminalPhase
+};
+
+//! Closed-loop model predictive guidance (MPC) controller for constant gravity.
+/*!
+ * Closed-loop controller that computes the control authority by solving, at each call, a
+ * constrained linear-quadratic optimal control problem over the remaining Time-To-Go (TTG), and
+ * applying the first control of the solution (receding horizon). The dynamics are those of the
+ * OptimalGuidanceController, i.e., a double integrator under constant gravity, and the problem is
+ * formulated directly in terms of the Zero-Effort-Miss (ZEM) and Zero-Effort-Velocity (ZEV)
+ * vectors. The TTG is divided in N steps of size \f$h = t_{\text{go}} / N\f$, whereby N follows
+ * from the nominal step size, up to the maximum number of steps, and the control acceleration
+ * \f$\vec{u}_{k}\f$ is held constant over each step, such that the terminal ZEM and ZEV follow
+ * exactly from the current ZEM and ZEV (see GainTuner):
+ *
+ * \f[
+ *      \vec{\text{ZEM}}_{N} = \vec{\text{ZEM}} - \sum_{k=0}^{N-1} c_{k} \vec{u}_{k},
+ *      \quad c_{k} = h \left( t_{\text{go}} - \left( k + \frac{1}{2} \right) h \right),
+ *      \quad
+ *      \vec{\text{ZEV}}_{N} = \vec{\text{ZEV}} - \sum_{k=0}^{N-1} h \vec{u}_{k}
+ * \f]
+ *
+ * The controls minimize
+ *
+ * \f[
+ *      J = \frac{1}{2} w_{r} \left\| \vec{\text{ZEM}}_{N} \right\|^{2}
+ *          + \frac{1}{2} w_{v} \left\| \vec{\text{ZEV}}_{N} \right\|^{2}
+ *          + \frac{1}{2} \rho h \sum_{k=0}^{N-1} \left\| \vec{u}_{k} \right\|^{2}
+ *      \quad \text{subject to} \quad \left\| \vec{u}_{k} \right\| \leq u_{\max}
+ * \f]
+ *
+ * Since the states are eliminated (condensed formulation), the controls of the different steps
+ * are only coupled through the terminal ZEM and ZEV. The Quadratic Program (QP) is therefore
+ * solved in its dual (Boyd and Vandenberghe, 2004): for given multipliers \f$\vec{\lambda}\f$ and
+ * \f$\vec{\mu}\f$ of the terminal ZEM and ZEV, the optimal control of each step follows in closed
+ * form as
+ *
+ * \f[
+ *      \vec{u}_{k} = \Pi_{u_{\max}} \left( \frac{c_{k} \vec{\lambda} + h \vec{\mu}}{\rho h} \right)
+ * \f]
+ *
+ * where \f$\Pi_{u_{\max}}\f$ is the projection onto the ball of maximum magnitude, and the six
+ * multipliers are found by a semi-smooth Newton method (Qi and Sun, 1993) with backtracking line
+ * search on the concave, continuously differentiable dual function. Each iteration evaluates the
+ * gradient and the 6x6 Hessian of the dual function in O(N) operations and solves a 6x6 linear
+ * system, so the cost per iteration grows linearly with the horizon, and the number of iterations
+ * does not depend on the conditioning of the primal QP. Without active constraints and for large
+ * terminal weights, the solution approaches the OGL, whose control profile is linear in time.
+ *
+ * Between calls, the solver is warm-started from the multipliers of the previous solution. Along
+ * the optimal trajectory, the multipliers are invariant to shifting the horizon, such that the
+ * previous solution shifted by the elapsed time is recovered, and typically only one or two
+ * iterations are needed per call. The solver stops once the largest component of the residual of
+ * the terminal ZEM and ZEV, i.e., of the gradient of the dual function, drops below the tolerance.
+ * If the iteration or time budget is exhausted first, the controller falls back on the OGL (see
+ * computeTerminalOptimalGuidanceLaw( ), which is bit-identical to computeOptimalGuidanceLaw( )
+ * above the TTG floor), but keeps the last multipliers as warm start, so that the solver catches
+ * up over subsequent calls. The OGL is also used once the TTG drops below the TTG floor, where the
+ * problem becomes ill-conditioned; the status of the last call is given by getStatus( ).
+ *
+ * All workspace is allocated on construction, such that no memory is allocated when computing the
+ * control authority.
+ *
+ * @sa computeOptimalGuidanceLaw( ), OptimalGuidanceController
+ * @tparam  Real    Real type
+ * @tparam  Vector3 3-Vector type
+ */
+template< typename Real, typename Vector3 >
+class ModelPredictiveGuidanceController
+{
+public:
+
+    //! Construct controller.
+    /*!
+     * Constructs controller for given target state, gravitational acceleration, final time and
+     * settings. The OGL gains are used whenever the controller falls back on the OGL.
+     *
+     * @param   aTargetPosition             Target position
+     * @param   aTargetVelocity             Target velocity
+     * @param   aGravitationalAcceleration  Constant gravitational acceleration
+     * @param   aFinalTime                  Final time at which target state should be reached
+     * @param   someSettings                Settings of solver (the step size, weights and TTG
+     *                                      floor must be strictly positive and finite, and the
+     *                                      maximum number of steps at least one)
+     * @param   aZeroEffortMissGain         Control gain for ZEM term of OGL (default=6.0)
+     * @param   aZeroEffortVelocityGain     Control gain for ZEV term of OGL (default=-2.0)
+     */
+    ModelPredictiveGuidanceController( const Vector3& aTargetPosition,
+                                       const Vector3& aTargetVelocity,
+                                       const Vector3& aGravitationalAcceleration,
+                                       const Real aFinalTime,
+                                       const ModelPredictiveGuidanceSettings< Real >& someSettings,
+                                       const Real aZeroEffortMissGain = Real( 6.0 ),
+                                       const Real aZeroEffortVelocityGain = Real( -2.0 ) )
+        : targetPosition( aTargetPosition ),
+          targetVelocity( aTargetVelocity ),
+          gravitationalAcceleration( aGravitationalAcceleration ),
+          finalTime( aFinalTime ),
+          settings( someSettings ),
+          zeroEffortMissGain( aZeroEffortMissGain ),
+          zeroEffortVelocityGain( aZeroEffortVelocityGain ),
+          timeToGo( aFinalTime ),
+          zeroEffortMiss( aTargetPosition ),
+          zeroEffortVelocity( aTargetVelocity ),
+          controlEffort( aTargetPosition ),
+          controls( 3 * someSettings.maximumNumberOfSteps, Real( 0.0 ) ),
+          numberOfSteps( 0 ),
+          numberOfIterations( 0 ),
+          status( modelPredictiveGuidanceTerminalPhase )
+    {
+        for ( unsigned int i = 0; i < 6; ++i )
+        {
+            multipliers[ i ] = Real( 0.0 );
+        }
+    }
+
+    //! Compute control authority.
+    /*!
+     * Computes the control authority for the given current time and state, by updating the ZEM
+     * and ZEV vectors and solving the QP, or evaluating the OGL if the solver exceeds its budget
+     * or the TTG is below the TTG floor.
+     *
+     * @param   currentTime Current time
+     * @param   position    Current position
+     * @param   velocity    Current velocity
+     * @return              Computed control authority
+     */
+    const Vector3& computeControl( const Real currentTime,
+                                   const Vector3& position,
+                                   const Vector3& velocity )
+    {
+        CONTROL_INSTRUMENT_SCOPE( modelPredictiveGuidanceProbe );
+
+        // The clock is only read if a time budget is set.
+        const std::chrono::steady_clock::time_point startTime
+            = settings.timeBudget > Real( 0.0 ) ? std::chrono::steady_clock::now( )
+                                                : std::chrono::steady_clock::time_point( );
+
+        timeToGo = finalTime - currentTime;
+        const Real halfTimeToGoSquared = Real( 0.5 ) * timeToGo * timeToGo;
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            zeroEffortMiss[ i ] = targetPosition[ i ]
+                                  - halfTimeToGoSquared * gravitationalAcceleration[ i ]
+                                  - position[ i ] - timeToGo * velocity[ i ];
+            zeroEffortVelocity[ i ] = targetVelocity[ i ]
+                                      - timeToGo * gravitationalAcceleration[ i ]
+                                      - velocity[ i ];
+        }
+
+        numberOfIterations = 0;
+        status = timeToGo > settings.minimumTimeToGo
+                 ? solve( startTime ) : modelPredictiveGuidanceTerminalPhase;
+
+        if ( status == modelPredictiveGuidanceConverged )
+        {
+            typedef typename VectorElement< Vector3 >::Type Element;
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                controlEffort[ i ] = static_cast< Element >( controls[ i ] );
+            }
+        }
+        else
+        {
+            computeTerminalOptimalGuidanceLaw( zeroEffortMiss,
+                                               zeroEffortVelocity,
+                                               timeToGo,
+                                               settings.minimumTimeToGo,
+                                               controlEffort,
+                                               zeroEffortMissGain,
+                                               zeroEffortVelocityGain );
+        }
+        return controlEffort;
+    }
+
+    //! Set final time.
+    /*!
+     * @param   aFinalTime Final time
+     */
+    void setFinalTime( const Real aFinalTime ) { finalTime = aFinalTime; }
+
+    //! Get final time.
+    /*!
+     * @return Final time at which target state should be reached
+     */
+    Real getFinalTime( ) const { return finalTime; }
+
+    //! Get TTG computed at last call to computeControl( ).
+    /*!
+     * @return TTG
+     */
+    Real getTimeToGo( ) const { return timeToGo; }
+
+    //! Get ZEM vector computed at last call to computeControl( ).
+    /*!
+     * @return ZEM vector
+     */
+    const Vector3& getZeroEffortMiss( ) const { return zeroEffortMiss; }
+
+    //! Get ZEV vector computed at last call to computeControl( ).
+    /*!
+     * @return ZEV vector
+     */
+    const Vector3& getZeroEffortVelocity( ) const { return zeroEffortVelocity; }
+
+    //! Get status of last call to computeControl( ).
+    /*!
+     * @return Status, whereby any status other than converged indicates the OGL was used
+     */
+    ModelPredictiveGuidanceStatus getStatus( ) const { return status; }
+
+    //! Get number of solver iterations carried out at last call to computeControl( ).
+    /*!
+     * @return Number of iterations
+     */
+    unsigned int getNumberOfIterations( ) const { return numberOfIterations; }
+
+    //! Get number of steps of prediction horizon at last call to computeControl( ).
+    /*!
+     * @return Number of steps
+     */
+    std::size_t getNumberOfSteps( ) const { return numberOfSteps; }
+
+    //! Get planned controls of last solver iterate.
+    /*!
+     * @return Control accelerations stored per step (x, y, z), of which the first
+     *         getNumberOfSteps( ) steps are in use
+     */
+    const std::vector< Real >& getPlannedControls( ) const { return controls; }
+
+private:
+
+    //! Maximum number of trial steps of line search.
+    static const unsigned int maximumNumberOfLineSearchTrials = 30;
+
+    //! Evaluate dual function, its gradient and, if requested, the negative of its Hessian.
+    Real evaluateDualFunction( const Real* someMultipliers,
+                               const Real stepSize,
+                               Real* gradient,
+                               Real* negativeHessian )
+    {
+        const Real effortWeight = settings.controlWeight * stepSize;
+        const Real inverseEffortWeight = Real( 1.0 ) / effortWeight;
+        const Real maximumControlAcceleration = settings.maximumControlAcceleration;
+        const Real maximumSquaredControlAcceleration
+            = maximumControlAcceleration * maximumControlAcceleration;
+
+        Real value = Real( 0.0 );
+        for ( unsigned int i = 0; i < 6; ++i )
+        {
+            gradient[ i ] = Real( 0.0 );
+        }
+        if ( negativeHessian != 0 )
+        {
+            for ( unsigned int i = 0; i < 36; ++i )
+            {
+                negativeHessian[ i ] = Real( 0.0 );
+            }
+        }
+
+        for ( std::size_t k = 0; k < numberOfSteps; ++k )
+        {
+            const Real coefficient
+                = stepSize * ( timeToGo - ( Real( k ) + Real( 0.5 ) ) * stepSize );
+
+            Real unconstrainedControl[ 3 ];
+            Real squaredMagnitude = Real( 0.0 );
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                unconstrainedControl[ i ]
+                    = ( coefficient * someMultipliers[ i ] + stepSize * someMultipliers[ 3 + i ] )
+                      * inverseEffortWeight;
+                squaredMagnitude += unconstrainedControl[ i ] * unconstrainedControl[ i ];
+            }
+
+            const bool isSaturated = squaredMagnitude > maximumSquaredControlAcceleration;
+            const Real scale = isSaturated
+                               ? maximumControlAcceleration / std::sqrt( squaredMagnitude )
+                               : Real( 1.0 );
+            Real* control = &controls[ 3 * k ];
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                control[ i ] = scale * unconstrainedControl[ i ];
+                value += effortWeight * control[ i ]
+                         * ( Real( 0.5 ) * control[ i ] - unconstrainedControl[ i ] );
+                gradient[ i ] -= coefficient * control[ i ];
+                gradient[ 3 + i ] -= stepSize * control[ i ];
+            }
+
+            // The Jacobian of the projected control with respect to the unconstrained control is
+            // the identity, or for saturated steps, the scaled projection onto the tangent plane.
+            if ( negativeHessian != 0 )
+            {
+                const Real weights[ 2 ] = { coefficient, stepSize };
+                for ( unsigned int i = 0; i < 3; ++i )
+                {
+                    for ( unsigned int j = 0; j < 3; ++j )
+                    {
+                        Real jacobian = i == j ? scale : Real( 0.0 );
+                        if ( isSaturated )
+                        {
+                            jacobian -= scale * unconstrainedControl[ i ]
+                                        * unconstrainedControl[ j ] / squaredMagnitude;
+                        }
+                        jacobian *= inverseEffortWeight;
+                        for ( unsigned int a = 0; a < 2; ++a )
+                        {
+                            for ( unsigned int b = 0; b < 2; ++b )
+                            {
+                                negativeHessian[ ( 3 * a + i ) * 6 + 3 * b + j ]
+                                    += weights[ a ] * weights[ b ] * jacobian;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        const Real inverseWeights[ 2 ] = { Real( 1.0 ) / settings.zeroEffortMissWeight,
+                                           Real( 1.0 ) / settings.zeroEffortVelocityWeight };
+        for ( unsigned int i = 0; i < 6; ++i )
+        {
+            const Real terminalVector = i < 3 ? static_cast< Real >( zeroEffortMiss[ i ] )
+                                              : static_cast< Real >( zeroEffortVelocity[ i - 3 ] );
+            const Real inverseWeight = inverseWeights[ i / 3 ];
+            gradient[ i ] += terminalVector - inverseWeight * someMultipliers[ i ];
+            value += someMultipliers[ i ]
+                     * ( terminalVector - Real( 0.5 ) * inverseWeight * someMultipliers[ i ] );
+            if ( negativeHessian != 0 )
+            {
+                negativeHessian[ i * 6 + i ] += inverseWeight;
+            }
+        }
+        return value;
+    }
+
+    //! Solve QP by semi-smooth Newton method on dual function.
+    ModelPredictiveGuidanceStatus solve( const std::chrono::steady_clock::time_point& startTime )
+    {
+        const Real nominalNumberOfSteps = std::floor( timeToGo / settings.stepSize + Real( 0.5 ) );
+        numberOfSteps = nominalNumberOfSteps < Real( 1.0 ) ? 1
+                        : ( nominalNumberOfSteps > Real( settings.maximumNumberOfSteps )
+                            ? settings.maximumNumberOfSteps
+                            : static_cast< std::size_t >( nominalNumberOfSteps ) );
+        const Real stepSize = timeToGo / Real( numberOfSteps );
+
+        Real gradient[ 6 ];
+        Real negativeHessian[ 36 ];
+        Real value = evaluateDualFunction( multipliers, stepSize, gradient, negativeHessian );
+        while ( true )
+        {
+            Real residual = Real( 0.0 );
+            for ( unsigned int i = 0; i < 6; ++i )
+            {
+                const Real absoluteGradient = std::fabs( gradient[ i ] );
+                residual = absoluteGradient > residual ? absoluteGradient : residual;
+            }
+            if ( residual <= settings.tolerance )
+            {
+                return modelPredictiveGuidanceConverged;
+            }
+            if ( numberOfIterations >= settings.maximumNumberOfIterations )
+            {
+                return modelPredictiveGuidanceIterationBudgetExceeded;
+            }
+            if ( settings.timeBudget > Real( 0.0 )
+                 && std::chrono::duration< Real >(
+                        std::chrono::steady_clock::now( ) - startTime ).count( )
+                    > settings.timeBudget )
+            {
+                return modelPredictiveGuidanceTimeBudgetExceeded;
+            }
+            ++numberOfIterations;
+
+            // The Newton direction is an ascent direction, since the negative Hessian is
+            // positive-definite for finite terminal weights; the gradient is used otherwise.
+            Real direction[ 6 ];
+            for ( unsigned int i = 0; i < 6; ++i )
+            {
+                direction[ i ] = gradient[ i ];
+            }
+            if ( !detail::solveSymmetricPositiveDefinite< Real, 6, 1 >( negativeHessian,
+                                                                         direction ) )
+            {
+                for ( unsigned int i = 0; i < 6; ++i )
+                {
+                    direction[ i ] = gradient[ i ];
+                }
+            }
+            Real slope = Real( 0.0 );
+            for ( unsigned int i = 0; i < 6; ++i )
+            {
+                slope += gradient[ i ] * direction[ i ];
+            }
+
+            // Backtracking line search with Armijo condition; the last trial step is accepted if
+            // the condition is not met, e.g., due to round-off close to the optimum.
+            Real trialMultipliers[ 6 ];
+            Real trialGradient[ 6 ];
+            Real stepLength = Real( 1.0 );
+            for ( unsigned int trial = 0; trial < maximumNumberOfLineSearchTrials; ++trial )
+            {
+                for ( unsigned int i = 0; i < 6; ++i )
+                {
+                    trialMultipliers[ i ] = multipliers[ i ] + stepLength * direction[ i ];
+                }
+                const Real trialValue
+                    = evaluateDualFunction( trialMultipliers, stepSize, trialGradient, 0 );
+                if ( trialValue >= value + Real( 1.0e-4 ) * stepLength * slope )
+                {
+                    break;
+                }
+                stepLength *= Real( 0.5 );
+            }
+
+            for ( unsigned int i = 0; i < 6; ++i )
+            {
+                multipliers[ i ] = trialMultipliers[ i ];
+            }
+            value = evaluateDualFunction( multipliers, stepSize, gradient, negativeHessian );
+        }
+    }
+
+    //! Target position.
+    Vector3 targetPosition;
+
+    //! Target velocity.
+    Vector3 targetVelocity;
+
+    //! Constant gravitational acceleration.
+    Vector3 gravitationalAcceleration;
+
+    //! Final time at which target state should be reached.
+    Real finalTime;
+
+    //! Settings of solver.
+    ModelPredictiveGuidanceSettings< Real > settings;
+
+    //! Control gain for ZEM term of OGL.
+    Real zeroEffortMissGain;
+
+    //! Control gain for ZEV term of OGL.
+    Real zeroEffortVelocityGain;
+
+    //! TTG computed at last call.
+    Real timeToGo;
+
+    //! ZEM vector computed at last call.
+    Vector3 zeroEffortMiss;
+
+    //! ZEV vector computed at last call.
+    Vector3 zeroEffortVelocity;
+
+    //! Control authority computed at last call.
+    Vector3 controlEffort;
+
+    //! Controls of last solver iterate, stored per step.
+    std::vector< Real > controls;
+
+    //! Number of steps of prediction horizon at last call.
+    std::size_t numberOfSteps;
+
+    //! Multipliers of terminal ZEM and ZEV, used to warm-start the solver.
+    Real multipliers[ 6 ];
+
+    //! Number of solver iterations at last call.
+    unsigned int numberOfIterations;
+
+    //! Status of last call.
+    ModelPredictiveGuidanceStatus status;
+};
+
+} // namespace control
+
+#endif // CONTROL_MODEL_PREDICTIVE_GUIDANCE_HPP
+
+/*
+ * References
+ * Qi, L., Sun, J. (1993) A nonsmooth version of Newton's method, Mathematical Programming,
+ *  pg. 353-367, vol. 58, doi: 10.1007/BF01581275.
+ * Boyd, S., Vandenberghe, L. (2004) Convex Optimization, Cambridge University Press.
+ */
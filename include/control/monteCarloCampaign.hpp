@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_MONTE_CARLO_CAMPAIGN_HPP
+#define CONTROL_MONTE_CARLO_CAMPAIGN_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "control/hostDevice.hpp"
+#include "control/optimalGuidanceController.hpp"
+#include "control/parallel.hpp"
+#include "control/randomNumberGenerator.hpp"
+#include "control/simd.hpp"
+#include "control/statistics.hpp"
+
+namespace control
+{
+
+//! Dispersion specification for Monte Carlo campaign.
+/*!
+ * Specification of the nominal values and the dispersions of the parameters of a closed-loop OGL
+ * trajectory. All dispersions are modelled as zero-mean normal distributions, with the given
+ * standard deviation per vector component; the sensor noise is sampled independently at each
+ * guidance step.
+ *
+ * @tparam  Real    Real type
+ * @tparam  Vector3 3-Vector type
+ */
+template< typename Real, typename Vector3 >
+struct MonteCarloDispersion
+{
+    //! Nominal initial position.
+    Vector3 initialPosition;
+
+    //! Standard deviation of initial position.
+    Vector3 initialPositionStandardDeviation;
+
+    //! Nominal initial velocity.
+    Vector3 initialVelocity;
+
+    //! Standard deviation of initial velocity.
+    Vector3 initialVelocityStandardDeviation;
+
+    //! Nominal gravitational acceleration, also used by the controller.
+    Vector3 gravitationalAcceleration;
+
+    //! Standard deviation of true gravitational acceleration.
+    Vector3 gravitationalAccelerationStandardDeviation;
+
+    //! Nominal control gain for ZEM term.
+    Real zeroEffortMissGain;
+
+    //! Standard deviation of control gain for ZEM term.
+    Real zeroEffortMissGainStandardDeviation;
+
+    //! Nominal control gain for ZEV term.
+    Real zeroEffortVelocityGain;
+
+    //! Standard deviation of control gain for ZEV term.
+    Real zeroEffortVelocityGainStandardDeviation;
+
+    //! Standard deviation of position measurement noise.
+    Vector3 positionNoiseStandardDeviation;
+
+    //! Standard deviation of velocity measurement noise.
+    Vector3 velocityNoiseStandardDeviation;
+};
+
+//! Result of single Monte Carlo trajectory.
+template< typename Real >
+struct MonteCarloTrajectoryResult
+{
+    //! Terminal miss distance, i.e., norm of difference between final and target position.
+    Real positionMiss;
+
+    //! Terminal velocity miss, i.e., norm of difference between final and target velocity.
+    Real velocityMiss;
+
+    //! Total Delta-V, i.e., integral of norm of control authority over trajectory.
+    Real deltaV;
+};
+
+//! Statistics of Monte Carlo campaign.
+template< typename Real >
+struct MonteCarloStatistics
+{
+    //! Statistics of terminal miss distance.
+    RunningStatistics< Real > positionMiss;
+
+    //! Statistics of terminal velocity miss.
+    RunningStatistics< Real > velocityMiss;
+
+    //! Statistics of total Delta-V.
+    RunningStatistics< Real > deltaV;
+
+    //! Add result of single trajectory.
+    CONTROL_HOST_DEVICE void add( const MonteCarloTrajectoryResult< Real >& result )
+    {
+        positionMiss.add( result.positionMiss );
+        velocityMiss.add( result.velocityMiss );
+        deltaV.add( result.deltaV );
+    }
+
+    //! Merge partial statistics.
+    CONTROL_HOST_DEVICE void merge( const MonteCarloStatistics& statistics )
+    {
+        positionMiss.merge( statistics.positionMiss );
+        velocityMiss.merge( statistics.velocityMiss );
+        deltaV.merge( statistics.deltaV );
+    }
+};
+
+//! Number of trajectories per block of partial statistics of Monte Carlo campaigns in
+//! deterministic mode.
+const std::size_t monteCarloDeterministicBlockSize = 64;
+
+//! Parallel Monte Carlo dispersion campaign for closed-loop OGL trajectories.
+/*!
+ * Runs Monte Carlo campaigns of closed-loop trajectories under the OGL for constant gravity (see
+ * OptimalGuidanceController), with dispersed initial state, gravitational acceleration, control
+ * gains and sensor noise. The controller uses the nominal gravitational acceleration and noisy
+ * state measurements, whereas the true state is propagated with the dispersed gravitational
+ * acceleration. The control authority is held constant over each guidance step, for which the
+ * state is propagated exactly.
+ *
+ * Trajectories are grouped in chunks and distributed across threads with parallelForChunks( ).
+ * Each trajectory draws its random numbers from its own counter-based stream, indexed by the
+ * trajectory index, and each chunk accumulates its own partial statistics, which are merged in
+ * chunk order once all chunks have been processed. The results of a campaign therefore only
+ * depend on the seed, the number of trajectories and the chunk size, and are bit-identical for any
+ * number of threads. In deterministic mode (see isDeterministicModeEnabled( )), the partial
+ * statistics are accumulated per block of monteCarloDeterministicBlockSize trajectories instead,
+ * and chunks consist of whole blocks, such that the statistics do not depend on the chunk size
+ * either. No locks are used, and memory only grows with the number of chunks or blocks.
+ *
+ * @tparam  Real    Real type
+ * @tparam  Vector3 3-Vector type
+ */
+template< typename Real, typename Vector3 >
+class MonteCarloCampaign
+{
+public:
+
+    //! Construct campaign.
+    /*!
+     * @param   aDispersion     Dispersion specification
+     * @param   aTargetPosition Target position
+     * @param   aTargetVelocity Target velocity
+     * @param   aFinalTime      Final time at which target state should be reached
+     * @param   aNumberOfSteps  Number of guidance steps per trajectory
+     */
+    MonteCarloCampaign( const MonteCarloDispersion< Real, Vector3 >& aDispersion,
+                        const Vector3& aTargetPosition,
+                        const Vector3& aTargetVelocity,
+                        const Real aFinalTime,
+                        const std::size_t aNumberOfSteps )
+        : dispersion( aDispersion ),
+          targetPosition( aTargetPosition ),
+          targetVelocity( aTargetVelocity ),
+          finalTime( aFinalTime ),
+          numberOfSteps( aNumberOfSteps )
+    { }
+
+    //! Simulate single trajectory.
+    /*!
+     * Simulates the trajectory with the given index. The result only depends on the seed and the
+     * trajectory index, such that any trajectory of a campaign can be reproduced in isolation.
+     *
+     * @param   seed            Seed of campaign
+     * @param   trajectoryIndex Index of trajectory
+     * @return                  Result of trajectory
+     */
+    MonteCarloTrajectoryResult< Real > simulateTrajectory( const std::uint64_t seed,
+                                                           const std::size_t trajectoryIndex ) const
+    {
+        CounterBasedRandomNumberGenerator< Real > generator( seed, trajectoryIndex );
+
+        Vector3 position = dispersion.initialPosition;
+        Vector3 velocity = dispersion.initialVelocity;
+        Vector3 gravitationalAcceleration = dispersion.gravitationalAcceleration;
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            position[ i ] = generator.generateNormal(
+                dispersion.initialPosition[ i ], dispersion.initialPositionStandardDeviation[ i ] );
+            velocity[ i ] = generator.generateNormal(
+                dispersion.initialVelocity[ i ], dispersion.initialVelocityStandardDeviation[ i ] );
+            gravitationalAcceleration[ i ] = generator.generateNormal(
+                dispersion.gravitationalAcceleration[ i ],
+                dispersion.gravitationalAccelerationStandardDeviation[ i ] );
+        }
+        const Real zeroEffortMissGain = generator.generateNormal(
+            dispersion.zeroEffortMissGain, dispersion.zeroEffortMissGainStandardDeviation );
+        const Real zeroEffortVelocityGain = generator.generateNormal(
+            dispersion.zeroEffortVelocityGain, dispersion.zeroEffortVelocityGainStandardDeviation );
+
+        OptimalGuidanceController< Real, Vector3 > controller( targetPosition,
+                                                               targetVelocity,
+                                                               dispersion.gravitationalAcceleration,
+                                                               finalTime,
+                                                               zeroEffortMissGain,
+                                                               zeroEffortVelocityGain );
+
+        const Real stepSize = finalTime / static_cast< Real >( numberOfSteps );
+        const Real halfStepSizeSquared = Real( 0.5 ) * stepSize * stepSize;
+        Vector3 measuredPosition = position;
+        Vector3 measuredVelocity = velocity;
+        Real deltaV = Real( 0.0 );
+
+        for ( std::size_t step = 0; step < numberOfSteps; ++step )
+        {
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                measuredPosition[ i ] = generator.generateNormal(
+                    position[ i ], dispersion.positionNoiseStandardDeviation[ i ] );
+                measuredVelocity[ i ] = generator.generateNormal(
+                    velocity[ i ], dispersion.velocityNoiseStandardDeviation[ i ] );
+            }
+
+            const Vector3& controlEffort = controller.computeControl(
+                static_cast< Real >( step ) * stepSize, measuredPosition, measuredVelocity );
+
+            Real controlEffortSquared = Real( 0.0 );
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                const Real acceleration = controlEffort[ i ] + gravitationalAcceleration[ i ];
+                position[ i ] += stepSize * velocity[ i ] + halfStepSizeSquared * acceleration;
+                velocity[ i ] += stepSize * acceleration;
+                controlEffortSquared += controlEffort[ i ] * controlEffort[ i ];
+            }
+            deltaV += stepSize * std::sqrt( controlEffortSquared );
+        }
+
+        Real positionMissSquared = Real( 0.0 );
+        Real velocityMissSquared = Real( 0.0 );
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            const Real positionMiss = position[ i ] - targetPosition[ i ];
+            const Real velocityMiss = velocity[ i ] - targetVelocity[ i ];
+            positionMissSquared += positionMiss * positionMiss;
+            velocityMissSquared += velocityMiss * velocityMiss;
+        }
+
+        MonteCarloTrajectoryResult< Real > result;
+        result.positionMiss = std::sqrt( positionMissSquared );
+        result.velocityMiss = std::sqrt( velocityMissSquared );
+        result.deltaV = deltaV;
+        return result;
+    }
+
+    //! Run campaign.
+    /*!
+     * Runs the campaign for the given number of trajectories in parallel and reduces the terminal
+     * miss and Delta-V statistics.
+     *
+     * @param   numberOfTrajectories Number of trajectories
+     * @param   seed                 Seed of campaign
+     * @param   numberOfThreads      Number of threads; if zero, the number of hardware threads is
+     *                               used (default=0)
+     * @param   chunkSize            Number of trajectories per chunk; if zero, one trajectory per
+     *                               chunk is used; in deterministic mode, it is rounded down to a
+     *                               whole number of blocks, with at least one block (default=64)
+     * @return                       Statistics of campaign
+     */
+    MonteCarloStatistics< Real > run( const std::size_t numberOfTrajectories,
+                                      const std::uint64_t seed,
+                                      const unsigned int numberOfThreads = 0,
+                                      std::size_t chunkSize = 64 ) const
+    {
+        chunkSize = chunkSize > 0 ? chunkSize : 1;
+
+        // Partial statistics are accumulated per block of trajectories and merged in block order.
+        // In deterministic mode, the blocks have a fixed size, such that the statistics do not
+        // depend on the chunk size, and each chunk consists of one or more whole blocks.
+#if defined( CONTROL_ENABLE_DETERMINISTIC_MODE )
+        const std::size_t blockSize = monteCarloDeterministicBlockSize;
+#else
+        const std::size_t blockSize = chunkSize;
+#endif
+        const std::size_t blocksPerChunk = chunkSize > blockSize ? chunkSize / blockSize : 1;
+        const std::size_t numberOfBlocks = ( numberOfTrajectories + blockSize - 1 ) / blockSize;
+        const std::size_t numberOfChunks = ( numberOfBlocks + blocksPerChunk - 1 ) / blocksPerChunk;
+        std::vector< MonteCarloStatistics< Real > > blockStatistics( numberOfBlocks );
+
+        parallelForChunks(
+            numberOfChunks,
+            numberOfThreads,
+            [ this, &blockStatistics, numberOfTrajectories, seed, blockSize, blocksPerChunk,
+              numberOfBlocks ]( std::size_t chunk )
+            {
+                const std::size_t endBlock = ( chunk + 1 ) * blocksPerChunk < numberOfBlocks
+                                             ? ( chunk + 1 ) * blocksPerChunk : numberOfBlocks;
+                for ( std::size_t block = chunk * blocksPerChunk; block < endBlock; ++block )
+                {
+                    const std::size_t begin = block * blockSize;
+                    const std::size_t end = begin + blockSize < numberOfTrajectories
+                                            ? begin + blockSize : numberOfTrajectories;
+                    // Statistics are accumulated locally and stored once, to avoid false sharing.
+                    MonteCarloStatistics< Real > statistics;
+                    for ( std::size_t i = begin; i < end; ++i )
+                    {
+                        statistics.add( simulateTrajectory( seed, i ) );
+                    }
+                    blockStatistics[ block ] = statistics;
+                }
+            } );
+
+        MonteCarloStatistics< Real > statistics;
+        for ( std::size_t i = 0; i < numberOfBlocks; ++i )
+        {
+            statistics.merge( blockStatistics[ i ] );
+        }
+        return statistics;
+    }
+
+private:
+
+    //! Dispersion specification.
+    MonteCarloDispersion< Real, Vector3 > dispersion;
+
+    //! Target position.
+    Vector3 targetPosition;
+
+    //! Target velocity.
+    Vector3 targetVelocity;
+
+    //! Final time at which target state should be reached.
+    Real finalTime;
+
+    //! Number of guidance steps per trajectory.
+    std::size_t numberOfSteps;
+};
+
+} // namespace control
+
+#endif // CONTROL_MONTE_CARLO_CAMPAIGN_HPP
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_OPTIMAL_GUIDANCE_CONTROLLER_HPP
+#define CONTROL_OPTIMAL_GUIDANCE_CONTROLLER_HPP
+
+#include "control/instrumentation.hpp"
+#include "control/optimalGuidanceLaw.hpp"
+
+namespace control
+{
+
+//! Closed-loop Optimal Guidance Law (OGL) controller for constant gravity.
+/*!
+ * Closed-loop controller that computes the control authority based on the OGL, for a vehicle
+ * under the influence of a constant gravitational acceleration. The controller owns the target
+ * state, the gravitational acceleration and the final time, and updates the Zero-Effort-Miss (ZEM)
+ * and Zero-Effort-Velocity (ZEV) vectors from the current state at each call, using the
+ * closed-form ballistic solution for constant gravity:
+ *
+ * \f[
+ *      \vec{\text{ZEM}}(t) = \vec{r}_{f} - \left( \vec{r} + \vec{v} t_{\text{go}}
+ *                              + \frac{1}{2} \vec{g} t_{\text{go}}^{2} \right)
+ * \f]
+ *
+ * \f[
+ *      \vec{\text{ZEV}}(t) = \vec{v}_{f} - \left( \vec{v} + \vec{g} t_{\text{go}} \right)
+ * \f]
+ *
+ * where \f$\vec{r}_{f}\f$ and \f$\vec{v}_{f}\f$ are the target position and velocity,
+ * \f$\vec{r}\f$ and \f$\vec{v}\f$ are the current position and velocity, \f$\vec{g}\f$ is the
+ * gravitational acceleration and \f$t_{\text{go}} = t_{f} - t\f$ is the Time-To-Go (TTG).
+ *
+ * All intermediate vectors are stored as members, such that no memory is allocated when computing
+ * the control authority.
+ *
+ * @sa computeOptimalGuidanceLaw( )
+ * @tparam  Real    Real type
+ * @tparam  Vector3 3-Vector type
+ */
+template< typename Real, typename Vector3 >
+class OptimalGuidanceController
+{
+public:
+
+    //! Construct controller.
+    /*!
+     * Constructs controller for given target state, gravitational acceleration and final time.
+     *
+     * @param   aTargetPosition             Target position
+     * @param   aTargetVelocity             Target velocity
+     * @param   aGravitationalAcceleration  Constant gravitational acceleration
+     * @param   aFinalTime                  Final time at which target state should be reached
+     * @param   aZeroEffortMissGain         Control gain for ZEM term (default=6.0)
+     * @param   aZeroEffortVelocityGain     Control gain for ZEV term (default=-2.0)
+     */
+    OptimalGuidanceController( const Vector3& aTargetPosition,
+                               const Vector3& aTargetVelocity,
+                               const Vector3& aGravitationalAcceleration,
+                               const Real aFinalTime,
+                               const Real aZeroEffortMissGain = Real( 6.0 ),
+                               const Real aZeroEffortVelocityGain = Real( -2.0 ) )
+        : targetPosition( aTargetPosition ),
+          targetVelocity( aTargetVelocity ),
+          gravitationalAcceleration( aGravitationalAcceleration ),
+          finalTime( aFinalTime ),
+          zeroEffortMissGain( aZeroEffortMissGain ),
+          zeroEffortVelocityGain( aZeroEffortVelocityGain ),
+          timeToGo( aFinalTime ),
+          zeroEffortMiss( aTargetPosition ),
+          zeroEffortVelocity( aTargetVelocity ),
+          controlEffort( aTargetPosition )
+    { }
+
+    //! Compute control authority.
+    /*!
+     * Computes the control authority for the given current time and state, by updating the ZEM
+     * and ZEV vectors and evaluating the OGL. The current time must be strictly less than the
+     * final time.
+     *
+     * @param   currentTime Current time
+     * @param   position    Current position
+     * @param   velocity    Current velocity
+     * @return              Computed control authority
+     */
+    const Vector3& computeControl( const Real currentTime,
+                                   const Vector3& position,
+                                   const Vector3& velocity )
+    {
+        CONTROL_INSTRUMENT_SCOPE( optimalGuidanceControllerProbe );
+
+        timeToGo = finalTime - currentTime;
+        const Real halfTimeToGoSquared = Real( 0.5 ) * timeToGo * timeToGo;
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            zeroEffortMiss[ i ] = targetPosition[ i ]
+                                  - halfTimeToGoSquared * gravitationalAcceleration[ i ]
+                                  - position[ i ] - timeToGo * velocity[ i ];
+            zeroEffortVelocity[ i ] = targetVelocity[ i ]
+                                      - timeToGo * gravitationalAcceleration[ i ]
+                                      - velocity[ i ];
+        }
+
+        computeOptimalGuidanceLaw( zeroEffortMiss,
+                                   zeroEffortVelocity,
+                                   timeToGo,
+                                   controlEffort,
+                                   zeroEffortMissGain,
+                                   zeroEffortVelocityGain );
+        return controlEffort;
+    }
+
+    //! Set final time.
+    /*!
+     * Sets final time at which target state should be reached, e.g., to update the final time
+     * based on a time-to-go solver.
+     *
+     * @param   aFinalTime Final time
+     */
+    void setFinalTime( const Real aFinalTime ) { finalTime = aFinalTime; }
+
+    //! Get final time.
+    /*!
+     * @return Final time at which target state should be reached
+     */
+    Real getFinalTime( ) const { return finalTime; }
+
+    //! Get TTG computed at last call to computeControl( ).
+    /*!
+     * @return TTG
+     */
+    Real getTimeToGo( ) const { return timeToGo; }
+
+    //! Get ZEM vector computed at last call to computeControl( ).
+    /*!
+     * @return ZEM vector
+     */
+    const Vector3& getZeroEffortMiss( ) const { return zeroEffortMiss; }
+
+    //! Get ZEV vector computed at last call to computeControl( ).
+    /*!
+     * @return ZEV vector
+     */
+    const Vector3& getZeroEffortVelocity( ) const { return zeroEffortVelocity; }
+
+private:
+
+    //! Target position.
+    Vector3 targetPosition;
+
+    //! Target velocity.
+    Vector3 targetVelocity;
+
+    //! Constant gravitational acceleration.
+    Vector3 gravitationalAcceleration;
+
+    //! Final time at which target state should be reached.
+    Real finalTime;
+
+    //! Control gain for ZEM term.
+    Real zeroEffortMissGain;
+
+    //! Control gain for ZEV term.
+    Real zeroEffortVelocityGain;
+
+    //! TTG computed at last call to computeControl( ).
+    Real timeToGo;
+
+    //! ZEM vector computed at last call to computeControl( ).
+    Vector3 zeroEffortMiss;
+
+    //! ZEV vector computed at last call to computeControl( ).
+    Vector3 zeroEffortVelocity;
+
+    //! Control authority computed at last call to computeControl( ).
+    Vector3 controlEffort;
+};
+
+} // namespace control
+
+#endif // CONTROL_OPTIMAL_GUIDANCE_CONTROLLER_HPP
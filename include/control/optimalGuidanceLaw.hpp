@@ -7,9 +7,232 @@
 #ifndef CONTROL_OPTIMAL_GUIDANCE_LAW_HPP
 #define CONTROL_OPTIMAL_GUIDANCE_LAW_HPP
 
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+#include "control/hostDevice.hpp"
+#include "control/instrumentation.hpp"
+#include "control/optimalGuidanceLawSimd.hpp"
+#include "control/vectorTraits.hpp"
+
 namespace control
 {
 
+//! Compute premultiplier of ZEM term for Optimal Guidance Law (OGL).
+/*!
+ * Computes the premultiplier of the ZEM term of the OGL, i.e., \f$k_{r}/t_{\text{go}}^{2}\f$.
+ * This function can be evaluated at compile-time.
+ *
+ * @sa computeOptimalGuidanceLaw( )
+ * @tparam  Real                   Real type
+ * @param   timeToGo               TTG to reach target
+ * @param   zeroEffortMissGain     Control gain for ZEM term (default=6.0)
+ * @return                         Premultiplier of ZEM term
+ */
+template< typename Real >
+CONTROL_HOST_DEVICE
+constexpr Real computeZeroEffortMissPremultiplier( const Real timeToGo,
+                                                   const Real zeroEffortMissGain = Real( 6.0 ) )
+{
+    return zeroEffortMissGain / ( timeToGo * timeToGo );
+}
+
+//! Compute premultiplier of ZEV term for Optimal Guidance Law (OGL).
+/*!
+ * Computes the premultiplier of the ZEV term of the OGL, i.e., \f$k_{v}/t_{\text{go}}\f$. This
+ * function can be evaluated at compile-time.
+ *
+ * @sa computeOptimalGuidanceLaw( )
+ * @tparam  Real                   Real type
+ * @param   timeToGo               TTG to reach target
+ * @param   zeroEffortVelocityGain Control gain for ZEV term (default=-2.0)
+ * @return                         Premultiplier of ZEV term
+ */
+template< typename Real >
+CONTROL_HOST_DEVICE
+constexpr Real computeZeroEffortVelocityPremultiplier(
+    const Real timeToGo, const Real zeroEffortVelocityGain = Real( -2.0 ) )
+{
+    return zeroEffortVelocityGain / timeToGo;
+}
+
+//! Compute premultiplier of ZEM term for Optimal Guidance Law (OGL) in terminal phase.
+/*!
+ * Computes the premultiplier of the ZEM term of the OGL with terminal-phase handling, i.e.,
+ * \f$w k_{r}/\max(t_{\text{go}}, t_{\text{go},\min})^{2}\f$, with the weight
+ * \f$w = \min(\max(t_{\text{go}}/t_{\text{go},\min}, 0), 1)\f$. This function can be evaluated
+ * at compile-time.
+ *
+ * @sa computeTerminalOptimalGuidanceLaw( )
+ * @tparam  Real                   Real type
+ * @param   timeToGo               TTG to reach target
+ * @param   minimumTimeToGo        TTG floor of terminal phase, which must be strictly positive
+ * @param   zeroEffortMissGain     Control gain for ZEM term (default=6.0)
+ * @return                         Premultiplier of ZEM term
+ */
+template< typename Real >
+CONTROL_HOST_DEVICE
+constexpr Real computeTerminalZeroEffortMissPremultiplier(
+    const Real timeToGo, const Real minimumTimeToGo, const Real zeroEffortMissGain = Real( 6.0 ) )
+{
+    return computeZeroEffortMissPremultiplier(
+               timeToGo > minimumTimeToGo ? timeToGo : minimumTimeToGo, zeroEffortMissGain )
+           * detail::computeTerminalZeroEffortMissWeight( timeToGo,
+                                                          Real( 1.0 ) / minimumTimeToGo );
+}
+
+//! Compute premultiplier of ZEV term for Optimal Guidance Law (OGL) in terminal phase.
+/*!
+ * Computes the premultiplier of the ZEV term of the OGL with terminal-phase handling, i.e.,
+ * \f$k_{v}/\max(t_{\text{go}}, t_{\text{go},\min})\f$. This function can be evaluated at
+ * compile-time.
+ *
+ * @sa computeTerminalOptimalGuidanceLaw( )
+ * @tparam  Real                   Real type
+ * @param   timeToGo               TTG to reach target
+ * @param   minimumTimeToGo        TTG floor of terminal phase, which must be strictly positive
+ * @param   zeroEffortVelocityGain Control gain for ZEV term (default=-2.0)
+ * @return                         Premultiplier of ZEV term
+ */
+template< typename Real >
+CONTROL_HOST_DEVICE
+constexpr Real computeTerminalZeroEffortVelocityPremultiplier(
+    const Real timeToGo,
+    const Real minimumTimeToGo,
+    const Real zeroEffortVelocityGain = Real( -2.0 ) )
+{
+    return computeZeroEffortVelocityPremultiplier(
+        timeToGo > minimumTimeToGo ? timeToGo : minimumTimeToGo, zeroEffortVelocityGain );
+}
+
+namespace detail
+{
+
+//! Apply premultipliers of OGL to compute control authority in place for generic 3-vector types.
+/*!
+ * @sa computeOptimalGuidanceLaw( )
+ */
+template< typename Real, typename Vector3 >
+CONTROL_HOST_DEVICE
+inline void applyOptimalGuidanceLawPremultipliers( const Vector3& zeroEffortMiss,
+                                                   const Vector3& zeroEffortVelocity,
+                                                   const Real zeroEffortMissPremultiplier,
+                                                   const Real zeroEffortVelocityPremultiplier,
+                                                   Vector3& controlEffort,
+                                                   std::false_type )
+{
+    typedef typename VectorElement< Vector3 >::Type Element;
+
+    controlEffort[ 0 ] = static_cast< Element >(
+        zeroEffortMissPremultiplier * static_cast< Real >( zeroEffortMiss[ 0 ] )
+        + zeroEffortVelocityPremultiplier * static_cast< Real >( zeroEffortVelocity[ 0 ] ) );
+    controlEffort[ 1 ] = static_cast< Element >(
+        zeroEffortMissPremultiplier * static_cast< Real >( zeroEffortMiss[ 1 ] )
+        + zeroEffortVelocityPremultiplier * static_cast< Real >( zeroEffortVelocity[ 1 ] ) );
+    controlEffort[ 2 ] = static_cast< Element >(
+        zeroEffortMissPremultiplier * static_cast< Real >( zeroEffortMiss[ 2 ] )
+        + zeroEffortVelocityPremultiplier * static_cast< Real >( zeroEffortVelocity[ 2 ] ) );
+}
+
+//! Apply premultipliers of OGL to compute control authority in place for fixed-size 3-vectors.
+/*!
+ * All components are loaded into local variables before the output is written, such that the
+ * compiler does not have to account for aliasing between the input and output vectors and can keep
+ * all values in registers.
+ *
+ * @sa computeOptimalGuidanceLaw( )
+ */
+template< typename Real, typename Vector3 >
+CONTROL_HOST_DEVICE
+inline void applyOptimalGuidanceLawPremultipliers( const Vector3& zeroEffortMiss,
+                                                   const Vector3& zeroEffortVelocity,
+                                                   const Real zeroEffortMissPremultiplier,
+                                                   const Real zeroEffortVelocityPremultiplier,
+                                                   Vector3& controlEffort,
+                                                   std::true_type )
+{
+    typedef typename VectorElement< Vector3 >::Type Element;
+
+    const Real zeroEffortMissX     = static_cast< Real >( zeroEffortMiss[ 0 ] );
+    const Real zeroEffortMissY     = static_cast< Real >( zeroEffortMiss[ 1 ] );
+    const Real zeroEffortMissZ     = static_cast< Real >( zeroEffortMiss[ 2 ] );
+    const Real zeroEffortVelocityX = static_cast< Real >( zeroEffortVelocity[ 0 ] );
+    const Real zeroEffortVelocityY = static_cast< Real >( zeroEffortVelocity[ 1 ] );
+    const Real zeroEffortVelocityZ = static_cast< Real >( zeroEffortVelocity[ 2 ] );
+
+    controlEffort[ 0 ] = static_cast< Element >( zeroEffortMissPremultiplier * zeroEffortMissX
+                          + zeroEffortVelocityPremultiplier * zeroEffortVelocityX );
+    controlEffort[ 1 ] = static_cast< Element >( zeroEffortMissPremultiplier * zeroEffortMissY
+                          + zeroEffortVelocityPremultiplier * zeroEffortVelocityY );
+    controlEffort[ 2 ] = static_cast< Element >( zeroEffortMissPremultiplier * zeroEffortMissZ
+                          + zeroEffortVelocityPremultiplier * zeroEffortVelocityZ );
+}
+
+//! Create control authority vector for generic 3-vector types, by copying the ZEM vector.
+template< typename Vector3 >
+CONTROL_HOST_DEVICE
+inline Vector3 createControlEffort( const Vector3& zeroEffortMiss, std::false_type )
+{
+    return zeroEffortMiss;
+}
+
+//! Create control authority vector for fixed-size 3-vector types, without copying.
+template< typename Vector3 >
+CONTROL_HOST_DEVICE
+inline Vector3 createControlEffort( const Vector3&, std::true_type )
+{
+    return Vector3( );
+}
+
+} // namespace detail
+
+//! Compute control authority for Optimal Guidance Law (OGL) in place.
+/*!
+ * Computes the control authority based on the OGL and writes it to a caller-supplied output
+ * vector, which must already be of size 3. No memory is allocated, irrespective of the vector type
+ * used, so this function is suitable for use in hot loops with dynamic vector types, e.g.,
+ * std::vector. The output vector may be the same object as one of the input vectors.
+ *
+ * All arithmetic is carried out in the Real type, and the gains default to constants of the Real
+ * type, such that for Real = float with single-precision vectors no operation is promoted to
+ * double-precision. The element type of the vectors may differ from the Real type: e.g.,
+ * computeOptimalGuidanceLaw< double >( ... ) with single-precision vectors accumulates in
+ * double-precision and rounds the result to single-precision only when it is stored (mixed
+ * precision). Note that the Real type is otherwise deduced from the TTG argument, so a
+ * double-precision TTG selects double-precision arithmetic.
+ *
+ * @sa computeOptimalGuidanceLaw( )
+ * @tparam  Real                   Real type
+ * @tparam  Vector3                3-Vector type
+ * @param   zeroEffortMiss         Miss distance vector between target and computed final state
+ * @param   zeroEffortVelocity     Miss velocity vector between target and computed final state
+ * @param   timeToGo               TTG to reach target
+ * @param   controlEffort          Computed control authority
+ * @param   zeroEffortMissGain     Control gain for ZEM term (default=6.0)
+ * @param   zeroEffortVelocityGain Control gain for ZEV term (default=-2.0)
+ */
+template< typename Real, typename Vector3 >
+CONTROL_HOST_DEVICE
+void computeOptimalGuidanceLaw( const Vector3& zeroEffortMiss,
+                                const Vector3& zeroEffortVelocity,
+                                const Real timeToGo,
+                                Vector3& controlEffort,
+                                const Real zeroEffortMissGain = Real( 6.0 ),
+                                const Real zeroEffortVelocityGain = Real( -2.0 ) )
+{
+    CONTROL_INSTRUMENT_SCOPE( optimalGuidanceLawProbe );
+    CONTROL_INSTRUMENT_TIME_TO_GO( timeToGo );
+
+    detail::applyOptimalGuidanceLawPremultipliers(
+        zeroEffortMiss,
+        zeroEffortVelocity,
+        computeZeroEffortMissPremultiplier( timeToGo, zeroEffortMissGain ),
+        computeZeroEffortVelocityPremultiplier( timeToGo, zeroEffortVelocityGain ),
+        controlEffort,
+        IsFixedSizeVector3< Vector3 >( ) );
+}
+
 //! Compute control authority for Optimal Guidance Law (OGL).
 /*!
  * Computes the control authority based on the OGL (Ebrahimi et al., 2008; Furfaro et al., 2011;
@@ -28,6 +251,9 @@ namespace control
  * assumption of no further control authority from the current time (\f$t_{1}\f$) to the final time
  * (\f$t_{2}\f$), and \f$\vec{\text{ZEV}}(t)\f$ is similarly the Zero-Effort-Velocity vector.
  *
+ * Fixed-size 3-vector types (see IsFixedSizeVector3) are detected at compile-time and handled by a
+ * fully-inlined code path, which does not copy the ZEM vector to create the output vector.
+ *
  * @tparam  Real                   Real type
  * @tparam  Vector3                3-Vector type
  * @param   zeroEffortMiss         Miss distance vector between target and computed final state
@@ -39,25 +265,338 @@ namespace control
 
  */
 template< typename Real, typename Vector3 >
+CONTROL_HOST_DEVICE
 Vector3 computeOptimalGuidanceLaw( const Vector3& zeroEffortMiss,
                                    const Vector3& zeroEffortVelocity,
                                    const Real timeToGo,
-                                   const Real zeroEffortMissGain = 6.0,
-                                   const Real zeroEffortVelocityGain = -2.0 )
+                                   const Real zeroEffortMissGain = Real( 6.0 ),
+                                   const Real zeroEffortVelocityGain = Real( -2.0 ) )
 {
-    Vector3 controlEffort = zeroEffortMiss;
+    Vector3 controlEffort
+        = detail::createControlEffort( zeroEffortMiss, IsFixedSizeVector3< Vector3 >( ) );
+    computeOptimalGuidanceLaw( zeroEffortMiss,
+                               zeroEffortVelocity,
+                               timeToGo,
+                               controlEffort,
+                               zeroEffortMissGain,
+                               zeroEffortVelocityGain );
+    return controlEffort;
+}
 
-    const Real zeroEffortMissPremultiplier     = zeroEffortMissGain / ( timeToGo * timeToGo );
-    const Real zeroEffortVelocityPremultiplier = zeroEffortVelocityGain / timeToGo;
+//! Compute control authority for Optimal Guidance Law (OGL) at compile-time.
+/*!
+ * Computes the control authority based on the OGL for std::array 3-vectors. This overload can be
+ * evaluated in constant expressions, e.g., to compute gain schedules and verification tables at
+ * compile-time. In deterministic mode (see isDeterministicModeEnabled( )), the results are
+ * bit-identical to the run-time evaluation; otherwise, the run-time evaluation may be contracted
+ * into fused multiply-add instructions, such that the results can differ in the last bits:
+ *
+ * \code
+ *  constexpr std::array< double, 3 > controlEffort
+ *      = control::computeOptimalGuidanceLaw( zeroEffortMiss, zeroEffortVelocity, 12.516 );
+ * \endcode
+ *
+ * @sa computeOptimalGuidanceLaw( )
+ * @tparam  Real                   Real type
+ * @param   zeroEffortMiss         Miss distance vector between target and computed final state
+ * @param   zeroEffortVelocity     Miss velocity vector between target and computed final state
+ * @param   timeToGo               TTG to reach target
+ * @param   zeroEffortMissGain     Control gain for ZEM term (default=6.0)
+ * @param   zeroEffortVelocityGain Control gain for ZEV term (default=-2.0)
+ * @return                         Computed control authority
+ */
+template< typename Real >
+CONTROL_HOST_DEVICE
+constexpr std::array< Real, 3 > computeOptimalGuidanceLaw(
+    const std::array< Real, 3 >& zeroEffortMiss,
+    const std::array< Real, 3 >& zeroEffortVelocity,
+    const Real timeToGo,
+    const Real zeroEffortMissGain = Real( 6.0 ),
+    const Real zeroEffortVelocityGain = Real( -2.0 ) )
+{
+    const Real zeroEffortMissPremultiplier
+        = computeZeroEffortMissPremultiplier( timeToGo, zeroEffortMissGain );
+    const Real zeroEffortVelocityPremultiplier
+        = computeZeroEffortVelocityPremultiplier( timeToGo, zeroEffortVelocityGain );
 
-    controlEffort[ 0 ] = zeroEffortMissPremultiplier * zeroEffortMiss[ 0 ]
-                        + zeroEffortVelocityPremultiplier * zeroEffortVelocity[ 0 ];
-    controlEffort[ 1 ] = zeroEffortMissPremultiplier * zeroEffortMiss[ 1 ]
-                        + zeroEffortVelocityPremultiplier * zeroEffortVelocity[ 1 ];
-    controlEffort[ 2 ] = zeroEffortMissPremultiplier * zeroEffortMiss[ 2 ]
-                        + zeroEffortVelocityPremultiplier * zeroEffortVelocity[ 2 ];
+    return { { zeroEffortMissPremultiplier * zeroEffortMiss[ 0 ]
+                + zeroEffortVelocityPremultiplier * zeroEffortVelocity[ 0 ],
+               zeroEffortMissPremultiplier * zeroEffortMiss[ 1 ]
+                + zeroEffortVelocityPremultiplier * zeroEffortVelocity[ 1 ],
+               zeroEffortMissPremultiplier * zeroEffortMiss[ 2 ]
+                + zeroEffortVelocityPremultiplier * zeroEffortVelocity[ 2 ] } };
+}
 
-    return controlEffort;
+//! Compute control authority for Optimal Guidance Law (OGL) for a batch of samples.
+/*!
+ * Computes the control authority based on the OGL for a batch of samples stored in
+ * structure-of-arrays (SoA) form, i.e., the x-, y- and z-components of the ZEM, ZEV and control
+ * authority vectors are stored in separate, contiguous arrays. The control authority for each
+ * sample is computed per the single-sample computeOptimalGuidanceLaw( ) function, and is written
+ * to caller-owned output arrays, such that no memory is allocated.
+ *
+ * Since each sample is evaluated independently, this layout allows the compiler to vectorize the
+ * premultiplier computations and the multiply-adds across samples instead of across the three
+ * vector components. The output arrays may alias the corresponding input arrays to compute the
+ * control authority in place.
+ *
+ * For single- and double-precision, a hand-vectorized kernel is selected at runtime based on the
+ * SIMD instruction set supported by the host CPU (AVX-512, AVX2 or NEON; see simd.hpp). These
+ * kernels compute the reciprocal of the TTG once per sample and reuse it for both premultipliers,
+ * so the results can differ from the single-sample function in the last bits. The scalar kernel,
+ * used for all other real types or by calling setSimdInstructionSet( scalarInstructionSet ),
+ * evaluates the single-sample function; it is only guaranteed to be bit-identical to it in
+ * deterministic mode, since the compiler may contract each call site differently otherwise.
+ *
+ * @sa computeOptimalGuidanceLaw( )
+ * @tparam  Real                   Real type
+ * @param   zeroEffortMissX        Array of x-components of ZEM vectors
+ * @param   zeroEffortMissY        Array of y-components of ZEM vectors
+ * @param   zeroEffortMissZ        Array of z-components of ZEM vectors
+ * @param   zeroEffortVelocityX    Array of x-components of ZEV vectors
+ * @param   zeroEffortVelocityY    Array of y-components of ZEV vectors
+ * @param   zeroEffortVelocityZ    Array of z-components of ZEV vectors
+ * @param   timeToGo               Array of TTGs to reach target
+ * @param   numberOfSamples        Number of samples, i.e., length of all input & output arrays
+ * @param   controlEffortX         Array of x-components of computed control authority
+ * @param   controlEffortY         Array of y-components of computed control authority
+ * @param   controlEffortZ         Array of z-components of computed control authority
+ * @param   zeroEffortMissGain     Control gain for ZEM term, shared by all samples (default=6.0)
+ * @param   zeroEffortVelocityGain Control gain for ZEV term, shared by all samples (default=-2.0)
+ */
+template< typename Real >
+void computeOptimalGuidanceLaw( const Real* zeroEffortMissX,
+                                const Real* zeroEffortMissY,
+                                const Real* zeroEffortMissZ,
+                                const Real* zeroEffortVelocityX,
+                                const Real* zeroEffortVelocityY,
+                                const Real* zeroEffortVelocityZ,
+                                const Real* timeToGo,
+                                const std::size_t numberOfSamples,
+                                Real* controlEffortX,
+                                Real* controlEffortY,
+                                Real* controlEffortZ,
+                                const Real zeroEffortMissGain = Real( 6.0 ),
+                                const Real zeroEffortVelocityGain = Real( -2.0 ) )
+{
+    CONTROL_INSTRUMENT_SCOPE( batchedOptimalGuidanceLawProbe );
+    CONTROL_INSTRUMENT_TIME_TO_GO( timeToGo, numberOfSamples );
+
+    detail::BatchedOptimalGuidanceLawDispatcher< Real >::template evaluate< false, false >(
+        zeroEffortMissX, zeroEffortMissY, zeroEffortMissZ,
+        zeroEffortVelocityX, zeroEffortVelocityY, zeroEffortVelocityZ,
+        timeToGo, numberOfSamples,
+        controlEffortX, controlEffortY, controlEffortZ,
+        &zeroEffortMissGain, &zeroEffortVelocityGain, Real( 0.0 ) );
+}
+
+//! Compute control authority for Optimal Guidance Law (OGL) for a batch of samples.
+/*!
+ * Computes the control authority based on the OGL for a batch of samples stored in
+ * structure-of-arrays (SoA) form, with gains specified per sample. Kernel selection is the same
+ * as for the batched function with gains shared by all samples.
+ *
+ * @sa computeOptimalGuidanceLaw( )
+ * @tparam  Real                   Real type
+ * @param   zeroEffortMissX        Array of x-components of ZEM vectors
+ * @param   zeroEffortMissY        Array of y-components of ZEM vectors
+ * @param   zeroEffortMissZ        Array of z-components of ZEM vectors
+ * @param   zeroEffortVelocityX    Array of x-components of ZEV vectors
+ * @param   zeroEffortVelocityY    Array of y-components of ZEV vectors
+ * @param   zeroEffortVelocityZ    Array of z-components of ZEV vectors
+ * @param   timeToGo               Array of TTGs to reach target
+ * @param   numberOfSamples        Number of samples, i.e., length of all input & output arrays
+ * @param   controlEffortX         Array of x-components of computed control authority
+ * @param   controlEffortY         Array of y-components of computed control authority
+ * @param   controlEffortZ         Array of z-components of computed control authority
+ * @param   zeroEffortMissGain     Array of control gains for ZEM term
+ * @param   zeroEffortVelocityGain Array of control gains for ZEV term
+ */
+template< typename Real >
+void computeOptimalGuidanceLaw( const Real* zeroEffortMissX,
+                                const Real* zeroEffortMissY,
+                                const Real* zeroEffortMissZ,
+                                const Real* zeroEffortVelocityX,
+                                const Real* zeroEffortVelocityY,
+                                const Real* zeroEffortVelocityZ,
+                                const Real* timeToGo,
+                                const std::size_t numberOfSamples,
+                                Real* controlEffortX,
+                                Real* controlEffortY,
+                                Real* controlEffortZ,
+                                const Real* zeroEffortMissGain,
+                                const Real* zeroEffortVelocityGain )
+{
+    CONTROL_INSTRUMENT_SCOPE( batchedOptimalGuidanceLawProbe );
+    CONTROL_INSTRUMENT_TIME_TO_GO( timeToGo, numberOfSamples );
+
+    detail::BatchedOptimalGuidanceLawDispatcher< Real >::template evaluate< true, false >(
+        zeroEffortMissX, zeroEffortMissY, zeroEffortMissZ,
+        zeroEffortVelocityX, zeroEffortVelocityY, zeroEffortVelocityZ,
+        timeToGo, numberOfSamples,
+        controlEffortX, controlEffortY, controlEffortZ,
+        zeroEffortMissGain, zeroEffortVelocityGain, Real( 0.0 ) );
+}
+
+//! Compute control authority for Optimal Guidance Law (OGL) with terminal-phase handling in place.
+/*!
+ * Computes the control authority based on the OGL, with numerically safe handling of the terminal
+ * phase, in which the TTG drops below the given TTG floor \f$t_{\text{go},\min}\f$:
+ *
+ * \f[
+ *      u(t) = w \frac{k_{r}}{\tilde{t}_{\text{go}}^{2}} \vec{\text{ZEM}}(t)
+ *              + \frac{k_{v}}{\tilde{t}_{\text{go}}} \vec{\text{ZEV}}(t),
+ *      \quad \tilde{t}_{\text{go}} = \max(t_{\text{go}}, t_{\text{go},\min}),
+ *      \quad w = \min(\max(t_{\text{go}}/t_{\text{go},\min}, 0), 1)
+ * \f]
+ *
+ * Above the TTG floor, this is the OGL (in deterministic mode, the result is bit-identical to
+ * computeOptimalGuidanceLaw( ) whenever \f$t_{\text{go}}/t_{\text{go},\min} \geq 1\f$ in
+ * floating-point). Below the floor,
+ * the ZEM term is blended out linearly, such that the law reduces to a ZEV-only velocity-hold law
+ * at and beyond the final time, and the control authority remains bounded as the TTG approaches
+ * zero or becomes negative. The floor and the weight are computed with selects only, so that the
+ * function does not branch on the TTG.
+ *
+ * @sa computeOptimalGuidanceLaw( )
+ * @tparam  Real                   Real type
+ * @tparam  Vector3                3-Vector type
+ * @param   zeroEffortMiss         Miss distance vector between target and computed final state
+ * @param   zeroEffortVelocity     Miss velocity vector between target and computed final state
+ * @param   timeToGo               TTG to reach target
+ * @param   minimumTimeToGo        TTG floor of terminal phase, which must be strictly positive
+ * @param   controlEffort          Computed control authority
+ * @param   zeroEffortMissGain     Control gain for ZEM term (default=6.0)
+ * @param   zeroEffortVelocityGain Control gain for ZEV term (default=-2.0)
+ */
+template< typename Real, typename Vector3 >
+CONTROL_HOST_DEVICE
+void computeTerminalOptimalGuidanceLaw( const Vector3& zeroEffortMiss,
+                                        const Vector3& zeroEffortVelocity,
+                                        const Real timeToGo,
+                                        const Real minimumTimeToGo,
+                                        Vector3& controlEffort,
+                                        const Real zeroEffortMissGain = Real( 6.0 ),
+                                        const Real zeroEffortVelocityGain = Real( -2.0 ) )
+{
+    CONTROL_INSTRUMENT_SCOPE( optimalGuidanceLawProbe );
+    CONTROL_INSTRUMENT_TIME_TO_GO( timeToGo );
+
+    detail::applyOptimalGuidanceLawPremultipliers(
+        zeroEffortMiss,
+        zeroEffortVelocity,
+        computeTerminalZeroEffortMissPremultiplier( timeToGo,
+                                                    minimumTimeToGo,
+                                                    zeroEffortMissGain ),
+        computeTerminalZeroEffortVelocityPremultiplier( timeToGo,
+                                                        minimumTimeToGo,
+                                                        zeroEffortVelocityGain ),
+        controlEffort,
+        IsFixedSizeVector3< Vector3 >( ) );
+}
+
+//! Compute control authority for OGL with terminal-phase handling for a batch of samples.
+/*!
+ * Computes the control authority based on the OGL with terminal-phase handling (see the
+ * single-sample computeTerminalOptimalGuidanceLaw( ) function) for a batch of samples stored in
+ * structure-of-arrays (SoA) form. Kernel selection is the same as for the batched
+ * computeOptimalGuidanceLaw( ) function: the SIMD kernels apply the TTG floor and the weight of
+ * the ZEM term with packed minimum and maximum instructions, so samples in the terminal phase do
+ * not cause branches, and the common case only costs three additional packed operations per
+ * sample. As for computeOptimalGuidanceLaw( ), the scalar kernel is only guaranteed to be
+ * bit-identical to the single-sample function in deterministic mode.
+ *
+ * @sa computeOptimalGuidanceLaw( ), computeTerminalOptimalGuidanceLaw( )
+ * @tparam  Real                   Real type
+ * @param   zeroEffortMissX        Array of x-components of ZEM vectors
+ * @param   zeroEffortMissY        Array of y-components of ZEM vectors
+ * @param   zeroEffortMissZ        Array of z-components of ZEM vectors
+ * @param   zeroEffortVelocityX    Array of x-components of ZEV vectors
+ * @param   zeroEffortVelocityY    Array of y-components of ZEV vectors
+ * @param   zeroEffortVelocityZ    Array of z-components of ZEV vectors
+ * @param   timeToGo               Array of TTGs to reach target
+ * @param   numberOfSamples        Number of samples, i.e., length of all input & output arrays
+ * @param   minimumTimeToGo        TTG floor of terminal phase, which must be strictly positive
+ * @param   controlEffortX         Array of x-components of computed control authority
+ * @param   controlEffortY         Array of y-components of computed control authority
+ * @param   controlEffortZ         Array of z-components of computed control authority
+ * @param   zeroEffortMissGain     Control gain for ZEM term, shared by all samples (default=6.0)
+ * @param   zeroEffortVelocityGain Control gain for ZEV term, shared by all samples (default=-2.0)
+ */
+template< typename Real >
+void computeTerminalOptimalGuidanceLaw( const Real* zeroEffortMissX,
+                                        const Real* zeroEffortMissY,
+                                        const Real* zeroEffortMissZ,
+                                        const Real* zeroEffortVelocityX,
+                                        const Real* zeroEffortVelocityY,
+                                        const Real* zeroEffortVelocityZ,
+                                        const Real* timeToGo,
+                                        const std::size_t numberOfSamples,
+                                        const Real minimumTimeToGo,
+                                        Real* controlEffortX,
+                                        Real* controlEffortY,
+                                        Real* controlEffortZ,
+                                        const Real zeroEffortMissGain = Real( 6.0 ),
+                                        const Real zeroEffortVelocityGain = Real( -2.0 ) )
+{
+    CONTROL_INSTRUMENT_SCOPE( batchedOptimalGuidanceLawProbe );
+    CONTROL_INSTRUMENT_TIME_TO_GO( timeToGo, numberOfSamples );
+
+    detail::BatchedOptimalGuidanceLawDispatcher< Real >::template evaluate< false, true >(
+        zeroEffortMissX, zeroEffortMissY, zeroEffortMissZ,
+        zeroEffortVelocityX, zeroEffortVelocityY, zeroEffortVelocityZ,
+        timeToGo, numberOfSamples,
+        controlEffortX, controlEffortY, controlEffortZ,
+        &zeroEffortMissGain, &zeroEffortVelocityGain, minimumTimeToGo );
+}
+
+//! Compute control authority for OGL with terminal-phase handling for a batch of samples.
+/*!
+ * Computes the control authority based on the OGL with terminal-phase handling for a batch of
+ * samples stored in structure-of-arrays (SoA) form, with gains specified per sample.
+ *
+ * @sa computeTerminalOptimalGuidanceLaw( )
+ * @tparam  Real                   Real type
+ * @param   zeroEffortMissX        Array of x-components of ZEM vectors
+ * @param   zeroEffortMissY        Array of y-components of ZEM vectors
+ * @param   zeroEffortMissZ        Array of z-components of ZEM vectors
+ * @param   zeroEffortVelocityX    Array of x-components of ZEV vectors
+ * @param   zeroEffortVelocityY    Array of y-components of ZEV vectors
+ * @param   zeroEffortVelocityZ    Array of z-components of ZEV vectors
+ * @param   timeToGo               Array of TTGs to reach target
+ * @param   numberOfSamples        Number of samples, i.e., length of all input & output arrays
+ * @param   minimumTimeToGo        TTG floor of terminal phase, which must be strictly positive
+ * @param   controlEffortX         Array of x-components of computed control authority
+ * @param   controlEffortY         Array of y-components of computed control authority
+ * @param   controlEffortZ         Array of z-components of computed control authority
+ * @param   zeroEffortMissGain     Array of control gains for ZEM term
+ * @param   zeroEffortVelocityGain Array of control gains for ZEV term
+ */
+template< typename Real >
+void computeTerminalOptimalGuidanceLaw( const Real* zeroEffortMissX,
+                                        const Real* zeroEffortMissY,
+                                        const Real* zeroEffortMissZ,
+                                        const Real* zeroEffortVelocityX,
+                                        const Real* zeroEffortVelocityY,
+                                        const Real* zeroEffortVelocityZ,
+                                        const Real* timeToGo,
+                                        const std::size_t numberOfSamples,
+                                        const Real minimumTimeToGo,
+                                        Real* controlEffortX,
+                                        Real* controlEffortY,
+                                        Real* controlEffortZ,
+                                        const Real* zeroEffortMissGain,
+                                        const Real* zeroEffortVelocityGain )
+{
+    CONTROL_INSTRUMENT_SCOPE( batchedOptimalGuidanceLawProbe );
+    CONTROL_INSTRUMENT_TIME_TO_GO( timeToGo, numberOfSamples );
+
+    detail::BatchedOptimalGuidanceLawDispatcher< Real >::template evaluate< true, true >(
+        zeroEffortMissX, zeroEffortMissY, zeroEffortMissZ,
+        zeroEffortVelocityX, zeroEffortVelocityY, zeroEffortVelocityZ,
+        timeToGo, numberOfSamples,
+        controlEffortX, controlEffortY, controlEffortZ,
+        zeroEffortMissGain, zeroEffortVelocityGain, minimumTimeToGo );
 }
 
 } // namespace control
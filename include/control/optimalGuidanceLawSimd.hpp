@@ -0,0 +1,885 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_OPTIMAL_GUIDANCE_LAW_SIMD_HPP
+#define CONTROL_OPTIMAL_GUIDANCE_LAW_SIMD_HPP
+
+#include <cstddef>
+
+#include "control/hostDevice.hpp"
+#include "control/simd.hpp"
+
+namespace control
+{
+namespace detail
+{
+
+//! Compute weight of ZEM term of OGL in terminal phase.
+/*!
+ * Computes the weight of the ZEM term of the OGL in the terminal phase, i.e.,
+ * \f$\min(\max(t_{\text{go}}/t_{\text{go},\min}, 0), 1)\f$, using selects only. This function can
+ * be evaluated at compile-time.
+ *
+ * @tparam  Real                   Real type
+ * @param   timeToGo               TTG to reach target
+ * @param   inverseMinimumTimeToGo Inverse of TTG floor of terminal phase
+ * @return                         Weight of ZEM term
+ */
+template< typename Real >
+CONTROL_HOST_DEVICE
+constexpr Real computeTerminalZeroEffortMissWeight( const Real timeToGo,
+                                                    const Real inverseMinimumTimeToGo )
+{
+    return timeToGo * inverseMinimumTimeToGo > Real( 1.0 )
+           ? Real( 1.0 )
+           : ( timeToGo * inverseMinimumTimeToGo > Real( 0.0 )
+               ? timeToGo * inverseMinimumTimeToGo : Real( 0.0 ) );
+}
+
+//! Compute control authority for OGL for a batch of samples using scalar instructions.
+/*!
+ * Computes the control authority based on the OGL for a batch of samples stored in SoA form. This
+ * is the scalar reference kernel, which evaluates the single-sample computeOptimalGuidanceLaw( )
+ * function per sample; in deterministic mode, the results are bit-identical to it.
+ *
+ * @tparam  Real                   Real type
+ * @tparam  PerSampleGains         Flag indicating if gains are given per sample; if false, the
+ *                                 first element of the gain arrays is used for all samples
+ * @tparam  IsTerminalPhase        Flag indicating if terminal-phase handling is enabled (see
+ *                                 computeTerminalOptimalGuidanceLaw( ))
+ * @param   zeroEffortMissX        Array of x-components of ZEM vectors
+ * @param   zeroEffortMissY        Array of y-components of ZEM vectors
+ * @param   zeroEffortMissZ        Array of z-components of ZEM vectors
+ * @param   zeroEffortVelocityX    Array of x-components of ZEV vectors
+ * @param   zeroEffortVelocityY    Array of y-components of ZEV vectors
+ * @param   zeroEffortVelocityZ    Array of z-components of ZEV vectors
+ * @param   timeToGo               Array of TTGs to reach target
+ * @param   numberOfSamples        Number of samples
+ * @param   controlEffortX         Array of x-components of computed control authority
+ * @param   controlEffortY         Array of y-components of computed control authority
+ * @param   controlEffortZ         Array of z-components of computed control authority
+ * @param   zeroEffortMissGain     Array of control gains for ZEM term
+ * @param   zeroEffortVelocityGain Array of control gains for ZEV term
+ * @param   minimumTimeToGo        TTG floor of terminal phase; ignored if terminal-phase
+ *                                 handling is disabled
+ */
+template< typename Real, bool PerSampleGains, bool IsTerminalPhase >
+void computeBatchedOptimalGuidanceLawScalar( const Real* zeroEffortMissX,
+                                             const Real* zeroEffortMissY,
+                                             const Real* zeroEffortMissZ,
+                                             const Real* zeroEffortVelocityX,
+                                             const Real* zeroEffortVelocityY,
+                                             const Real* zeroEffortVelocityZ,
+                                             const Real* timeToGo,
+                                             const std::size_t numberOfSamples,
+                                             Real* controlEffortX,
+                                             Real* controlEffortY,
+                                             Real* controlEffortZ,
+                                             const Real* zeroEffortMissGain,
+                                             const Real* zeroEffortVelocityGain,
+                                             const Real minimumTimeToGo )
+{
+    const Real inverseMinimumTimeToGo
+        = IsTerminalPhase ? Real( 1.0 ) / minimumTimeToGo : Real( 1.0 );
+
+    for ( std::size_t i = 0; i < numberOfSamples; ++i )
+    {
+        const std::size_t gainIndex = PerSampleGains ? i : 0;
+
+        Real sampleTimeToGo = timeToGo[ i ];
+        Real zeroEffortMissWeight = Real( 1.0 );
+        if ( IsTerminalPhase )
+        {
+            zeroEffortMissWeight = computeTerminalZeroEffortMissWeight( sampleTimeToGo,
+                                                                        inverseMinimumTimeToGo );
+            sampleTimeToGo = sampleTimeToGo > minimumTimeToGo ? sampleTimeToGo : minimumTimeToGo;
+        }
+
+        Real zeroEffortMissPremultiplier
+            = zeroEffortMissGain[ gainIndex ] / ( sampleTimeToGo * sampleTimeToGo );
+        const Real zeroEffortVelocityPremultiplier
+            = zeroEffortVelocityGain[ gainIndex ] / sampleTimeToGo;
+        if ( IsTerminalPhase )
+        {
+            zeroEffortMissPremultiplier *= zeroEffortMissWeight;
+        }
+
+        controlEffortX[ i ] = zeroEffortMissPremultiplier * zeroEffortMissX[ i ]
+                              + zeroEffortVelocityPremultiplier * zeroEffortVelocityX[ i ];
+        controlEffortY[ i ] = zeroEffortMissPremultiplier * zeroEffortMissY[ i ]
+                              + zeroEffortVelocityPremultiplier * zeroEffortVelocityY[ i ];
+        controlEffortZ[ i ] = zeroEffortMissPremultiplier * zeroEffortMissZ[ i ]
+                              + zeroEffortVelocityPremultiplier * zeroEffortVelocityZ[ i ];
+    }
+}
+
+//! Evaluate SIMD kernel for OGL for a batch of samples of arbitrary length.
+/*!
+ * Evaluates a SIMD kernel, which only processes whole packets, for a batch of samples of
+ * arbitrary length. The remaining samples that do not fill a whole packet are copied to padded
+ * buffers and evaluated as one packet, such that all samples are computed with the same
+ * instruction sequence, irrespective of their position in the batch.
+ *
+ * @tparam  Real                   Real type
+ * @tparam  PacketSize             Number of samples per SIMD packet
+ * @tparam  PerSampleGains         Flag indicating if gains are given per sample
+ * @param   kernel                 SIMD kernel, which processes a multiple of PacketSize samples
+ * @sa      computeBatchedOptimalGuidanceLawScalar( ) for description of remaining parameters
+ */
+template< typename Real, std::size_t PacketSize, bool PerSampleGains >
+void evaluateBatchedOptimalGuidanceLawKernel(
+    void ( *kernel )( const Real*, const Real*, const Real*,
+                      const Real*, const Real*, const Real*,
+                      const Real*, const std::size_t,
+                      Real*, Real*, Real*,
+                      const Real*, const Real*, const Real ),
+    const Real* zeroEffortMissX,
+    const Real* zeroEffortMissY,
+    const Real* zeroEffortMissZ,
+    const Real* zeroEffortVelocityX,
+    const Real* zeroEffortVelocityY,
+    const Real* zeroEffortVelocityZ,
+    const Real* timeToGo,
+    const std::size_t numberOfSamples,
+    Real* controlEffortX,
+    Real* controlEffortY,
+    Real* controlEffortZ,
+    const Real* zeroEffortMissGain,
+    const Real* zeroEffortVelocityGain,
+    const Real minimumTimeToGo )
+{
+    const std::size_t numberOfRemainingSamples = numberOfSamples % PacketSize;
+    const std::size_t numberOfPacketSamples = numberOfSamples - numberOfRemainingSamples;
+
+    kernel( zeroEffortMissX, zeroEffortMissY, zeroEffortMissZ,
+            zeroEffortVelocityX, zeroEffortVelocityY, zeroEffortVelocityZ,
+            timeToGo, numberOfPacketSamples,
+            controlEffortX, controlEffortY, controlEffortZ,
+            zeroEffortMissGain, zeroEffortVelocityGain, minimumTimeToGo );
+
+    if ( numberOfRemainingSamples == 0 )
+    {
+        return;
+    }
+
+    // Padding uses unit TTG and zero gains, such that padded lanes remain finite.
+    Real input[ 9 ][ PacketSize ];
+    Real output[ 3 ][ PacketSize ];
+    for ( std::size_t j = 0; j < PacketSize; ++j )
+    {
+        for ( std::size_t k = 0; k < 9; ++k )
+        {
+            input[ k ][ j ] = Real( 0.0 );
+        }
+        input[ 6 ][ j ] = Real( 1.0 );
+    }
+
+    const std::size_t offset = numberOfPacketSamples;
+    for ( std::size_t j = 0; j < numberOfRemainingSamples; ++j )
+    {
+        input[ 0 ][ j ] = zeroEffortMissX[ offset + j ];
+        input[ 1 ][ j ] = zeroEffortMissY[ offset + j ];
+        input[ 2 ][ j ] = zeroEffortMissZ[ offset + j ];
+        input[ 3 ][ j ] = zeroEffortVelocityX[ offset + j ];
+        input[ 4 ][ j ] = zeroEffortVelocityY[ offset + j ];
+        input[ 5 ][ j ] = zeroEffortVelocityZ[ offset + j ];
+        input[ 6 ][ j ] = timeToGo[ offset + j ];
+        if ( PerSampleGains )
+        {
+            input[ 7 ][ j ] = zeroEffortMissGain[ offset + j ];
+            input[ 8 ][ j ] = zeroEffortVelocityGain[ offset + j ];
+        }
+    }
+
+    kernel( input[ 0 ], input[ 1 ], input[ 2 ],
+            input[ 3 ], input[ 4 ], input[ 5 ],
+            input[ 6 ], PacketSize,
+            output[ 0 ], output[ 1 ], output[ 2 ],
+            PerSampleGains ? input[ 7 ] : zeroEffortMissGain,
+            PerSampleGains ? input[ 8 ] : zeroEffortVelocityGain,
+            minimumTimeToGo );
+
+    for ( std::size_t j = 0; j < numberOfRemainingSamples; ++j )
+    {
+        controlEffortX[ offset + j ] = output[ 0 ][ j ];
+        controlEffortY[ offset + j ] = output[ 1 ][ j ];
+        controlEffortZ[ offset + j ] = output[ 2 ][ j ];
+    }
+}
+
+#if defined( CONTROL_HAS_X86_SIMD ) || defined( CONTROL_HAS_NEON_SIMD )
+
+// The shared kernel body is compiled without target attributes, such that GCC warns about passing
+// packets by value, although the body is only ever inlined into the target-attributed entry points.
+#if defined( __GNUC__ )
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+//! Compute control authority for OGL for a batch of samples using SIMD instructions.
+/*!
+ * Computes the control authority based on the OGL for a batch of samples stored in SoA form, using
+ * the packet operations of a SIMD instruction set. The reciprocal of the TTG is computed once per
+ * lane and reused for both the ZEM and ZEV premultipliers, such that only one division is needed
+ * per sample. In the terminal phase, the TTG floor and the weight of the ZEM term are applied with
+ * packed minimum and maximum instructions, such that no lane branches. The number of samples must
+ * be a multiple of the packet size. This kernel body is shared by all instruction sets, and is
+ * inlined into their entry points below.
+ *
+ * @tparam  Operations Packet operations of SIMD instruction set, e.g., Avx2Operations< double >
+ * @sa      computeBatchedOptimalGuidanceLawScalar( )
+ */
+template< typename Operations, bool PerSampleGains, bool IsTerminalPhase >
+CONTROL_SIMD_INLINE void computeBatchedOptimalGuidanceLawSimd(
+    const typename Operations::Real* zeroEffortMissX,
+    const typename Operations::Real* zeroEffortMissY,
+    const typename Operations::Real* zeroEffortMissZ,
+    const typename Operations::Real* zeroEffortVelocityX,
+    const typename Operations::Real* zeroEffortVelocityY,
+    const typename Operations::Real* zeroEffortVelocityZ,
+    const typename Operations::Real* timeToGo,
+    const std::size_t numberOfSamples,
+    typename Operations::Real* controlEffortX,
+    typename Operations::Real* controlEffortY,
+    typename Operations::Real* controlEffortZ,
+    const typename Operations::Real* zeroEffortMissGain,
+    const typename Operations::Real* zeroEffortVelocityGain,
+    const typename Operations::Real minimumTimeToGo )
+{
+    typedef typename Operations::Real Real;
+    typedef typename Operations::Packet Packet;
+
+    const Packet zero = Operations::broadcast( Real( 0.0 ) );
+    const Packet one = Operations::broadcast( Real( 1.0 ) );
+    const Packet minimumTimeToGoPacket = Operations::broadcast( minimumTimeToGo );
+    const Packet inverseMinimumTimeToGo
+        = Operations::broadcast( IsTerminalPhase ? Real( 1.0 ) / minimumTimeToGo : Real( 1.0 ) );
+    Packet zeroEffortMissGainPacket = Operations::broadcast( zeroEffortMissGain[ 0 ] );
+    Packet zeroEffortVelocityGainPacket = Operations::broadcast( zeroEffortVelocityGain[ 0 ] );
+
+    for ( std::size_t i = 0; i < numberOfSamples; i += Operations::size )
+    {
+        if ( PerSampleGains )
+        {
+            zeroEffortMissGainPacket = Operations::load( zeroEffortMissGain + i );
+            zeroEffortVelocityGainPacket = Operations::load( zeroEffortVelocityGain + i );
+        }
+
+        Packet timeToGoPacket = Operations::load( timeToGo + i );
+        Packet zeroEffortMissWeight = one;
+        if ( IsTerminalPhase )
+        {
+            zeroEffortMissWeight = Operations::minimum(
+                Operations::maximum( Operations::multiply( timeToGoPacket, inverseMinimumTimeToGo ),
+                                     zero ),
+                one );
+            timeToGoPacket = Operations::maximum( timeToGoPacket, minimumTimeToGoPacket );
+        }
+
+#if defined( CONTROL_ENABLE_DETERMINISTIC_MODE )
+        // The premultipliers are computed with the operation sequence of the scalar kernel.
+        const Packet zeroEffortVelocityPremultiplier
+            = Operations::divide( zeroEffortVelocityGainPacket, timeToGoPacket );
+        Packet zeroEffortMissPremultiplier
+            = Operations::divide( zeroEffortMissGainPacket,
+                                  Operations::multiply( timeToGoPacket, timeToGoPacket ) );
+#else
+        const Packet inverseTimeToGo = Operations::divide( one, timeToGoPacket );
+        const Packet zeroEffortVelocityPremultiplier
+            = Operations::multiply( zeroEffortVelocityGainPacket, inverseTimeToGo );
+        Packet zeroEffortMissPremultiplier
+            = Operations::multiply( Operations::multiply( zeroEffortMissGainPacket,
+                                                          inverseTimeToGo ),
+                                    inverseTimeToGo );
+#endif
+        if ( IsTerminalPhase )
+        {
+            zeroEffortMissPremultiplier
+                = Operations::multiply( zeroEffortMissPremultiplier, zeroEffortMissWeight );
+        }
+
+        Operations::store(
+            controlEffortX + i,
+            Operations::multiplyAdd( zeroEffortMissPremultiplier,
+                                     Operations::load( zeroEffortMissX + i ),
+                                     Operations::multiply(
+                                        zeroEffortVelocityPremultiplier,
+                                        Operations::load( zeroEffortVelocityX + i ) ) ) );
+        Operations::store(
+            controlEffortY + i,
+            Operations::multiplyAdd( zeroEffortMissPremultiplier,
+                                     Operations::load( zeroEffortMissY + i ),
+                                     Operations::multiply(
+                                        zeroEffortVelocityPremultiplier,
+                                        Operations::load( zeroEffortVelocityY + i ) ) ) );
+        Operations::store(
+            controlEffortZ + i,
+            Operations::multiplyAdd( zeroEffortMissPremultiplier,
+                                     Operations::load( zeroEffortMissZ + i ),
+                                     Operations::multiply(
+                                        zeroEffortVelocityPremultiplier,
+                                        Operations::load( zeroEffortVelocityZ + i ) ) ) );
+    }
+}
+
+#if defined( __GNUC__ )
+#pragma GCC diagnostic pop
+#endif
+
+#endif // CONTROL_HAS_X86_SIMD || CONTROL_HAS_NEON_SIMD
+
+#if defined( CONTROL_HAS_X86_SIMD )
+
+//! AVX2 packet operations.
+template< typename Real >
+struct Avx2Operations;
+
+//! AVX2 packet operations for double-precision.
+template< >
+struct Avx2Operations< double >
+{
+    typedef double Real;
+    typedef __m256d Packet;
+    static const std::size_t size = 4;
+
+    static CONTROL_AVX2_FUNCTION inline Packet load( const Real* data )
+    {
+        return _mm256_loadu_pd( data );
+    }
+
+    static CONTROL_AVX2_FUNCTION inline void store( Real* data, const Packet value )
+    {
+        _mm256_storeu_pd( data, value );
+    }
+
+    static CONTROL_AVX2_FUNCTION inline Packet broadcast( const Real value )
+    {
+        return _mm256_set1_pd( value );
+    }
+
+    static CONTROL_AVX2_FUNCTION inline Packet add( const Packet a, const Packet b )
+    {
+        return _mm256_add_pd( a, b );
+    }
+
+    static CONTROL_AVX2_FUNCTION inline Packet subtract( const Packet a, const Packet b )
+    {
+        return _mm256_sub_pd( a, b );
+    }
+
+    static CONTROL_AVX2_FUNCTION inline Packet multiply( const Packet a, const Packet b )
+    {
+        return _mm256_mul_pd( a, b );
+    }
+
+    static CONTROL_AVX2_FUNCTION inline Packet divide( const Packet a, const Packet b )
+    {
+        return _mm256_div_pd( a, b );
+    }
+
+    static CONTROL_AVX2_FUNCTION inline Packet multiplyAdd( const Packet a,
+                                                            const Packet b,
+                                                            const Packet c )
+    {
+#if defined( CONTROL_ENABLE_DETERMINISTIC_MODE )
+        return _mm256_add_pd( _mm256_mul_pd( a, b ), c );
+#else
+        return _mm256_fmadd_pd( a, b, c );
+#endif
+    }
+
+    static CONTROL_AVX2_FUNCTION inline Packet minimum( const Packet a, const Packet b )
+    {
+        return _mm256_min_pd( a, b );
+    }
+
+    static CONTROL_AVX2_FUNCTION inline Packet maximum( const Packet a, const Packet b )
+    {
+        return _mm256_max_pd( a, b );
+    }
+};
+
+//! AVX2 packet operations for single-precision.
+template< >
+struct Avx2Operations< float >
+{
+    typedef float Real;
+    typedef __m256 Packet;
+    static const std::size_t size = 8;
+
+    static CONTROL_AVX2_FUNCTION inline Packet load( const Real* data )
+    {
+        return _mm256_loadu_ps( data );
+    }
+
+    static CONTROL_AVX2_FUNCTION inline void store( Real* data, const Packet value )
+    {
+        _mm256_storeu_ps( data, value );
+    }
+
+    static CONTROL_AVX2_FUNCTION inline Packet broadcast( const Real value )
+    {
+        return _mm256_set1_ps( value );
+    }
+
+    static CONTROL_AVX2_FUNCTION inline Packet add( const Packet a, const Packet b )
+    {
+        return _mm256_add_ps( a, b );
+    }
+
+    static CONTROL_AVX2_FUNCTION inline Packet subtract( const Packet a, const Packet b )
+    {
+        return _mm256_sub_ps( a, b );
+    }
+
+    static CONTROL_AVX2_FUNCTION inline Packet multiply( const Packet a, const Packet b )
+    {
+        return _mm256_mul_ps( a, b );
+    }
+
+    static CONTROL_AVX2_FUNCTION inline Packet divide( const Packet a, const Packet b )
+    {
+        return _mm256_div_ps( a, b );
+    }
+
+    static CONTROL_AVX2_FUNCTION inline Packet multiplyAdd( const Packet a,
+                                                            const Packet b,
+                                                            const Packet c )
+    {
+#if defined( CONTROL_ENABLE_DETERMINISTIC_MODE )
+        return _mm256_add_ps( _mm256_mul_ps( a, b ), c );
+#else
+        return _mm256_fmadd_ps( a, b, c );
+#endif
+    }
+
+    static CONTROL_AVX2_FUNCTION inline Packet minimum( const Packet a, const Packet b )
+    {
+        return _mm256_min_ps( a, b );
+    }
+
+    static CONTROL_AVX2_FUNCTION inline Packet maximum( const Packet a, const Packet b )
+    {
+        return _mm256_max_ps( a, b );
+    }
+};
+
+//! AVX-512 packet operations.
+template< typename Real >
+struct Avx512Operations;
+
+//! AVX-512 packet operations for double-precision.
+template< >
+struct Avx512Operations< double >
+{
+    typedef double Real;
+    typedef __m512d Packet;
+    static const std::size_t size = 8;
+
+    static CONTROL_AVX512_FUNCTION inline Packet load( const Real* data )
+    {
+        return _mm512_loadu_pd( data );
+    }
+
+    static CONTROL_AVX512_FUNCTION inline void store( Real* data, const Packet value )
+    {
+        _mm512_storeu_pd( data, value );
+    }
+
+    static CONTROL_AVX512_FUNCTION inline Packet broadcast( const Real value )
+    {
+        return _mm512_set1_pd( value );
+    }
+
+    static CONTROL_AVX512_FUNCTION inline Packet add( const Packet a, const Packet b )
+    {
+        return _mm512_add_pd( a, b );
+    }
+
+    static CONTROL_AVX512_FUNCTION inline Packet subtract( const Packet a, const Packet b )
+    {
+        return _mm512_sub_pd( a, b );
+    }
+
+    static CONTROL_AVX512_FUNCTION inline Packet multiply( const Packet a, const Packet b )
+    {
+        return _mm512_mul_pd( a, b );
+    }
+
+    static CONTROL_AVX512_FUNCTION inline Packet divide( const Packet a, const Packet b )
+    {
+        return _mm512_div_pd( a, b );
+    }
+
+    static CONTROL_AVX512_FUNCTION inline Packet multiplyAdd( const Packet a,
+                                                              const Packet b,
+                                                              const Packet c )
+    {
+#if defined( CONTROL_ENABLE_DETERMINISTIC_MODE )
+        return _mm512_add_pd( _mm512_mul_pd( a, b ), c );
+#else
+        return _mm512_fmadd_pd( a, b, c );
+#endif
+    }
+
+    // The full-mask forms are used, since the unmasked intrinsics pass an undefined source
+    // operand that triggers spurious uninitialized-value warnings on some compilers.
+    static CONTROL_AVX512_FUNCTION inline Packet minimum( const Packet a, const Packet b )
+    {
+        return _mm512_mask_min_pd( a, 0xFF, a, b );
+    }
+
+    static CONTROL_AVX512_FUNCTION inline Packet maximum( const Packet a, const Packet b )
+    {
+        return _mm512_mask_max_pd( a, 0xFF, a, b );
+    }
+};
+
+//! AVX-512 packet operations for single-precision.
+template< >
+struct Avx512Operations< float >
+{
+    typedef float Real;
+    typedef __m512 Packet;
+    static const std::size_t size = 16;
+
+    static CONTROL_AVX512_FUNCTION inline Packet load( const Real* data )
+    {
+        return _mm512_loadu_ps( data );
+    }
+
+    static CONTROL_AVX512_FUNCTION inline void store( Real* data, const Packet value )
+    {
+        _mm512_storeu_ps( data, value );
+    }
+
+    static CONTROL_AVX512_FUNCTION inline Packet broadcast( const Real value )
+    {
+        return _mm512_set1_ps( value );
+    }
+
+    static CONTROL_AVX512_FUNCTION inline Packet add( const Packet a, const Packet b )
+    {
+        return _mm512_add_ps( a, b );
+    }
+
+    static CONTROL_AVX512_FUNCTION inline Packet subtract( const Packet a, const Packet b )
+    {
+        return _mm512_sub_ps( a, b );
+    }
+
+    static CONTROL_AVX512_FUNCTION inline Packet multiply( const Packet a, const Packet b )
+    {
+        return _mm512_mul_ps( a, b );
+    }
+
+    static CONTROL_AVX512_FUNCTION inline Packet divide( const Packet a, const Packet b )
+    {
+        return _mm512_div_ps( a, b );
+    }
+
+    static CONTROL_AVX512_FUNCTION inline Packet multiplyAdd( const Packet a,
+                                                              const Packet b,
+                                                              const Packet c )
+    {
+#if defined( CONTROL_ENABLE_DETERMINISTIC_MODE )
+        return _mm512_add_ps( _mm512_mul_ps( a, b ), c );
+#else
+        return _mm512_fmadd_ps( a, b, c );
+#endif
+    }
+
+    static CONTROL_AVX512_FUNCTION inline Packet minimum( const Packet a, const Packet b )
+    {
+        return _mm512_mask_min_ps( a, 0xFFFF, a, b );
+    }
+
+    static CONTROL_AVX512_FUNCTION inline Packet maximum( const Packet a, const Packet b )
+    {
+        return _mm512_mask_max_ps( a, 0xFFFF, a, b );
+    }
+};
+
+//! Compute control authority for OGL for a batch of samples using AVX2 instructions.
+/*!
+ * @sa computeBatchedOptimalGuidanceLawSimd( )
+ */
+template< typename Operations, bool PerSampleGains, bool IsTerminalPhase >
+CONTROL_AVX2_FUNCTION void computeBatchedOptimalGuidanceLawAvx2(
+    const typename Operations::Real* zeroEffortMissX,
+    const typename Operations::Real* zeroEffortMissY,
+    const typename Operations::Real* zeroEffortMissZ,
+    const typename Operations::Real* zeroEffortVelocityX,
+    const typename Operations::Real* zeroEffortVelocityY,
+    const typename Operations::Real* zeroEffortVelocityZ,
+    const typename Operations::Real* timeToGo,
+    const std::size_t numberOfSamples,
+    typename Operations::Real* controlEffortX,
+    typename Operations::Real* controlEffortY,
+    typename Operations::Real* controlEffortZ,
+    const typename Operations::Real* zeroEffortMissGain,
+    const typename Operations::Real* zeroEffortVelocityGain,
+    const typename Operations::Real minimumTimeToGo )
+{
+    computeBatchedOptimalGuidanceLawSimd< Operations, PerSampleGains, IsTerminalPhase >(
+        zeroEffortMissX, zeroEffortMissY, zeroEffortMissZ,
+        zeroEffortVelocityX, zeroEffortVelocityY, zeroEffortVelocityZ,
+        timeToGo, numberOfSamples, controlEffortX, controlEffortY, controlEffortZ,
+        zeroEffortMissGain, zeroEffortVelocityGain, minimumTimeToGo );
+}
+
+//! Compute control authority for OGL for a batch of samples using AVX-512 instructions.
+/*!
+ * @sa computeBatchedOptimalGuidanceLawSimd( )
+ */
+template< typename Operations, bool PerSampleGains, bool IsTerminalPhase >
+CONTROL_AVX512_FUNCTION void computeBatchedOptimalGuidanceLawAvx512(
+    const typename Operations::Real* zeroEffortMissX,
+    const typename Operations::Real* zeroEffortMissY,
+    const typename Operations::Real* zeroEffortMissZ,
+    const typename Operations::Real* zeroEffortVelocityX,
+    const typename Operations::Real* zeroEffortVelocityY,
+    const typename Operations::Real* zeroEffortVelocityZ,
+    const typename Operations::Real* timeToGo,
+    const std::size_t numberOfSamples,
+    typename Operations::Real* controlEffortX,
+    typename Operations::Real* controlEffortY,
+    typename Operations::Real* controlEffortZ,
+    const typename Operations::Real* zeroEffortMissGain,
+    const typename Operations::Real* zeroEffortVelocityGain,
+    const typename Operations::Real minimumTimeToGo )
+{
+    computeBatchedOptimalGuidanceLawSimd< Operations, PerSampleGains, IsTerminalPhase >(
+        zeroEffortMissX, zeroEffortMissY, zeroEffortMissZ,
+        zeroEffortVelocityX, zeroEffortVelocityY, zeroEffortVelocityZ,
+        timeToGo, numberOfSamples, controlEffortX, controlEffortY, controlEffortZ,
+        zeroEffortMissGain, zeroEffortVelocityGain, minimumTimeToGo );
+}
+
+#endif // CONTROL_HAS_X86_SIMD
+
+#if defined( CONTROL_HAS_NEON_SIMD )
+
+//! NEON packet operations.
+template< typename Real >
+struct NeonOperations;
+
+//! NEON packet operations for double-precision.
+template< >
+struct NeonOperations< double >
+{
+    typedef double Real;
+    typedef float64x2_t Packet;
+    static const std::size_t size = 2;
+
+    static inline Packet load( const Real* data ) { return vld1q_f64( data ); }
+    static inline void store( Real* data, const Packet value ) { vst1q_f64( data, value ); }
+    static inline Packet broadcast( const Real value ) { return vdupq_n_f64( value ); }
+    static inline Packet add( const Packet a, const Packet b ) { return vaddq_f64( a, b ); }
+    static inline Packet subtract( const Packet a, const Packet b ) { return vsubq_f64( a, b ); }
+    static inline Packet multiply( const Packet a, const Packet b ) { return vmulq_f64( a, b ); }
+    static inline Packet divide( const Packet a, const Packet b ) { return vdivq_f64( a, b ); }
+    static inline Packet minimum( const Packet a, const Packet b ) { return vminq_f64( a, b ); }
+    static inline Packet maximum( const Packet a, const Packet b ) { return vmaxq_f64( a, b ); }
+    static inline Packet multiplyAdd( const Packet a, const Packet b, const Packet c )
+    {
+#if defined( CONTROL_ENABLE_DETERMINISTIC_MODE )
+        return vaddq_f64( vmulq_f64( a, b ), c );
+#else
+        return vfmaq_f64( c, a, b );
+#endif
+    }
+};
+
+//! NEON packet operations for single-precision.
+template< >
+struct NeonOperations< float >
+{
+    typedef float Real;
+    typedef float32x4_t Packet;
+    static const std::size_t size = 4;
+
+    static inline Packet load( const Real* data ) { return vld1q_f32( data ); }
+    static inline void store( Real* data, const Packet value ) { vst1q_f32( data, value ); }
+    static inline Packet broadcast( const Real value ) { return vdupq_n_f32( value ); }
+    static inline Packet add( const Packet a, const Packet b ) { return vaddq_f32( a, b ); }
+    static inline Packet subtract( const Packet a, const Packet b ) { return vsubq_f32( a, b ); }
+    static inline Packet multiply( const Packet a, const Packet b ) { return vmulq_f32( a, b ); }
+    static inline Packet divide( const Packet a, const Packet b ) { return vdivq_f32( a, b ); }
+    static inline Packet minimum( const Packet a, const Packet b ) { return vminq_f32( a, b ); }
+    static inline Packet maximum( const Packet a, const Packet b ) { return vmaxq_f32( a, b ); }
+    static inline Packet multiplyAdd( const Packet a, const Packet b, const Packet c )
+    {
+#if defined( CONTROL_ENABLE_DETERMINISTIC_MODE )
+        return vaddq_f32( vmulq_f32( a, b ), c );
+#else
+        return vfmaq_f32( c, a, b );
+#endif
+    }
+};
+
+//! Compute control authority for OGL for a batch of samples using NEON instructions.
+/*!
+ * @sa computeBatchedOptimalGuidanceLawSimd( )
+ */
+template< typename Operations, bool PerSampleGains, bool IsTerminalPhase >
+void computeBatchedOptimalGuidanceLawNeon(
+    const typename Operations::Real* zeroEffortMissX,
+    const typename Operations::Real* zeroEffortMissY,
+    const typename Operations::Real* zeroEffortMissZ,
+    const typename Operations::Real* zeroEffortVelocityX,
+    const typename Operations::Real* zeroEffortVelocityY,
+    const typename Operations::Real* zeroEffortVelocityZ,
+    const typename Operations::Real* timeToGo,
+    const std::size_t numberOfSamples,
+    typename Operations::Real* controlEffortX,
+    typename Operations::Real* controlEffortY,
+    typename Operations::Real* controlEffortZ,
+    const typename Operations::Real* zeroEffortMissGain,
+    const typename Operations::Real* zeroEffortVelocityGain,
+    const typename Operations::Real minimumTimeToGo )
+{
+    computeBatchedOptimalGuidanceLawSimd< Operations, PerSampleGains, IsTerminalPhase >(
+        zeroEffortMissX, zeroEffortMissY, zeroEffortMissZ,
+        zeroEffortVelocityX, zeroEffortVelocityY, zeroEffortVelocityZ,
+        timeToGo, numberOfSamples, controlEffortX, controlEffortY, controlEffortZ,
+        zeroEffortMissGain, zeroEffortVelocityGain, minimumTimeToGo );
+}
+
+#endif // CONTROL_HAS_NEON_SIMD
+
+//! Dispatcher for batched OGL kernels.
+/*!
+ * Dispatcher for batched OGL kernels. The generic dispatcher always uses the scalar kernel; the
+ * specializations for single- and double-precision select a SIMD kernel based on the active SIMD
+ * instruction set.
+ *
+ * @tparam  Real Real type
+ */
+template< typename Real >
+struct BatchedOptimalGuidanceLawDispatcher
+{
+    template< bool PerSampleGains, bool IsTerminalPhase >
+    static void evaluate( const Real* zeroEffortMissX,
+                          const Real* zeroEffortMissY,
+                          const Real* zeroEffortMissZ,
+                          const Real* zeroEffortVelocityX,
+                          const Real* zeroEffortVelocityY,
+                          const Real* zeroEffortVelocityZ,
+                          const Real* timeToGo,
+                          const std::size_t numberOfSamples,
+                          Real* controlEffortX,
+                          Real* controlEffortY,
+                          Real* controlEffortZ,
+                          const Real* zeroEffortMissGain,
+                          const Real* zeroEffortVelocityGain,
+                          const Real minimumTimeToGo )
+    {
+        computeBatchedOptimalGuidanceLawScalar< Real, PerSampleGains, IsTerminalPhase >(
+            zeroEffortMissX, zeroEffortMissY, zeroEffortMissZ,
+            zeroEffortVelocityX, zeroEffortVelocityY, zeroEffortVelocityZ,
+            timeToGo, numberOfSamples,
+            controlEffortX, controlEffortY, controlEffortZ,
+            zeroEffortMissGain, zeroEffortVelocityGain, minimumTimeToGo );
+    }
+};
+
+//! Dispatcher for batched OGL kernels for SIMD-enabled real types.
+template< typename Real >
+struct SimdBatchedOptimalGuidanceLawDispatcher
+{
+    template< bool PerSampleGains, bool IsTerminalPhase >
+    static void evaluate( const Real* zeroEffortMissX,
+                          const Real* zeroEffortMissY,
+                          const Real* zeroEffortMissZ,
+                          const Real* zeroEffortVelocityX,
+                          const Real* zeroEffortVelocityY,
+                          const Real* zeroEffortVelocityZ,
+                          const Real* timeToGo,
+                          const std::size_t numberOfSamples,
+                          Real* controlEffortX,
+                          Real* controlEffortY,
+                          Real* controlEffortZ,
+                          const Real* zeroEffortMissGain,
+                          const Real* zeroEffortVelocityGain,
+                          const Real minimumTimeToGo )
+    {
+        switch ( getSimdInstructionSet( ) )
+        {
+#if defined( CONTROL_HAS_X86_SIMD )
+            case avx512InstructionSet:
+                evaluateBatchedOptimalGuidanceLawKernel< Real,
+                                                         Avx512Operations< Real >::size,
+                                                         PerSampleGains >(
+                    &computeBatchedOptimalGuidanceLawAvx512< Avx512Operations< Real >,
+                                                             PerSampleGains,
+                                                             IsTerminalPhase >,
+                    zeroEffortMissX, zeroEffortMissY, zeroEffortMissZ,
+                    zeroEffortVelocityX, zeroEffortVelocityY, zeroEffortVelocityZ,
+                    timeToGo, numberOfSamples,
+                    controlEffortX, controlEffortY, controlEffortZ,
+                    zeroEffortMissGain, zeroEffortVelocityGain, minimumTimeToGo );
+                return;
+
+            case avx2InstructionSet:
+                evaluateBatchedOptimalGuidanceLawKernel< Real,
+                                                         Avx2Operations< Real >::size,
+                                                         PerSampleGains >(
+                    &computeBatchedOptimalGuidanceLawAvx2< Avx2Operations< Real >,
+                                                           PerSampleGains,
+                                                           IsTerminalPhase >,
+                    zeroEffortMissX, zeroEffortMissY, zeroEffortMissZ,
+                    zeroEffortVelocityX, zeroEffortVelocityY, zeroEffortVelocityZ,
+                    timeToGo, numberOfSamples,
+                    controlEffortX, controlEffortY, controlEffortZ,
+                    zeroEffortMissGain, zeroEffortVelocityGain, minimumTimeToGo );
+                return;
+#endif
+
+#if defined( CONTROL_HAS_NEON_SIMD )
+            case neonInstructionSet:
+                evaluateBatchedOptimalGuidanceLawKernel< Real,
+                                                         NeonOperations< Real >::size,
+                                                         PerSampleGains >(
+                    &computeBatchedOptimalGuidanceLawNeon< NeonOperations< Real >,
+                                                           PerSampleGains,
+                                                           IsTerminalPhase >,
+                    zeroEffortMissX, zeroEffortMissY, zeroEffortMissZ,
+                    zeroEffortVelocityX, zeroEffortVelocityY, zeroEffortVelocityZ,
+                    timeToGo, numberOfSamples,
+                    controlEffortX, controlEffortY, controlEffortZ,
+                    zeroEffortMissGain, zeroEffortVelocityGain, minimumTimeToGo );
+                return;
+#endif
+
+            default:
+                computeBatchedOptimalGuidanceLawScalar< Real, PerSampleGains, IsTerminalPhase >(
+                    zeroEffortMissX, zeroEffortMissY, zeroEffortMissZ,
+                    zeroEffortVelocityX, zeroEffortVelocityY, zeroEffortVelocityZ,
+                    timeToGo, numberOfSamples,
+                    controlEffortX, controlEffortY, controlEffortZ,
+                    zeroEffortMissGain, zeroEffortVelocityGain, minimumTimeToGo );
+                return;
+        }
+    }
+};
+
+//! Dispatcher for batched OGL kernels for double-precision.
+template< >
+struct BatchedOptimalGuidanceLawDispatcher< double >
+    : public SimdBatchedOptimalGuidanceLawDispatcher< double >
+{ };
+
+//! Dispatcher for batched OGL kernels for single-precision.
+template< >
+struct BatchedOptimalGuidanceLawDispatcher< float >
+    : public SimdBatchedOptimalGuidanceLawDispatcher< float >
+{ };
+
+} // namespace detail
+} // namespace control
+
+#endif // CONTROL_OPTIMAL_GUIDANCE_LAW_SIMD_HPP
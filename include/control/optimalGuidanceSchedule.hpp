@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_OPTIMAL_GUIDANCE_SCHEDULE_HPP
+#define CONTROL_OPTIMAL_GUIDANCE_SCHEDULE_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "control/instrumentation.hpp"
+#include "control/optimalGuidanceLaw.hpp"
+#include "control/vectorTraits.hpp"
+
+namespace control
+{
+
+//! Precomputed Optimal Guidance Law (OGL) schedule for fixed-interval maneuvers.
+/*!
+ * Schedule of OGL premultipliers for fixed-interval maneuvers (Ebrahimi et al., 2008), for which
+ * the sequence of Time-To-Go (TTG) values is known in advance. The premultipliers of the ZEM and
+ * ZEV terms, i.e., \f$k_{r}/t_{\text{go}}^{2}\f$ and \f$k_{v}/t_{\text{go}}\f$, are computed once
+ * for the given TTG grid and gains when the schedule is constructed. Evaluating the OGL for a
+ * step of the schedule then only requires multiplications and additions, and contains no
+ * divisions.
+ *
+ * The premultipliers are computed by the same functions as used by computeOptimalGuidanceLaw( ),
+ * such that the control authority computed from the schedule is bit-identical to the control
+ * authority computed directly for the same TTG. Memory is only allocated on construction.
+ *
+ * @sa computeOptimalGuidanceLaw( )
+ * @tparam  Real Real type
+ */
+template< typename Real >
+class OptimalGuidanceSchedule
+{
+public:
+
+    //! Construct schedule.
+    /*!
+     * Constructs schedule for given TTG grid and gains. All TTG values must be strictly positive.
+     *
+     * @param   aTimeToGo               TTG grid, i.e., TTG to reach target at each step
+     * @param   aZeroEffortMissGain     Control gain for ZEM term (default=6.0)
+     * @param   aZeroEffortVelocityGain Control gain for ZEV term (default=-2.0)
+     */
+    explicit OptimalGuidanceSchedule( const std::vector< Real >& aTimeToGo,
+                                      const Real aZeroEffortMissGain = Real( 6.0 ),
+                                      const Real aZeroEffortVelocityGain = Real( -2.0 ) )
+        : zeroEffortMissPremultipliers( aTimeToGo.size( ) ),
+          zeroEffortVelocityPremultipliers( aTimeToGo.size( ) )
+    {
+        for ( std::size_t i = 0; i < aTimeToGo.size( ); ++i )
+        {
+            zeroEffortMissPremultipliers[ i ]
+                = computeZeroEffortMissPremultiplier( aTimeToGo[ i ], aZeroEffortMissGain );
+            zeroEffortVelocityPremultipliers[ i ]
+                = computeZeroEffortVelocityPremultiplier( aTimeToGo[ i ], aZeroEffortVelocityGain );
+        }
+    }
+
+    //! Construct schedule for uniform TTG grid.
+    /*!
+     * Constructs schedule for a uniform TTG grid, starting at the given initial TTG and decreasing
+     * by the given step size at each step, i.e.,
+     * \f$t_{\text{go},i} = t_{\text{go},0} - i \Delta t\f$. The final TTG must be strictly
+     * positive.
+     *
+     * @param   anInitialTimeToGo       TTG to reach target at first step
+     * @param   aStepSize               Step size
+     * @param   aNumberOfSteps          Number of steps
+     * @param   aZeroEffortMissGain     Control gain for ZEM term (default=6.0)
+     * @param   aZeroEffortVelocityGain Control gain for ZEV term (default=-2.0)
+     */
+    OptimalGuidanceSchedule( const Real anInitialTimeToGo,
+                             const Real aStepSize,
+                             const std::size_t aNumberOfSteps,
+                             const Real aZeroEffortMissGain = Real( 6.0 ),
+                             const Real aZeroEffortVelocityGain = Real( -2.0 ) )
+        : zeroEffortMissPremultipliers( aNumberOfSteps ),
+          zeroEffortVelocityPremultipliers( aNumberOfSteps )
+    {
+        for ( std::size_t i = 0; i < aNumberOfSteps; ++i )
+        {
+            const Real timeToGo = anInitialTimeToGo - static_cast< Real >( i ) * aStepSize;
+            zeroEffortMissPremultipliers[ i ]
+                = computeZeroEffortMissPremultiplier( timeToGo, aZeroEffortMissGain );
+            zeroEffortVelocityPremultipliers[ i ]
+                = computeZeroEffortVelocityPremultiplier( timeToGo, aZeroEffortVelocityGain );
+        }
+    }
+
+    //! Compute control authority for given step of schedule.
+    /*!
+     * Computes the control authority based on the OGL for the given step of the schedule, using
+     * the precomputed premultipliers, and writes it to a caller-supplied output vector, which must
+     * already be of size 3. No divisions are performed and no memory is allocated. The output
+     * vector may be the same object as one of the input vectors.
+     *
+     * @tparam  Vector3            3-Vector type
+     * @param   step               Step of schedule, must be less than getNumberOfSteps( )
+     * @param   zeroEffortMiss     Miss distance vector between target and computed final state
+     * @param   zeroEffortVelocity Miss velocity vector between target and computed final state
+     * @param   controlEffort      Computed control authority
+     */
+    template< typename Vector3 >
+    void computeControl( const std::size_t step,
+                         const Vector3& zeroEffortMiss,
+                         const Vector3& zeroEffortVelocity,
+                         Vector3& controlEffort ) const
+    {
+        CONTROL_INSTRUMENT_SCOPE( optimalGuidanceScheduleProbe );
+
+        detail::applyOptimalGuidanceLawPremultipliers( zeroEffortMiss,
+                                                       zeroEffortVelocity,
+                                                       zeroEffortMissPremultipliers[ step ],
+                                                       zeroEffortVelocityPremultipliers[ step ],
+                                                       controlEffort,
+                                                       IsFixedSizeVector3< Vector3 >( ) );
+    }
+
+    //! Get number of steps in schedule.
+    /*!
+     * @return Number of steps
+     */
+    std::size_t getNumberOfSteps( ) const { return zeroEffortMissPremultipliers.size( ); }
+
+    //! Get premultiplier of ZEM term for given step of schedule.
+    /*!
+     * @param   step Step of schedule
+     * @return       Premultiplier of ZEM term
+     */
+    Real getZeroEffortMissPremultiplier( const std::size_t step ) const
+    {
+        return zeroEffortMissPremultipliers[ step ];
+    }
+
+    //! Get premultiplier of ZEV term for given step of schedule.
+    /*!
+     * @param   step Step of schedule
+     * @return       Premultiplier of ZEV term
+     */
+    Real getZeroEffortVelocityPremultiplier( const std::size_t step ) const
+    {
+        return zeroEffortVelocityPremultipliers[ step ];
+    }
+
+private:
+
+    //! Premultipliers of ZEM term for all steps of schedule.
+    std::vector< Real > zeroEffortMissPremultipliers;
+
+    //! Premultipliers of ZEV term for all steps of schedule.
+    std::vector< Real > zeroEffortVelocityPremultipliers;
+};
+
+} // namespace control
+
+#endif // CONTROL_OPTIMAL_GUIDANCE_SCHEDULE_HPP
+
+/*
+ * References
+ * Ebrahimi, B., Bahrami, M., Roshanian, J. (2008) Optimal sliding-mode guidance with terminal
+ *  velocity constraint for fixed-interval propulsive maneuvers, Acta Astronautica, pg. 556–562,
+ *  vol. 62, doi: 10.1016/j.actaastro.2008.02.002.
+ */
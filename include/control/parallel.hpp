@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_PARALLEL_HPP
+#define CONTROL_PARALLEL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace control
+{
+
+//! Get number of worker threads to use.
+/*!
+ * @param   numberOfThreads Requested number of threads; if zero, the number of hardware threads
+ *                          is used
+ * @return                  Number of threads, at least one
+ */
+inline unsigned int getNumberOfThreads( const unsigned int numberOfThreads )
+{
+    if ( numberOfThreads > 0 )
+    {
+        return numberOfThreads;
+    }
+
+    const unsigned int numberOfHardwareThreads = std::thread::hardware_concurrency( );
+    return numberOfHardwareThreads > 0 ? numberOfHardwareThreads : 1;
+}
+
+//! Execute function for a range of chunks in parallel.
+/*!
+ * Executes the given function for each chunk index in [0, numberOfChunks) using a pool of worker
+ * threads, including the calling thread. Chunks are dispensed dynamically through a shared atomic
+ * counter, such that idle threads take the next unprocessed chunk without locking and load is
+ * balanced across threads, even if the cost per chunk varies. Each chunk is processed exactly
+ * once, but the assignment of chunks to threads is not deterministic; functions should therefore
+ * only write to per-chunk storage, which can be reduced in chunk order after this function
+ * returns.
+ *
+ * The function must not throw exceptions.
+ *
+ * @tparam  Function        Function type, callable as function( chunkIndex )
+ * @param   numberOfChunks  Number of chunks
+ * @param   numberOfThreads Number of threads; if zero, the number of hardware threads is used
+ * @param   function        Function to execute for each chunk
+ */
+template< typename Function >
+void parallelForChunks( const std::size_t numberOfChunks,
+                        const unsigned int numberOfThreads,
+                        Function function )
+{
+    std::size_t numberOfWorkers = getNumberOfThreads( numberOfThreads );
+    numberOfWorkers = numberOfWorkers < numberOfChunks ? numberOfWorkers : numberOfChunks;
+
+    std::atomic< std::size_t > nextChunk( 0 );
+    const auto worker = [ &nextChunk, &function, numberOfChunks ]( )
+    {
+        for ( ;; )
+        {
+            const std::size_t chunk = nextChunk.fetch_add( 1, std::memory_order_relaxed );
+            if ( chunk >= numberOfChunks )
+            {
+                return;
+            }
+            function( chunk );
+        }
+    };
+
+    std::vector< std::thread > threads;
+    threads.reserve( numberOfWorkers > 0 ? numberOfWorkers - 1 : 0 );
+    for ( std::size_t i = 1; i < numberOfWorkers; ++i )
+    {
+        threads.emplace_back( worker );
+    }
+
+    worker( );
+
+    for ( std::size_t i = 0; i < threads.size( ); ++i )
+    {
+        threads[ i ].join( );
+    }
+}
+
+} // namespace control
+
+#endif // CONTROL_PARALLEL_HPP
@@ -0,0 +1,392 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_PID_CONTROLLER_HPP
+#define CONTROL_PID_CONTROLLER_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "control/instrumentation.hpp"
+#include "control/pidControllerSimd.hpp"
+
+namespace control
+{
+
+//! Settings of channel of discrete PID controller.
+template< typename Real >
+struct PidSettings
+{
+    //! Proportional gain.
+    Real proportionalGain;
+
+    //! Integral gain.
+    Real integralGain;
+
+    //! Derivative gain.
+    Real derivativeGain;
+
+    //! Time constant of first-order low-pass filter of derivative term (zero: no filtering).
+    Real derivativeFilterTimeConstant;
+
+    //! Lower limit of output and of integral term.
+    Real minimumOutput;
+
+    //! Upper limit of output and of integral term.
+    Real maximumOutput;
+};
+
+namespace detail
+{
+
+//! Compute discrete coefficients of channel of PID controller.
+/*!
+ * Computes the coefficients of the discrete update of a PID channel (see updatePidChannel( )).
+ * The filtered derivative follows from the backward Euler discretization of
+ * \f$T_{f} \dot{d} + d = K_{d} \dot{e}\f$:
+ *
+ * \f[
+ *      d_{k} = \frac{T_{f}}{T_{f} + h} d_{k-1}
+ *              + \frac{K_{d}}{T_{f} + h} \left( e_{k} - e_{k-1} \right)
+ * \f]
+ *
+ * @tparam  Real                        Real type
+ * @param   settings                    Settings of channel
+ * @param   stepSize                    Step size of controller
+ * @param   integralCoefficient         Integral gain multiplied by the step size
+ * @param   derivativeFilterCoefficient Decay factor of the filtered derivative per step
+ * @param   derivativeCoefficient       Derivative gain divided by the sum of the filter time
+ *                                      constant and the step size
+ */
+template< typename Real >
+void computePidCoefficients( const PidSettings< Real >& settings,
+                             const Real stepSize,
+                             Real& integralCoefficient,
+                             Real& derivativeFilterCoefficient,
+                             Real& derivativeCoefficient )
+{
+    const Real inverseFilterStep
+        = Real( 1.0 ) / ( settings.derivativeFilterTimeConstant + stepSize );
+    integralCoefficient = settings.integralGain * stepSize;
+    derivativeFilterCoefficient = settings.derivativeFilterTimeConstant * inverseFilterStep;
+    derivativeCoefficient = settings.derivativeGain * inverseFilterStep;
+}
+
+} // namespace detail
+
+//! Discrete PID controller.
+/*!
+ * Discrete Proportional-Integral-Derivative (PID) controller with fixed step size, anti-windup
+ * and derivative filtering. At each update, with error \f$e_{k}\f$ (setpoint minus measurement),
+ * the integral term is integrated with the forward Euler method and clamped to the output limits,
+ * such that it cannot wind up while the output is saturated; the derivative of the error is
+ * filtered with a first-order low-pass filter (see detail::computePidCoefficients( )); and the
+ * output is clamped to the output limits:
+ *
+ * \f[
+ *      i_{k} = \text{clamp} \left( i_{k-1} + K_{i} h e_{k}, u_{\min}, u_{\max} \right), \quad
+ *      u_{k} = \text{clamp} \left( K_{p} e_{k} + i_{k} + d_{k}, u_{\min}, u_{\max} \right)
+ * \f]
+ *
+ * The update does not branch and does not allocate memory. Since the derivative acts on the
+ * error, setpoint steps cause a derivative kick, which is attenuated by the filter. To avoid a
+ * kick at the first update, the controller can be reset with the initial error.
+ *
+ * @sa MultiChannelPidController
+ * @tparam  Real Real type
+ */
+template< typename Real >
+class PidController
+{
+public:
+
+    //! Construct controller.
+    /*!
+     * Constructs controller with zero integral and derivative terms and zero previous error.
+     *
+     * @param   someSettings Settings of controller (the filter time constant must be
+     *                       non-negative, the step size strictly positive, and the minimum
+     *                       output not larger than the maximum output)
+     * @param   aStepSize    Step size, i.e., time between updates
+     */
+    PidController( const PidSettings< Real >& someSettings, const Real aStepSize )
+        : settings( someSettings ),
+          stepSize( aStepSize ),
+          integral( Real( 0.0 ) ),
+          derivative( Real( 0.0 ) ),
+          previousError( Real( 0.0 ) )
+    {
+        detail::computePidCoefficients(
+            settings, stepSize, integralCoefficient, derivativeFilterCoefficient,
+            derivativeCoefficient );
+    }
+
+    //! Compute control output.
+    /*!
+     * Updates the state of the controller with the current error and computes the output.
+     *
+     * @param   error Current error, i.e., setpoint minus measurement
+     * @return        Computed output
+     */
+    Real computeControl( const Real error )
+    {
+        CONTROL_INSTRUMENT_SCOPE( pidControllerProbe );
+
+        return detail::updatePidChannel( error,
+                                         settings.proportionalGain,
+                                         integralCoefficient,
+                                         derivativeFilterCoefficient,
+                                         derivativeCoefficient,
+                                         settings.minimumOutput,
+                                         settings.maximumOutput,
+                                         integral,
+                                         derivative,
+                                         previousError );
+    }
+
+    //! Reset controller.
+    /*!
+     * Resets the integral and derivative terms to zero, and the previous error to the given error.
+     *
+     * @param   anInitialError Error to use as previous error at next update (default=0.0)
+     */
+    void reset( const Real anInitialError = Real( 0.0 ) )
+    {
+        integral = Real( 0.0 );
+        derivative = Real( 0.0 );
+        previousError = anInitialError;
+    }
+
+    //! Get integral term.
+    /*!
+     * @return Integral term at last update
+     */
+    Real getIntegral( ) const { return integral; }
+
+    //! Get filtered derivative term.
+    /*!
+     * @return Filtered derivative term at last update
+     */
+    Real getDerivative( ) const { return derivative; }
+
+    //! Get step size.
+    /*!
+     * @return Step size, i.e., time between updates
+     */
+    Real getStepSize( ) const { return stepSize; }
+
+private:
+
+    //! Settings of controller.
+    PidSettings< Real > settings;
+
+    //! Step size.
+    Real stepSize;
+
+    //! Integral gain multiplied by the step size.
+    Real integralCoefficient;
+
+    //! Decay factor of the filtered derivative per step.
+    Real derivativeFilterCoefficient;
+
+    //! Derivative gain divided by the sum of the filter time constant and the step size.
+    Real derivativeCoefficient;
+
+    //! Integral term.
+    Real integral;
+
+    //! Filtered derivative term.
+    Real derivative;
+
+    //! Error at previous update.
+    Real previousError;
+};
+
+//! Multi-channel discrete PID controller.
+/*!
+ * Discrete PID controller for many independent channels with a shared step size, e.g., all
+ * attitude and rate loops of one or more vehicles. Each channel is updated per the single-channel
+ * PidController, but the coefficients and states of all channels are stored in
+ * structure-of-arrays (SoA) form, such that all channels are updated in one pass that is
+ * vectorized across channels. All arrays are allocated on construction.
+ *
+ * For single- and double-precision, a hand-vectorized kernel is selected at runtime based on the
+ * SIMD instruction set supported by the host CPU (AVX-512, AVX2 or NEON; see simd.hpp). These
+ * kernels fuse the multiply-adds, so the results can differ from the single-channel controller in
+ * the last bits. The scalar kernel, used for all other real types or by calling
+ * setSimdInstructionSet( scalarInstructionSet ), is bit-identical to the single-channel
+ * controller.
+ *
+ * @sa PidController
+ * @tparam  Real Real type
+ */
+template< typename Real >
+class MultiChannelPidController
+{
+public:
+
+    //! Construct controller.
+    /*!
+     * Constructs controller with zero integral and derivative terms and zero previous errors.
+     *
+     * @param   someSettings Settings of all channels (see PidController)
+     * @param   aStepSize    Step size, i.e., time between updates, shared by all channels
+     */
+    MultiChannelPidController( const std::vector< PidSettings< Real > >& someSettings,
+                               const Real aStepSize )
+        : numberOfChannels( someSettings.size( ) ),
+          stepSize( aStepSize ),
+          proportionalGains( computePaddedSize( someSettings.size( ) ), Real( 0.0 ) ),
+          integralCoefficients( proportionalGains.size( ), Real( 0.0 ) ),
+          derivativeFilterCoefficients( proportionalGains.size( ), Real( 0.0 ) ),
+          derivativeCoefficients( proportionalGains.size( ), Real( 0.0 ) ),
+          minimumOutputs( proportionalGains.size( ), Real( 0.0 ) ),
+          maximumOutputs( proportionalGains.size( ), Real( 0.0 ) ),
+          integrals( proportionalGains.size( ), Real( 0.0 ) ),
+          derivatives( proportionalGains.size( ), Real( 0.0 ) ),
+          previousErrors( proportionalGains.size( ), Real( 0.0 ) )
+    {
+        for ( std::size_t i = 0; i < numberOfChannels; ++i )
+        {
+            proportionalGains[ i ] = someSettings[ i ].proportionalGain;
+            minimumOutputs[ i ] = someSettings[ i ].minimumOutput;
+            maximumOutputs[ i ] = someSettings[ i ].maximumOutput;
+            detail::computePidCoefficients( someSettings[ i ],
+                                            stepSize,
+                                            integralCoefficients[ i ],
+                                            derivativeFilterCoefficients[ i ],
+                                            derivativeCoefficients[ i ] );
+        }
+    }
+
+    //! Compute control outputs of all channels.
+    /*!
+     * Updates the states of all channels with the current errors and computes the outputs. The
+     * output array may alias the error array.
+     *
+     * @param   errors   Array of current errors, with one element per channel
+     * @param   controls Array of computed outputs, with one element per channel
+     */
+    void computeControl( const Real* errors, Real* controls )
+    {
+        CONTROL_INSTRUMENT_SCOPE( multiChannelPidControllerProbe );
+
+        const detail::PidChannelArrays< Real > arrays = { proportionalGains.data( ),
+                                                          integralCoefficients.data( ),
+                                                          derivativeFilterCoefficients.data( ),
+                                                          derivativeCoefficients.data( ),
+                                                          minimumOutputs.data( ),
+                                                          maximumOutputs.data( ),
+                                                          integrals.data( ),
+                                                          derivatives.data( ),
+                                                          previousErrors.data( ) };
+        detail::MultiChannelPidDispatcher< Real >::evaluate(
+            arrays, errors, numberOfChannels, controls );
+    }
+
+    //! Reset all channels.
+    /*!
+     * Resets the integral and derivative terms and the previous errors of all channels to zero.
+     */
+    void reset( )
+    {
+        for ( std::size_t i = 0; i < numberOfChannels; ++i )
+        {
+            integrals[ i ] = Real( 0.0 );
+            derivatives[ i ] = Real( 0.0 );
+            previousErrors[ i ] = Real( 0.0 );
+        }
+    }
+
+    //! Reset all channels with given initial errors.
+    /*!
+     * Resets the integral and derivative terms of all channels to zero, and the previous errors to
+     * the given errors.
+     *
+     * @param   initialErrors Array of errors to use as previous errors at next update, with one
+     *                        element per channel
+     */
+    void reset( const Real* initialErrors )
+    {
+        reset( );
+        for ( std::size_t i = 0; i < numberOfChannels; ++i )
+        {
+            previousErrors[ i ] = initialErrors[ i ];
+        }
+    }
+
+    //! Get number of channels.
+    /*!
+     * @return Number of channels
+     */
+    std::size_t getNumberOfChannels( ) const { return numberOfChannels; }
+
+    //! Get integral term of channel.
+    /*!
+     * @param   channel Index of channel
+     * @return          Integral term at last update
+     */
+    Real getIntegral( const std::size_t channel ) const { return integrals[ channel ]; }
+
+    //! Get filtered derivative term of channel.
+    /*!
+     * @param   channel Index of channel
+     * @return          Filtered derivative term at last update
+     */
+    Real getDerivative( const std::size_t channel ) const { return derivatives[ channel ]; }
+
+    //! Get step size.
+    /*!
+     * @return Step size, i.e., time between updates
+     */
+    Real getStepSize( ) const { return stepSize; }
+
+private:
+
+    //! Compute number of channels padded to a multiple of the largest SIMD packet size.
+    static std::size_t computePaddedSize( const std::size_t aNumberOfChannels )
+    {
+        return ( aNumberOfChannels + detail::pidChannelPadding - 1 )
+               / detail::pidChannelPadding * detail::pidChannelPadding;
+    }
+
+    //! Number of channels.
+    std::size_t numberOfChannels;
+
+    //! Step size.
+    Real stepSize;
+
+    //! Proportional gains of all channels.
+    std::vector< Real > proportionalGains;
+
+    //! Integral gains multiplied by the step size of all channels.
+    std::vector< Real > integralCoefficients;
+
+    //! Decay factors of the filtered derivatives per step of all channels.
+    std::vector< Real > derivativeFilterCoefficients;
+
+    //! Derivative coefficients of all channels.
+    std::vector< Real > derivativeCoefficients;
+
+    //! Lower output limits of all channels.
+    std::vector< Real > minimumOutputs;
+
+    //! Upper output limits of all channels.
+    std::vector< Real > maximumOutputs;
+
+    //! Integral terms of all channels.
+    std::vector< Real > integrals;
+
+    //! Filtered derivative terms of all channels.
+    std::vector< Real > derivatives;
+
+    //! Errors at previous update of all channels.
+    std::vector< Real > previousErrors;
+};
+
+} // namespace control
+
+#endif // CONTROL_PID_CONTROLLER_HPP
@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_PID_CONTROLLER_SIMD_HPP
+#define CONTROL_PID_CONTROLLER_SIMD_HPP
+
+#include <cstddef>
+
+#include "control/hostDevice.hpp"
+#include "control/optimalGuidanceLawSimd.hpp"
+#include "control/simd.hpp"
+
+namespace control
+{
+namespace detail
+{
+
+//! Number of channels to which the arrays of multi-channel PID controllers are padded.
+/*!
+ * Number of channels to which the coefficient and state arrays of multi-channel PID controllers
+ * are padded, i.e., the largest packet size of all SIMD instruction sets (AVX-512 in
+ * single-precision), such that the last packet of any kernel can load these arrays directly.
+ */
+const std::size_t pidChannelPadding = 16;
+
+//! Coefficient and state arrays of multi-channel PID controller.
+/*!
+ * Coefficient and state arrays of a multi-channel PID controller, stored in SoA form. All arrays
+ * are padded to a multiple of pidChannelPadding channels; padded channels have zero coefficients
+ * and limits, such that their outputs and states remain zero.
+ *
+ * @tparam  Real Real type
+ */
+template< typename Real >
+struct PidChannelArrays
+{
+    //! Proportional gains.
+    const Real* proportionalGain;
+
+    //! Integral gains multiplied by the step size.
+    const Real* integralCoefficient;
+
+    //! Decay factors of the filtered derivative per step.
+    const Real* derivativeFilterCoefficient;
+
+    //! Derivative gains divided by the sum of the filter time constant and the step size.
+    const Real* derivativeCoefficient;
+
+    //! Lower output limits.
+    const Real* minimumOutput;
+
+    //! Upper output limits.
+    const Real* maximumOutput;
+
+    //! Integral terms.
+    Real* integral;
+
+    //! Filtered derivative terms.
+    Real* derivative;
+
+    //! Errors at previous update.
+    Real* previousError;
+};
+
+//! Update single channel of discrete PID controller.
+/*!
+ * Updates the state of a single channel of a discrete PID controller and computes its output.
+ * The integral term is integrated with the forward Euler method and clamped to the output limits
+ * (anti-windup), the derivative of the error is filtered with a first-order low-pass filter
+ * discretized with the backward Euler method, and the output is clamped to the output limits. The
+ * clamps are written as selects, which compilers translate to minimum and maximum instructions,
+ * such that the update does not branch. This function is the scalar reference for all kernels.
+ *
+ * @tparam  Real                        Real type
+ * @param   error                       Current error, i.e., setpoint minus measurement
+ * @param   proportionalGain            Proportional gain
+ * @param   integralCoefficient         Integral gain multiplied by the step size
+ * @param   derivativeFilterCoefficient Decay factor of the filtered derivative per step
+ * @param   derivativeCoefficient       Derivative gain divided by the sum of the filter time
+ *                                      constant and the step size
+ * @param   minimumOutput               Lower output limit
+ * @param   maximumOutput               Upper output limit
+ * @param   integral                    Integral term, which is updated
+ * @param   derivative                  Filtered derivative term, which is updated
+ * @param   previousError               Error at previous update, which is updated
+ * @return                              Output of the channel
+ */
+template< typename Real >
+CONTROL_HOST_DEVICE
+inline Real updatePidChannel( const Real error,
+                              const Real proportionalGain,
+                              const Real integralCoefficient,
+                              const Real derivativeFilterCoefficient,
+                              const Real derivativeCoefficient,
+                              const Real minimumOutput,
+                              const Real maximumOutput,
+                              Real& integral,
+                              Real& derivative,
+                              Real& previousError )
+{
+    const Real updatedIntegral = integral + integralCoefficient * error;
+    integral = updatedIntegral < minimumOutput
+               ? minimumOutput
+               : ( updatedIntegral > maximumOutput ? maximumOutput : updatedIntegral );
+    derivative = derivativeFilterCoefficient * derivative
+                 + derivativeCoefficient * ( error - previousError );
+    previousError = error;
+
+    const Real output = proportionalGain * error + integral + derivative;
+    return output < minimumOutput
+           ? minimumOutput : ( output > maximumOutput ? maximumOutput : output );
+}
+
+//! Update multi-channel PID controller using scalar instructions.
+/*!
+ * Updates all channels of a multi-channel PID controller per updatePidChannel( ). This is the
+ * scalar reference kernel: the results are bit-identical to the single-channel PidController.
+ *
+ * @tparam  Real             Real type
+ * @param   arrays           Coefficient and state arrays of the controller
+ * @param   errors           Array of current errors
+ * @param   numberOfChannels Number of channels
+ * @param   controls         Array of computed outputs
+ */
+template< typename Real >
+void computeMultiChannelPidControlScalar( const PidChannelArrays< Real >& arrays,
+                                          const Real* errors,
+                                          const std::size_t numberOfChannels,
+                                          Real* controls )
+{
+    for ( std::size_t i = 0; i < numberOfChannels; ++i )
+    {
+        controls[ i ] = updatePidChannel( errors[ i ],
+                                          arrays.proportionalGain[ i ],
+                                          arrays.integralCoefficient[ i ],
+                                          arrays.derivativeFilterCoefficient[ i ],
+                                          arrays.derivativeCoefficient[ i ],
+                                          arrays.minimumOutput[ i ],
+                                          arrays.maximumOutput[ i ],
+                                          arrays.integral[ i ],
+                                          arrays.derivative[ i ],
+                                          arrays.previousError[ i ] );
+    }
+}
+
+//! Evaluate SIMD kernel for multi-channel PID controller for arbitrary number of channels.
+/*!
+ * Evaluates a SIMD kernel, which only processes whole packets, for an arbitrary number of
+ * channels. Since the coefficient and state arrays are padded, the remaining channels that do not
+ * fill a whole packet are evaluated as one packet, with the errors and outputs copied through
+ * padded buffers, such that all channels are computed with the same instruction sequence.
+ *
+ * @tparam  Real       Real type
+ * @tparam  PacketSize Number of channels per SIMD packet, which must divide pidChannelPadding
+ * @param   kernel     SIMD kernel, which processes a multiple of PacketSize channels
+ * @sa      computeMultiChannelPidControlScalar( ) for description of remaining parameters
+ */
+template< typename Real, std::size_t PacketSize >
+void evaluateMultiChannelPidKernel(
+    void ( *kernel )( const PidChannelArrays< Real >&, const Real*, const std::size_t, Real* ),
+    const PidChannelArrays< Real >& arrays,
+    const Real* errors,
+    const std::size_t numberOfChannels,
+    Real* controls )
+{
+    const std::size_t numberOfRemainingChannels = numberOfChannels % PacketSize;
+    const std::size_t numberOfPacketChannels = numberOfChannels - numberOfRemainingChannels;
+
+    kernel( arrays, errors, numberOfPacketChannels, controls );
+
+    if ( numberOfRemainingChannels == 0 )
+    {
+        return;
+    }
+
+    Real paddedErrors[ PacketSize ];
+    Real paddedControls[ PacketSize ];
+    for ( std::size_t j = 0; j < PacketSize; ++j )
+    {
+        paddedErrors[ j ] = j < numberOfRemainingChannels
+                            ? errors[ numberOfPacketChannels + j ] : Real( 0.0 );
+    }
+
+    const std::size_t offset = numberOfPacketChannels;
+    const PidChannelArrays< Real > remainingArrays = { arrays.proportionalGain + offset,
+                                                       arrays.integralCoefficient + offset,
+                                                       arrays.derivativeFilterCoefficient + offset,
+                                                       arrays.derivativeCoefficient + offset,
+                                                       arrays.minimumOutput + offset,
+                                                       arrays.maximumOutput + offset,
+                                                       arrays.integral + offset,
+                                                       arrays.derivative + offset,
+                                                       arrays.previousError + offset };
+    kernel( remainingArrays, paddedErrors, PacketSize, paddedControls );
+
+    for ( std::size_t j = 0; j < numberOfRemainingChannels; ++j )
+    {
+        controls[ offset + j ] = paddedControls[ j ];
+    }
+}
+
+#if defined( CONTROL_HAS_X86_SIMD ) || defined( CONTROL_HAS_NEON_SIMD )
+
+// The shared kernel body is compiled without target attributes, such that GCC warns about passing
+// packets by value, although the body is only ever inlined into the target-attributed entry points.
+#if defined( __GNUC__ )
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+//! Update multi-channel PID controller using SIMD instructions.
+/*!
+ * Updates all channels of a multi-channel PID controller, using the packet operations of a SIMD
+ * instruction set. The clamps are applied with packed minimum and maximum instructions, and the
+ * multiply-adds are fused, such that the results can differ from the scalar kernel in the last
+ * bits. The number of channels must be a multiple of the packet size. This kernel body is shared
+ * by all instruction sets, and is inlined into their entry points below.
+ *
+ * @tparam  Operations Packet operations of SIMD instruction set, e.g., Avx2Operations< double >
+ * @sa      computeMultiChannelPidControlScalar( )
+ */
+template< typename Operations >
+CONTROL_SIMD_INLINE void computeMultiChannelPidControlSimd(
+    const PidChannelArrays< typename Operations::Real >& arrays,
+    const typename Operations::Real* errors,
+    const std::size_t numberOfChannels,
+    typename Operations::Real* controls )
+{
+    typedef typename Operations::Packet Packet;
+
+    for ( std::size_t i = 0; i < numberOfChannels; i += Operations::size )
+    {
+        const Packet error = Operations::load( errors + i );
+        const Packet minimumOutput = Operations::load( arrays.minimumOutput + i );
+        const Packet maximumOutput = Operations::load( arrays.maximumOutput + i );
+
+        const Packet integral = Operations::minimum(
+            Operations::maximum( Operations::multiplyAdd( Operations::load(
+                                                              arrays.integralCoefficient + i ),
+                                                          error,
+                                                          Operations::load( arrays.integral + i ) ),
+                                 minimumOutput ),
+            maximumOutput );
+        const Packet derivative = Operations::multiplyAdd(
+            Operations::load( arrays.derivativeFilterCoefficient + i ),
+            Operations::load( arrays.derivative + i ),
+            Operations::multiply( Operations::load( arrays.derivativeCoefficient + i ),
+                                  Operations::subtract(
+                                      error, Operations::load( arrays.previousError + i ) ) ) );
+        const Packet output = Operations::add(
+            Operations::multiplyAdd( Operations::load( arrays.proportionalGain + i ),
+                                     error,
+                                     integral ),
+            derivative );
+
+        Operations::store( arrays.integral + i, integral );
+        Operations::store( arrays.derivative + i, derivative );
+        Operations::store( arrays.previousError + i, error );
+        Operations::store( controls + i,
+                           Operations::minimum( Operations::maximum( output, minimumOutput ),
+                                                maximumOutput ) );
+    }
+}
+
+#if defined( __GNUC__ )
+#pragma GCC diagnostic pop
+#endif
+
+#endif // CONTROL_HAS_X86_SIMD || CONTROL_HAS_NEON_SIMD
+
+#if defined( CONTROL_HAS_X86_SIMD )
+
+//! Update multi-channel PID controller using AVX2 instructions.
+/*!
+ * @sa computeMultiChannelPidControlSimd( )
+ */
+template< typename Operations >
+CONTROL_AVX2_FUNCTION void computeMultiChannelPidControlAvx2(
+    const PidChannelArrays< typename Operations::Real >& arrays,
+    const typename Operations::Real* errors,
+    const std::size_t numberOfChannels,
+    typename Operations::Real* controls )
+{
+    computeMultiChannelPidControlSimd< Operations >( arrays, errors, numberOfChannels, controls );
+}
+
+//! Update multi-channel PID controller using AVX-512 instructions.
+/*!
+ * @sa computeMultiChannelPidControlSimd( )
+ */
+template< typename Operations >
+CONTROL_AVX512_FUNCTION void computeMultiChannelPidControlAvx512(
+    const PidChannelArrays< typename Operations::Real >& arrays,
+    const typename Operations::Real* errors,
+    const std::size_t numberOfChannels,
+    typename Operations::Real* controls )
+{
+    computeMultiChannelPidControlSimd< Operations >( arrays, errors, numberOfChannels, controls );
+}
+
+#endif // CONTROL_HAS_X86_SIMD
+
+#if defined( CONTROL_HAS_NEON_SIMD )
+
+//! Update multi-channel PID controller using NEON instructions.
+/*!
+ * @sa computeMultiChannelPidControlSimd( )
+ */
+template< typename Operations >
+void computeMultiChannelPidControlNeon( const PidChannelArrays< typename Operations::Real >& arrays,
+                                        const typename Operations::Real* errors,
+                                        const std::size_t numberOfChannels,
+                                        typename Operations::Real* controls )
+{
+    computeMultiChannelPidControlSimd< Operations >( arrays, errors, numberOfChannels, controls );
+}
+
+#endif // CONTROL_HAS_NEON_SIMD
+
+//! Dispatcher for multi-channel PID kernels.
+/*!
+ * Dispatcher for multi-channel PID kernels. The generic dispatcher always uses the scalar kernel;
+ * the specializations for single- and double-precision select a SIMD kernel based on the active
+ * SIMD instruction set (see setSimdInstructionSet( )).
+ *
+ * @tparam  Real Real type
+ */
+template< typename Real >
+struct MultiChannelPidDispatcher
+{
+    static void evaluate( const PidChannelArrays< Real >& arrays,
+                          const Real* errors,
+                          const std::size_t numberOfChannels,
+                          Real* controls )
+    {
+        computeMultiChannelPidControlScalar( arrays, errors, numberOfChannels, controls );
+    }
+};
+
+//! Dispatcher for multi-channel PID kernels for SIMD-enabled real types.
+template< typename Real >
+struct SimdMultiChannelPidDispatcher
+{
+    static void evaluate( const PidChannelArrays< Real >& arrays,
+                          const Real* errors,
+                          const std::size_t numberOfChannels,
+                          Real* controls )
+    {
+        switch ( getSimdInstructionSet( ) )
+        {
+#if defined( CONTROL_HAS_X86_SIMD )
+            case avx512InstructionSet:
+                evaluateMultiChannelPidKernel< Real, Avx512Operations< Real >::size >(
+                    &computeMultiChannelPidControlAvx512< Avx512Operations< Real > >,
+                    arrays, errors, numberOfChannels, controls );
+                return;
+
+            case avx2InstructionSet:
+                evaluateMultiChannelPidKernel< Real, Avx2Operations< Real >::size >(
+                    &computeMultiChannelPidControlAvx2< Avx2Operations< Real > >,
+                    arrays, errors, numberOfChannels, controls );
+                return;
+#endif
+
+#if defined( CONTROL_HAS_NEON_SIMD )
+            case neonInstructionSet:
+                evaluateMultiChannelPidKernel< Real, NeonOperations< Real >::size >(
+                    &computeMultiChannelPidControlNeon< NeonOperations< Real > >,
+                    arrays, errors, numberOfChannels, controls );
+                return;
+#endif
+
+            default:
+                computeMultiChannelPidControlScalar( arrays, errors, numberOfChannels, controls );
+                return;
+        }
+    }
+};
+
+//! Dispatcher for multi-channel PID kernels for double-precision.
+template< >
+struct MultiChannelPidDispatcher< double >
+    : public SimdMultiChannelPidDispatcher< double >
+{ };
+
+//! Dispatcher for multi-channel PID kernels for single-precision.
+template< >
+struct MultiChannelPidDispatcher< float >
+    : public SimdMultiChannelPidDispatcher< float >
+{ };
+
+} // namespace detail
+} // namespace control
+
+#endif // CONTROL_PID_CONTROLLER_SIMD_HPP
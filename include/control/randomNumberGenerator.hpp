@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_RANDOM_NUMBER_GENERATOR_HPP
+#define CONTROL_RANDOM_NUMBER_GENERATOR_HPP
+
+#include <cmath>
+#include <cstdint>
+
+#include "control/hostDevice.hpp"
+
+namespace control
+{
+
+//! Counter-based random number generator.
+/*!
+ * Random number generator whose n-th output is a pure function of a key and the counter n, i.e.,
+ * \f$x_{n} = f(k + n \gamma)\f$, where \f$f\f$ is the SplitMix64 finalizer (Steele et al., 2014)
+ * and \f$\gamma\f$ is the 64-bit golden ratio. The key is derived from a seed and a stream index,
+ * such that each stream (e.g., each Monte Carlo trajectory) has its own, independent sequence,
+ * which is the same irrespective of which thread generates it and in which order streams are
+ * processed. The generator has no shared state and does not allocate memory.
+ *
+ * @tparam  Real Real type
+ */
+template< typename Real >
+class CounterBasedRandomNumberGenerator
+{
+public:
+
+    //! Construct generator.
+    /*!
+     * @param   aSeed   Seed shared by all streams
+     * @param   aStream Index of stream
+     */
+    CONTROL_HOST_DEVICE CounterBasedRandomNumberGenerator( const std::uint64_t aSeed,
+                                                           const std::uint64_t aStream )
+        : key( mix( aSeed ^ mix( aStream * goldenRatio + goldenRatio ) ) ),
+          counter( 0 ),
+          hasCachedNormal( false ),
+          cachedNormal( Real( 0.0 ) )
+    { }
+
+    //! Generate random 64-bit integer.
+    /*!
+     * @return Uniformly distributed random 64-bit integer
+     */
+    CONTROL_HOST_DEVICE std::uint64_t generate( )
+    {
+        ++counter;
+        return mix( key + counter * goldenRatio );
+    }
+
+    //! Generate uniformly distributed random number.
+    /*!
+     * @return Random number, uniformly distributed on the open interval (0, 1)
+     */
+    CONTROL_HOST_DEVICE Real generateUniform( )
+    {
+        // The 53 most significant bits are mapped to the centers of 2^53 equal intervals on (0, 1).
+        return static_cast< Real >(
+            ( static_cast< double >( generate( ) >> 11 ) + 0.5 ) * ( 1.0 / 9007199254740992.0 ) );
+    }
+
+    //! Generate normally distributed random number.
+    /*!
+     * Generates normally distributed random numbers using the Box-Muller transform. Each transform
+     * yields two numbers, the second of which is cached for the next call.
+     *
+     * @param   mean              Mean of normal distribution (default=0.0)
+     * @param   standardDeviation Standard deviation of normal distribution (default=1.0)
+     * @return                    Normally distributed random number
+     */
+    CONTROL_HOST_DEVICE Real generateNormal( const Real mean = Real( 0.0 ),
+                                      const Real standardDeviation = Real( 1.0 ) )
+    {
+        if ( hasCachedNormal )
+        {
+            hasCachedNormal = false;
+            return mean + standardDeviation * cachedNormal;
+        }
+
+        const Real radius = std::sqrt( Real( -2.0 ) * std::log( generateUniform( ) ) );
+        const Real angle = Real( 6.283185307179586 ) * generateUniform( );
+        cachedNormal = radius * std::sin( angle );
+        hasCachedNormal = true;
+        return mean + standardDeviation * radius * std::cos( angle );
+    }
+
+private:
+
+    //! 64-bit golden ratio, used as Weyl sequence increment.
+    static const std::uint64_t goldenRatio = 0x9E3779B97F4A7C15ULL;
+
+    //! SplitMix64 finalizer.
+    static CONTROL_HOST_DEVICE std::uint64_t mix( std::uint64_t value )
+    {
+        value = ( value ^ ( value >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+        value = ( value ^ ( value >> 27 ) ) * 0x94D049BB133111EBULL;
+        return value ^ ( value >> 31 );
+    }
+
+    //! Key of stream.
+    std::uint64_t key;
+
+    //! Counter of generated 64-bit integers.
+    std::uint64_t counter;
+
+    //! Flag indicating if a normally distributed number is cached.
+    bool hasCachedNormal;
+
+    //! Cached normally distributed number.
+    Real cachedNormal;
+};
+
+} // namespace control
+
+#endif // CONTROL_RANDOM_NUMBER_GENERATOR_HPP
+
+/*
+ * References
+ * Steele, G.L., Lea, D., Flood, C.H. (2014) Fast Splittable Pseudorandom Number Generators,
+ *  Proceedings of the 2014 ACM International Conference on Object Oriented Programming Systems
+ *  Languages & Applications, pg. 453-472, doi: 10.1145/2660193.2660195.
+ */
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_RING_BUFFER_HPP
+#define CONTROL_RING_BUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace control
+{
+
+//! Lock-free single-producer, single-consumer ring buffer.
+/*!
+ * Bounded first-in, first-out queue for exactly one producer thread and one consumer thread. All
+ * slots are allocated on construction, such that pushing and popping do not allocate memory and
+ * only copy the element into or out of its slot. The producer and consumer synchronize through
+ * two monotonically increasing indices, using acquire-release ordering only; each side caches the
+ * last index read from the other side, so that the shared indices are only read when the buffer
+ * appears to be full or empty. The indices are padded onto separate cache lines, to avoid false
+ * sharing between the producer and consumer.
+ *
+ * @tparam  T Element type, which must be copy-assignable
+ */
+template< typename T >
+class SingleProducerSingleConsumerRingBuffer
+{
+public:
+
+    //! Construct ring buffer.
+    /*!
+     * @param   aCapacity Minimum capacity, rounded up to the next power of two (at least one)
+     */
+    explicit SingleProducerSingleConsumerRingBuffer( const std::size_t aCapacity )
+        : slots( computeCapacity( aCapacity ) ),
+          mask( slots.size( ) - 1 ),
+          head( 0 ),
+          cachedTail( 0 ),
+          tail( 0 ),
+          cachedHead( 0 )
+    { }
+
+    //! Push element, to be called by the producer thread only.
+    /*!
+     * @param   value Element to push
+     * @return        True if the element was pushed, false if the buffer is full
+     */
+    bool tryPush( const T& value )
+    {
+        const std::size_t currentTail = tail.load( std::memory_order_relaxed );
+        if ( currentTail - cachedHead == slots.size( ) )
+        {
+            cachedHead = head.load( std::memory_order_acquire );
+            if ( currentTail - cachedHead == slots.size( ) )
+            {
+                return false;
+            }
+        }
+
+        slots[ currentTail & mask ] = value;
+        tail.store( currentTail + 1, std::memory_order_release );
+        return true;
+    }
+
+    //! Pop element, to be called by the consumer thread only.
+    /*!
+     * @param   value Popped element
+     * @return        True if an element was popped, false if the buffer is empty
+     */
+    bool tryPop( T& value )
+    {
+        const std::size_t currentHead = head.load( std::memory_order_relaxed );
+        if ( currentHead == cachedTail )
+        {
+            cachedTail = tail.load( std::memory_order_acquire );
+            if ( currentHead == cachedTail )
+            {
+                return false;
+            }
+        }
+
+        value = slots[ currentHead & mask ];
+        head.store( currentHead + 1, std::memory_order_release );
+        return true;
+    }
+
+    //! Get capacity.
+    /*!
+     * @return Maximum number of elements in the buffer
+     */
+    std::size_t getCapacity( ) const { return slots.size( ); }
+
+    //! Get number of elements, which is approximate if called while pushing or popping.
+    /*!
+     * @return Number of elements in the buffer
+     */
+    std::size_t getSize( ) const
+    {
+        return tail.load( std::memory_order_acquire ) - head.load( std::memory_order_acquire );
+    }
+
+private:
+
+    //! Size of cache line, used to pad the indices.
+    static const std::size_t cacheLineSize = 64;
+
+    //! Compute capacity, i.e., the next power of two not less than the requested capacity.
+    static std::size_t computeCapacity( const std::size_t requestedCapacity )
+    {
+        std::size_t capacity = 1;
+        while ( capacity < requestedCapacity )
+        {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    //! Preallocated slots.
+    std::vector< T > slots;
+
+    //! Mask to map indices to slots.
+    const std::size_t mask;
+
+    //! Padding to separate the consumer index from the slot pointer and mask.
+    char consumerPadding[ cacheLineSize ];
+
+    //! Index of next element to pop, written by the consumer.
+    std::atomic< std::size_t > head;
+
+    //! Last tail index read by the consumer.
+    std::size_t cachedTail;
+
+    //! Padding to separate the producer index from the consumer index.
+    char producerPadding[ cacheLineSize ];
+
+    //! Index of next slot to push to, written by the producer.
+    std::atomic< std::size_t > tail;
+
+    //! Last head index read by the producer.
+    std::size_t cachedHead;
+
+    //! Padding to separate the producer index from subsequent objects.
+    char trailingPadding[ cacheLineSize ];
+};
+
+} // namespace control
+
+#endif // CONTROL_RING_BUFFER_HPP
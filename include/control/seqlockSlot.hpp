@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_SEQLOCK_SLOT_HPP
+#define CONTROL_SEQLOCK_SLOT_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace control
+{
+
+//! Lock-free single-writer, multiple-reader latest-value slot based on a sequence lock.
+/*!
+ * Slot that holds the latest value stored by exactly one writer thread, which can be read by any
+ * number of reader threads. The writer never waits for the readers: a store increments a
+ * sequence number to an odd value, copies the value into the slot and increments the sequence
+ * number to an even value again. A reader copies the value out of the slot between two reads of
+ * the sequence number, and retries if the sequence numbers differ or are odd, i.e., if the value
+ * was overwritten while it was being read. Since a store takes constant time, a read takes
+ * constant time, unless the writer stores continuously.
+ *
+ * The value is stored as an array of atomic words, which are copied with relaxed ordering and
+ * synchronized through the sequence number with fences, such that concurrent stores and reads do
+ * not constitute a data race. No memory is allocated.
+ *
+ * @tparam  T Value type, which must be trivially copyable
+ */
+template< typename T >
+class SeqlockSlot
+{
+public:
+
+    static_assert( std::is_trivially_copyable< T >::value,
+                   "SeqlockSlot requires a trivially copyable value type" );
+
+    //! Construct slot.
+    /*!
+     * @param   aValue Initial value, which is not counted as a store
+     */
+    explicit SeqlockSlot( const T& aValue = T( ) )
+        : sequenceNumber( 0 )
+    {
+        Word buffer[ numberOfWords ] = { };
+        std::memcpy( buffer, &aValue, sizeof( T ) );
+        for ( std::size_t i = 0; i < numberOfWords; ++i )
+        {
+            words[ i ].store( buffer[ i ], std::memory_order_relaxed );
+        }
+    }
+
+    //! Store value, to be called by the writer thread only.
+    /*!
+     * @param   value Value to store
+     */
+    void store( const T& value )
+    {
+        Word buffer[ numberOfWords ] = { };
+        std::memcpy( buffer, &value, sizeof( T ) );
+
+        const std::size_t currentSequenceNumber = sequenceNumber.load( std::memory_order_relaxed );
+        sequenceNumber.store( currentSequenceNumber + 1, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_release );
+        for ( std::size_t i = 0; i < numberOfWords; ++i )
+        {
+            words[ i ].store( buffer[ i ], std::memory_order_relaxed );
+        }
+        sequenceNumber.store( currentSequenceNumber + 2, std::memory_order_release );
+    }
+
+    //! Try to read value once.
+    /*!
+     * @param   value Read value, which is only valid if the read succeeded
+     * @return        True if the value was read, false if it was overwritten while being read
+     */
+    bool tryLoad( T& value ) const
+    {
+        const std::size_t firstSequenceNumber = sequenceNumber.load( std::memory_order_acquire );
+        if ( firstSequenceNumber & 1 )
+        {
+            return false;
+        }
+
+        Word buffer[ numberOfWords ];
+        for ( std::size_t i = 0; i < numberOfWords; ++i )
+        {
+            buffer[ i ] = words[ i ].load( std::memory_order_relaxed );
+        }
+        std::atomic_thread_fence( std::memory_order_acquire );
+        if ( sequenceNumber.load( std::memory_order_relaxed ) != firstSequenceNumber )
+        {
+            return false;
+        }
+
+        std::memcpy( &value, buffer, sizeof( T ) );
+        return true;
+    }
+
+    //! Read value, retrying until the value is not overwritten while being read.
+    /*!
+     * @return Latest stored value
+     */
+    T load( ) const
+    {
+        T value;
+        while ( !tryLoad( value ) )
+        { }
+        return value;
+    }
+
+    //! Get number of stores.
+    /*!
+     * The number of stores can be used by readers to detect whether a new value was stored since
+     * the last read.
+     *
+     * @return Number of completed stores
+     */
+    std::size_t getNumberOfStores( ) const
+    {
+        return sequenceNumber.load( std::memory_order_acquire ) / 2;
+    }
+
+private:
+
+    //! Word type used to store the value.
+    typedef std::size_t Word;
+
+    //! Number of words needed to store the value.
+    static const std::size_t numberOfWords = ( sizeof( T ) + sizeof( Word ) - 1 ) / sizeof( Word );
+
+    //! Sequence number, which is odd while a store is in progress.
+    std::atomic< std::size_t > sequenceNumber;
+
+    //! Words holding the value.
+    std::atomic< Word > words[ numberOfWords ];
+};
+
+} // namespace control
+
+#endif // CONTROL_SEQLOCK_SLOT_HPP
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_SIMD_HPP
+#define CONTROL_SIMD_HPP
+
+#include "control/hostDevice.hpp"
+
+// SIMD kernels are enabled for GCC-compatible compilers targeting x86 (AVX2, AVX-512; selected at
+// runtime) and AArch64 (NEON; always available), except in the device compilation pass of a GPU
+// compiler. Define CONTROL_DISABLE_SIMD to force the scalar kernels. Kernel bodies that are shared
+// by all instruction sets are declared CONTROL_SIMD_INLINE, such that they are always inlined into,
+// and compiled for, the target-attributed entry points of each instruction set.
+#if !defined( CONTROL_DISABLE_SIMD ) && !defined( CONTROL_DEVICE_COMPILATION )
+#if ( defined( __GNUC__ ) || defined( __clang__ ) ) \
+    && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define CONTROL_HAS_X86_SIMD
+#include <immintrin.h>
+#define CONTROL_AVX2_FUNCTION   __attribute__( ( target( "avx2,fma" ) ) )
+#define CONTROL_AVX512_FUNCTION __attribute__( ( target( "avx512f" ) ) )
+#define CONTROL_SIMD_INLINE     inline __attribute__( ( always_inline ) )
+#elif defined( __aarch64__ )
+#define CONTROL_HAS_NEON_SIMD
+#include <arm_neon.h>
+#define CONTROL_SIMD_INLINE     inline
+#endif
+#endif // CONTROL_DISABLE_SIMD
+
+// Deterministic mode is enabled by defining CONTROL_ENABLE_DETERMINISTIC_MODE, which must be
+// combined with disabling floating-point contraction (e.g., -ffp-contract=off). In deterministic
+// mode, the SIMD kernels use the operation sequence of the scalar kernels without fused
+// multiply-add instructions, such that the batched results are bit-identical for all instruction
+// sets, and Monte Carlo reductions are carried out in blocks of fixed size. Without it, the SIMD
+// kernels use reciprocals and fused multiply-add instructions, which is faster, but rounds
+// differently per instruction set.
+
+namespace control
+{
+
+//! SIMD instruction sets supported by the batched kernels.
+enum SimdInstructionSet
+{
+    scalarInstructionSet,
+    avx2InstructionSet,
+    avx512InstructionSet,
+    neonInstructionSet
+};
+
+//! Check if SIMD instruction set is supported by the host CPU.
+/*!
+ * Checks if the given SIMD instruction set is supported by the host CPU and has been compiled in.
+ * The scalar instruction set is always supported.
+ *
+ * @param   instructionSet SIMD instruction set
+ * @return                 True if instruction set is supported
+ */
+inline bool isSimdInstructionSetSupported( const SimdInstructionSet instructionSet )
+{
+    switch ( instructionSet )
+    {
+        case scalarInstructionSet:
+            return true;
+
+#if defined( CONTROL_HAS_X86_SIMD )
+        case avx2InstructionSet:
+            __builtin_cpu_init( );
+            return __builtin_cpu_supports( "avx2" ) && __builtin_cpu_supports( "fma" );
+
+        case avx512InstructionSet:
+            __builtin_cpu_init( );
+            return __builtin_cpu_supports( "avx512f" );
+#endif
+
+#if defined( CONTROL_HAS_NEON_SIMD )
+        case neonInstructionSet:
+            return true;
+#endif
+
+        default:
+            return false;
+    }
+}
+
+//! Detect widest SIMD instruction set supported by the host CPU.
+/*!
+ * Detects the widest SIMD instruction set supported by the host CPU, using CPU feature detection
+ * at runtime.
+ *
+ * @return Widest supported SIMD instruction set
+ */
+inline SimdInstructionSet detectSimdInstructionSet( )
+{
+    if ( isSimdInstructionSetSupported( avx512InstructionSet ) )
+    {
+        return avx512InstructionSet;
+    }
+
+    if ( isSimdInstructionSetSupported( avx2InstructionSet ) )
+    {
+        return avx2InstructionSet;
+    }
+
+    if ( isSimdInstructionSetSupported( neonInstructionSet ) )
+    {
+        return neonInstructionSet;
+    }
+
+    return scalarInstructionSet;
+}
+
+namespace detail
+{
+
+//! Get reference to SIMD instruction set used by batched kernels.
+inline SimdInstructionSet& activeSimdInstructionSet( )
+{
+    static SimdInstructionSet instructionSet = detectSimdInstructionSet( );
+    return instructionSet;
+}
+
+} // namespace detail
+
+//! Get SIMD instruction set used by batched kernels.
+/*!
+ * Gets the SIMD instruction set used by the batched kernels. Defaults to the widest instruction
+ * set supported by the host CPU.
+ *
+ * @return SIMD instruction set used by batched kernels
+ */
+inline SimdInstructionSet getSimdInstructionSet( )
+{
+    return detail::activeSimdInstructionSet( );
+}
+
+//! Set SIMD instruction set used by batched kernels.
+/*!
+ * Sets the SIMD instruction set used by the batched kernels, e.g., to force the scalar kernels.
+ * This setting is global and not thread-safe: it should not be changed while batched kernels are
+ * being evaluated.
+ *
+ * @param   instructionSet SIMD instruction set
+ * @return                 True if instruction set is supported and has been set
+ */
+inline bool setSimdInstructionSet( const SimdInstructionSet instructionSet )
+{
+    if ( !isSimdInstructionSetSupported( instructionSet ) )
+    {
+        return false;
+    }
+
+    detail::activeSimdInstructionSet( ) = instructionSet;
+    return true;
+}
+
+//! Check if deterministic mode is compiled in.
+/*!
+ * @return True if CONTROL_ENABLE_DETERMINISTIC_MODE is defined
+ */
+inline constexpr bool isDeterministicModeEnabled( )
+{
+#if defined( CONTROL_ENABLE_DETERMINISTIC_MODE )
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace control
+
+#endif // CONTROL_SIMD_HPP
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_SLIDING_MODE_GUIDANCE_HPP
+#define CONTROL_SLIDING_MODE_GUIDANCE_HPP
+
+#include <cstddef>
+
+#include "control/instrumentation.hpp"
+#include "control/optimalGuidanceLaw.hpp"
+#include "control/vectorTraits.hpp"
+
+namespace control
+{
+
+namespace detail
+{
+
+//! Compute saturation function of boundary layer of sliding-mode guidance.
+/*!
+ * Computes the saturation function \f$\text{sat}(x) = \min(\max(x, -1), 1)\f$, which replaces the
+ * sign function of the switching term within the boundary layer, using selects only.
+ *
+ * @tparam  Real  Real type
+ * @param   value Value
+ * @return        Saturated value
+ */
+template< typename Real >
+CONTROL_HOST_DEVICE
+constexpr Real computeBoundaryLayerSaturation( const Real value )
+{
+    return value < Real( -1.0 ) ? Real( -1.0 ) : ( value > Real( 1.0 ) ? Real( 1.0 ) : value );
+}
+
+} // namespace detail
+
+//! Compute control authority for Optimal Sliding-mode Guidance (OSG) in place.
+/*!
+ * Computes the control authority based on the OSG (Ebrahimi et al., 2008), which adds a switching
+ * term to the energy-optimal OGL to reject bounded, unmodeled perturbations, e.g., gravity model
+ * errors, thrust misalignment or aerodynamic forces. The sliding variable is defined per component
+ * from the ZEM and ZEV vectors as:
+ *
+ * \f[
+ *      \vec{s}(t) = \vec{\text{ZEM}}(t) - \frac{t_{\text{go}}}{2} \vec{\text{ZEV}}(t)
+ * \f]
+ *
+ * for which the OGL with the optimal gains (\f$k_{r} = 6\f$, \f$k_{v} = -2\f$) is the equivalent
+ * control \f$\vec{\text{ZEV}}/t_{\text{go}}\f$ plus the linear reaching term
+ * \f$6\vec{s}/t_{\text{go}}^{2}\f$. On the sliding surface \f$\vec{s} = \vec{0}\f$, the ZEV
+ * decays linearly with the TTG, such that both the terminal position and the terminal velocity
+ * constraints are met. The OSG is given by:
+ *
+ * \f[
+ *      u(t) = \frac{6}{t_{\text{go}}^{2}} \vec{\text{ZEM}}(t)
+ *              - \frac{2}{t_{\text{go}}} \vec{\text{ZEV}}(t)
+ *              + \Phi \: \text{sat} \left( \frac{\vec{s}(t)}{\delta} \right)
+ * \f]
+ *
+ * where \f$\Phi\f$ is the sliding gain and the saturation function is applied per component.
+ * Since \f$\dot{\vec{s}} = -3\vec{s}/t_{\text{go}} - t_{\text{go}}(\vec{w} + \vec{d})/2\f$ for
+ * the switching term \f$\vec{w}\f$ and a perturbing acceleration \f$\vec{d}\f$, the switching
+ * term drives the sliding variable to the boundary layer of thickness \f$\delta\f$ as long as the
+ * perturbation per component is bounded by \f$\Phi\f$. The boundary layer replaces the sign
+ * function of the classical switching term to avoid chattering; the OGL is recovered for
+ * \f$\Phi = 0\f$.
+ *
+ * The OGL part is evaluated with the same premultipliers as computeOptimalGuidanceLaw( ), and the
+ * sliding variable is formed from the ZEM and ZEV components that are loaded for the OGL, such that
+ * the switching term only adds two multiplications, a clamp and two additions per component, and
+ * no division. All components are loaded before the output is written, such that the output vector
+ * may be the same object as one of the input vectors. No memory is allocated.
+ *
+ * @sa computeOptimalGuidanceLaw( )
+ * @tparam  Real                   Real type
+ * @tparam  Vector3                3-Vector type
+ * @param   zeroEffortMiss         Miss distance vector between target and computed final state
+ * @param   zeroEffortVelocity     Miss velocity vector between target and computed final state
+ * @param   timeToGo               TTG to reach target
+ * @param   slidingGain            Sliding gain, i.e., bound on perturbing acceleration per
+ *                                 component (non-negative)
+ * @param   boundaryLayerThickness Thickness of boundary layer about sliding surface [distance]
+ *                                 (strictly positive)
+ * @param   controlEffort          Computed control authority
+ */
+template< typename Real, typename Vector3 >
+CONTROL_HOST_DEVICE
+void computeSlidingModeOptimalGuidanceLaw( const Vector3& zeroEffortMiss,
+                                           const Vector3& zeroEffortVelocity,
+                                           const Real timeToGo,
+                                           const Real slidingGain,
+                                           const Real boundaryLayerThickness,
+                                           Vector3& controlEffort )
+{
+    typedef typename VectorElement< Vector3 >::Type Element;
+
+    CONTROL_INSTRUMENT_SCOPE( slidingModeOptimalGuidanceLawProbe );
+    CONTROL_INSTRUMENT_TIME_TO_GO( timeToGo );
+
+    const Real zeroEffortMissPremultiplier
+        = computeZeroEffortMissPremultiplier( timeToGo, Real( 6.0 ) );
+    const Real zeroEffortVelocityPremultiplier
+        = computeZeroEffortVelocityPremultiplier( timeToGo, Real( -2.0 ) );
+    const Real halfTimeToGo = Real( 0.5 ) * timeToGo;
+    const Real inverseBoundaryLayerThickness = Real( 1.0 ) / boundaryLayerThickness;
+
+    Real zeroEffortMissComponents[ 3 ];
+    Real zeroEffortVelocityComponents[ 3 ];
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+        zeroEffortMissComponents[ i ] = static_cast< Real >( zeroEffortMiss[ i ] );
+        zeroEffortVelocityComponents[ i ] = static_cast< Real >( zeroEffortVelocity[ i ] );
+    }
+
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+        const Real slidingVariable
+            = zeroEffortMissComponents[ i ] - halfTimeToGo * zeroEffortVelocityComponents[ i ];
+        controlEffort[ i ] = static_cast< Element >(
+            zeroEffortMissPremultiplier * zeroEffortMissComponents[ i ]
+            + zeroEffortVelocityPremultiplier * zeroEffortVelocityComponents[ i ]
+            + slidingGain * detail::computeBoundaryLayerSaturation(
+                slidingVariable * inverseBoundaryLayerThickness ) );
+    }
+}
+
+namespace detail
+{
+
+//! Number of samples per block of batched OSG.
+/*!
+ * The block size is chosen such that the control authority, ZEM and ZEV vectors of a block stay in
+ * the L1 cache between the OGL kernel and the addition of the switching term.
+ */
+const std::size_t slidingModeOptimalGuidanceLawBlockSize = 256;
+
+} // namespace detail
+
+//! Compute control authority for Optimal Sliding-mode Guidance (OSG) for a batch of samples.
+/*!
+ * Computes the control authority based on the OSG for a batch of samples stored in
+ * structure-of-arrays (SoA) form (see the batched computeOptimalGuidanceLaw( ) function), with
+ * the sliding gain and boundary layer thickness shared by all samples. No memory is allocated.
+ *
+ * The samples are processed in blocks: the OGL is evaluated for a block with the SIMD kernel
+ * selected at runtime, after which the switching term is added to the block while it is still in
+ * the L1 cache. The switching term is computed as for the single-sample function, such that the
+ * results are bit-identical to the single-sample function for the scalar kernel (see
+ * setSimdInstructionSet( )). Since the ZEM and ZEV arrays are read again after the OGL has been
+ * evaluated, the output arrays may not alias any of the input arrays.
+ *
+ * @sa computeSlidingModeOptimalGuidanceLaw( )
+ * @tparam  Real                   Real type
+ * @param   zeroEffortMissX        Array of x-components of ZEM vectors
+ * @param   zeroEffortMissY        Array of y-components of ZEM vectors
+ * @param   zeroEffortMissZ        Array of z-components of ZEM vectors
+ * @param   zeroEffortVelocityX    Array of x-components of ZEV vectors
+ * @param   zeroEffortVelocityY    Array of y-components of ZEV vectors
+ * @param   zeroEffortVelocityZ    Array of z-components of ZEV vectors
+ * @param   timeToGo               Array of TTGs to reach target
+ * @param   numberOfSamples        Number of samples, i.e., length of all input & output arrays
+ * @param   slidingGain            Sliding gain, shared by all samples
+ * @param   boundaryLayerThickness Thickness of boundary layer, shared by all samples
+ * @param   controlEffortX         Array of x-components of computed control authority
+ * @param   controlEffortY         Array of y-components of computed control authority
+ * @param   controlEffortZ         Array of z-components of computed control authority
+ */
+template< typename Real >
+void computeSlidingModeOptimalGuidanceLaw( const Real* zeroEffortMissX,
+                                           const Real* zeroEffortMissY,
+                                           const Real* zeroEffortMissZ,
+                                           const Real* zeroEffortVelocityX,
+                                           const Real* zeroEffortVelocityY,
+                                           const Real* zeroEffortVelocityZ,
+                                           const Real* timeToGo,
+                                           const std::size_t numberOfSamples,
+                                           const Real slidingGain,
+                                           const Real boundaryLayerThickness,
+                                           Real* controlEffortX,
+                                           Real* controlEffortY,
+                                           Real* controlEffortZ )
+{
+    CONTROL_INSTRUMENT_SCOPE( batchedSlidingModeOptimalGuidanceLawProbe );
+    CONTROL_INSTRUMENT_TIME_TO_GO( timeToGo, numberOfSamples );
+
+    const Real zeroEffortMissGain = Real( 6.0 );
+    const Real zeroEffortVelocityGain = Real( -2.0 );
+    const Real inverseBoundaryLayerThickness = Real( 1.0 ) / boundaryLayerThickness;
+
+    for ( std::size_t begin = 0; begin < numberOfSamples;
+          begin += detail::slidingModeOptimalGuidanceLawBlockSize )
+    {
+        const std::size_t blockSize
+            = numberOfSamples - begin < detail::slidingModeOptimalGuidanceLawBlockSize
+              ? numberOfSamples - begin
+              : detail::slidingModeOptimalGuidanceLawBlockSize;
+
+        detail::BatchedOptimalGuidanceLawDispatcher< Real >::template evaluate< false, false >(
+            zeroEffortMissX + begin, zeroEffortMissY + begin, zeroEffortMissZ + begin,
+            zeroEffortVelocityX + begin, zeroEffortVelocityY + begin, zeroEffortVelocityZ + begin,
+            timeToGo + begin, blockSize,
+            controlEffortX + begin, controlEffortY + begin, controlEffortZ + begin,
+            &zeroEffortMissGain, &zeroEffortVelocityGain, Real( 0.0 ) );
+
+        for ( std::size_t i = begin; i < begin + blockSize; ++i )
+        {
+            const Real halfTimeToGo = Real( 0.5 ) * timeToGo[ i ];
+            controlEffortX[ i ] += slidingGain * detail::computeBoundaryLayerSaturation(
+                ( zeroEffortMissX[ i ] - halfTimeToGo * zeroEffortVelocityX[ i ] )
+                * inverseBoundaryLayerThickness );
+            controlEffortY[ i ] += slidingGain * detail::computeBoundaryLayerSaturation(
+                ( zeroEffortMissY[ i ] - halfTimeToGo * zeroEffortVelocityY[ i ] )
+                * inverseBoundaryLayerThickness );
+            controlEffortZ[ i ] += slidingGain * detail::computeBoundaryLayerSaturation(
+                ( zeroEffortMissZ[ i ] - halfTimeToGo * zeroEffortVelocityZ[ i ] )
+                * inverseBoundaryLayerThickness );
+        }
+    }
+}
+
+} // namespace control
+
+#endif // CONTROL_SLIDING_MODE_GUIDANCE_HPP
+
+/*
+ * References
+ * Ebrahimi, B., Bahrami, M., Roshanian, J. (2008) Optimal sliding-mode guidance with terminal
+ *  velocity constraint for fixed-interval propulsive maneuvers, Acta Astronautica, pg. 556–562,
+ *  vol. 62, doi: 10.1016/j.actaastro.2008.02.002.
+ */
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_STATISTICS_HPP
+#define CONTROL_STATISTICS_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "control/hostDevice.hpp"
+
+namespace control
+{
+
+//! Running statistics of a scalar quantity.
+/*!
+ * Accumulates the count, mean, variance, minimum and maximum of a sequence of samples in a single
+ * pass, using Welford's algorithm (Welford, 1962). Partial statistics, e.g., computed by separate
+ * threads for separate chunks of samples, can be merged using the pairwise update of Chan et al.
+ * (1979). Merging partial statistics in a fixed order yields results that do not depend on which
+ * thread computed which partial statistics.
+ *
+ * @tparam  Real Real type
+ */
+template< typename Real >
+class RunningStatistics
+{
+public:
+
+    //! Construct empty statistics.
+    CONTROL_HOST_DEVICE RunningStatistics( )
+        : numberOfSamples( 0 ),
+          mean( Real( 0.0 ) ),
+          sumOfSquaredDeviations( Real( 0.0 ) ),
+          minimum( std::numeric_limits< Real >::infinity( ) ),
+          maximum( -std::numeric_limits< Real >::infinity( ) )
+    { }
+
+    //! Add sample.
+    /*!
+     * @param   sample Sample to add
+     */
+    CONTROL_HOST_DEVICE void add( const Real sample )
+    {
+        ++numberOfSamples;
+        const Real deviation = sample - mean;
+        mean += deviation / static_cast< Real >( numberOfSamples );
+        sumOfSquaredDeviations += deviation * ( sample - mean );
+        minimum = sample < minimum ? sample : minimum;
+        maximum = sample > maximum ? sample : maximum;
+    }
+
+    //! Merge partial statistics.
+    /*!
+     * Merges the given partial statistics into these statistics, such that the result is the
+     * same (up to rounding) as adding all samples of the partial statistics.
+     *
+     * @param   statistics Partial statistics to merge
+     */
+    CONTROL_HOST_DEVICE void merge( const RunningStatistics& statistics )
+    {
+        if ( statistics.numberOfSamples == 0 )
+        {
+            return;
+        }
+
+        const std::size_t mergedNumberOfSamples = numberOfSamples + statistics.numberOfSamples;
+        const Real deviation = statistics.mean - mean;
+        const Real weight = static_cast< Real >( statistics.numberOfSamples )
+                            / static_cast< Real >( mergedNumberOfSamples );
+
+        mean += deviation * weight;
+        sumOfSquaredDeviations += statistics.sumOfSquaredDeviations
+                                  + deviation * deviation
+                                    * static_cast< Real >( numberOfSamples ) * weight;
+        minimum = statistics.minimum < minimum ? statistics.minimum : minimum;
+        maximum = statistics.maximum > maximum ? statistics.maximum : maximum;
+        numberOfSamples = mergedNumberOfSamples;
+    }
+
+    //! Get number of samples.
+    /*!
+     * @return Number of samples
+     */
+    CONTROL_HOST_DEVICE std::size_t getNumberOfSamples( ) const { return numberOfSamples; }
+
+    //! Get mean.
+    /*!
+     * @return Sample mean (zero if no samples have been added)
+     */
+    CONTROL_HOST_DEVICE Real getMean( ) const { return mean; }
+
+    //! Get variance.
+    /*!
+     * @return Unbiased sample variance (zero if fewer than two samples have been added)
+     */
+    CONTROL_HOST_DEVICE Real getVariance( ) const
+    {
+        return numberOfSamples < 2
+            ? Real( 0.0 ) : sumOfSquaredDeviations / static_cast< Real >( numberOfSamples - 1 );
+    }
+
+    //! Get standard deviation.
+    /*!
+     * @return Unbiased sample standard deviation (zero if fewer than two samples have been added)
+     */
+    CONTROL_HOST_DEVICE Real getStandardDeviation( ) const { return std::sqrt( getVariance( ) ); }
+
+    //! Get minimum.
+    /*!
+     * @return Minimum sample (infinity if no samples have been added)
+     */
+    CONTROL_HOST_DEVICE Real getMinimum( ) const { return minimum; }
+
+    //! Get maximum.
+    /*!
+     * @return Maximum sample (negative infinity if no samples have been added)
+     */
+    CONTROL_HOST_DEVICE Real getMaximum( ) const { return maximum; }
+
+private:
+
+    //! Number of samples.
+    std::size_t numberOfSamples;
+
+    //! Sample mean.
+    Real mean;
+
+    //! Sum of squared deviations from sample mean.
+    Real sumOfSquaredDeviations;
+
+    //! Minimum sample.
+    Real minimum;
+
+    //! Maximum sample.
+    Real maximum;
+};
+
+} // namespace control
+
+#endif // CONTROL_STATISTICS_HPP
+
+/*
+ * References
+ * Welford, B.P. (1962) Note on a Method for Calculating Corrected Sums of Squares and Products,
+ *  Technometrics, pg. 419-420, vol. 4, doi: 10.1080/00401706.1962.10490022.
+ * Chan, T.F., Golub, G.H., LeVeque, R.J. (1979) Updating Formulae and a Pairwise Algorithm for
+ *  Computing Sample Variances, Technical Report STAN-CS-79-773, Stanford University.
+ */
@@ -0,0 +1,433 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_THRUST_SATURATION_HPP
+#define CONTROL_THRUST_SATURATION_HPP
+
+#include <cmath>
+#include <cstddef>
+
+#include "control/instrumentation.hpp"
+#include "control/optimalGuidanceLaw.hpp"
+#include "control/vectorTraits.hpp"
+
+namespace control
+{
+
+//! Flags that indicate which thrust limits were active for a sample.
+enum ThrustSaturationFlag
+{
+    noThrustSaturation                  = 0,
+    maximumMagnitudeThrustSaturation    = 1,
+    minimumMagnitudeThrustSaturation    = 2,
+    pointingConeThrustSaturation        = 4
+};
+
+//! Thrust limits.
+/*!
+ * Limits on the control authority: a minimum and maximum magnitude and, optionally, a pointing cone
+ * about a given axis, within which the control authority must lie.
+ *
+ * @tparam  Real    Real type
+ */
+template< typename Real >
+class ThrustLimits
+{
+public:
+
+    //! Construct thrust limits without pointing cone.
+    /*!
+     * @param   aMinimumMagnitude Minimum magnitude of control authority
+     * @param   aMaximumMagnitude Maximum magnitude of control authority
+     */
+    ThrustLimits( const Real aMinimumMagnitude, const Real aMaximumMagnitude )
+        : minimumMagnitude( aMinimumMagnitude ),
+          maximumMagnitude( aMaximumMagnitude ),
+          isPointingConstrained( false ),
+          pointingAxisX( Real( 0.0 ) ),
+          pointingAxisY( Real( 0.0 ) ),
+          pointingAxisZ( Real( 1.0 ) ),
+          cosineMaximumPointingAngle( Real( -1.0 ) ),
+          sineMaximumPointingAngle( Real( 0.0 ) )
+    { }
+
+    //! Construct thrust limits with pointing cone.
+    /*!
+     * @tparam  Vector3                 3-Vector type
+     * @param   aMinimumMagnitude       Minimum magnitude of control authority
+     * @param   aMaximumMagnitude       Maximum magnitude of control authority
+     * @param   aPointingAxis           Axis of pointing cone, which is normalized internally
+     * @param   aMaximumPointingAngle   Half-angle of pointing cone [rad], in [0, pi/2]
+     */
+    template< typename Vector3 >
+    ThrustLimits( const Real aMinimumMagnitude,
+                  const Real aMaximumMagnitude,
+                  const Vector3& aPointingAxis,
+                  const Real aMaximumPointingAngle )
+        : minimumMagnitude( aMinimumMagnitude ),
+          maximumMagnitude( aMaximumMagnitude ),
+          isPointingConstrained( true ),
+          pointingAxisX( static_cast< Real >( aPointingAxis[ 0 ] ) ),
+          pointingAxisY( static_cast< Real >( aPointingAxis[ 1 ] ) ),
+          pointingAxisZ( static_cast< Real >( aPointingAxis[ 2 ] ) ),
+          cosineMaximumPointingAngle( std::cos( aMaximumPointingAngle ) ),
+          sineMaximumPointingAngle( std::sin( aMaximumPointingAngle ) )
+    {
+        const Real inverseNorm = Real( 1.0 ) / std::sqrt( pointingAxisX * pointingAxisX
+                                                          + pointingAxisY * pointingAxisY
+                                                          + pointingAxisZ * pointingAxisZ );
+        pointingAxisX *= inverseNorm;
+        pointingAxisY *= inverseNorm;
+        pointingAxisZ *= inverseNorm;
+    }
+
+    //! Apply thrust limits to control authority in place.
+    /*!
+     * Applies the thrust limits to the given control authority. If a pointing cone is set and the
+     * control authority lies outside of it, the control authority is first replaced by its
+     * projection onto the cone, i.e., the closest vector within the cone; this is the zero vector
+     * if the control authority points away from the cone. The magnitude is then clamped to the
+     * minimum and maximum magnitude, preserving the direction. A zero control authority, e.g., an
+     * engine cut-off, has no direction and is left unchanged by the minimum magnitude.
+     *
+     * All operations are written as selects instead of branches, such that the compiler can
+     * vectorize loops over samples.
+     *
+     * @param   controlEffortX x-component of control authority
+     * @param   controlEffortY y-component of control authority
+     * @param   controlEffortZ z-component of control authority
+     * @return                 Bitwise combination of ThrustSaturationFlag values
+     */
+    unsigned char apply( Real& controlEffortX, Real& controlEffortY, Real& controlEffortZ ) const
+    {
+        Real x = controlEffortX;
+        Real y = controlEffortY;
+        Real z = controlEffortZ;
+        Real magnitude = std::sqrt( x * x + y * y + z * z );
+        unsigned char flags = noThrustSaturation;
+
+        if ( isPointingConstrained )
+        {
+            const Real parallelMagnitude
+                = x * pointingAxisX + y * pointingAxisY + z * pointingAxisZ;
+            const Real perpendicularX = x - parallelMagnitude * pointingAxisX;
+            const Real perpendicularY = y - parallelMagnitude * pointingAxisY;
+            const Real perpendicularZ = z - parallelMagnitude * pointingAxisZ;
+            const Real perpendicularMagnitude = std::sqrt( perpendicularX * perpendicularX
+                                                           + perpendicularY * perpendicularY
+                                                           + perpendicularZ * perpendicularZ );
+            const bool isOutsideCone
+                = parallelMagnitude < cosineMaximumPointingAngle * magnitude;
+
+            // Project onto the generatrix of the cone in the plane of the axis and the control.
+            const Real inversePerpendicularMagnitude = perpendicularMagnitude > Real( 0.0 )
+                                                       ? Real( 1.0 ) / perpendicularMagnitude
+                                                       : Real( 0.0 );
+            const Real projectedMagnitude = parallelMagnitude * cosineMaximumPointingAngle
+                                            + perpendicularMagnitude * sineMaximumPointingAngle;
+            const Real coneMagnitude
+                = projectedMagnitude > Real( 0.0 ) ? projectedMagnitude : Real( 0.0 );
+            const Real axisFactor = coneMagnitude * cosineMaximumPointingAngle;
+            const Real perpendicularFactor
+                = coneMagnitude * sineMaximumPointingAngle * inversePerpendicularMagnitude;
+
+            x = isOutsideCone ? axisFactor * pointingAxisX + perpendicularFactor * perpendicularX
+                              : x;
+            y = isOutsideCone ? axisFactor * pointingAxisY + perpendicularFactor * perpendicularY
+                              : y;
+            z = isOutsideCone ? axisFactor * pointingAxisZ + perpendicularFactor * perpendicularZ
+                              : z;
+            magnitude = isOutsideCone ? coneMagnitude : magnitude;
+            flags = isOutsideCone ? static_cast< unsigned char >( pointingConeThrustSaturation )
+                                  : flags;
+        }
+
+        const Real inverseMagnitude
+            = magnitude > Real( 0.0 ) ? Real( 1.0 ) / magnitude : Real( 0.0 );
+        const bool isAboveMaximum = magnitude > maximumMagnitude;
+        const bool isBelowMinimum = magnitude < minimumMagnitude && magnitude > Real( 0.0 );
+        const Real scale = isAboveMaximum ? maximumMagnitude * inverseMagnitude
+                                          : ( isBelowMinimum ? minimumMagnitude * inverseMagnitude
+                                                             : Real( 1.0 ) );
+
+        controlEffortX = scale * x;
+        controlEffortY = scale * y;
+        controlEffortZ = scale * z;
+        return static_cast< unsigned char >(
+            flags | ( isAboveMaximum ? maximumMagnitudeThrustSaturation : 0 )
+                  | ( isBelowMinimum ? minimumMagnitudeThrustSaturation : 0 ) );
+    }
+
+    //! Get minimum magnitude of control authority.
+    Real getMinimumMagnitude( ) const { return minimumMagnitude; }
+
+    //! Get maximum magnitude of control authority.
+    Real getMaximumMagnitude( ) const { return maximumMagnitude; }
+
+    //! Check if pointing cone is set.
+    bool getIsPointingConstrained( ) const { return isPointingConstrained; }
+
+private:
+
+    //! Minimum magnitude of control authority.
+    Real minimumMagnitude;
+
+    //! Maximum magnitude of control authority.
+    Real maximumMagnitude;
+
+    //! Flag that indicates if pointing cone is set.
+    bool isPointingConstrained;
+
+    //! x-component of unit axis of pointing cone.
+    Real pointingAxisX;
+
+    //! y-component of unit axis of pointing cone.
+    Real pointingAxisY;
+
+    //! z-component of unit axis of pointing cone.
+    Real pointingAxisZ;
+
+    //! Cosine of half-angle of pointing cone.
+    Real cosineMaximumPointingAngle;
+
+    //! Sine of half-angle of pointing cone.
+    Real sineMaximumPointingAngle;
+};
+
+//! Compute saturated control authority for Optimal Guidance Law (OGL) in place.
+/*!
+ * Computes the control authority based on the OGL and applies the given thrust limits (see
+ * ThrustLimits::apply( )) before the result is written to the caller-supplied output vector, such
+ * that no separate pass over the output is required. No memory is allocated.
+ *
+ * @sa computeOptimalGuidanceLaw( )
+ * @tparam  Real                   Real type
+ * @tparam  Vector3                3-Vector type
+ * @param   zeroEffortMiss         Miss distance vector between target and computed final state
+ * @param   zeroEffortVelocity     Miss velocity vector between target and computed final state
+ * @param   timeToGo               TTG to reach target
+ * @param   thrustLimits           Thrust limits
+ * @param   controlEffort          Computed saturated control authority
+ * @param   zeroEffortMissGain     Control gain for ZEM term (default=6.0)
+ * @param   zeroEffortVelocityGain Control gain for ZEV term (default=-2.0)
+ * @return                         Bitwise combination of ThrustSaturationFlag values
+ */
+template< typename Real, typename Vector3 >
+unsigned char computeSaturatedOptimalGuidanceLaw( const Vector3& zeroEffortMiss,
+                                                  const Vector3& zeroEffortVelocity,
+                                                  const Real timeToGo,
+                                                  const ThrustLimits< Real >& thrustLimits,
+                                                  Vector3& controlEffort,
+                                                  const Real zeroEffortMissGain = Real( 6.0 ),
+                                                  const Real zeroEffortVelocityGain = Real( -2.0 ) )
+{
+    typedef typename VectorElement< Vector3 >::Type Element;
+
+    CONTROL_INSTRUMENT_SCOPE( saturatedOptimalGuidanceLawProbe );
+    CONTROL_INSTRUMENT_TIME_TO_GO( timeToGo );
+
+    const Real zeroEffortMissPremultiplier
+        = computeZeroEffortMissPremultiplier( timeToGo, zeroEffortMissGain );
+    const Real zeroEffortVelocityPremultiplier
+        = computeZeroEffortVelocityPremultiplier( timeToGo, zeroEffortVelocityGain );
+
+    Real controlEffortX
+        = zeroEffortMissPremultiplier * static_cast< Real >( zeroEffortMiss[ 0 ] )
+          + zeroEffortVelocityPremultiplier * static_cast< Real >( zeroEffortVelocity[ 0 ] );
+    Real controlEffortY
+        = zeroEffortMissPremultiplier * static_cast< Real >( zeroEffortMiss[ 1 ] )
+          + zeroEffortVelocityPremultiplier * static_cast< Real >( zeroEffortVelocity[ 1 ] );
+    Real controlEffortZ
+        = zeroEffortMissPremultiplier * static_cast< Real >( zeroEffortMiss[ 2 ] )
+          + zeroEffortVelocityPremultiplier * static_cast< Real >( zeroEffortVelocity[ 2 ] );
+
+    const unsigned char flags
+        = thrustLimits.apply( controlEffortX, controlEffortY, controlEffortZ );
+
+    controlEffort[ 0 ] = static_cast< Element >( controlEffortX );
+    controlEffort[ 1 ] = static_cast< Element >( controlEffortY );
+    controlEffort[ 2 ] = static_cast< Element >( controlEffortZ );
+
+    CONTROL_INSTRUMENT_EVENT( thrustSaturationEvent, flags != noThrustSaturation ? 1 : 0 );
+    return flags;
+}
+
+namespace detail
+{
+
+//! Number of samples per block of batched saturated OGL.
+/*!
+ * The block size is chosen such that the control authority of a block stays in the L1 cache
+ * between the OGL kernel and the application of the thrust limits.
+ */
+const std::size_t saturatedOptimalGuidanceLawBlockSize = 256;
+
+//! Compute saturated control authority for OGL for a batch of samples.
+/*!
+ * @sa computeSaturatedOptimalGuidanceLaw( )
+ */
+template< typename Real, bool PerSampleGains >
+std::size_t computeBatchedSaturatedOptimalGuidanceLaw( const Real* zeroEffortMissX,
+                                                       const Real* zeroEffortMissY,
+                                                       const Real* zeroEffortMissZ,
+                                                       const Real* zeroEffortVelocityX,
+                                                       const Real* zeroEffortVelocityY,
+                                                       const Real* zeroEffortVelocityZ,
+                                                       const Real* timeToGo,
+                                                       const std::size_t numberOfSamples,
+                                                       const ThrustLimits< Real >& thrustLimits,
+                                                       Real* controlEffortX,
+                                                       Real* controlEffortY,
+                                                       Real* controlEffortZ,
+                                                       unsigned char* saturationFlags,
+                                                       const Real* zeroEffortMissGain,
+                                                       const Real* zeroEffortVelocityGain )
+{
+    CONTROL_INSTRUMENT_SCOPE( batchedSaturatedOptimalGuidanceLawProbe );
+    CONTROL_INSTRUMENT_TIME_TO_GO( timeToGo, numberOfSamples );
+
+    std::size_t numberOfSaturatedSamples = 0;
+
+    for ( std::size_t begin = 0; begin < numberOfSamples;
+          begin += saturatedOptimalGuidanceLawBlockSize )
+    {
+        const std::size_t blockSize = numberOfSamples - begin < saturatedOptimalGuidanceLawBlockSize
+                                      ? numberOfSamples - begin
+                                      : saturatedOptimalGuidanceLawBlockSize;
+        const std::size_t gainOffset = PerSampleGains ? begin : 0;
+
+        BatchedOptimalGuidanceLawDispatcher< Real >::template evaluate< PerSampleGains, false >(
+            zeroEffortMissX + begin, zeroEffortMissY + begin, zeroEffortMissZ + begin,
+            zeroEffortVelocityX + begin, zeroEffortVelocityY + begin, zeroEffortVelocityZ + begin,
+            timeToGo + begin, blockSize,
+            controlEffortX + begin, controlEffortY + begin, controlEffortZ + begin,
+            zeroEffortMissGain + gainOffset, zeroEffortVelocityGain + gainOffset, Real( 0.0 ) );
+
+        for ( std::size_t i = begin; i < begin + blockSize; ++i )
+        {
+            const unsigned char flags = thrustLimits.apply(
+                controlEffortX[ i ], controlEffortY[ i ], controlEffortZ[ i ] );
+            saturationFlags[ i ] = flags;
+            numberOfSaturatedSamples += flags != noThrustSaturation ? 1 : 0;
+        }
+    }
+
+    CONTROL_INSTRUMENT_EVENT( thrustSaturationEvent, numberOfSaturatedSamples );
+    return numberOfSaturatedSamples;
+}
+
+} // namespace detail
+
+//! Compute saturated control authority for Optimal Guidance Law (OGL) for a batch of samples.
+/*!
+ * Computes the control authority based on the OGL for a batch of samples stored in
+ * structure-of-arrays (SoA) form (see the batched computeOptimalGuidanceLaw( ) function) and
+ * applies the given thrust limits (see ThrustLimits::apply( )). For each sample, the active thrust
+ * limits are written to the saturation flags array, and the number of saturated samples is
+ * returned, such that no second scan over the output is required to collect saturation
+ * statistics. No memory is allocated.
+ *
+ * The samples are processed in blocks: the OGL is evaluated for a block with the SIMD kernel
+ * selected at runtime, after which the thrust limits are applied to the block while it is still in
+ * the L1 cache. Each output array is therefore only streamed through memory once. The output
+ * arrays may alias the corresponding input arrays.
+ *
+ * @sa computeOptimalGuidanceLaw( ), computeSaturatedOptimalGuidanceLaw( )
+ * @tparam  Real                   Real type
+ * @param   zeroEffortMissX        Array of x-components of ZEM vectors
+ * @param   zeroEffortMissY        Array of y-components of ZEM vectors
+ * @param   zeroEffortMissZ        Array of z-components of ZEM vectors
+ * @param   zeroEffortVelocityX    Array of x-components of ZEV vectors
+ * @param   zeroEffortVelocityY    Array of y-components of ZEV vectors
+ * @param   zeroEffortVelocityZ    Array of z-components of ZEV vectors
+ * @param   timeToGo               Array of TTGs to reach target
+ * @param   numberOfSamples        Number of samples, i.e., length of all input & output arrays
+ * @param   thrustLimits           Thrust limits, shared by all samples
+ * @param   controlEffortX         Array of x-components of computed saturated control authority
+ * @param   controlEffortY         Array of y-components of computed saturated control authority
+ * @param   controlEffortZ         Array of z-components of computed saturated control authority
+ * @param   saturationFlags        Array of bitwise combinations of ThrustSaturationFlag values
+ * @param   zeroEffortMissGain     Control gain for ZEM term, shared by all samples (default=6.0)
+ * @param   zeroEffortVelocityGain Control gain for ZEV term, shared by all samples (default=-2.0)
+ * @return                         Number of samples for which any thrust limit was active
+ */
+template< typename Real >
+std::size_t computeSaturatedOptimalGuidanceLaw( const Real* zeroEffortMissX,
+                                                const Real* zeroEffortMissY,
+                                                const Real* zeroEffortMissZ,
+                                                const Real* zeroEffortVelocityX,
+                                                const Real* zeroEffortVelocityY,
+                                                const Real* zeroEffortVelocityZ,
+                                                const Real* timeToGo,
+                                                const std::size_t numberOfSamples,
+                                                const ThrustLimits< Real >& thrustLimits,
+                                                Real* controlEffortX,
+                                                Real* controlEffortY,
+                                                Real* controlEffortZ,
+                                                unsigned char* saturationFlags,
+                                                const Real zeroEffortMissGain = Real( 6.0 ),
+                                                const Real zeroEffortVelocityGain = Real( -2.0 ) )
+{
+    return detail::computeBatchedSaturatedOptimalGuidanceLaw< Real, false >(
+        zeroEffortMissX, zeroEffortMissY, zeroEffortMissZ,
+        zeroEffortVelocityX, zeroEffortVelocityY, zeroEffortVelocityZ,
+        timeToGo, numberOfSamples, thrustLimits,
+        controlEffortX, controlEffortY, controlEffortZ, saturationFlags,
+        &zeroEffortMissGain, &zeroEffortVelocityGain );
+}
+
+//! Compute saturated control authority for Optimal Guidance Law (OGL) for a batch of samples.
+/*!
+ * Computes the saturated control authority based on the OGL for a batch of samples stored in
+ * structure-of-arrays (SoA) form, with gains specified per sample.
+ *
+ * @sa computeSaturatedOptimalGuidanceLaw( )
+ * @tparam  Real                   Real type
+ * @param   zeroEffortMissX        Array of x-components of ZEM vectors
+ * @param   zeroEffortMissY        Array of y-components of ZEM vectors
+ * @param   zeroEffortMissZ        Array of z-components of ZEM vectors
+ * @param   zeroEffortVelocityX    Array of x-components of ZEV vectors
+ * @param   zeroEffortVelocityY    Array of y-components of ZEV vectors
+ * @param   zeroEffortVelocityZ    Array of z-components of ZEV vectors
+ * @param   timeToGo               Array of TTGs to reach target
+ * @param   numberOfSamples        Number of samples, i.e., length of all input & output arrays
+ * @param   thrustLimits           Thrust limits, shared by all samples
+ * @param   controlEffortX         Array of x-components of computed saturated control authority
+ * @param   controlEffortY         Array of y-components of computed saturated control authority
+ * @param   controlEffortZ         Array of z-components of computed saturated control authority
+ * @param   saturationFlags        Array of bitwise combinations of ThrustSaturationFlag values
+ * @param   zeroEffortMissGain     Array of control gains for ZEM term
+ * @param   zeroEffortVelocityGain Array of control gains for ZEV term
+ * @return                         Number of samples for which any thrust limit was active
+ */
+template< typename Real >
+std::size_t computeSaturatedOptimalGuidanceLaw( const Real* zeroEffortMissX,
+                                                const Real* zeroEffortMissY,
+                                                const Real* zeroEffortMissZ,
+                                                const Real* zeroEffortVelocityX,
+                                                const Real* zeroEffortVelocityY,
+                                                const Real* zeroEffortVelocityZ,
+                                                const Real* timeToGo,
+                                                const std::size_t numberOfSamples,
+                                                const ThrustLimits< Real >& thrustLimits,
+                                                Real* controlEffortX,
+                                                Real* controlEffortY,
+                                                Real* controlEffortZ,
+                                                unsigned char* saturationFlags,
+                                                const Real* zeroEffortMissGain,
+                                                const Real* zeroEffortVelocityGain )
+{
+    return detail::computeBatchedSaturatedOptimalGuidanceLaw< Real, true >(
+        zeroEffortMissX, zeroEffortMissY, zeroEffortMissZ,
+        zeroEffortVelocityX, zeroEffortVelocityY, zeroEffortVelocityZ,
+        timeToGo, numberOfSamples, thrustLimits,
+        controlEffortX, controlEffortY, controlEffortZ, saturationFlags,
+        zeroEffortMissGain, zeroEffortVelocityGain );
+}
+
+} // namespace control
+
+#endif // CONTROL_THRUST_SATURATION_HPP
@@ -0,0 +1,480 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_TIME_TO_GO_SOLVER_HPP
+#define CONTROL_TIME_TO_GO_SOLVER_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace control
+{
+namespace detail
+{
+
+//! Evaluate polynomial of fourth degree and its derivative.
+/*!
+ * @param   coefficients Coefficients of polynomial, in order of increasing degree
+ * @param   x            Value at which polynomial is evaluated
+ * @param   derivative   Computed derivative of polynomial
+ * @return               Computed value of polynomial
+ */
+template< typename Real >
+inline Real evaluateQuarticPolynomial( const Real coefficients[ 5 ],
+                                       const Real x,
+                                       Real& derivative )
+{
+    Real value = coefficients[ 4 ];
+    derivative = Real( 0.0 );
+    for ( int i = 3; i >= 0; --i )
+    {
+        derivative = derivative * x + value;
+        value = value * x + coefficients[ i ];
+    }
+    return value;
+}
+
+//! Compute dot product of two 3-vectors stored as arrays.
+template< typename Real >
+inline Real computeDotProduct( const Real first[ 3 ], const Real second[ 3 ] )
+{
+    return first[ 0 ] * second[ 0 ] + first[ 1 ] * second[ 1 ] + first[ 2 ] * second[ 2 ];
+}
+
+//! Compute coefficients of polynomial for optimal TTG.
+/*!
+ * Computes the coefficients of the quartic polynomial whose positive root is the optimal TTG, for
+ * the given state relative to the target and constant gravitational acceleration.
+ *
+ * @sa computeOptimalTimeToGo( )
+ * @param   positionDifference Difference between target position and current position
+ * @param   velocity           Current velocity
+ * @param   velocityDifference Difference between target velocity and current velocity
+ * @param   gravity            Constant gravitational acceleration
+ * @param   timeWeight         Weight of final time in cost function
+ * @param   coefficients       Computed coefficients, in order of increasing degree
+ */
+template< typename Real >
+inline void computeTimeToGoPolynomial( const Real positionDifference[ 3 ],
+                                       const Real velocity[ 3 ],
+                                       const Real velocityDifference[ 3 ],
+                                       const Real gravity[ 3 ],
+                                       const Real timeWeight,
+                                       Real coefficients[ 5 ] )
+{
+    // ZEM(T) = a0 + a1 T + a2 T^2 and ZEV(T) = b0 + b1 T, with a0 = r_f - r, a1 = -v, a2 = -g/2,
+    // b0 = v_f - v and b1 = -g. The coefficients m_k of |ZEM|^2, c_k of ZEM.ZEV and e_k of
+    // |ZEV|^2 follow from the dot products of these vectors.
+    const Real dd = computeDotProduct( positionDifference, positionDifference );
+    const Real dv = computeDotProduct( positionDifference, velocity );
+    const Real dw = computeDotProduct( positionDifference, velocityDifference );
+    const Real dg = computeDotProduct( positionDifference, gravity );
+    const Real vv = computeDotProduct( velocity, velocity );
+    const Real vw = computeDotProduct( velocity, velocityDifference );
+    const Real vg = computeDotProduct( velocity, gravity );
+    const Real ww = computeDotProduct( velocityDifference, velocityDifference );
+    const Real wg = computeDotProduct( velocityDifference, gravity );
+    const Real gg = computeDotProduct( gravity, gravity );
+
+    const Real m[ 5 ] = { dd, Real( -2.0 ) * dv, vv - dg, vg, Real( 0.25 ) * gg };
+    const Real c[ 4 ] = { dw, -dg - vw, vg - Real( 0.5 ) * wg, Real( 0.5 ) * gg };
+    const Real e[ 3 ] = { ww, Real( -2.0 ) * wg, gg };
+
+    // P(T) = T^4 dJ/dT = Gamma T^4 + sum_k 6 (k - 3) m_k T^k - sum_k 6 (k - 2) c_k T^(k + 1)
+    //                    + sum_k 2 (k - 1) e_k T^(k + 2).
+    for ( unsigned int k = 0; k < 5; ++k )
+    {
+        coefficients[ k ] = Real( 6.0 ) * ( static_cast< Real >( k ) - Real( 3.0 ) ) * m[ k ];
+    }
+    for ( unsigned int k = 0; k < 4; ++k )
+    {
+        coefficients[ k + 1 ]
+            -= Real( 6.0 ) * ( static_cast< Real >( k ) - Real( 2.0 ) ) * c[ k ];
+    }
+    for ( unsigned int k = 0; k < 3; ++k )
+    {
+        coefficients[ k + 2 ]
+            += Real( 2.0 ) * ( static_cast< Real >( k ) - Real( 1.0 ) ) * e[ k ];
+    }
+    coefficients[ 4 ] += timeWeight;
+}
+
+//! Solve polynomial for optimal TTG.
+/*!
+ * Finds a positive root of the quartic polynomial for the optimal TTG using Newton's method,
+ * started from the given initial guess. The root is bracketed between zero, where the polynomial
+ * is negative, and the Cauchy bound on its roots, where it is positive; Newton steps that leave
+ * the bracket are replaced by bisection steps, such that convergence is guaranteed.
+ *
+ * @param   coefficients        Coefficients of polynomial, in order of increasing degree
+ * @param   initialGuess        Initial guess; if not strictly positive, the midpoint of the
+ *                              initial bracket is used
+ * @param   relativeTolerance   Relative tolerance on TTG
+ * @param   maximumIterations   Maximum number of iterations
+ * @param   numberOfIterations  Number of iterations performed
+ * @return                      Optimal TTG
+ */
+template< typename Real >
+inline Real solveTimeToGoPolynomial( const Real coefficients[ 5 ],
+                                     const Real initialGuess,
+                                     const Real relativeTolerance,
+                                     const unsigned int maximumIterations,
+                                     unsigned int& numberOfIterations )
+{
+    numberOfIterations = 0;
+
+    // If the current position is the target position, the optimal TTG is zero.
+    if ( !( coefficients[ 0 ] < Real( 0.0 ) ) || !( coefficients[ 4 ] > Real( 0.0 ) ) )
+    {
+        return Real( 0.0 );
+    }
+
+    Real lowerBound = Real( 0.0 );
+    Real upperBound = Real( 0.0 );
+    for ( unsigned int i = 0; i < 4; ++i )
+    {
+        const Real ratio = std::fabs( coefficients[ i ] / coefficients[ 4 ] );
+        upperBound = ratio > upperBound ? ratio : upperBound;
+    }
+    upperBound += Real( 1.0 );
+
+    Real timeToGo = initialGuess > lowerBound && initialGuess < upperBound
+        ? initialGuess : Real( 0.5 ) * ( lowerBound + upperBound );
+
+    while ( numberOfIterations < maximumIterations )
+    {
+        ++numberOfIterations;
+
+        Real derivative = Real( 0.0 );
+        const Real value = evaluateQuarticPolynomial( coefficients, timeToGo, derivative );
+        if ( value == Real( 0.0 ) )
+        {
+            break;
+        }
+        else if ( value < Real( 0.0 ) )
+        {
+            lowerBound = timeToGo;
+        }
+        else
+        {
+            upperBound = timeToGo;
+        }
+
+        Real nextTimeToGo = timeToGo - value / derivative;
+        if ( !( nextTimeToGo > lowerBound && nextTimeToGo < upperBound ) )
+        {
+            nextTimeToGo = Real( 0.5 ) * ( lowerBound + upperBound );
+        }
+
+        const Real step = std::fabs( nextTimeToGo - timeToGo );
+        timeToGo = nextTimeToGo;
+        if ( step <= relativeTolerance * timeToGo )
+        {
+            break;
+        }
+    }
+
+    return timeToGo;
+}
+
+} // namespace detail
+
+//! Compute optimal Time-To-Go (TTG) for constant gravity.
+/*!
+ * Computes the optimal TTG for the free-final-time, energy-optimal guidance problem under constant
+ * gravity, i.e., the TTG that minimizes the cost function
+ *
+ * \f[
+ *      J = \Gamma t_{f} + \frac{1}{2} \int_{t}^{t_{f}} \vec{u}^{T} \vec{u} \, d\tau
+ * \f]
+ *
+ * where \f$\Gamma\f$ is the weight of the final time. Along the optimal trajectory, which is
+ * followed by the OGL (see computeOptimalGuidanceLaw( )), the cost-to-go for a given TTG
+ * \f$T\f$ is
+ *
+ * \f[
+ *      J(T) = \Gamma T + \frac{6 |\vec{\text{ZEM}}|^{2}}{T^{3}}
+ *              - \frac{6 \vec{\text{ZEM}} \cdot \vec{\text{ZEV}}}{T^{2}}
+ *              + \frac{2 |\vec{\text{ZEV}}|^{2}}{T}
+ * \f]
+ *
+ * where the ZEM and ZEV vectors are polynomials in \f$T\f$ for constant gravity. The optimality
+ * condition \f$dJ/dT = 0\f$, multiplied by \f$T^{4}\f$, is a quartic polynomial in \f$T\f$ (Guo et
+ * al., 2013), whose leading coefficient is \f$\Gamma + \frac{1}{2} |\vec{g}|^{2}\f$. Its positive
+ * root is found with a safeguarded Newton method. When warm-started from the solution at the
+ * previous guidance step, minus the elapsed time, Newton's method typically converges in one or
+ * two iterations.
+ *
+ * If the polynomial has multiple positive roots, the root found is the one that the iteration
+ * converges to from the initial guess, such that warm-starting tracks a continuous solution
+ * branch.
+ *
+ * @tparam  Real                       Real type
+ * @tparam  Vector3                    3-Vector type
+ * @param   position                   Current position
+ * @param   velocity                   Current velocity
+ * @param   targetPosition             Target position
+ * @param   targetVelocity             Target velocity
+ * @param   gravitationalAcceleration  Constant gravitational acceleration
+ * @param   timeWeight                 Weight of final time in cost function
+ * @param   initialGuess               Initial guess for TTG; if not strictly positive, the solver
+ *                                     is started without an initial guess (default=0.0)
+ * @param   relativeTolerance          Relative tolerance on TTG (default=square root of machine
+ *                                     precision)
+ * @param   maximumIterations          Maximum number of iterations (default=100)
+ * @return                             Optimal TTG
+ */
+template< typename Real, typename Vector3 >
+Real computeOptimalTimeToGo(
+    const Vector3& position,
+    const Vector3& velocity,
+    const Vector3& targetPosition,
+    const Vector3& targetVelocity,
+    const Vector3& gravitationalAcceleration,
+    const Real timeWeight,
+    const Real initialGuess = Real( 0.0 ),
+    const Real relativeTolerance = std::sqrt( std::numeric_limits< Real >::epsilon( ) ),
+    const unsigned int maximumIterations = 100 )
+{
+    Real positionDifference[ 3 ];
+    Real currentVelocity[ 3 ];
+    Real velocityDifference[ 3 ];
+    Real gravity[ 3 ];
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+        positionDifference[ i ] = targetPosition[ i ] - position[ i ];
+        currentVelocity[ i ] = velocity[ i ];
+        velocityDifference[ i ] = targetVelocity[ i ] - velocity[ i ];
+        gravity[ i ] = gravitationalAcceleration[ i ];
+    }
+
+    Real coefficients[ 5 ];
+    detail::computeTimeToGoPolynomial( positionDifference,
+                                       currentVelocity,
+                                       velocityDifference,
+                                       gravity,
+                                       timeWeight,
+                                       coefficients );
+
+    unsigned int numberOfIterations = 0;
+    return detail::solveTimeToGoPolynomial(
+        coefficients, initialGuess, relativeTolerance, maximumIterations, numberOfIterations );
+}
+
+//! Compute optimal Time-To-Go (TTG) for constant gravity for a batch of samples.
+/*!
+ * Computes the optimal TTG for a batch of samples stored in structure-of-arrays (SoA) form, e.g.,
+ * for a Monte Carlo population, with the target state and gravitational acceleration shared by all
+ * samples. The TTG array is used both for the initial guesses and for the solutions, such that
+ * calling this function at each guidance step warm-starts each sample from its previous solution.
+ * Before the first guidance step, the TTG array should be filled with zeros, or with the previous
+ * solutions minus the elapsed time at later steps. No memory is allocated.
+ *
+ * @sa computeOptimalTimeToGo( )
+ * @tparam  Real                       Real type
+ * @tparam  Vector3                    3-Vector type
+ * @param   positionX                  Array of x-components of current positions
+ * @param   positionY                  Array of y-components of current positions
+ * @param   positionZ                  Array of z-components of current positions
+ * @param   velocityX                  Array of x-components of current velocities
+ * @param   velocityY                  Array of y-components of current velocities
+ * @param   velocityZ                  Array of z-components of current velocities
+ * @param   numberOfSamples            Number of samples, i.e., length of all arrays
+ * @param   targetPosition             Target position
+ * @param   targetVelocity             Target velocity
+ * @param   gravitationalAcceleration  Constant gravitational acceleration
+ * @param   timeWeight                 Weight of final time in cost function
+ * @param   timeToGo                   Array of initial guesses on input, and of optimal TTGs on
+ *                                     output
+ * @param   relativeTolerance          Relative tolerance on TTG (default=square root of machine
+ *                                     precision)
+ * @param   maximumIterations          Maximum number of iterations (default=100)
+ */
+template< typename Real, typename Vector3 >
+void computeOptimalTimeToGo(
+    const Real* positionX,
+    const Real* positionY,
+    const Real* positionZ,
+    const Real* velocityX,
+    const Real* velocityY,
+    const Real* velocityZ,
+    const std::size_t numberOfSamples,
+    const Vector3& targetPosition,
+    const Vector3& targetVelocity,
+    const Vector3& gravitationalAcceleration,
+    const Real timeWeight,
+    Real* timeToGo,
+    const Real relativeTolerance = std::sqrt( std::numeric_limits< Real >::epsilon( ) ),
+    const unsigned int maximumIterations = 100 )
+{
+    const Real gravity[ 3 ] = { gravitationalAcceleration[ 0 ],
+                                gravitationalAcceleration[ 1 ],
+                                gravitationalAcceleration[ 2 ] };
+
+    for ( std::size_t i = 0; i < numberOfSamples; ++i )
+    {
+        const Real positionDifference[ 3 ] = { targetPosition[ 0 ] - positionX[ i ],
+                                               targetPosition[ 1 ] - positionY[ i ],
+                                               targetPosition[ 2 ] - positionZ[ i ] };
+        const Real velocity[ 3 ] = { velocityX[ i ], velocityY[ i ], velocityZ[ i ] };
+        const Real velocityDifference[ 3 ] = { targetVelocity[ 0 ] - velocityX[ i ],
+                                               targetVelocity[ 1 ] - velocityY[ i ],
+                                               targetVelocity[ 2 ] - velocityZ[ i ] };
+
+        Real coefficients[ 5 ];
+        detail::computeTimeToGoPolynomial(
+            positionDifference, velocity, velocityDifference, gravity, timeWeight, coefficients );
+
+        unsigned int numberOfIterations = 0;
+        timeToGo[ i ] = detail::solveTimeToGoPolynomial(
+            coefficients, timeToGo[ i ], relativeTolerance, maximumIterations, numberOfIterations );
+    }
+}
+
+//! Warm-started optimal Time-To-Go (TTG) solver for constant gravity.
+/*!
+ * Solver for the optimal TTG (see computeOptimalTimeToGo( )) at successive guidance steps. At each
+ * step, the solver is warm-started from the solution at the previous step, minus the time elapsed
+ * since, which is the exact solution if the vehicle has followed the optimal trajectory. The
+ * solver does not allocate memory.
+ *
+ * @sa computeOptimalTimeToGo( )
+ * @tparam  Real    Real type
+ * @tparam  Vector3 3-Vector type
+ */
+template< typename Real, typename Vector3 >
+class TimeToGoSolver
+{
+public:
+
+    //! Construct solver.
+    /*!
+     * @param   aTargetPosition             Target position
+     * @param   aTargetVelocity             Target velocity
+     * @param   aGravitationalAcceleration  Constant gravitational acceleration
+     * @param   aTimeWeight                 Weight of final time in cost function
+     * @param   aRelativeTolerance          Relative tolerance on TTG (default=square root of
+     *                                      machine precision)
+     * @param   aMaximumIterations          Maximum number of iterations (default=100)
+     */
+    TimeToGoSolver(
+        const Vector3& aTargetPosition,
+        const Vector3& aTargetVelocity,
+        const Vector3& aGravitationalAcceleration,
+        const Real aTimeWeight,
+        const Real aRelativeTolerance = std::sqrt( std::numeric_limits< Real >::epsilon( ) ),
+        const unsigned int aMaximumIterations = 100 )
+        : timeWeight( aTimeWeight ),
+          relativeTolerance( aRelativeTolerance ),
+          maximumIterations( aMaximumIterations ),
+          hasSolution( false ),
+          previousTime( Real( 0.0 ) ),
+          timeToGo( Real( 0.0 ) ),
+          numberOfIterations( 0 )
+    {
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            targetPosition[ i ] = aTargetPosition[ i ];
+            targetVelocity[ i ] = aTargetVelocity[ i ];
+            gravity[ i ] = aGravitationalAcceleration[ i ];
+        }
+    }
+
+    //! Solve for optimal TTG.
+    /*!
+     * @param   currentTime Current time
+     * @param   position    Current position
+     * @param   velocity    Current velocity
+     * @return              Optimal TTG
+     */
+    Real solve( const Real currentTime, const Vector3& position, const Vector3& velocity )
+    {
+        Real positionDifference[ 3 ];
+        Real currentVelocity[ 3 ];
+        Real velocityDifference[ 3 ];
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            positionDifference[ i ] = targetPosition[ i ] - position[ i ];
+            currentVelocity[ i ] = velocity[ i ];
+            velocityDifference[ i ] = targetVelocity[ i ] - velocity[ i ];
+        }
+
+        Real coefficients[ 5 ];
+        detail::computeTimeToGoPolynomial( positionDifference,
+                                           currentVelocity,
+                                           velocityDifference,
+                                           gravity,
+                                           timeWeight,
+                                           coefficients );
+
+        const Real initialGuess
+            = hasSolution ? timeToGo - ( currentTime - previousTime ) : Real( 0.0 );
+        timeToGo = detail::solveTimeToGoPolynomial(
+            coefficients, initialGuess, relativeTolerance, maximumIterations, numberOfIterations );
+        previousTime = currentTime;
+        hasSolution = true;
+        return timeToGo;
+    }
+
+    //! Reset solver, such that the next solve is not warm-started.
+    void reset( ) { hasSolution = false; }
+
+    //! Get TTG computed at last call to solve( ).
+    /*!
+     * @return TTG
+     */
+    Real getTimeToGo( ) const { return timeToGo; }
+
+    //! Get number of iterations performed at last call to solve( ).
+    /*!
+     * @return Number of iterations
+     */
+    unsigned int getNumberOfIterations( ) const { return numberOfIterations; }
+
+private:
+
+    //! Target position.
+    Real targetPosition[ 3 ];
+
+    //! Target velocity.
+    Real targetVelocity[ 3 ];
+
+    //! Constant gravitational acceleration.
+    Real gravity[ 3 ];
+
+    //! Weight of final time in cost function.
+    Real timeWeight;
+
+    //! Relative tolerance on TTG.
+    Real relativeTolerance;
+
+    //! Maximum number of iterations.
+    unsigned int maximumIterations;
+
+    //! Flag indicating if a previous solution is available for warm-starting.
+    bool hasSolution;
+
+    //! Time at last call to solve( ).
+    Real previousTime;
+
+    //! TTG computed at last call to solve( ).
+    Real timeToGo;
+
+    //! Number of iterations performed at last call to solve( ).
+    unsigned int numberOfIterations;
+};
+
+} // namespace control
+
+#endif // CONTROL_TIME_TO_GO_SOLVER_HPP
+
+/*
+ * References
+ * Guo, Y., Hawkins, M., Wie, B. (2013) Applications of Generalized
+ *  Zero-Effort-Miss/Zero-Effort-Velocity Feedback Guidance Algorithm, Journal of Guidance, Control,
+ *  and Dynamics, pg. 810-820, vol. 36, doi: 10.2514/1.58099.
+ */
@@ -0,0 +1,587 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_TRAJECTORY_LOGGER_HPP
+#define CONTROL_TRAJECTORY_LOGGER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "control/ringBuffer.hpp"
+
+namespace control
+{
+
+//! Record of inputs and outputs of a single guidance step.
+template< typename Real >
+struct GuidanceLogRecord
+{
+    //! Time of guidance step.
+    Real time;
+
+    //! TTG to reach target.
+    Real timeToGo;
+
+    //! ZEM vector.
+    Real zeroEffortMiss[ 3 ];
+
+    //! ZEV vector.
+    Real zeroEffortVelocity[ 3 ];
+
+    //! Commanded control authority.
+    Real controlEffort[ 3 ];
+};
+
+//! Compression of the columns of a trajectory log.
+enum TrajectoryLogCompression
+{
+    //! Values are stored as raw little-endian bit patterns.
+    uncompressedTrajectoryLog,
+
+    //! Values are stored as XOR-deltas of successive bit patterns, without leading zero bytes.
+    xorDeltaTrajectoryLog
+};
+
+namespace detail
+{
+
+//! Number of columns of a trajectory log, i.e., number of values per GuidanceLogRecord.
+const unsigned int numberOfTrajectoryLogColumns = 11;
+
+//! Magic number at the start of a trajectory log file.
+const char trajectoryLogMagic[ 4 ] = { 'C', 'T', 'L', 'G' };
+
+//! Version of the trajectory log file format.
+const unsigned char trajectoryLogVersion = 1;
+
+//! Size of the header of a trajectory log file in bytes.
+const std::size_t trajectoryLogHeaderSize = 8;
+
+//! Unsigned integer type with the same size as the Real type, used to store bit patterns.
+template< typename Real >
+struct TrajectoryLogBits
+{
+    static_assert( sizeof( Real ) == 4 || sizeof( Real ) == 8,
+                   "Trajectory logs support 32-bit and 64-bit real types only" );
+
+    //! Bit pattern type.
+    typedef typename std::conditional<
+        sizeof( Real ) == 8, std::uint64_t, std::uint32_t >::type Type;
+};
+
+//! Get value of given column of a record.
+template< typename Real >
+inline const Real& getTrajectoryLogValue( const GuidanceLogRecord< Real >& record,
+                                          const unsigned int column )
+{
+    if ( column == 0 )
+    {
+        return record.time;
+    }
+    if ( column == 1 )
+    {
+        return record.timeToGo;
+    }
+    if ( column < 5 )
+    {
+        return record.zeroEffortMiss[ column - 2 ];
+    }
+    if ( column < 8 )
+    {
+        return record.zeroEffortVelocity[ column - 5 ];
+    }
+    return record.controlEffort[ column - 8 ];
+}
+
+//! Get value of given column of a record.
+template< typename Real >
+inline Real& getTrajectoryLogValue( GuidanceLogRecord< Real >& record, const unsigned int column )
+{
+    const GuidanceLogRecord< Real >& constantRecord = record;
+    return const_cast< Real& >( getTrajectoryLogValue( constantRecord, column ) );
+}
+
+//! Append 32-bit unsigned integer in little-endian byte order.
+inline void appendUnsigned32( const std::uint32_t value, std::vector< unsigned char >& bytes )
+{
+    for ( unsigned int i = 0; i < 4; ++i )
+    {
+        bytes.push_back( static_cast< unsigned char >( value >> ( 8 * i ) ) );
+    }
+}
+
+//! Read 32-bit unsigned integer in little-endian byte order.
+inline std::uint32_t readUnsigned32( const unsigned char* bytes )
+{
+    std::uint32_t value = 0;
+    for ( unsigned int i = 0; i < 4; ++i )
+    {
+        value |= static_cast< std::uint32_t >( bytes[ i ] ) << ( 8 * i );
+    }
+    return value;
+}
+
+//! Encode column of block of records and append it to byte buffer.
+/*!
+ * For XOR-delta compression, each value is stored as the XOR of its bit pattern with the bit
+ * pattern of the previous value in the column (zero for the first value of a block), preceded by
+ * a single byte holding the number of significant bytes of the XOR. Slowly varying signals share
+ * the sign, the exponent and the leading mantissa bits, so that their XOR-deltas have leading zero
+ * bytes, which are dropped.
+ */
+template< typename Real >
+inline void encodeTrajectoryLogColumn( const std::vector< GuidanceLogRecord< Real > >& records,
+                                       const unsigned int column,
+                                       const TrajectoryLogCompression compression,
+                                       std::vector< unsigned char >& bytes )
+{
+    typedef typename TrajectoryLogBits< Real >::Type Bits;
+
+    Bits previousBits = 0;
+    for ( std::size_t i = 0; i < records.size( ); ++i )
+    {
+        Bits bits;
+        std::memcpy( &bits, &getTrajectoryLogValue( records[ i ], column ), sizeof( Bits ) );
+
+        Bits delta = bits;
+        unsigned int numberOfBytes = sizeof( Bits );
+        if ( compression == xorDeltaTrajectoryLog )
+        {
+            delta = bits ^ previousBits;
+            previousBits = bits;
+            numberOfBytes = 0;
+            for ( Bits remainder = delta; remainder != 0; remainder >>= 8 )
+            {
+                ++numberOfBytes;
+            }
+            bytes.push_back( static_cast< unsigned char >( numberOfBytes ) );
+        }
+
+        for ( unsigned int j = 0; j < numberOfBytes; ++j )
+        {
+            bytes.push_back( static_cast< unsigned char >( delta >> ( 8 * j ) ) );
+        }
+    }
+}
+
+//! Decode column of block of records, returning false if the column is malformed.
+template< typename Real >
+inline bool decodeTrajectoryLogColumn( const unsigned char* bytes,
+                                       const std::size_t numberOfBytes,
+                                       const unsigned int column,
+                                       const TrajectoryLogCompression compression,
+                                       GuidanceLogRecord< Real >* records,
+                                       const std::size_t numberOfRecords )
+{
+    typedef typename TrajectoryLogBits< Real >::Type Bits;
+
+    std::size_t position = 0;
+    Bits previousBits = 0;
+    for ( std::size_t i = 0; i < numberOfRecords; ++i )
+    {
+        unsigned int numberOfValueBytes = sizeof( Bits );
+        if ( compression == xorDeltaTrajectoryLog )
+        {
+            if ( position >= numberOfBytes || bytes[ position ] > sizeof( Bits ) )
+            {
+                return false;
+            }
+            numberOfValueBytes = bytes[ position++ ];
+        }
+        if ( position + numberOfValueBytes > numberOfBytes )
+        {
+            return false;
+        }
+
+        Bits bits = 0;
+        for ( unsigned int j = 0; j < numberOfValueBytes; ++j )
+        {
+            bits |= static_cast< Bits >( bytes[ position++ ] ) << ( 8 * j );
+        }
+        if ( compression == xorDeltaTrajectoryLog )
+        {
+            bits ^= previousBits;
+            previousBits = bits;
+        }
+
+        std::memcpy( &getTrajectoryLogValue( records[ i ], column ), &bits, sizeof( Bits ) );
+    }
+
+    return position == numberOfBytes;
+}
+
+} // namespace detail
+
+//! Streaming logger of guidance inputs and outputs to a columnar binary file.
+/*!
+ * Logs the time, TTG, ZEM, ZEV and commanded control authority of each guidance step to a binary
+ * file. The control thread only copies a fixed-size record into a preallocated slot of a
+ * lock-free single-producer, single-consumer ring buffer (see
+ * SingleProducerSingleConsumerRingBuffer); it never blocks, allocates memory or performs I/O. If
+ * the ring buffer is full, the record is dropped and counted. A background thread drains the ring
+ * buffer, and encodes and writes the records in blocks.
+ *
+ * The file starts with an 8-byte header: the magic number "CTLG", the format version, the size
+ * of the Real type in bytes, the compression (see TrajectoryLogCompression) and the number of
+ * columns. Each block consists of the number of records in the block, followed by the columns in
+ * the order of GuidanceLogRecord (time, TTG, ZEM, ZEV and control authority components), each
+ * stored as its size in bytes followed by the encoded values. All integers are stored as 32-bit
+ * little-endian numbers. Each block can be decoded independently; readTrajectoryLog( ) reads a
+ * complete file.
+ *
+ * Only one thread may call log( ). The log is completed by close( ), which is also called by the
+ * destructor.
+ *
+ * @tparam  Real Real type, which must be a 32-bit or 64-bit floating-point type
+ */
+template< typename Real >
+class TrajectoryLogger
+{
+public:
+
+    //! Open log file and start background writer thread.
+    /*!
+     * @param   aFilePath               Path to log file, which is overwritten
+     * @param   aCompression            Compression of columns (default=xorDeltaTrajectoryLog)
+     * @param   aCapacity               Minimum capacity of ring buffer in records (default=8192)
+     * @param   aNumberOfRecordsPerBlock Number of records per block of log file (default=1024)
+     */
+    explicit TrajectoryLogger(
+        const std::string& aFilePath,
+        const TrajectoryLogCompression aCompression = xorDeltaTrajectoryLog,
+        const std::size_t aCapacity = 8192,
+        const std::size_t aNumberOfRecordsPerBlock = 1024 )
+        : compression( aCompression ),
+          numberOfRecordsPerBlock( aNumberOfRecordsPerBlock > 0 ? aNumberOfRecordsPerBlock : 1 ),
+          ringBuffer( aCapacity ),
+          file( std::fopen( aFilePath.c_str( ), "wb" ) ),
+          isStopping( false ),
+          hasWriteError( false ),
+          numberOfDroppedRecords( 0 ),
+          numberOfWrittenRecords( 0 )
+    {
+        if ( file == 0 )
+        {
+            return;
+        }
+
+        const unsigned char header[ detail::trajectoryLogHeaderSize ]
+            = { static_cast< unsigned char >( detail::trajectoryLogMagic[ 0 ] ),
+                static_cast< unsigned char >( detail::trajectoryLogMagic[ 1 ] ),
+                static_cast< unsigned char >( detail::trajectoryLogMagic[ 2 ] ),
+                static_cast< unsigned char >( detail::trajectoryLogMagic[ 3 ] ),
+                detail::trajectoryLogVersion,
+                static_cast< unsigned char >( sizeof( Real ) ),
+                static_cast< unsigned char >( compression ),
+                static_cast< unsigned char >( detail::numberOfTrajectoryLogColumns ) };
+        hasWriteError = std::fwrite( header, 1, sizeof( header ), file ) != sizeof( header );
+
+        writer = std::thread( &TrajectoryLogger::runWriter, this );
+    }
+
+    //! Close log file.
+    ~TrajectoryLogger( ) { close( ); }
+
+    //! Log guidance step.
+    /*!
+     * Copies the inputs and outputs of a guidance step into the ring buffer. This function does
+     * not block, allocate memory or perform I/O.
+     *
+     * @tparam  Vector3             3-Vector type
+     * @param   time                Time of guidance step
+     * @param   timeToGo            TTG to reach target
+     * @param   zeroEffortMiss      ZEM vector
+     * @param   zeroEffortVelocity  ZEV vector
+     * @param   controlEffort       Commanded control authority
+     * @return                      True if the record was logged, false if it was dropped
+     */
+    template< typename Vector3 >
+    bool log( const Real time,
+              const Real timeToGo,
+              const Vector3& zeroEffortMiss,
+              const Vector3& zeroEffortVelocity,
+              const Vector3& controlEffort )
+    {
+        GuidanceLogRecord< Real > record;
+        record.time = time;
+        record.timeToGo = timeToGo;
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            record.zeroEffortMiss[ i ] = static_cast< Real >( zeroEffortMiss[ i ] );
+            record.zeroEffortVelocity[ i ] = static_cast< Real >( zeroEffortVelocity[ i ] );
+            record.controlEffort[ i ] = static_cast< Real >( controlEffort[ i ] );
+        }
+        return log( record );
+    }
+
+    //! Log guidance step.
+    /*!
+     * @param   record Record of guidance step
+     * @return         True if the record was logged, false if it was dropped
+     */
+    bool log( const GuidanceLogRecord< Real >& record )
+    {
+        if ( file == 0 || ringBuffer.tryPush( record ) )
+        {
+            return file != 0;
+        }
+
+        numberOfDroppedRecords.store( numberOfDroppedRecords.load( std::memory_order_relaxed ) + 1,
+                                      std::memory_order_relaxed );
+        return false;
+    }
+
+    //! Close log file, after writing all logged records.
+    /*!
+     * Stops the background writer thread once it has written all records in the ring buffer, and
+     * closes the file. Must not be called concurrently with log( ).
+     *
+     * @return True if the log file was opened and all records were written successfully
+     */
+    bool close( )
+    {
+        if ( writer.joinable( ) )
+        {
+            isStopping.store( true, std::memory_order_release );
+            writer.join( );
+        }
+        if ( file != 0 )
+        {
+            hasWriteError = std::fclose( file ) != 0 || hasWriteError;
+            file = 0;
+            return !hasWriteError;
+        }
+        return false;
+    }
+
+    //! Check if log file is open.
+    /*!
+     * @return True if the log file was opened successfully and has not been closed
+     */
+    bool isOpen( ) const { return file != 0; }
+
+    //! Get number of records dropped since the ring buffer was full.
+    /*!
+     * @return Number of dropped records
+     */
+    std::size_t getNumberOfDroppedRecords( ) const
+    {
+        return numberOfDroppedRecords.load( std::memory_order_relaxed );
+    }
+
+    //! Get number of records written to the log file.
+    /*!
+     * @return Number of written records, which is exact once close( ) has returned
+     */
+    std::size_t getNumberOfWrittenRecords( ) const
+    {
+        return numberOfWrittenRecords.load( std::memory_order_relaxed );
+    }
+
+private:
+
+    //! Copying is disabled, since the logger owns a file and a thread.
+    TrajectoryLogger( const TrajectoryLogger& );
+
+    //! Assignment is disabled, since the logger owns a file and a thread.
+    TrajectoryLogger& operator=( const TrajectoryLogger& );
+
+    //! Drain ring buffer and write blocks until stopped.
+    void runWriter( )
+    {
+        std::vector< GuidanceLogRecord< Real > > block;
+        block.reserve( numberOfRecordsPerBlock );
+        std::vector< unsigned char > bytes;
+
+        for ( ;; )
+        {
+            // The stop flag is read before draining, such that all records logged before close( )
+            // are written.
+            const bool isFinalPass = isStopping.load( std::memory_order_acquire );
+
+            GuidanceLogRecord< Real > record;
+            bool isEmpty = true;
+            while ( ringBuffer.tryPop( record ) )
+            {
+                isEmpty = false;
+                block.push_back( record );
+                if ( block.size( ) == numberOfRecordsPerBlock )
+                {
+                    writeBlock( block, bytes );
+                }
+            }
+
+            if ( isFinalPass )
+            {
+                break;
+            }
+            if ( isEmpty )
+            {
+                std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+            }
+        }
+
+        if ( !block.empty( ) )
+        {
+            writeBlock( block, bytes );
+        }
+        std::fflush( file );
+    }
+
+    //! Encode and write block of records, and clear block.
+    void writeBlock( std::vector< GuidanceLogRecord< Real > >& block,
+                     std::vector< unsigned char >& bytes )
+    {
+        bytes.clear( );
+        detail::appendUnsigned32( static_cast< std::uint32_t >( block.size( ) ), bytes );
+        for ( unsigned int column = 0; column < detail::numberOfTrajectoryLogColumns; ++column )
+        {
+            const std::size_t sizePosition = bytes.size( );
+            detail::appendUnsigned32( 0, bytes );
+            detail::encodeTrajectoryLogColumn( block, column, compression, bytes );
+            const std::uint32_t columnSize
+                = static_cast< std::uint32_t >( bytes.size( ) - sizePosition - 4 );
+            for ( unsigned int i = 0; i < 4; ++i )
+            {
+                bytes[ sizePosition + i ] = static_cast< unsigned char >( columnSize >> ( 8 * i ) );
+            }
+        }
+
+        hasWriteError = std::fwrite( &bytes[ 0 ], 1, bytes.size( ), file ) != bytes.size( )
+                        || hasWriteError;
+        numberOfWrittenRecords.store(
+            numberOfWrittenRecords.load( std::memory_order_relaxed ) + block.size( ),
+            std::memory_order_relaxed );
+        block.clear( );
+    }
+
+    //! Compression of columns.
+    const TrajectoryLogCompression compression;
+
+    //! Number of records per block of log file.
+    const std::size_t numberOfRecordsPerBlock;
+
+    //! Ring buffer between control thread and writer thread.
+    SingleProducerSingleConsumerRingBuffer< GuidanceLogRecord< Real > > ringBuffer;
+
+    //! Log file.
+    std::FILE* file;
+
+    //! Flag indicating that the writer thread should stop once the ring buffer is drained.
+    std::atomic< bool > isStopping;
+
+    //! Flag indicating that writing to the log file failed.
+    bool hasWriteError;
+
+    //! Number of records dropped since the ring buffer was full, written by the control thread.
+    std::atomic< std::size_t > numberOfDroppedRecords;
+
+    //! Number of records written to the log file, written by the writer thread.
+    std::atomic< std::size_t > numberOfWrittenRecords;
+
+    //! Background writer thread.
+    std::thread writer;
+};
+
+//! Read trajectory log file.
+/*!
+ * Reads all records of a log file written by TrajectoryLogger with the same Real type.
+ *
+ * @tparam  Real     Real type
+ * @param   filePath Path to log file
+ * @param   records  Records read from log file, in the order in which they were logged
+ * @return           True if the file was read successfully, false if it could not be opened, is
+ *                   malformed or truncated, or was written with a different Real type
+ */
+template< typename Real >
+bool readTrajectoryLog( const std::string& filePath,
+                        std::vector< GuidanceLogRecord< Real > >& records )
+{
+    records.clear( );
+
+    std::FILE* file = std::fopen( filePath.c_str( ), "rb" );
+    if ( file == 0 )
+    {
+        return false;
+    }
+    std::vector< unsigned char > bytes;
+    unsigned char buffer[ 4096 ];
+    for ( std::size_t numberOfBytesRead = std::fread( buffer, 1, sizeof( buffer ), file );
+          numberOfBytesRead > 0;
+          numberOfBytesRead = std::fread( buffer, 1, sizeof( buffer ), file ) )
+    {
+        bytes.insert( bytes.end( ), buffer, buffer + numberOfBytesRead );
+    }
+    std::fclose( file );
+
+    if ( bytes.size( ) < detail::trajectoryLogHeaderSize
+         || std::memcmp( &bytes[ 0 ], detail::trajectoryLogMagic, 4 ) != 0
+         || bytes[ 4 ] != detail::trajectoryLogVersion
+         || bytes[ 5 ] != sizeof( Real )
+         || bytes[ 6 ] > xorDeltaTrajectoryLog
+         || bytes[ 7 ] != detail::numberOfTrajectoryLogColumns )
+    {
+        return false;
+    }
+    const TrajectoryLogCompression compression
+        = static_cast< TrajectoryLogCompression >( bytes[ 6 ] );
+
+    std::size_t position = detail::trajectoryLogHeaderSize;
+    while ( position < bytes.size( ) )
+    {
+        if ( position + 4 > bytes.size( ) )
+        {
+            return false;
+        }
+        const std::size_t numberOfRecords = detail::readUnsigned32( &bytes[ position ] );
+        position += 4;
+
+        // Each record takes at least one byte per column, such that a corrupt record count is
+        // rejected before the records are allocated.
+        if ( numberOfRecords
+             > ( bytes.size( ) - position ) / detail::numberOfTrajectoryLogColumns )
+        {
+            return false;
+        }
+
+        const std::size_t firstRecord = records.size( );
+        records.resize( firstRecord + numberOfRecords );
+        for ( unsigned int column = 0; column < detail::numberOfTrajectoryLogColumns; ++column )
+        {
+            if ( position + 4 > bytes.size( ) )
+            {
+                return false;
+            }
+            const std::size_t columnSize = detail::readUnsigned32( &bytes[ position ] );
+            position += 4;
+            if ( position + columnSize > bytes.size( )
+                 || !detail::decodeTrajectoryLogColumn( &bytes[ 0 ] + position,
+                                                        columnSize,
+                                                        column,
+                                                        compression,
+                                                        records.data( ) + firstRecord,
+                                                        numberOfRecords ) )
+            {
+                return false;
+            }
+            position += columnSize;
+        }
+    }
+
+    return true;
+}
+
+} // namespace control
+
+#endif // CONTROL_TRAJECTORY_LOGGER_HPP
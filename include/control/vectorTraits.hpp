@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_VECTOR_TRAITS_HPP
+#define CONTROL_VECTOR_TRAITS_HPP
+
+#include <array>
+#include <type_traits>
+#include <utility>
+
+namespace control
+{
+
+//! Trait to detect fixed-size 3-vector types.
+/*!
+ * Trait to detect, at compile-time, 3-vector types whose size is fixed and whose storage does not
+ * require dynamic memory allocation. Such types can be default-constructed without sizing, and
+ * are handled by fully-inlined code paths that keep all intermediate values in registers.
+ *
+ * The trait detects std::array< Real, 3 > and any type that exposes a SizeAtCompileTime member
+ * equal to 3 (e.g., Eigen::Vector3d and Eigen::Vector3f). Other fixed-size 3-vector types can
+ * enable these code paths by specializing this trait.
+ *
+ * @tparam  Vector3 3-Vector type
+ */
+template< typename Vector3, typename Enable = void >
+struct IsFixedSizeVector3 : public std::false_type
+{ };
+
+//! Trait to detect fixed-size 3-vector types, specialized for std::array.
+template< typename Real >
+struct IsFixedSizeVector3< std::array< Real, 3 >, void > : public std::true_type
+{ };
+
+//! Trait to detect fixed-size 3-vector types, specialized for Eigen-like vector types.
+template< typename Vector3 >
+struct IsFixedSizeVector3<
+    Vector3, typename std::enable_if< Vector3::SizeAtCompileTime == 3 >::type >
+    : public std::true_type
+{ };
+
+//! Trait to extract the element type of 3-vector types.
+/*!
+ * Trait to extract, at compile-time, the type of the elements stored in a 3-vector type, as
+ * returned by its subscript operator. Computations are carried out in a given real type and
+ * explicitly converted to the element type when stored, such that the storage precision can differ
+ * from the precision of the arithmetic without implicit promotions.
+ *
+ * @tparam  Vector3 3-Vector type
+ */
+template< typename Vector3 >
+struct VectorElement
+{
+    //! Element type.
+    typedef typename std::decay< decltype( std::declval< const Vector3& >( )[ 0 ] ) >::type Type;
+};
+
+} // namespace control
+
+#endif // CONTROL_VECTOR_TRAITS_HPP
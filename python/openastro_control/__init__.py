@@ -0,0 +1,172 @@
+# Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+# Distributed under the MIT License.
+# See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+
+"""NumPy bindings for the C ABI of the control library (see include/control/controlApi.h).
+
+The bindings load the control_c shared library with ctypes and pass the data pointers and strides
+of NumPy arrays to the C ABI, such that no array is copied, provided that it already has the
+requested dtype. The GIL is released by ctypes for the duration of each call, such that other
+Python threads keep running while the batch is evaluated across the worker threads of the library.
+
+The shared library is searched for in the directory given by the CONTROL_LIBRARY_PATH environment
+variable, next to this package and on the system library path, in that order.
+"""
+
+import ctypes
+import ctypes.util
+import os
+
+import numpy as np
+
+__all__ = ["API_VERSION", "ControlError", "compute_optimal_guidance_law"]
+
+#: Version of the C ABI that these bindings were written for.
+API_VERSION = 1
+
+_SUCCESS = 0
+_STATUS_MESSAGES = {
+    1: "invalid argument",
+    2: "internal error",
+}
+
+
+class ControlError(RuntimeError):
+    """Error returned by a function of the C ABI."""
+
+
+class _StridedArray(ctypes.Structure):
+    _fields_ = [("data", ctypes.c_void_p), ("sample_stride", ctypes.c_ssize_t)]
+
+
+class _StridedVector3Array(ctypes.Structure):
+    _fields_ = [
+        ("data", ctypes.c_void_p),
+        ("sample_stride", ctypes.c_ssize_t),
+        ("component_stride", ctypes.c_ssize_t),
+    ]
+
+
+def _load_library():
+    names = ["libcontrol_c.so", "libcontrol_c.dylib", "control_c.dll"]
+    directories = [os.environ.get("CONTROL_LIBRARY_PATH"), os.path.dirname(__file__)]
+    for directory in directories:
+        if not directory:
+            continue
+        for name in names:
+            path = os.path.join(directory, name)
+            if os.path.exists(path):
+                return ctypes.CDLL(path)
+
+    path = ctypes.util.find_library("control_c")
+    if path is None:
+        raise ImportError("control_c shared library not found; build it with -DBUILD_C_API=ON "
+                          "and set CONTROL_LIBRARY_PATH to its directory")
+    return ctypes.CDLL(path)
+
+
+_library = _load_library()
+_library.controlGetApiVersion.restype = ctypes.c_int
+_library.controlGetApiVersion.argtypes = []
+
+if _library.controlGetApiVersion() < API_VERSION:
+    raise ImportError("control_c shared library is older than these bindings")
+
+_functions = {}
+for _dtype, _real, _name in ((np.float64, ctypes.c_double, "Double"),
+                             (np.float32, ctypes.c_float, "Float")):
+    _function = getattr(_library, "controlComputeOptimalGuidanceLaw" + _name)
+    _function.restype = ctypes.c_int
+    _function.argtypes = [
+        ctypes.POINTER(_StridedVector3Array),
+        ctypes.POINTER(_StridedVector3Array),
+        ctypes.POINTER(_StridedArray),
+        ctypes.c_size_t,
+        ctypes.POINTER(_StridedArray),
+        ctypes.POINTER(_StridedArray),
+        _real,
+        ctypes.c_uint,
+        ctypes.POINTER(_StridedVector3Array),
+    ]
+    _functions[np.dtype(_dtype)] = _function
+
+
+def _as_vector3_array(array, dtype, name):
+    array = np.asarray(array, dtype=dtype)
+    if array.ndim != 2 or array.shape[1] != 3:
+        raise ValueError("%s must have shape (N, 3)" % name)
+    return array, _StridedVector3Array(array.ctypes.data, array.strides[0], array.strides[1])
+
+
+def _as_strided_array(array, dtype, number_of_samples, name):
+    array = np.asarray(array, dtype=dtype)
+    if array.ndim == 0:
+        return array, _StridedArray(array.ctypes.data, 0)
+    if array.shape != (number_of_samples,):
+        raise ValueError("%s must be a scalar or have shape (N,)" % name)
+    return array, _StridedArray(array.ctypes.data, array.strides[0])
+
+
+def compute_optimal_guidance_law(zero_effort_miss,
+                                 zero_effort_velocity,
+                                 time_to_go,
+                                 zero_effort_miss_gain=6.0,
+                                 zero_effort_velocity_gain=-2.0,
+                                 minimum_time_to_go=0.0,
+                                 number_of_threads=0,
+                                 out=None):
+    """Compute control authority for the Optimal Guidance Law (OGL) for a batch of samples.
+
+    All arrays are passed to the C ABI without copying if they have the dtype of the ZEM array
+    (float32 or float64; other dtypes are converted to float64); any strides are supported, e.g.,
+    views and transposes of arrays of shape (3, N).
+
+    Args:
+        zero_effort_miss: ZEM vectors, array of shape (N, 3).
+        zero_effort_velocity: ZEV vectors, array of shape (N, 3).
+        time_to_go: TTGs to reach target, array of shape (N,).
+        zero_effort_miss_gain: Control gain for ZEM term, scalar or array of shape (N,).
+        zero_effort_velocity_gain: Control gain for ZEV term, scalar or array of shape (N,).
+        minimum_time_to_go: TTG floor of terminal phase; zero to disable terminal-phase handling.
+        number_of_threads: Number of threads; if zero, the number of hardware threads is used.
+        out: Optional output array of shape (N, 3), which must not overlap the inputs.
+
+    Returns:
+        Control authority, array of shape (N, 3).
+    """
+    dtype = np.asarray(zero_effort_miss).dtype
+    dtype = dtype if dtype in _functions else np.dtype(np.float64)
+
+    # The converted arrays are kept alive until the call returns.
+    zem, zem_view = _as_vector3_array(zero_effort_miss, dtype, "zero_effort_miss")
+    zev, zev_view = _as_vector3_array(zero_effort_velocity, dtype, "zero_effort_velocity")
+    number_of_samples = zem.shape[0]
+    if zev.shape[0] != number_of_samples:
+        raise ValueError("zero_effort_velocity must have the same number of samples as "
+                         "zero_effort_miss")
+    ttg, ttg_view = _as_strided_array(time_to_go, dtype, number_of_samples, "time_to_go")
+    if ttg.ndim == 0:
+        raise ValueError("time_to_go must have shape (N,)")
+    zem_gain, zem_gain_view = _as_strided_array(
+        zero_effort_miss_gain, dtype, number_of_samples, "zero_effort_miss_gain")
+    zev_gain, zev_gain_view = _as_strided_array(
+        zero_effort_velocity_gain, dtype, number_of_samples, "zero_effort_velocity_gain")
+
+    if out is None:
+        out = np.empty((number_of_samples, 3), dtype=dtype)
+    elif out.dtype != dtype or out.shape != (number_of_samples, 3) or not out.flags.writeable:
+        raise ValueError("out must be a writeable array of shape (N, 3) with dtype %s" % dtype)
+    out_view = _StridedVector3Array(out.ctypes.data, out.strides[0], out.strides[1])
+
+    status = _functions[dtype](ctypes.byref(zem_view),
+                               ctypes.byref(zev_view),
+                               ctypes.byref(ttg_view),
+                               number_of_samples,
+                               ctypes.byref(zem_gain_view),
+                               ctypes.byref(zev_gain_view),
+                               minimum_time_to_go,
+                               number_of_threads,
+                               ctypes.byref(out_view))
+    if status != _SUCCESS:
+        raise ControlError(_STATUS_MESSAGES.get(status, "unknown error %d" % status))
+    return out
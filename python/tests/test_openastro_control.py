@@ -0,0 +1,88 @@
+# Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+# Distributed under the MIT License.
+# See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+
+"""Smoke tests of the NumPy bindings for the C ABI.
+
+The tests are skipped if NumPy is not installed, or if the control_c shared library is not found
+(see CONTROL_LIBRARY_PATH in openastro_control).
+"""
+
+import unittest
+
+try:
+    import numpy as np
+    import openastro_control
+    SKIP_REASON = None
+except ImportError as error:
+    SKIP_REASON = str(error)
+
+
+def compute_reference(zero_effort_miss, zero_effort_velocity, time_to_go,
+                      zero_effort_miss_gain=6.0, zero_effort_velocity_gain=-2.0):
+    time_to_go = time_to_go[:, np.newaxis]
+    return (zero_effort_miss_gain * zero_effort_miss / (time_to_go * time_to_go)
+            + zero_effort_velocity_gain * zero_effort_velocity / time_to_go)
+
+
+@unittest.skipIf(SKIP_REASON is not None, SKIP_REASON)
+class TestComputeOptimalGuidanceLaw(unittest.TestCase):
+
+    def setUp(self):
+        # An odd number of samples spans several chunks and ends in a partial block.
+        number_of_samples = 9001
+        generator = np.random.RandomState(42)
+        self.zero_effort_miss = 20.0 * generator.standard_normal((number_of_samples, 3))
+        self.zero_effort_velocity = 2.0 * generator.standard_normal((number_of_samples, 3))
+        self.time_to_go = 1.0 + 9.0 * generator.uniform(size=number_of_samples)
+
+    def test_contiguous_arrays(self):
+        control = openastro_control.compute_optimal_guidance_law(
+            self.zero_effort_miss, self.zero_effort_velocity, self.time_to_go)
+        np.testing.assert_allclose(
+            control,
+            compute_reference(self.zero_effort_miss, self.zero_effort_velocity, self.time_to_go),
+            rtol=1.0e-12)
+
+    def test_strided_arrays_and_per_sample_gains(self):
+        # Transposes of arrays of shape (3, N) are passed without copying.
+        zero_effort_miss = np.ascontiguousarray(self.zero_effort_miss.T).T
+        zero_effort_velocity = np.ascontiguousarray(self.zero_effort_velocity.T).T
+        zero_effort_miss_gain = np.full(self.time_to_go.shape, 5.0)
+        out = np.empty((3, self.time_to_go.size)).T
+        control = openastro_control.compute_optimal_guidance_law(
+            zero_effort_miss, zero_effort_velocity, self.time_to_go,
+            zero_effort_miss_gain=zero_effort_miss_gain, number_of_threads=2, out=out)
+        self.assertIs(control, out)
+        np.testing.assert_allclose(
+            control,
+            compute_reference(self.zero_effort_miss, self.zero_effort_velocity, self.time_to_go,
+                              zero_effort_miss_gain=5.0),
+            rtol=1.0e-12)
+
+    def test_single_precision(self):
+        control = openastro_control.compute_optimal_guidance_law(
+            self.zero_effort_miss.astype(np.float32),
+            self.zero_effort_velocity.astype(np.float32),
+            self.time_to_go.astype(np.float32))
+        self.assertEqual(control.dtype, np.float32)
+        np.testing.assert_allclose(
+            control,
+            compute_reference(self.zero_effort_miss, self.zero_effort_velocity, self.time_to_go),
+            rtol=1.0e-4, atol=1.0e-4)
+
+    def test_invalid_arguments(self):
+        with self.assertRaises(ValueError):
+            openastro_control.compute_optimal_guidance_law(
+                self.zero_effort_miss, self.zero_effort_velocity[:-1], self.time_to_go)
+
+        # A writeable output with a zero sample stride is rejected by the C ABI.
+        out = np.lib.stride_tricks.as_strided(np.empty(3), shape=(self.time_to_go.size, 3),
+                                              strides=(0, 8))
+        with self.assertRaises(openastro_control.ControlError):
+            openastro_control.compute_optimal_guidance_law(
+                self.zero_effort_miss, self.zero_effort_velocity, self.time_to_go, out=out)
+
+
+if __name__ == "__main__":
+    unittest.main()
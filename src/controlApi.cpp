@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "control/controlApi.h"
+#include "control/optimalGuidanceLaw.hpp"
+#include "control/parallel.hpp"
+
+namespace control
+{
+namespace detail
+{
+
+//! Number of samples per block of the C ABI.
+/*!
+ * The block size is chosen such that the gather and scatter buffers of a block stay in the L1
+ * cache (see computeBatchedSaturatedOptimalGuidanceLaw( )).
+ */
+const std::size_t apiBlockSize = 256;
+
+//! Number of blocks per chunk dispensed to the worker threads of the C ABI.
+const std::size_t apiBlocksPerChunk = 16;
+
+//! Get contiguous array of a block of samples of a strided array.
+/*!
+ * Gets a pointer to a contiguous array of the samples [begin, begin + numberOfSamples) of a
+ * strided array. If the samples are stored contiguously and aligned, the pointer points to the
+ * strided array itself; otherwise, the samples are gathered to the given buffer.
+ *
+ * @tparam  Real            Real type
+ * @param   data            Pointer to first element of strided array
+ * @param   stride          Stride between consecutive samples in bytes
+ * @param   begin           Index of first sample of block
+ * @param   numberOfSamples Number of samples of block
+ * @param   buffer          Buffer of at least numberOfSamples elements
+ * @return                  Pointer to contiguous array of samples
+ */
+template< typename Real >
+const Real* getBlockArray( const void* data,
+                           const std::ptrdiff_t stride,
+                           const std::size_t begin,
+                           const std::size_t numberOfSamples,
+                           Real* buffer )
+{
+    const char* element = static_cast< const char* >( data )
+                          + static_cast< std::ptrdiff_t >( begin ) * stride;
+    if ( stride == static_cast< std::ptrdiff_t >( sizeof( Real ) )
+         && reinterpret_cast< std::uintptr_t >( element ) % alignof( Real ) == 0 )
+    {
+        return reinterpret_cast< const Real* >( element );
+    }
+
+    // The elements are copied bytewise, since strided arrays need not be aligned.
+    for ( std::size_t i = 0; i < numberOfSamples; ++i, element += stride )
+    {
+        std::memcpy( buffer + i, element, sizeof( Real ) );
+    }
+    return buffer;
+}
+
+//! Get writable contiguous array of a block of samples of a strided array.
+/*!
+ * @sa getBlockArray( ), scatterBlockArray( )
+ * @return Pointer to contiguous array of samples, which is the buffer if the samples are not
+ *         stored contiguously and aligned
+ */
+template< typename Real >
+Real* getMutableBlockArray( void* data,
+                            const std::ptrdiff_t stride,
+                            const std::size_t begin,
+                            Real* buffer )
+{
+    char* element = static_cast< char* >( data ) + static_cast< std::ptrdiff_t >( begin ) * stride;
+    if ( stride == static_cast< std::ptrdiff_t >( sizeof( Real ) )
+         && reinterpret_cast< std::uintptr_t >( element ) % alignof( Real ) == 0 )
+    {
+        return reinterpret_cast< Real* >( element );
+    }
+    return buffer;
+}
+
+//! Scatter block of samples to a strided array, if it was computed in a buffer.
+/*!
+ * @sa getMutableBlockArray( )
+ */
+template< typename Real >
+void scatterBlockArray( const Real* array,
+                        void* data,
+                        const std::ptrdiff_t stride,
+                        const std::size_t begin,
+                        const std::size_t numberOfSamples,
+                        const Real* buffer )
+{
+    if ( array != buffer )
+    {
+        return;
+    }
+
+    char* element = static_cast< char* >( data ) + static_cast< std::ptrdiff_t >( begin ) * stride;
+    for ( std::size_t i = 0; i < numberOfSamples; ++i, element += stride )
+    {
+        std::memcpy( element, buffer + i, sizeof( Real ) );
+    }
+}
+
+//! Compute control authority for OGL for a batch of strided samples.
+/*!
+ * @sa controlComputeOptimalGuidanceLawDouble( )
+ */
+template< typename Real >
+controlStatus computeStridedOptimalGuidanceLaw(
+    const controlStridedVector3Array* zeroEffortMiss,
+    const controlStridedVector3Array* zeroEffortVelocity,
+    const controlStridedArray* timeToGo,
+    const std::size_t numberOfSamples,
+    const controlStridedArray* zeroEffortMissGain,
+    const controlStridedArray* zeroEffortVelocityGain,
+    const Real minimumTimeToGo,
+    const unsigned int numberOfThreads,
+    const controlMutableStridedVector3Array* controlEffort )
+{
+    if ( zeroEffortMiss == nullptr || zeroEffortVelocity == nullptr || timeToGo == nullptr
+         || zeroEffortMissGain == nullptr || zeroEffortVelocityGain == nullptr
+         || controlEffort == nullptr || !( minimumTimeToGo >= Real( 0.0 ) ) )
+    {
+        return controlInvalidArgument;
+    }
+
+    // With a zero output stride, samples or components would be written to the same element, by
+    // several worker threads in case of the sample stride.
+    if ( controlEffort->sampleStride == 0 || controlEffort->componentStride == 0 )
+    {
+        return controlInvalidArgument;
+    }
+
+    if ( numberOfSamples == 0 )
+    {
+        return controlSuccess;
+    }
+
+    if ( zeroEffortMiss->data == nullptr || zeroEffortVelocity->data == nullptr
+         || timeToGo->data == nullptr || zeroEffortMissGain->data == nullptr
+         || zeroEffortVelocityGain->data == nullptr || controlEffort->data == nullptr )
+    {
+        return controlInvalidArgument;
+    }
+
+    const bool isSharedGain
+        = zeroEffortMissGain->sampleStride == 0 && zeroEffortVelocityGain->sampleStride == 0;
+    Real sharedZeroEffortMissGain;
+    Real sharedZeroEffortVelocityGain;
+    std::memcpy( &sharedZeroEffortMissGain, zeroEffortMissGain->data, sizeof( Real ) );
+    std::memcpy( &sharedZeroEffortVelocityGain, zeroEffortVelocityGain->data, sizeof( Real ) );
+
+    const std::size_t numberOfBlocks = ( numberOfSamples + apiBlockSize - 1 ) / apiBlockSize;
+    const std::size_t numberOfChunks
+        = ( numberOfBlocks + apiBlocksPerChunk - 1 ) / apiBlocksPerChunk;
+
+    const auto computeChunk = [ & ]( const std::size_t chunk )
+    {
+        // Buffers for ZEM (3), ZEV (3), TTG (1), gains (2) and control authority (3).
+        Real buffers[ 12 ][ apiBlockSize ];
+
+        const std::size_t chunkEnd
+            = ( chunk + 1 ) * apiBlocksPerChunk * apiBlockSize < numberOfSamples
+              ? ( chunk + 1 ) * apiBlocksPerChunk * apiBlockSize : numberOfSamples;
+        for ( std::size_t begin = chunk * apiBlocksPerChunk * apiBlockSize;
+              begin < chunkEnd;
+              begin += apiBlockSize )
+        {
+            const std::size_t blockSize
+                = chunkEnd - begin < apiBlockSize ? chunkEnd - begin : apiBlockSize;
+
+            const Real* zeroEffortMissBlock[ 3 ];
+            const Real* zeroEffortVelocityBlock[ 3 ];
+            Real* controlEffortBlock[ 3 ];
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                zeroEffortMissBlock[ i ] = getBlockArray(
+                    static_cast< const char* >( zeroEffortMiss->data )
+                    + i * zeroEffortMiss->componentStride,
+                    zeroEffortMiss->sampleStride, begin, blockSize, buffers[ i ] );
+                zeroEffortVelocityBlock[ i ] = getBlockArray(
+                    static_cast< const char* >( zeroEffortVelocity->data )
+                    + i * zeroEffortVelocity->componentStride,
+                    zeroEffortVelocity->sampleStride, begin, blockSize, buffers[ 3 + i ] );
+
+                controlEffortBlock[ i ] = getMutableBlockArray(
+                    static_cast< char* >( controlEffort->data ) + i * controlEffort->componentStride,
+                    controlEffort->sampleStride, begin, buffers[ 9 + i ] );
+            }
+            const Real* timeToGoBlock = getBlockArray(
+                timeToGo->data, timeToGo->sampleStride, begin, blockSize, buffers[ 6 ] );
+
+            if ( isSharedGain && minimumTimeToGo > Real( 0.0 ) )
+            {
+                computeTerminalOptimalGuidanceLaw(
+                    zeroEffortMissBlock[ 0 ], zeroEffortMissBlock[ 1 ], zeroEffortMissBlock[ 2 ],
+                    zeroEffortVelocityBlock[ 0 ], zeroEffortVelocityBlock[ 1 ],
+                    zeroEffortVelocityBlock[ 2 ],
+                    timeToGoBlock, blockSize, minimumTimeToGo,
+                    controlEffortBlock[ 0 ], controlEffortBlock[ 1 ], controlEffortBlock[ 2 ],
+                    sharedZeroEffortMissGain, sharedZeroEffortVelocityGain );
+            }
+            else if ( isSharedGain )
+            {
+                computeOptimalGuidanceLaw(
+                    zeroEffortMissBlock[ 0 ], zeroEffortMissBlock[ 1 ], zeroEffortMissBlock[ 2 ],
+                    zeroEffortVelocityBlock[ 0 ], zeroEffortVelocityBlock[ 1 ],
+                    zeroEffortVelocityBlock[ 2 ],
+                    timeToGoBlock, blockSize,
+                    controlEffortBlock[ 0 ], controlEffortBlock[ 1 ], controlEffortBlock[ 2 ],
+                    sharedZeroEffortMissGain, sharedZeroEffortVelocityGain );
+            }
+            else
+            {
+                const Real* zeroEffortMissGainBlock = getBlockArray(
+                    zeroEffortMissGain->data, zeroEffortMissGain->sampleStride,
+                    begin, blockSize, buffers[ 7 ] );
+                const Real* zeroEffortVelocityGainBlock = getBlockArray(
+                    zeroEffortVelocityGain->data, zeroEffortVelocityGain->sampleStride,
+                    begin, blockSize, buffers[ 8 ] );
+
+                if ( minimumTimeToGo > Real( 0.0 ) )
+                {
+                    computeTerminalOptimalGuidanceLaw(
+                        zeroEffortMissBlock[ 0 ], zeroEffortMissBlock[ 1 ],
+                        zeroEffortMissBlock[ 2 ],
+                        zeroEffortVelocityBlock[ 0 ], zeroEffortVelocityBlock[ 1 ],
+                        zeroEffortVelocityBlock[ 2 ],
+                        timeToGoBlock, blockSize, minimumTimeToGo,
+                        controlEffortBlock[ 0 ], controlEffortBlock[ 1 ], controlEffortBlock[ 2 ],
+                        zeroEffortMissGainBlock, zeroEffortVelocityGainBlock );
+                }
+                else
+                {
+                    computeOptimalGuidanceLaw(
+                        zeroEffortMissBlock[ 0 ], zeroEffortMissBlock[ 1 ],
+                        zeroEffortMissBlock[ 2 ],
+                        zeroEffortVelocityBlock[ 0 ], zeroEffortVelocityBlock[ 1 ],
+                        zeroEffortVelocityBlock[ 2 ],
+                        timeToGoBlock, blockSize,
+                        controlEffortBlock[ 0 ], controlEffortBlock[ 1 ], controlEffortBlock[ 2 ],
+                        zeroEffortMissGainBlock, zeroEffortVelocityGainBlock );
+                }
+            }
+
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                scatterBlockArray(
+                    controlEffortBlock[ i ],
+                    static_cast< char* >( controlEffort->data ) + i * controlEffort->componentStride,
+                    controlEffort->sampleStride, begin, blockSize, buffers[ 9 + i ] );
+            }
+        }
+    };
+
+    try
+    {
+        parallelForChunks( numberOfChunks, numberOfThreads, computeChunk );
+    }
+    catch ( ... )
+    {
+        return controlInternalError;
+    }
+    return controlSuccess;
+}
+
+} // namespace detail
+} // namespace control
+
+extern "C"
+{
+
+int controlGetApiVersion( void )
+{
+    return CONTROL_API_VERSION;
+}
+
+controlStatus controlComputeOptimalGuidanceLawDouble(
+    const controlStridedVector3Array* zeroEffortMiss,
+    const controlStridedVector3Array* zeroEffortVelocity,
+    const controlStridedArray* timeToGo,
+    size_t numberOfSamples,
+    const controlStridedArray* zeroEffortMissGain,
+    const controlStridedArray* zeroEffortVelocityGain,
+    double minimumTimeToGo,
+    unsigned int numberOfThreads,
+    const controlMutableStridedVector3Array* controlEffort )
+{
+    return control::detail::computeStridedOptimalGuidanceLaw< double >(
+        zeroEffortMiss, zeroEffortVelocity, timeToGo, numberOfSamples,
+        zeroEffortMissGain, zeroEffortVelocityGain, minimumTimeToGo, numberOfThreads,
+        controlEffort );
+}
+
+controlStatus controlComputeOptimalGuidanceLawFloat(
+    const controlStridedVector3Array* zeroEffortMiss,
+    const controlStridedVector3Array* zeroEffortVelocity,
+    const controlStridedArray* timeToGo,
+    size_t numberOfSamples,
+    const controlStridedArray* zeroEffortMissGain,
+    const controlStridedArray* zeroEffortVelocityGain,
+    float minimumTimeToGo,
+    unsigned int numberOfThreads,
+    const controlMutableStridedVector3Array* controlEffort )
+{
+    return control::detail::computeStridedOptimalGuidanceLaw< float >(
+        zeroEffortMiss, zeroEffortVelocity, timeToGo, numberOfSamples,
+        zeroEffortMissGain, zeroEffortVelocityGain, minimumTimeToGo, numberOfThreads,
+        controlEffort );
+}
+
+} // extern "C"
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include "control/explicitInstantiations.hpp"
+
+namespace control
+{
+
+CONTROL_INSTANTIATE_BATCHED_GUIDANCE( , float );
+CONTROL_INSTANTIATE_BATCHED_GUIDANCE( , double );
+
+CONTROL_INSTANTIATE_VECTOR_GUIDANCE( , float, std::array< float, 3 > );
+CONTROL_INSTANTIATE_VECTOR_GUIDANCE( , double, std::array< double, 3 > );
+
+CONTROL_INSTANTIATE_VECTOR_GUIDANCE( , float, std::vector< float > );
+CONTROL_INSTANTIATE_VECTOR_GUIDANCE( , double, std::vector< double > );
+CONTROL_INSTANTIATE_RETURNING_GUIDANCE( , float, std::vector< float > );
+CONTROL_INSTANTIATE_RETURNING_GUIDANCE( , double, std::vector< double > );
+
+#if defined( CONTROL_EXPLICIT_INSTANTIATIONS_EIGEN )
+CONTROL_INSTANTIATE_VECTOR_GUIDANCE( , float, Eigen::Matrix< float, 3, 1 > );
+CONTROL_INSTANTIATE_VECTOR_GUIDANCE( , double, Eigen::Matrix< double, 3, 1 > );
+CONTROL_INSTANTIATE_RETURNING_GUIDANCE( , float, Eigen::Matrix< float, 3, 1 > );
+CONTROL_INSTANTIATE_RETURNING_GUIDANCE( , double, Eigen::Matrix< double, 3, 1 > );
+#endif // CONTROL_EXPLICIT_INSTANTIATIONS_EIGEN
+
+} // namespace control
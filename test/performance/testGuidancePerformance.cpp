@@ -0,0 +1,562 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/generalizedOptimalGuidanceController.hpp"
+#include "control/gravityModels.hpp"
+#include "control/instrumentation.hpp"
+#include "control/optimalGuidanceController.hpp"
+#include "control/optimalGuidanceLaw.hpp"
+#include "control/simd.hpp"
+
+#include "../testAllocationCounter.hpp"
+
+// The performance tests measure the cost of the guidance scenarios in timestamp-counter ticks per
+// evaluation (see readTimestampCounter( )) and the number of allocations per guidance step, and
+// compare them against the baselines stored for the platform in baselines.txt. A scenario fails if
+// it allocates more than the baseline, or, if the timing check is enabled, if it takes more than
+// the tolerance factor times the baseline number of ticks. Since ticks are not comparable across
+// CPUs, baselines are keyed by platform, which includes the CPU model, and the timing check is
+// skipped with a warning if no baseline is stored for the host platform. The timing check is
+// opt-in, since timings also depend on the load and frequency scaling of the host.
+//
+// The following environment variables change the behaviour of the performance tests:
+//  - CONTROL_PERFORMANCE_CHECK_TIMING: if set, enables the timing check
+//  - CONTROL_PERFORMANCE_PLATFORM: platform key, which overrides the detected key
+//  - CONTROL_PERFORMANCE_BASELINES: path to baselines file, which overrides the default path
+//  - CONTROL_PERFORMANCE_TOLERANCE: tolerance factor on ticks per evaluation (default=1.5)
+//  - CONTROL_PERFORMANCE_RECORD: if set, prints the measurements as baseline lines
+
+#if !defined( CONTROL_PERFORMANCE_BASELINES_PATH )
+#define CONTROL_PERFORMANCE_BASELINES_PATH "test/performance/baselines.txt"
+#endif
+
+namespace control
+{
+namespace tests
+{
+
+//! Result of performance measurement of a guidance scenario.
+struct PerformanceMeasurement
+{
+    //! Minimum number of ticks per evaluation across repetitions.
+    double ticksPerEvaluation;
+
+    //! Maximum number of allocations per step across repetitions.
+    double allocationsPerStep;
+};
+
+//! Baseline stored for a guidance scenario.
+struct PerformanceBaseline
+{
+    //! Flag indicating if a baseline is stored for the scenario on the host platform.
+    bool isFound;
+
+    //! Baseline number of ticks per evaluation.
+    double ticksPerEvaluation;
+
+    //! Baseline number of allocations per step.
+    double allocationsPerStep;
+};
+
+//! Number of repetitions of each scenario; the minimum number of ticks is taken to reject noise.
+static const unsigned int numberOfRepetitions = 15;
+
+//! Sink for results of measured scenarios, such that the measured work is not optimized away.
+static volatile double performanceSink = 0.0;
+
+//! Get value of environment variable, or empty string if the variable is not set.
+static std::string getEnvironmentVariable( const char* name )
+{
+    const char* value = std::getenv( name );
+    return value == 0 ? std::string( ) : std::string( value );
+}
+
+//! Get CPU model of host, with all characters other than letters and digits replaced by '_'.
+/*!
+ * Gets the CPU model of the host from /proc/cpuinfo, or "unknown" if it is not available, in which
+ * case the platform key must be set with CONTROL_PERFORMANCE_PLATFORM to check timings.
+ */
+static std::string getCpuModel( )
+{
+    std::ifstream cpuInfoFile( "/proc/cpuinfo" );
+    std::string line;
+    while ( std::getline( cpuInfoFile, line ) )
+    {
+        const std::string::size_type separator = line.find( ':' );
+        if ( line.compare( 0, 10, "model name" ) != 0 || separator == std::string::npos )
+        {
+            continue;
+        }
+
+        std::string cpuModel;
+        for ( std::string::size_type i = separator + 1; i < line.size( ); ++i )
+        {
+            const char character = line[ i ];
+            const bool isAlphanumeric = ( character >= 'a' && character <= 'z' )
+                                        || ( character >= 'A' && character <= 'Z' )
+                                        || ( character >= '0' && character <= '9' );
+            if ( isAlphanumeric )
+            {
+                cpuModel += character;
+            }
+            else if ( !cpuModel.empty( ) && cpuModel[ cpuModel.size( ) - 1 ] != '_' )
+            {
+                cpuModel += '_';
+            }
+        }
+        while ( !cpuModel.empty( ) && cpuModel[ cpuModel.size( ) - 1 ] == '_' )
+        {
+            cpuModel.erase( cpuModel.size( ) - 1 );
+        }
+
+        if ( !cpuModel.empty( ) )
+        {
+            return cpuModel;
+        }
+    }
+
+    return "unknown";
+}
+
+//! Get key of host platform, composed of the CPU architecture, the active SIMD instruction set and
+//! the CPU model.
+static std::string getPerformancePlatform( )
+{
+    const std::string platformOverride = getEnvironmentVariable( "CONTROL_PERFORMANCE_PLATFORM" );
+    if ( !platformOverride.empty( ) )
+    {
+        return platformOverride;
+    }
+
+#if defined( __x86_64__ ) || defined( _M_X64 )
+    std::string platform = "x86_64";
+#elif defined( __aarch64__ ) || defined( _M_ARM64 )
+    std::string platform = "aarch64";
+#else
+    std::string platform = "generic";
+#endif
+
+    switch ( getSimdInstructionSet( ) )
+    {
+        case avx2InstructionSet:
+            platform += "-avx2";
+            break;
+
+        case avx512InstructionSet:
+            platform += "-avx512";
+            break;
+
+        case neonInstructionSet:
+            platform += "-neon";
+            break;
+
+        default:
+            platform += "-scalar";
+            break;
+    }
+
+    if ( isDeterministicModeEnabled( ) )
+    {
+        platform += "-deterministic";
+    }
+
+    return platform + "-" + getCpuModel( );
+}
+
+//! Read baseline for given scenario on host platform from baselines file.
+static PerformanceBaseline readPerformanceBaseline( const std::string& scenario )
+{
+    std::string path = getEnvironmentVariable( "CONTROL_PERFORMANCE_BASELINES" );
+    if ( path.empty( ) )
+    {
+        path = CONTROL_PERFORMANCE_BASELINES_PATH;
+    }
+
+    const std::string platform = getPerformancePlatform( );
+    PerformanceBaseline baseline = { false, 0.0, 0.0 };
+
+    std::ifstream baselinesFile( path.c_str( ) );
+    std::string line;
+    while ( std::getline( baselinesFile, line ) )
+    {
+        if ( line.empty( ) || line[ 0 ] == '#' )
+        {
+            continue;
+        }
+
+        std::istringstream lineStream( line );
+        std::string linePlatform;
+        std::string lineScenario;
+        double ticksPerEvaluation = 0.0;
+        double allocationsPerStep = 0.0;
+        if ( ( lineStream >> linePlatform >> lineScenario
+                          >> ticksPerEvaluation >> allocationsPerStep )
+             && linePlatform == platform && lineScenario == scenario )
+        {
+            baseline.isFound = true;
+            baseline.ticksPerEvaluation = ticksPerEvaluation;
+            baseline.allocationsPerStep = allocationsPerStep;
+        }
+    }
+
+    return baseline;
+}
+
+//! Measure performance of guidance scenario.
+/*!
+ * Measures the performance of a guidance scenario, by resetting the scenario and executing the
+ * given number of steps for each repetition. Allocations made while resetting are not counted.
+ *
+ * @param   reset               Function that resets the scenario to its initial state
+ * @param   step                Function that executes a step, given the step index
+ * @param   numberOfSteps       Number of steps per repetition
+ * @param   evaluationsPerStep  Number of guidance evaluations per step
+ * @return                      Performance measurement
+ */
+template< typename ResetFunction, typename StepFunction >
+PerformanceMeasurement measurePerformance( ResetFunction reset,
+                                           StepFunction step,
+                                           const unsigned int numberOfSteps,
+                                           const unsigned int evaluationsPerStep )
+{
+    PerformanceMeasurement measurement = { std::numeric_limits< double >::max( ), 0.0 };
+
+    for ( unsigned int repetition = 0; repetition < numberOfRepetitions; ++repetition )
+    {
+        reset( );
+
+        const std::size_t startAllocationCount = getAllocationCount( );
+        const std::uint64_t startTime = readTimestampCounter( );
+        for ( unsigned int i = 0; i < numberOfSteps; ++i )
+        {
+            step( i );
+        }
+        const std::uint64_t endTime = readTimestampCounter( );
+        const std::size_t endAllocationCount = getAllocationCount( );
+
+        measurement.ticksPerEvaluation
+            = std::min( measurement.ticksPerEvaluation,
+                        static_cast< double >( endTime - startTime )
+                            / ( static_cast< double >( numberOfSteps ) * evaluationsPerStep ) );
+        measurement.allocationsPerStep
+            = std::max( measurement.allocationsPerStep,
+                        static_cast< double >( endAllocationCount - startAllocationCount )
+                            / numberOfSteps );
+    }
+
+    return measurement;
+}
+
+//! Check performance measurement of guidance scenario against baseline for host platform.
+static void checkPerformance( const std::string& scenario,
+                              const PerformanceMeasurement& measurement )
+{
+    const std::string platform = getPerformancePlatform( );
+    if ( !getEnvironmentVariable( "CONTROL_PERFORMANCE_RECORD" ).empty( ) )
+    {
+        std::cout << platform << " " << scenario << " "
+                  << measurement.ticksPerEvaluation << " "
+                  << measurement.allocationsPerStep << std::endl;
+    }
+
+    const std::string toleranceOverride
+        = getEnvironmentVariable( "CONTROL_PERFORMANCE_TOLERANCE" );
+    const double tolerance
+        = toleranceOverride.empty( ) ? 1.5 : std::atof( toleranceOverride.c_str( ) );
+
+    const PerformanceBaseline baseline = readPerformanceBaseline( scenario );
+
+    INFO( "Platform: " << platform << ", scenario: " << scenario );
+    INFO( "Measured: " << measurement.ticksPerEvaluation << " ticks per evaluation, "
+          << measurement.allocationsPerStep << " allocations per step" );
+
+    // Guidance steps must not allocate, irrespective of whether a baseline is stored.
+    REQUIRE( measurement.allocationsPerStep
+             <= ( baseline.isFound ? baseline.allocationsPerStep : 0.0 ) );
+
+    if ( getEnvironmentVariable( "CONTROL_PERFORMANCE_CHECK_TIMING" ).empty( ) )
+    {
+        return;
+    }
+
+    if ( !baseline.isFound )
+    {
+        WARN( "No performance baseline stored for platform " << platform << " and scenario "
+              << scenario << "; skipping timing check" );
+        return;
+    }
+
+    INFO( "Baseline: " << baseline.ticksPerEvaluation << " ticks per evaluation, tolerance "
+          << tolerance );
+    REQUIRE( measurement.ticksPerEvaluation <= tolerance * baseline.ticksPerEvaluation );
+}
+
+TEST_CASE( "Test performance of Optimal Guidance Law", "[performance][ogl]" )
+{
+    typedef double Real;
+
+    const unsigned int numberOfSteps = 1000;
+
+    SECTION( "Test std::array" )
+    {
+        typedef std::array< Real, 3 > Vector;
+
+        Vector zeroEffortMiss = { { -21.163, 9.887, -0.613 } };
+        const Vector zeroEffortVelocity = { { -1.244, -0.112, 3.119 } };
+        Vector controlEffort = { { 0.0, 0.0, 0.0 } };
+
+        const PerformanceMeasurement measurement = measurePerformance(
+            [ & ]( ) { zeroEffortMiss[ 0 ] = -21.163; },
+            [ & ]( const unsigned int i )
+            {
+                computeOptimalGuidanceLaw( zeroEffortMiss,
+                                           zeroEffortVelocity,
+                                           12.516 + 1.0e-3 * i,
+                                           controlEffort );
+                // Feed result back into input, such that evaluations cannot be hoisted.
+                zeroEffortMiss[ 0 ] += 1.0e-9 * controlEffort[ 0 ];
+            },
+            numberOfSteps,
+            1 );
+        performanceSink = controlEffort[ 0 ] + controlEffort[ 1 ] + controlEffort[ 2 ];
+
+        checkPerformance( "ogl-array", measurement );
+    }
+
+    SECTION( "Test std::vector" )
+    {
+        typedef std::vector< Real > Vector;
+
+        Vector zeroEffortMiss = { -21.163, 9.887, -0.613 };
+        const Vector zeroEffortVelocity = { -1.244, -0.112, 3.119 };
+        Vector controlEffort( 3, 0.0 );
+
+        const PerformanceMeasurement measurement = measurePerformance(
+            [ & ]( ) { zeroEffortMiss[ 0 ] = -21.163; },
+            [ & ]( const unsigned int i )
+            {
+                computeOptimalGuidanceLaw( zeroEffortMiss,
+                                           zeroEffortVelocity,
+                                           12.516 + 1.0e-3 * i,
+                                           controlEffort );
+                zeroEffortMiss[ 0 ] += 1.0e-9 * controlEffort[ 0 ];
+            },
+            numberOfSteps,
+            1 );
+        performanceSink = controlEffort[ 0 ] + controlEffort[ 1 ] + controlEffort[ 2 ];
+
+        checkPerformance( "ogl-vector", measurement );
+    }
+
+    SECTION( "Test batch" )
+    {
+        const unsigned int numberOfSamples = 1024;
+
+        std::vector< Real > zeroEffortMissX( numberOfSamples );
+        std::vector< Real > zeroEffortMissY( numberOfSamples );
+        std::vector< Real > zeroEffortMissZ( numberOfSamples );
+        std::vector< Real > zeroEffortVelocityX( numberOfSamples );
+        std::vector< Real > zeroEffortVelocityY( numberOfSamples );
+        std::vector< Real > zeroEffortVelocityZ( numberOfSamples );
+        std::vector< Real > timeToGo( numberOfSamples );
+        std::vector< Real > controlEffortX( numberOfSamples );
+        std::vector< Real > controlEffortY( numberOfSamples );
+        std::vector< Real > controlEffortZ( numberOfSamples );
+        for ( unsigned int i = 0; i < numberOfSamples; ++i )
+        {
+            zeroEffortMissX[ i ] = -21.163 + 1.0e-2 * i;
+            zeroEffortMissY[ i ] = 9.887;
+            zeroEffortMissZ[ i ] = -0.613;
+            zeroEffortVelocityX[ i ] = -1.244;
+            zeroEffortVelocityY[ i ] = -0.112 + 1.0e-3 * i;
+            zeroEffortVelocityZ[ i ] = 3.119;
+            timeToGo[ i ] = 12.516 + 1.0e-2 * i;
+        }
+
+        const PerformanceMeasurement measurement = measurePerformance(
+            [ ]( ) { },
+            [ & ]( const unsigned int )
+            {
+                computeOptimalGuidanceLaw( zeroEffortMissX.data( ),
+                                           zeroEffortMissY.data( ),
+                                           zeroEffortMissZ.data( ),
+                                           zeroEffortVelocityX.data( ),
+                                           zeroEffortVelocityY.data( ),
+                                           zeroEffortVelocityZ.data( ),
+                                           timeToGo.data( ),
+                                           numberOfSamples,
+                                           controlEffortX.data( ),
+                                           controlEffortY.data( ),
+                                           controlEffortZ.data( ) );
+                performanceSink = controlEffortX[ numberOfSamples - 1 ];
+            },
+            numberOfSteps / 10,
+            numberOfSamples );
+
+        checkPerformance( "ogl-batch", measurement );
+    }
+}
+
+TEST_CASE( "Test performance of closed-loop guidance", "[performance][controller]" )
+{
+    typedef double Real;
+
+    // Lunar landing, integrated with the explicit Euler method until just before the final time.
+    const Real finalTime = 30.0;
+    const Real timeStep = 0.03;
+    const unsigned int numberOfSteps = 990;
+
+    SECTION( "Test Optimal Guidance controller with std::array" )
+    {
+        typedef std::array< Real, 3 > Vector;
+
+        const Vector targetPosition = { { 0.0, 0.0, 0.0 } };
+        const Vector targetVelocity = { { 0.0, 0.0, -0.5 } };
+        const Vector gravitationalAcceleration = { { 0.0, 0.0, -1.62 } };
+
+        OptimalGuidanceController< Real, Vector > controller( targetPosition,
+                                                              targetVelocity,
+                                                              gravitationalAcceleration,
+                                                              finalTime );
+        Vector position;
+        Vector velocity;
+
+        const PerformanceMeasurement measurement = measurePerformance(
+            [ & ]( )
+            {
+                position = { { 150.0, -75.0, 500.0 } };
+                velocity = { { -10.0, 2.5, -20.0 } };
+            },
+            [ & ]( const unsigned int i )
+            {
+                const Vector& controlEffort
+                    = controller.computeControl( i * timeStep, position, velocity );
+                for ( unsigned int j = 0; j < 3; ++j )
+                {
+                    position[ j ] += velocity[ j ] * timeStep;
+                    velocity[ j ] += ( controlEffort[ j ] + gravitationalAcceleration[ j ] )
+                                     * timeStep;
+                }
+            },
+            numberOfSteps,
+            1 );
+        performanceSink = position[ 2 ];
+
+        checkPerformance( "controller-array", measurement );
+    }
+
+    SECTION( "Test Optimal Guidance controller with std::vector" )
+    {
+        typedef std::vector< Real > Vector;
+
+        const Vector targetPosition = { 0.0, 0.0, 0.0 };
+        const Vector targetVelocity = { 0.0, 0.0, -0.5 };
+        const Vector gravitationalAcceleration = { 0.0, 0.0, -1.62 };
+
+        OptimalGuidanceController< Real, Vector > controller( targetPosition,
+                                                              targetVelocity,
+                                                              gravitationalAcceleration,
+                                                              finalTime );
+        Vector position( 3 );
+        Vector velocity( 3 );
+
+        const PerformanceMeasurement measurement = measurePerformance(
+            [ & ]( )
+            {
+                position[ 0 ] = 150.0;
+                position[ 1 ] = -75.0;
+                position[ 2 ] = 500.0;
+                velocity[ 0 ] = -10.0;
+                velocity[ 1 ] = 2.5;
+                velocity[ 2 ] = -20.0;
+            },
+            [ & ]( const unsigned int i )
+            {
+                const Vector& controlEffort
+                    = controller.computeControl( i * timeStep, position, velocity );
+                for ( unsigned int j = 0; j < 3; ++j )
+                {
+                    position[ j ] += velocity[ j ] * timeStep;
+                    velocity[ j ] += ( controlEffort[ j ] + gravitationalAcceleration[ j ] )
+                                     * timeStep;
+                }
+            },
+            numberOfSteps,
+            1 );
+        performanceSink = position[ 2 ];
+
+        checkPerformance( "controller-vector", measurement );
+    }
+
+    SECTION( "Test Generalized Optimal Guidance controller with std::vector" )
+    {
+        typedef std::vector< Real > Vector;
+        typedef ConstantGravity< Real, Vector > Gravity;
+
+        const Vector targetPosition = { 0.0, 0.0, 0.0 };
+        const Vector targetVelocity = { 0.0, 0.0, -0.5 };
+        const Vector gravitationalAcceleration = { 0.0, 0.0, -1.62 };
+        const Gravity gravity( gravitationalAcceleration );
+
+        // The controller is constructed when the scenario is reset, since the current time must
+        // not decrease between calls; the allocations made by the constructor are not counted.
+        typedef GeneralizedOptimalGuidanceController< Real, Vector, Gravity > Controller;
+        std::unique_ptr< Controller > controller;
+        Vector position( 3 );
+        Vector velocity( 3 );
+
+        const PerformanceMeasurement measurement = measurePerformance(
+            [ & ]( )
+            {
+                controller.reset( new Controller( targetPosition,
+                                                  targetVelocity,
+                                                  gravity,
+                                                  finalTime,
+                                                  100,
+                                                  1.0e-3,
+                                                  1.0e-4 ) );
+                position[ 0 ] = 150.0;
+                position[ 1 ] = -75.0;
+                position[ 2 ] = 500.0;
+                velocity[ 0 ] = -10.0;
+                velocity[ 1 ] = 2.5;
+                velocity[ 2 ] = -20.0;
+            },
+            [ & ]( const unsigned int i )
+            {
+                const Vector& controlEffort
+                    = controller->computeControl( i * timeStep, position, velocity );
+                for ( unsigned int j = 0; j < 3; ++j )
+                {
+                    position[ j ] += velocity[ j ] * timeStep;
+                    velocity[ j ] += ( controlEffort[ j ] + gravitationalAcceleration[ j ] )
+                                     * timeStep;
+                }
+            },
+            numberOfSteps,
+            1 );
+        performanceSink = position[ 2 ];
+
+        checkPerformance( "generalized-controller-vector", measurement );
+    }
+}
+
+} // namespace tests
+} // namespace control
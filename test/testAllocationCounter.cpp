@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "testAllocationCounter.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+static std::atomic< std::size_t > allocationCount( 0 );
+
+std::size_t getAllocationCount( )
+{
+    return allocationCount.load( std::memory_order_relaxed );
+}
+
+} // namespace tests
+} // namespace control
+
+// Replace global allocation functions to count the number of allocations made by the tests.
+void* operator new( std::size_t size )
+{
+    control::tests::allocationCount.fetch_add( 1, std::memory_order_relaxed );
+    void* pointer = std::malloc( size == 0 ? 1 : size );
+    if ( pointer == 0 )
+    {
+        throw std::bad_alloc( );
+    }
+    return pointer;
+}
+
+void operator delete( void* pointer ) noexcept
+{
+    std::free( pointer );
+}
+
+void operator delete( void* pointer, std::size_t ) noexcept
+{
+    operator delete( pointer );
+}
@@ -0,0 +1,23 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#ifndef CONTROL_TEST_ALLOCATION_COUNTER_HPP
+#define CONTROL_TEST_ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+
+namespace control
+{
+namespace tests
+{
+
+//! Get number of calls made to global operator new since start of test executable.
+std::size_t getAllocationCount( );
+
+} // namespace tests
+} // namespace control
+
+#endif // CONTROL_TEST_ALLOCATION_COUNTER_HPP
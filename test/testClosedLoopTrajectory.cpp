@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <array>
+#include <type_traits>
+
+#include <catch.hpp>
+
+#include "control/closedLoopTrajectory.hpp"
+#include "control/simd.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::array< Real, 3 > Vector;
+
+TEST_CASE( "Test closed-loop trajectory", "[closed-loop-trajectory]" )
+{
+    static_assert( IsFixedSizeVector3< DeviceVector3< Real > >::value,
+                   "DeviceVector3 must select the fixed-size code paths" );
+    static_assert( std::is_trivially_copyable< ClosedLoopTrajectory< Real > >::value,
+                   "Closed-loop trajectory must be trivially copyable to device memory" );
+
+    // Powered descent from 1500 m altitude under Mars gravity, with target at the origin.
+    MonteCarloDispersion< Real, Vector > dispersion;
+    dispersion.initialPosition = { { 200.0, -100.0, 1500.0 } };
+    dispersion.initialPositionStandardDeviation = { { 50.0, 50.0, 50.0 } };
+    dispersion.initialVelocity = { { -10.0, 5.0, -75.0 } };
+    dispersion.initialVelocityStandardDeviation = { { 2.0, 2.0, 2.0 } };
+    dispersion.gravitationalAcceleration = { { 0.0, 0.0, -3.7114 } };
+    dispersion.gravitationalAccelerationStandardDeviation = { { 0.01, 0.01, 0.01 } };
+    dispersion.zeroEffortMissGain = 6.0;
+    dispersion.zeroEffortMissGainStandardDeviation = 0.1;
+    dispersion.zeroEffortVelocityGain = -2.0;
+    dispersion.zeroEffortVelocityGainStandardDeviation = 0.05;
+    dispersion.positionNoiseStandardDeviation = { { 0.01, 0.01, 0.01 } };
+    dispersion.velocityNoiseStandardDeviation = { { 0.001, 0.001, 0.001 } };
+
+    const Vector targetPosition = { { 0.0, 0.0, 0.0 } };
+    const Vector targetVelocity = { { 0.0, 0.0, 0.0 } };
+    const Real finalTime = 40.0;
+    const std::size_t numberOfSteps = 400;
+    const std::uint64_t seed = 12345;
+
+    const ClosedLoopTrajectory< Real >::Dispersion deviceDispersion
+        = toDeviceDispersion( dispersion );
+    const DeviceVector3< Real > deviceTargetPosition = toDeviceVector3< Real >( targetPosition );
+    const DeviceVector3< Real > deviceTargetVelocity = toDeviceVector3< Real >( targetVelocity );
+
+    SECTION( "Test agreement with Monte Carlo campaign" )
+    {
+        const MonteCarloCampaign< Real, Vector > campaign(
+            dispersion, targetPosition, targetVelocity, finalTime, numberOfSteps );
+
+        for ( std::size_t trajectoryIndex = 0; trajectoryIndex < 20; ++trajectoryIndex )
+        {
+            ClosedLoopTrajectory< Real > trajectory( deviceDispersion, seed, trajectoryIndex );
+            trajectory.propagate( deviceDispersion,
+                                  deviceTargetPosition,
+                                  deviceTargetVelocity,
+                                  finalTime,
+                                  numberOfSteps,
+                                  0,
+                                  numberOfSteps );
+
+            const MonteCarloTrajectoryResult< Real > result
+                = trajectory.computeResult( deviceTargetPosition, deviceTargetVelocity );
+            const MonteCarloTrajectoryResult< Real > expectedResult
+                = campaign.simulateTrajectory( seed, trajectoryIndex );
+
+            // Outside deterministic mode, the compiler may contract the device and host
+            // propagation into fused multiply-add instructions differently.
+            if ( isDeterministicModeEnabled( ) )
+            {
+                REQUIRE( result.positionMiss == expectedResult.positionMiss );
+                REQUIRE( result.velocityMiss == expectedResult.velocityMiss );
+                REQUIRE( result.deltaV == expectedResult.deltaV );
+            }
+            else
+            {
+                REQUIRE( result.positionMiss
+                         == Approx( expectedResult.positionMiss ).epsilon( 1.0e-9 ) );
+                REQUIRE( result.velocityMiss
+                         == Approx( expectedResult.velocityMiss ).epsilon( 1.0e-9 ) );
+                REQUIRE( result.deltaV == Approx( expectedResult.deltaV ).epsilon( 1.0e-9 ) );
+            }
+        }
+    }
+
+    SECTION( "Test propagation over several calls" )
+    {
+        ClosedLoopTrajectory< Real > trajectory( deviceDispersion, seed, 3 );
+        ClosedLoopTrajectory< Real > splitTrajectory = trajectory;
+
+        trajectory.propagate( deviceDispersion,
+                              deviceTargetPosition,
+                              deviceTargetVelocity,
+                              finalTime,
+                              numberOfSteps,
+                              0,
+                              numberOfSteps );
+
+        // Propagate in uneven ranges of steps, as done for a given number of steps per launch.
+        const std::size_t numberOfStepsPerCall = 37;
+        for ( std::size_t firstStep = 0; firstStep < numberOfSteps;
+              firstStep += numberOfStepsPerCall )
+        {
+            const std::size_t lastStep = firstStep + numberOfStepsPerCall < numberOfSteps
+                                         ? firstStep + numberOfStepsPerCall : numberOfSteps;
+            splitTrajectory.propagate( deviceDispersion,
+                                       deviceTargetPosition,
+                                       deviceTargetVelocity,
+                                       finalTime,
+                                       numberOfSteps,
+                                       firstStep,
+                                       lastStep );
+        }
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( splitTrajectory.getPosition( )[ i ] == trajectory.getPosition( )[ i ] );
+            REQUIRE( splitTrajectory.getVelocity( )[ i ] == trajectory.getVelocity( )[ i ] );
+        }
+        const MonteCarloTrajectoryResult< Real > result
+            = trajectory.computeResult( deviceTargetPosition, deviceTargetVelocity );
+        REQUIRE( splitTrajectory.computeResult( deviceTargetPosition, deviceTargetVelocity ).deltaV
+                    == result.deltaV );
+
+        // The trajectory reaches the target closely.
+        REQUIRE( result.positionMiss < 1.0 );
+    }
+}
+
+} // namespace tests
+} // namespace control
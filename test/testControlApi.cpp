@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/controlApi.h"
+#include "control/optimalGuidanceLaw.hpp"
+#include "control/randomNumberGenerator.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+
+TEST_CASE( "Test C ABI", "[ogl][c-api]" )
+{
+    REQUIRE( controlGetApiVersion( ) == CONTROL_API_VERSION );
+
+    // An odd number of samples spans several chunks and ends in a partial block.
+    const std::size_t numberOfSamples = 9001;
+    const Real minimumTimeToGo = 0.5;
+
+    // Samples are stored as arrays of shape (N, 3), as for NumPy arrays of 3-vectors.
+    CounterBasedRandomNumberGenerator< Real > generator( 42, 0 );
+    std::vector< Real > zeroEffortMiss( 3 * numberOfSamples );
+    std::vector< Real > zeroEffortVelocity( 3 * numberOfSamples );
+    std::vector< Real > timeToGo( numberOfSamples );
+    std::vector< Real > zeroEffortMissGain( numberOfSamples );
+    std::vector< Real > zeroEffortVelocityGain( numberOfSamples );
+    for ( std::size_t i = 0; i < numberOfSamples; ++i )
+    {
+        for ( unsigned int j = 0; j < 3; ++j )
+        {
+            zeroEffortMiss[ 3 * i + j ] = 20.0 * generator.generateNormal( );
+            zeroEffortVelocity[ 3 * i + j ] = 2.0 * generator.generateNormal( );
+        }
+        timeToGo[ i ] = 10.0 * generator.generateUniform( );
+        zeroEffortMissGain[ i ] = 6.0 + generator.generateUniform( );
+        zeroEffortVelocityGain[ i ] = -2.0 - generator.generateUniform( );
+    }
+
+    // The reference is computed with the batched functions in SoA form.
+    std::vector< Real > soa[ 6 ];
+    for ( unsigned int j = 0; j < 3; ++j )
+    {
+        soa[ j ].resize( numberOfSamples );
+        soa[ 3 + j ].resize( numberOfSamples );
+        for ( std::size_t i = 0; i < numberOfSamples; ++i )
+        {
+            soa[ j ][ i ] = zeroEffortMiss[ 3 * i + j ];
+            soa[ 3 + j ][ i ] = zeroEffortVelocity[ 3 * i + j ];
+        }
+    }
+
+    const controlStridedVector3Array zeroEffortMissArray
+        = { zeroEffortMiss.data( ), 3 * sizeof( Real ), sizeof( Real ) };
+    const controlStridedVector3Array zeroEffortVelocityArray
+        = { zeroEffortVelocity.data( ), 3 * sizeof( Real ), sizeof( Real ) };
+    const controlStridedArray timeToGoArray = { timeToGo.data( ), sizeof( Real ) };
+
+    SECTION( "Test shared and per-sample gains with and without terminal phase" )
+    {
+        const Real sharedGains[ 2 ] = { 6.0, -2.0 };
+
+        for ( unsigned int k = 0; k < 4; ++k )
+        {
+            const bool perSampleGains = k % 2 == 1;
+            const Real timeToGoFloor = k / 2 == 1 ? minimumTimeToGo : 0.0;
+
+            std::vector< Real > expected[ 3 ];
+            for ( unsigned int j = 0; j < 3; ++j )
+            {
+                expected[ j ].resize( numberOfSamples );
+            }
+            if ( perSampleGains && timeToGoFloor > 0.0 )
+            {
+                computeTerminalOptimalGuidanceLaw(
+                    soa[ 0 ].data( ), soa[ 1 ].data( ), soa[ 2 ].data( ),
+                    soa[ 3 ].data( ), soa[ 4 ].data( ), soa[ 5 ].data( ),
+                    timeToGo.data( ), numberOfSamples, timeToGoFloor,
+                    expected[ 0 ].data( ), expected[ 1 ].data( ), expected[ 2 ].data( ),
+                    zeroEffortMissGain.data( ), zeroEffortVelocityGain.data( ) );
+            }
+            else if ( perSampleGains )
+            {
+                computeOptimalGuidanceLaw(
+                    soa[ 0 ].data( ), soa[ 1 ].data( ), soa[ 2 ].data( ),
+                    soa[ 3 ].data( ), soa[ 4 ].data( ), soa[ 5 ].data( ),
+                    timeToGo.data( ), numberOfSamples,
+                    expected[ 0 ].data( ), expected[ 1 ].data( ), expected[ 2 ].data( ),
+                    zeroEffortMissGain.data( ), zeroEffortVelocityGain.data( ) );
+            }
+            else if ( timeToGoFloor > 0.0 )
+            {
+                computeTerminalOptimalGuidanceLaw(
+                    soa[ 0 ].data( ), soa[ 1 ].data( ), soa[ 2 ].data( ),
+                    soa[ 3 ].data( ), soa[ 4 ].data( ), soa[ 5 ].data( ),
+                    timeToGo.data( ), numberOfSamples, timeToGoFloor,
+                    expected[ 0 ].data( ), expected[ 1 ].data( ), expected[ 2 ].data( ) );
+            }
+            else
+            {
+                computeOptimalGuidanceLaw(
+                    soa[ 0 ].data( ), soa[ 1 ].data( ), soa[ 2 ].data( ),
+                    soa[ 3 ].data( ), soa[ 4 ].data( ), soa[ 5 ].data( ),
+                    timeToGo.data( ), numberOfSamples,
+                    expected[ 0 ].data( ), expected[ 1 ].data( ), expected[ 2 ].data( ) );
+            }
+
+            const controlStridedArray zeroEffortMissGainArray
+                = perSampleGains
+                  ? controlStridedArray{ zeroEffortMissGain.data( ), sizeof( Real ) }
+                  : controlStridedArray{ &sharedGains[ 0 ], 0 };
+            const controlStridedArray zeroEffortVelocityGainArray
+                = perSampleGains
+                  ? controlStridedArray{ zeroEffortVelocityGain.data( ), sizeof( Real ) }
+                  : controlStridedArray{ &sharedGains[ 1 ], 0 };
+
+            // The results are written as an array of shape (N, 3) and, transposed, as an array of
+            // shape (3, N), with 1 and 4 threads; all are bit-identical to the reference.
+            for ( unsigned int numberOfThreads = 1; numberOfThreads <= 4; numberOfThreads += 3 )
+            {
+                std::vector< Real > controlEffort( 3 * numberOfSamples );
+                const controlMutableStridedVector3Array arrayOfVectors
+                    = { controlEffort.data( ), 3 * sizeof( Real ), sizeof( Real ) };
+                REQUIRE( controlComputeOptimalGuidanceLawDouble( &zeroEffortMissArray,
+                                                                 &zeroEffortVelocityArray,
+                                                                 &timeToGoArray,
+                                                                 numberOfSamples,
+                                                                 &zeroEffortMissGainArray,
+                                                                 &zeroEffortVelocityGainArray,
+                                                                 timeToGoFloor,
+                                                                 numberOfThreads,
+                                                                 &arrayOfVectors )
+                         == controlSuccess );
+
+                std::vector< Real > transposedControlEffort( 3 * numberOfSamples );
+                const controlMutableStridedVector3Array vectorOfArrays
+                    = { transposedControlEffort.data( ),
+                        sizeof( Real ),
+                        static_cast< std::ptrdiff_t >( numberOfSamples * sizeof( Real ) ) };
+                REQUIRE( controlComputeOptimalGuidanceLawDouble( &zeroEffortMissArray,
+                                                                 &zeroEffortVelocityArray,
+                                                                 &timeToGoArray,
+                                                                 numberOfSamples,
+                                                                 &zeroEffortMissGainArray,
+                                                                 &zeroEffortVelocityGainArray,
+                                                                 timeToGoFloor,
+                                                                 numberOfThreads,
+                                                                 &vectorOfArrays )
+                         == controlSuccess );
+
+                bool isIdentical = true;
+                for ( std::size_t i = 0; i < numberOfSamples; ++i )
+                {
+                    for ( unsigned int j = 0; j < 3; ++j )
+                    {
+                        isIdentical = isIdentical
+                                      && controlEffort[ 3 * i + j ] == expected[ j ][ i ]
+                                      && transposedControlEffort[ j * numberOfSamples + i ]
+                                         == expected[ j ][ i ];
+                    }
+                }
+                REQUIRE( isIdentical );
+            }
+        }
+    }
+
+    SECTION( "Test single precision" )
+    {
+        std::vector< float > zeroEffortMissFloat( zeroEffortMiss.begin( ), zeroEffortMiss.end( ) );
+        std::vector< float > zeroEffortVelocityFloat( zeroEffortVelocity.begin( ),
+                                                      zeroEffortVelocity.end( ) );
+        std::vector< float > timeToGoFloat( timeToGo.begin( ), timeToGo.end( ) );
+        const float gains[ 2 ] = { 6.0f, -2.0f };
+        std::vector< float > controlEffort( 3 * numberOfSamples );
+
+        const controlStridedVector3Array zeroEffortMissFloatArray
+            = { zeroEffortMissFloat.data( ), 3 * sizeof( float ), sizeof( float ) };
+        const controlStridedVector3Array zeroEffortVelocityFloatArray
+            = { zeroEffortVelocityFloat.data( ), 3 * sizeof( float ), sizeof( float ) };
+        const controlStridedArray timeToGoFloatArray = { timeToGoFloat.data( ), sizeof( float ) };
+        const controlStridedArray zeroEffortMissGainArray = { &gains[ 0 ], 0 };
+        const controlStridedArray zeroEffortVelocityGainArray = { &gains[ 1 ], 0 };
+        const controlMutableStridedVector3Array controlEffortArray
+            = { controlEffort.data( ), 3 * sizeof( float ), sizeof( float ) };
+        REQUIRE( controlComputeOptimalGuidanceLawFloat( &zeroEffortMissFloatArray,
+                                                        &zeroEffortVelocityFloatArray,
+                                                        &timeToGoFloatArray,
+                                                        numberOfSamples,
+                                                        &zeroEffortMissGainArray,
+                                                        &zeroEffortVelocityGainArray,
+                                                        minimumTimeToGo,
+                                                        0,
+                                                        &controlEffortArray )
+                 == controlSuccess );
+
+        bool isClose = true;
+        for ( std::size_t i = 0; i < numberOfSamples; ++i )
+        {
+            std::array< float, 3 > expectedControl;
+            computeTerminalOptimalGuidanceLaw(
+                std::array< float, 3 >{ { zeroEffortMissFloat[ 3 * i ],
+                                          zeroEffortMissFloat[ 3 * i + 1 ],
+                                          zeroEffortMissFloat[ 3 * i + 2 ] } },
+                std::array< float, 3 >{ { zeroEffortVelocityFloat[ 3 * i ],
+                                          zeroEffortVelocityFloat[ 3 * i + 1 ],
+                                          zeroEffortVelocityFloat[ 3 * i + 2 ] } },
+                timeToGoFloat[ i ], static_cast< float >( minimumTimeToGo ), expectedControl );
+            for ( unsigned int j = 0; j < 3; ++j )
+            {
+                isClose = isClose && controlEffort[ 3 * i + j ]
+                                     == Approx( expectedControl[ j ] ).epsilon( 1.0e-5 )
+                                                                      .margin( 1.0e-4 );
+            }
+        }
+        REQUIRE( isClose );
+    }
+
+    SECTION( "Test invalid arguments" )
+    {
+        const Real gains[ 2 ] = { 6.0, -2.0 };
+        const controlStridedArray zeroEffortMissGainArray = { &gains[ 0 ], 0 };
+        const controlStridedArray zeroEffortVelocityGainArray = { &gains[ 1 ], 0 };
+        std::vector< Real > controlEffort( 3 * numberOfSamples );
+        const controlMutableStridedVector3Array controlEffortArray
+            = { controlEffort.data( ), 3 * sizeof( Real ), sizeof( Real ) };
+
+        REQUIRE( controlComputeOptimalGuidanceLawDouble( nullptr,
+                                                         &zeroEffortVelocityArray,
+                                                         &timeToGoArray,
+                                                         numberOfSamples,
+                                                         &zeroEffortMissGainArray,
+                                                         &zeroEffortVelocityGainArray,
+                                                         0.0,
+                                                         1,
+                                                         &controlEffortArray )
+                 == controlInvalidArgument );
+        REQUIRE( controlComputeOptimalGuidanceLawDouble( &zeroEffortMissArray,
+                                                         &zeroEffortVelocityArray,
+                                                         &timeToGoArray,
+                                                         numberOfSamples,
+                                                         &zeroEffortMissGainArray,
+                                                         &zeroEffortVelocityGainArray,
+                                                         -1.0,
+                                                         1,
+                                                         &controlEffortArray )
+                 == controlInvalidArgument );
+
+        const controlStridedArray nullTimeToGoArray = { nullptr, sizeof( Real ) };
+        REQUIRE( controlComputeOptimalGuidanceLawDouble( &zeroEffortMissArray,
+                                                         &zeroEffortVelocityArray,
+                                                         &nullTimeToGoArray,
+                                                         numberOfSamples,
+                                                         &zeroEffortMissGainArray,
+                                                         &zeroEffortVelocityGainArray,
+                                                         0.0,
+                                                         1,
+                                                         &controlEffortArray )
+                 == controlInvalidArgument );
+
+        // Zero output strides would write several samples or components to the same element.
+        const controlMutableStridedVector3Array broadcastControlEffortArray
+            = { controlEffort.data( ), 0, sizeof( Real ) };
+        REQUIRE( controlComputeOptimalGuidanceLawDouble( &zeroEffortMissArray,
+                                                         &zeroEffortVelocityArray,
+                                                         &timeToGoArray,
+                                                         numberOfSamples,
+                                                         &zeroEffortMissGainArray,
+                                                         &zeroEffortVelocityGainArray,
+                                                         0.0,
+                                                         0,
+                                                         &broadcastControlEffortArray )
+                 == controlInvalidArgument );
+        const controlMutableStridedVector3Array overlappingControlEffortArray
+            = { controlEffort.data( ), 3 * sizeof( Real ), 0 };
+        REQUIRE( controlComputeOptimalGuidanceLawDouble( &zeroEffortMissArray,
+                                                         &zeroEffortVelocityArray,
+                                                         &timeToGoArray,
+                                                         numberOfSamples,
+                                                         &zeroEffortMissGainArray,
+                                                         &zeroEffortVelocityGainArray,
+                                                         0.0,
+                                                         0,
+                                                         &overlappingControlEffortArray )
+                 == controlInvalidArgument );
+
+        // An empty batch is valid, irrespective of the data pointers.
+        REQUIRE( controlComputeOptimalGuidanceLawDouble( &zeroEffortMissArray,
+                                                         &zeroEffortVelocityArray,
+                                                         &nullTimeToGoArray,
+                                                         0,
+                                                         &zeroEffortMissGainArray,
+                                                         &zeroEffortVelocityGainArray,
+                                                         0.0,
+                                                         1,
+                                                         &controlEffortArray )
+                 == controlSuccess );
+    }
+}
+
+} // namespace tests
+} // namespace control
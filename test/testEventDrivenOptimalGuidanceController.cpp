@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/eventDrivenOptimalGuidanceController.hpp"
+#include "control/optimalGuidanceController.hpp"
+
+#include "testAllocationCounter.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector;
+
+TEST_CASE( "Test event-driven Optimal Guidance controller",
+           "[ogl][controller][event-driven]" )
+{
+    Vector targetPosition( 3, 0.0 );
+    Vector targetVelocity( 3, 0.0 );
+    targetVelocity[ 2 ] = -0.5;
+
+    Vector gravitationalAcceleration( 3, 0.0 );
+    gravitationalAcceleration[ 2 ] = -1.62;
+
+    const Real finalTime = 30.0;
+
+    Vector position( 3 );
+    position[ 0 ] = 150.0;
+    position[ 1 ] = -75.0;
+    position[ 2 ] = 500.0;
+
+    Vector velocity( 3 );
+    velocity[ 0 ] = -10.0;
+    velocity[ 1 ] = 2.5;
+    velocity[ 2 ] = -20.0;
+
+    // Landing at a control rate of 100 Hz, with the trajectory propagated using the exact solution
+    // for a constant acceleration over each time step.
+    const Real timeStep = 0.01;
+    const unsigned int numberOfSteps = 3000;
+
+    OptimalGuidanceController< Real, Vector > referenceController( targetPosition,
+                                                                   targetVelocity,
+                                                                   gravitationalAcceleration,
+                                                                   finalTime );
+
+    SECTION( "Test error bound in closed-loop landing" )
+    {
+        const Real commandTolerance = 1.0e-2;
+        EventDrivenOptimalGuidanceController< Real, Vector > controller( targetPosition,
+                                                                         targetVelocity,
+                                                                         gravitationalAcceleration,
+                                                                         finalTime,
+                                                                         commandTolerance );
+
+        unsigned int numberOfCruiseEvaluations = 0;
+        unsigned int numberOfCruiseSteps = 0;
+        const std::size_t allocationCountBefore = getAllocationCount( );
+        for ( unsigned int step = 0; step < numberOfSteps; ++step )
+        {
+            const Real currentTime = step * timeStep;
+            const Vector& control = controller.computeControl( currentTime, position, velocity );
+            const Vector& referenceControl
+                = referenceController.computeControl( currentTime, position, velocity );
+
+            // The bound holds up to round-off, which grows in the terminal phase.
+            Real errorSquared = 0.0;
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                errorSquared += ( control[ i ] - referenceControl[ i ] )
+                                * ( control[ i ] - referenceControl[ i ] );
+            }
+            REQUIRE( controller.getCommandErrorBound( ) <= commandTolerance );
+            REQUIRE( std::sqrt( errorSquared ) <= controller.getCommandErrorBound( ) + 1.0e-8 );
+            REQUIRE( controller.isCommandHeld( ) == ( controller.getCommandErrorBound( ) > 0.0 ) );
+
+            if ( finalTime - currentTime > 5.0 )
+            {
+                ++numberOfCruiseSteps;
+                numberOfCruiseEvaluations += controller.isCommandHeld( ) ? 0 : 1;
+            }
+
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                const Real acceleration = control[ i ] + gravitationalAcceleration[ i ];
+                position[ i ] += velocity[ i ] * timeStep
+                                 + 0.5 * acceleration * timeStep * timeStep;
+                velocity[ i ] += acceleration * timeStep;
+            }
+        }
+        const std::size_t allocationCountAfter = getAllocationCount( );
+
+        REQUIRE( allocationCountAfter == allocationCountBefore );
+        REQUIRE( 10 * numberOfCruiseEvaluations < numberOfCruiseSteps );
+        REQUIRE( controller.getNumberOfEvaluations( ) < numberOfSteps );
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( position[ i ] == Approx( targetPosition[ i ] ).margin( 1.0e-2 ) );
+            REQUIRE( velocity[ i ] == Approx( targetVelocity[ i ] ).margin( 1.0e-2 ) );
+        }
+    }
+
+    SECTION( "Test error bound with disturbance acceleration" )
+    {
+        // Start on the ballistic trajectory to the target state, such that the OGL command is
+        // zero without disturbance, and only the disturbance bound triggers re-evaluations.
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            velocity[ i ] = targetVelocity[ i ] - gravitationalAcceleration[ i ] * finalTime;
+            position[ i ] = targetPosition[ i ] - velocity[ i ] * finalTime
+                            - 0.5 * gravitationalAcceleration[ i ] * finalTime * finalTime;
+        }
+
+        // Constant disturbance acceleration, e.g., due to a thrust misalignment.
+        Vector disturbance( 3, 0.0 );
+        disturbance[ 0 ] = 3.0e-2;
+        disturbance[ 1 ] = -4.0e-2;
+
+        const Real commandTolerance = 2.0e-2;
+        EventDrivenOptimalGuidanceController< Real, Vector > controller( targetPosition,
+                                                                         targetVelocity,
+                                                                         gravitationalAcceleration,
+                                                                         finalTime,
+                                                                         commandTolerance,
+                                                                         5.0e-2 );
+
+        for ( unsigned int step = 0; step < numberOfSteps; ++step )
+        {
+            const Real currentTime = step * timeStep;
+            const Vector& control = controller.computeControl( currentTime, position, velocity );
+            const Vector& referenceControl
+                = referenceController.computeControl( currentTime, position, velocity );
+
+            Real errorSquared = 0.0;
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                errorSquared += ( control[ i ] - referenceControl[ i ] )
+                                * ( control[ i ] - referenceControl[ i ] );
+            }
+            REQUIRE( controller.getCommandErrorBound( ) <= commandTolerance );
+            REQUIRE( std::sqrt( errorSquared ) <= controller.getCommandErrorBound( ) + 1.0e-8 );
+
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                const Real acceleration
+                    = control[ i ] + gravitationalAcceleration[ i ] + disturbance[ i ];
+                position[ i ] += velocity[ i ] * timeStep
+                                 + 0.5 * acceleration * timeStep * timeStep;
+                velocity[ i ] += acceleration * timeStep;
+            }
+        }
+
+        REQUIRE( controller.getNumberOfEvaluations( ) > 1 );
+        REQUIRE( controller.getNumberOfEvaluations( ) < numberOfSteps / 2 );
+    }
+
+    SECTION( "Test negative tolerance" )
+    {
+        // With a negative tolerance, the OGL is re-evaluated at every call.
+        EventDrivenOptimalGuidanceController< Real, Vector > controller( targetPosition,
+                                                                         targetVelocity,
+                                                                         gravitationalAcceleration,
+                                                                         finalTime,
+                                                                         -1.0 );
+
+        for ( unsigned int step = 0; step < 100; ++step )
+        {
+            const Real currentTime = step * timeStep;
+            const Vector& control = controller.computeControl( currentTime, position, velocity );
+            const Vector& referenceControl
+                = referenceController.computeControl( currentTime, position, velocity );
+
+            REQUIRE( !controller.isCommandHeld( ) );
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                REQUIRE( control[ i ] == referenceControl[ i ] );
+                const Real acceleration = control[ i ] + gravitationalAcceleration[ i ];
+                position[ i ] += velocity[ i ] * timeStep
+                                 + 0.5 * acceleration * timeStep * timeStep;
+                velocity[ i ] += acceleration * timeStep;
+            }
+        }
+
+        REQUIRE( controller.getNumberOfEvaluations( ) == 100 );
+    }
+
+    SECTION( "Test re-evaluation after reset" )
+    {
+        EventDrivenOptimalGuidanceController< Real, Vector > controller( targetPosition,
+                                                                         targetVelocity,
+                                                                         gravitationalAcceleration,
+                                                                         finalTime,
+                                                                         1.0e-1 );
+
+        controller.computeControl( 0.0, position, velocity );
+        controller.computeControl( timeStep, position, velocity );
+        REQUIRE( controller.isCommandHeld( ) );
+        REQUIRE( controller.getNumberOfEvaluations( ) == 1 );
+
+        // After a state jump, the held command is discarded.
+        position[ 0 ] += 10.0;
+        controller.resetCommand( );
+        const Vector control = controller.computeControl( 2.0 * timeStep, position, velocity );
+        const Vector& referenceControl
+            = referenceController.computeControl( 2.0 * timeStep, position, velocity );
+        REQUIRE( !controller.isCommandHeld( ) );
+        REQUIRE( controller.getCommandErrorBound( ) == 0.0 );
+        REQUIRE( controller.getNumberOfEvaluations( ) == 2 );
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( control[ i ] == referenceControl[ i ] );
+        }
+
+        // Updating the final time discards the held command.
+        controller.setFinalTime( 40.0 );
+        REQUIRE( controller.getFinalTime( ) == 40.0 );
+        controller.computeControl( 3.0 * timeStep, position, velocity );
+        REQUIRE( !controller.isCommandHeld( ) );
+
+        // A decreasing time discards the held command.
+        controller.computeControl( 4.0 * timeStep, position, velocity );
+        REQUIRE( controller.isCommandHeld( ) );
+        controller.computeControl( 0.0, position, velocity );
+        REQUIRE( !controller.isCommandHeld( ) );
+        REQUIRE( controller.getNumberOfEvaluations( ) == 4 );
+    }
+}
+
+} // namespace tests
+} // namespace control
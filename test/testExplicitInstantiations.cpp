@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <array>
+#include <limits>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/explicitInstantiations.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+TEST_CASE( "Test explicit instantiations", "[instantiations]" )
+{
+    // The guidance templates are declared as extern templates in this translation unit, such that
+    // the calls below link against the explicit instantiations in src/explicitInstantiations.cpp.
+
+    const double timeToGo = 12.516;
+    const std::array< double, 3 > zeroEffortMiss = { { -21.163, 9.887, -0.613 } };
+    const std::array< double, 3 > zeroEffortVelocity = { { -1.244, -0.112, 3.119 } };
+    const std::array< double, 3 > expectedControl
+        = { { -0.611797225534058, 0.396587823003621, -0.521881100532641 } };
+    const double tolerance = 100.0 * std::numeric_limits< double >::epsilon( );
+
+    SECTION( "Test std::array" )
+    {
+        std::array< double, 3 > controlEffort;
+        computeOptimalGuidanceLaw( zeroEffortMiss, zeroEffortVelocity, timeToGo, controlEffort );
+
+        std::array< float, 3 > singlePrecisionControlEffort;
+        computeOptimalGuidanceLaw( std::array< float, 3 >{ { -21.163f, 9.887f, -0.613f } },
+                                   std::array< float, 3 >{ { -1.244f, -0.112f, 3.119f } },
+                                   12.516f,
+                                   singlePrecisionControlEffort );
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( controlEffort[ i ] == Approx( expectedControl[ i ] ).epsilon( tolerance ) );
+            REQUIRE( singlePrecisionControlEffort[ i ]
+                     == Approx( expectedControl[ i ] ).epsilon( 1.0e-5 ) );
+        }
+    }
+
+    SECTION( "Test std::vector" )
+    {
+        const std::vector< double > zeroEffortMissVector( zeroEffortMiss.begin( ),
+                                                          zeroEffortMiss.end( ) );
+        const std::vector< double > zeroEffortVelocityVector( zeroEffortVelocity.begin( ),
+                                                              zeroEffortVelocity.end( ) );
+
+        const std::vector< double > controlEffort
+            = computeOptimalGuidanceLaw( zeroEffortMissVector, zeroEffortVelocityVector, timeToGo );
+
+        std::vector< double > terminalControlEffort( 3 );
+        computeTerminalOptimalGuidanceLaw( zeroEffortMissVector,
+                                           zeroEffortVelocityVector,
+                                           timeToGo,
+                                           1.0,
+                                           terminalControlEffort );
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( controlEffort[ i ] == Approx( expectedControl[ i ] ).epsilon( tolerance ) );
+            REQUIRE( terminalControlEffort[ i ] == controlEffort[ i ] );
+        }
+    }
+
+    SECTION( "Test batch" )
+    {
+        const double timeToGoBatch[ 2 ] = { timeToGo, timeToGo };
+        const double zeroEffortMissX[ 2 ] = { zeroEffortMiss[ 0 ], zeroEffortMiss[ 0 ] };
+        const double zeroEffortMissY[ 2 ] = { zeroEffortMiss[ 1 ], zeroEffortMiss[ 1 ] };
+        const double zeroEffortMissZ[ 2 ] = { zeroEffortMiss[ 2 ], zeroEffortMiss[ 2 ] };
+        const double zeroEffortVelocityX[ 2 ] = { zeroEffortVelocity[ 0 ], zeroEffortVelocity[ 0 ] };
+        const double zeroEffortVelocityY[ 2 ] = { zeroEffortVelocity[ 1 ], zeroEffortVelocity[ 1 ] };
+        const double zeroEffortVelocityZ[ 2 ] = { zeroEffortVelocity[ 2 ], zeroEffortVelocity[ 2 ] };
+        double controlEffortX[ 2 ];
+        double controlEffortY[ 2 ];
+        double controlEffortZ[ 2 ];
+
+        computeOptimalGuidanceLaw( zeroEffortMissX, zeroEffortMissY, zeroEffortMissZ,
+                                   zeroEffortVelocityX, zeroEffortVelocityY, zeroEffortVelocityZ,
+                                   timeToGoBatch, 2,
+                                   controlEffortX, controlEffortY, controlEffortZ );
+
+        for ( unsigned int i = 0; i < 2; ++i )
+        {
+            REQUIRE( controlEffortX[ i ] == Approx( expectedControl[ 0 ] ).epsilon( tolerance ) );
+            REQUIRE( controlEffortY[ i ] == Approx( expectedControl[ 1 ] ).epsilon( tolerance ) );
+            REQUIRE( controlEffortZ[ i ] == Approx( expectedControl[ 2 ] ).epsilon( tolerance ) );
+        }
+    }
+
+    SECTION( "Test controller" )
+    {
+        const std::array< double, 3 > zero = { { 0.0, 0.0, 0.0 } };
+        OptimalGuidanceController< double, std::array< double, 3 > > controller(
+            zero, zero, zero, timeToGo );
+
+        // With zero gravity and a target at rest at the origin, the ZEM and ZEV follow directly
+        // from the current state.
+        const std::array< double, 3 > velocity = { { 1.244, 0.112, -3.119 } };
+        const std::array< double, 3 > position
+            = { { 21.163 - timeToGo * 1.244, -9.887 - timeToGo * 0.112, 0.613 + timeToGo * 3.119 } };
+        const std::array< double, 3 > controlEffort
+            = controller.computeControl( 0.0, position, velocity );
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( controlEffort[ i ] == Approx( expectedControl[ i ] ).epsilon( 1.0e-12 ) );
+        }
+    }
+}
+
+} // namespace tests
+} // namespace control
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/formationGuidance.hpp"
+#include "control/optimalGuidanceController.hpp"
+#include "control/simd.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::array< Real, 3 > Vector;
+typedef ConstantAccelerationTarget< Real, Vector > Target;
+
+//! Target ephemeris that counts its evaluations.
+class CountingTarget
+{
+public:
+
+    CountingTarget( const Target& aTarget, unsigned int* aNumberOfEvaluations )
+        : target( aTarget ),
+          numberOfEvaluations( aNumberOfEvaluations )
+    { }
+
+    void computeState( const Real time, Vector& position, Vector& velocity ) const
+    {
+        ++*numberOfEvaluations;
+        target.computeState( time, position, velocity );
+    }
+
+private:
+
+    Target target;
+
+    unsigned int* numberOfEvaluations;
+};
+
+TEST_CASE( "Test formation guidance", "[formation-guidance]" )
+{
+    // Landers descending under Mars gravity towards a stationary site and a moving target.
+    const Vector gravitationalAcceleration = { { 0.0, 0.0, -3.7114 } };
+    const Vector zero = { { 0.0, 0.0, 0.0 } };
+    const Vector sitePosition = { { 100.0, -50.0, 0.0 } };
+    const Vector roverPosition = { { -300.0, 200.0, 0.0 } };
+    const Vector roverVelocity = { { 2.0, -1.0, 0.0 } };
+    std::vector< Target > targets;
+    targets.push_back( Target( sitePosition, zero, zero ) );
+    targets.push_back( Target( roverPosition, roverVelocity, zero ) );
+    std::vector< Real > finalTimes;
+    finalTimes.push_back( 40.0 );
+    finalTimes.push_back( 45.0 );
+
+    const std::size_t numberOfVehicles = 1000;
+    std::vector< std::size_t > targetIndices( numberOfVehicles );
+    std::vector< Real > positionX( numberOfVehicles );
+    std::vector< Real > positionY( numberOfVehicles );
+    std::vector< Real > positionZ( numberOfVehicles );
+    std::vector< Real > velocityX( numberOfVehicles );
+    std::vector< Real > velocityY( numberOfVehicles );
+    std::vector< Real > velocityZ( numberOfVehicles );
+    for ( std::size_t j = 0; j < numberOfVehicles; ++j )
+    {
+        targetIndices[ j ] = j % 3 == 0 ? 1 : 0;
+        positionX[ j ] = 200.0 + 0.5 * j;
+        positionY[ j ] = -100.0 - 0.25 * j;
+        positionZ[ j ] = 1500.0 + 0.1 * j;
+        velocityX[ j ] = -10.0;
+        velocityY[ j ] = 5.0 + 0.001 * j;
+        velocityZ[ j ] = -75.0;
+    }
+
+    std::vector< Real > controlEffortX( numberOfVehicles );
+    std::vector< Real > controlEffortY( numberOfVehicles );
+    std::vector< Real > controlEffortZ( numberOfVehicles );
+
+    SECTION( "Test shared target propagation" )
+    {
+        unsigned int numberOfEvaluations = 0;
+        std::vector< CountingTarget > countingTargets;
+        countingTargets.push_back( CountingTarget( targets[ 0 ], &numberOfEvaluations ) );
+        countingTargets.push_back( CountingTarget( targets[ 1 ], &numberOfEvaluations ) );
+
+        FormationGuidance< Real, Vector, CountingTarget > formation(
+            countingTargets, finalTimes, targetIndices, std::vector< Vector >( ),
+            gravitationalAcceleration );
+        REQUIRE( formation.getNumberOfTargets( ) == 2 );
+        REQUIRE( formation.getNumberOfVehicles( ) == numberOfVehicles );
+
+        for ( unsigned int call = 1; call <= 3; ++call )
+        {
+            formation.computeControl( 1.0 * call,
+                                      &positionX[ 0 ], &positionY[ 0 ], &positionZ[ 0 ],
+                                      &velocityX[ 0 ], &velocityY[ 0 ], &velocityZ[ 0 ],
+                                      &controlEffortX[ 0 ], &controlEffortY[ 0 ],
+                                      &controlEffortZ[ 0 ] );
+            REQUIRE( numberOfEvaluations == 2 * call );
+        }
+    }
+
+    SECTION( "Test agreement with controller per vehicle" )
+    {
+        const SimdInstructionSet defaultInstructionSet = getSimdInstructionSet( );
+        setSimdInstructionSet( scalarInstructionSet );
+
+        FormationGuidance< Real, Vector, Target > formation(
+            targets, finalTimes, targetIndices, std::vector< Vector >( ),
+            gravitationalAcceleration );
+        const Real currentTime = 3.5;
+        formation.computeControl( currentTime,
+                                  &positionX[ 0 ], &positionY[ 0 ], &positionZ[ 0 ],
+                                  &velocityX[ 0 ], &velocityY[ 0 ], &velocityZ[ 0 ],
+                                  &controlEffortX[ 0 ], &controlEffortY[ 0 ],
+                                  &controlEffortZ[ 0 ] );
+
+        // The results are bit-identical in deterministic mode; otherwise, the compiler may
+        // contract the batched and single-vehicle paths into fused multiply-add instructions
+        // differently.
+        const auto isClose = [ ]( const Real value, const Real expectedValue )
+        {
+            return isDeterministicModeEnabled( )
+                   ? value == expectedValue
+                   : std::abs( value - expectedValue ) <= 1.0e-12 * std::abs( expectedValue );
+        };
+
+        bool isConsistent = true;
+        for ( std::size_t j = 0; j < numberOfVehicles; ++j )
+        {
+            const std::size_t k = targetIndices[ j ];
+            Vector targetPosition;
+            Vector targetVelocity;
+            targets[ k ].computeState( finalTimes[ k ], targetPosition, targetVelocity );
+            OptimalGuidanceController< Real, Vector > controller(
+                targetPosition, targetVelocity, gravitationalAcceleration, finalTimes[ k ] );
+
+            const Vector position = { { positionX[ j ], positionY[ j ], positionZ[ j ] } };
+            const Vector velocity = { { velocityX[ j ], velocityY[ j ], velocityZ[ j ] } };
+            const Vector& controlEffort
+                = controller.computeControl( currentTime, position, velocity );
+            isConsistent = isConsistent
+                           && isClose( controlEffortX[ j ], controlEffort[ 0 ] )
+                           && isClose( controlEffortY[ j ], controlEffort[ 1 ] )
+                           && isClose( controlEffortZ[ j ], controlEffort[ 2 ] )
+                           && formation.getTimesToGo( )[ j ] == finalTimes[ k ] - currentTime;
+        }
+        REQUIRE( isConsistent );
+
+        setSimdInstructionSet( defaultInstructionSet );
+    }
+
+    SECTION( "Test closed-loop formation with offsets" )
+    {
+        std::vector< Vector > targetOffsets( numberOfVehicles );
+        for ( std::size_t j = 0; j < numberOfVehicles; ++j )
+        {
+            targetOffsets[ j ][ 0 ] = 10.0 * std::cos( 0.01 * j );
+            targetOffsets[ j ][ 1 ] = 10.0 * std::sin( 0.01 * j );
+            targetOffsets[ j ][ 2 ] = 0.0;
+        }
+
+        FormationGuidance< Real, Vector, Target > formation(
+            targets, finalTimes, targetIndices, targetOffsets, gravitationalAcceleration );
+
+        // Both targets are reached at the same time, by updating the final time of the rover.
+        formation.setFinalTime( 1, 40.0 );
+        REQUIRE( formation.getFinalTime( 1 ) == 40.0 );
+
+        const Real stepSize = 0.01;
+        const unsigned int numberOfSteps = 4000;
+        for ( unsigned int step = 0; step < numberOfSteps; ++step )
+        {
+            formation.computeControl( step * stepSize,
+                                      &positionX[ 0 ], &positionY[ 0 ], &positionZ[ 0 ],
+                                      &velocityX[ 0 ], &velocityY[ 0 ], &velocityZ[ 0 ],
+                                      &controlEffortX[ 0 ], &controlEffortY[ 0 ],
+                                      &controlEffortZ[ 0 ] );
+
+            for ( std::size_t j = 0; j < numberOfVehicles; ++j )
+            {
+                const Real accelerationX = controlEffortX[ j ] + gravitationalAcceleration[ 0 ];
+                const Real accelerationY = controlEffortY[ j ] + gravitationalAcceleration[ 1 ];
+                const Real accelerationZ = controlEffortZ[ j ] + gravitationalAcceleration[ 2 ];
+                positionX[ j ] += stepSize * velocityX[ j ]
+                                  + 0.5 * stepSize * stepSize * accelerationX;
+                positionY[ j ] += stepSize * velocityY[ j ]
+                                  + 0.5 * stepSize * stepSize * accelerationY;
+                positionZ[ j ] += stepSize * velocityZ[ j ]
+                                  + 0.5 * stepSize * stepSize * accelerationZ;
+                velocityX[ j ] += stepSize * accelerationX;
+                velocityY[ j ] += stepSize * accelerationY;
+                velocityZ[ j ] += stepSize * accelerationZ;
+            }
+        }
+
+        Real maximumPositionMiss = 0.0;
+        Real maximumVelocityMiss = 0.0;
+        for ( std::size_t j = 0; j < numberOfVehicles; ++j )
+        {
+            Vector targetPosition;
+            Vector targetVelocity;
+            targets[ targetIndices[ j ] ].computeState( 40.0, targetPosition, targetVelocity );
+            const Real positionMiss = std::sqrt(
+                std::pow( positionX[ j ] - targetPosition[ 0 ] - targetOffsets[ j ][ 0 ], 2 )
+                + std::pow( positionY[ j ] - targetPosition[ 1 ] - targetOffsets[ j ][ 1 ], 2 )
+                + std::pow( positionZ[ j ] - targetPosition[ 2 ] - targetOffsets[ j ][ 2 ], 2 ) );
+            const Real velocityMiss = std::sqrt(
+                std::pow( velocityX[ j ] - targetVelocity[ 0 ], 2 )
+                + std::pow( velocityY[ j ] - targetVelocity[ 1 ], 2 )
+                + std::pow( velocityZ[ j ] - targetVelocity[ 2 ], 2 ) );
+            maximumPositionMiss = positionMiss > maximumPositionMiss
+                                  ? positionMiss : maximumPositionMiss;
+            maximumVelocityMiss = velocityMiss > maximumVelocityMiss
+                                  ? velocityMiss : maximumVelocityMiss;
+        }
+        REQUIRE( maximumPositionMiss < 1.0e-2 );
+        REQUIRE( maximumVelocityMiss < 1.0e-1 );
+    }
+
+    SECTION( "Test invalid arguments" )
+    {
+        typedef FormationGuidance< Real, Vector, Target > Formation;
+
+        // The number of offsets must be zero or equal to the number of vehicles.
+        REQUIRE_THROWS_AS( Formation( targets, finalTimes, targetIndices,
+                                      std::vector< Vector >( numberOfVehicles + 1, zero ),
+                                      gravitationalAcceleration ),
+                           std::invalid_argument );
+        REQUIRE_THROWS_AS( Formation( targets, finalTimes, targetIndices,
+                                      std::vector< Vector >( 1, zero ),
+                                      gravitationalAcceleration ),
+                           std::invalid_argument );
+
+        // Each target needs a final time, and each vehicle a valid target index.
+        REQUIRE_THROWS_AS( Formation( targets, std::vector< Real >( 1, 40.0 ), targetIndices,
+                                      std::vector< Vector >( ), gravitationalAcceleration ),
+                           std::invalid_argument );
+        std::vector< std::size_t > invalidTargetIndices( targetIndices );
+        invalidTargetIndices[ 7 ] = 2;
+        REQUIRE_THROWS_AS( Formation( targets, finalTimes, invalidTargetIndices,
+                                      std::vector< Vector >( ), gravitationalAcceleration ),
+                           std::invalid_argument );
+    }
+}
+
+} // namespace tests
+} // namespace control
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/frameArena.hpp"
+#include "control/optimalGuidanceController.hpp"
+#include "control/optimalGuidanceLaw.hpp"
+#include "control/simd.hpp"
+
+#include "testAllocationCounter.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+typedef ArenaVector< Real > Vector;
+
+TEST_CASE( "Test frame arena", "[frame-arena]" )
+{
+    SECTION( "Test allocation, alignment and reset" )
+    {
+        FrameArena arena( 256 );
+        REQUIRE( arena.getCapacity( ) == 256 );
+
+        void* bytes = arena.allocate( 3, 1 );
+        REQUIRE( arena.owns( bytes ) );
+        REQUIRE( arena.getSize( ) == 3 );
+
+        void* reals = arena.allocate( 3 * sizeof( Real ), alignof( Real ) );
+        REQUIRE( reinterpret_cast< std::size_t >( reals ) % alignof( Real ) == 0 );
+        REQUIRE( arena.getSize( ) <= 3 + alignof( Real ) - 1 + 3 * sizeof( Real ) );
+
+        // Releasing the most recent allocation rolls back the arena, other releases are no-ops.
+        const std::size_t sizeAfterReals = arena.getSize( );
+        arena.deallocate( bytes, 3 );
+        REQUIRE( arena.getSize( ) == sizeAfterReals );
+        arena.deallocate( reals, 3 * sizeof( Real ) );
+        REQUIRE( arena.getSize( ) < sizeAfterReals );
+
+        REQUIRE( arena.allocate( 512, 1 ) == 0 );
+
+        arena.reset( );
+        REQUIRE( arena.getSize( ) == 0 );
+        REQUIRE( arena.getHighWaterMark( ) == sizeAfterReals );
+        REQUIRE( arena.getNumberOfOverflowAllocations( ) == 0 );
+    }
+
+    SECTION( "Test fallback on global allocator" )
+    {
+        FrameArena arena( 4 * sizeof( Real ) );
+        Vector vector = createArenaVector3( arena, 1.0, 2.0, 3.0 );
+        REQUIRE( arena.owns( vector.data( ) ) );
+
+        const Vector copy = vector;
+        REQUIRE( !arena.owns( copy.data( ) ) );
+        REQUIRE( copy == vector );
+        REQUIRE( arena.getNumberOfOverflowAllocations( ) == 1 );
+        REQUIRE( copy.get_allocator( ) == vector.get_allocator( ) );
+    }
+
+    SECTION( "Test guidance with arena vectors" )
+    {
+        FrameArena arena( 1024 );
+        const Vector targetPosition = createArenaVector3( arena, 0.0, 0.0, 0.0 );
+        const Vector targetVelocity = createArenaVector3( arena, 0.0, 0.0, 0.0 );
+        const Vector gravitationalAcceleration = createArenaVector3( arena, 0.0, 0.0, -3.7114 );
+        Vector position = createArenaVector3( arena, 2000.0, -1000.0, 1500.0 );
+        Vector velocity = createArenaVector3( arena, -40.0, 20.0, -75.0 );
+        const Real finalTime = 30.0;
+        OptimalGuidanceController< Real, Vector > controller(
+            targetPosition, targetVelocity, gravitationalAcceleration, finalTime );
+
+        // All vectors that persist across steps are allocated before the first frame.
+        FrameArena frameArena( 1024 );
+        const Real timeStep = 0.01;
+        const unsigned int numberOfSteps = 3000;
+
+        // The results are bit-identical in deterministic mode; otherwise, the compiler may
+        // contract the OGL and the controller into fused multiply-add instructions differently.
+        const auto isClose = [ ]( const Real value, const Real expectedValue )
+        {
+            return isDeterministicModeEnabled( )
+                   ? value == expectedValue
+                   : std::abs( value - expectedValue )
+                     <= 1.0e-12 * ( 1.0 + std::abs( expectedValue ) );
+        };
+
+        bool isConsistent = true;
+        const std::size_t allocationCountBefore = getAllocationCount( );
+        for ( unsigned int step = 0; step < numberOfSteps; ++step )
+        {
+            frameArena.reset( );
+            const Real timeToGo = finalTime - step * timeStep;
+
+            // Temporaries created by the guidance templates are allocated from the frame arena.
+            const Vector zeroEffortMiss = createArenaVector3(
+                frameArena, -position[ 0 ] - timeToGo * velocity[ 0 ],
+                -position[ 1 ] - timeToGo * velocity[ 1 ],
+                -position[ 2 ] - timeToGo * velocity[ 2 ]
+                - 0.5 * timeToGo * timeToGo * gravitationalAcceleration[ 2 ] );
+            const Vector zeroEffortVelocity = createArenaVector3(
+                frameArena, -velocity[ 0 ], -velocity[ 1 ],
+                -velocity[ 2 ] - timeToGo * gravitationalAcceleration[ 2 ] );
+            const Vector controlEffort
+                = computeOptimalGuidanceLaw( zeroEffortMiss, zeroEffortVelocity, timeToGo );
+
+            const Vector& control
+                = controller.computeControl( step * timeStep, position, velocity );
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                isConsistent = isConsistent && isClose( control[ i ], controlEffort[ i ] );
+                const Real acceleration = control[ i ] + gravitationalAcceleration[ i ];
+                position[ i ] += velocity[ i ] * timeStep
+                                 + 0.5 * acceleration * timeStep * timeStep;
+                velocity[ i ] += acceleration * timeStep;
+            }
+        }
+        const std::size_t allocationCountAfter = getAllocationCount( );
+
+        REQUIRE( allocationCountAfter == allocationCountBefore );
+        REQUIRE( isConsistent );
+        REQUIRE( frameArena.getHighWaterMark( ) == 3 * 3 * sizeof( Real ) );
+        REQUIRE( frameArena.getNumberOfOverflowAllocations( ) == 0 );
+        REQUIRE( arena.getNumberOfOverflowAllocations( ) == 0 );
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( position[ i ] == Approx( targetPosition[ i ] ).margin( 1.0e-3 ) );
+            REQUIRE( velocity[ i ] == Approx( targetVelocity[ i ] ).margin( 1.0e-2 ) );
+        }
+    }
+}
+
+} // namespace tests
+} // namespace control
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/gainTuner.hpp"
+#include "control/optimalGuidanceController.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::array< Real, 3 > Vector;
+
+//! Simulate closed-loop OGL trajectory for scenario and add objectives to result.
+void simulateScenario( const GainTuningScenario< Real, Vector >& scenario,
+                       const Real velocityErrorWeight,
+                       GainTuningResult< Real >& result )
+{
+    OptimalGuidanceController< Real, Vector > controller( scenario.targetPosition,
+                                                          scenario.targetVelocity,
+                                                          scenario.gravitationalAcceleration,
+                                                          scenario.finalTime,
+                                                          result.zeroEffortMissGain,
+                                                          result.zeroEffortVelocityGain );
+
+    const Real stepSize = scenario.finalTime / static_cast< Real >( scenario.numberOfSteps );
+    Vector position = scenario.initialPosition;
+    Vector velocity = scenario.initialVelocity;
+    for ( std::size_t step = 0; step < scenario.numberOfSteps; ++step )
+    {
+        const Vector& controlEffort = controller.computeControl(
+            static_cast< Real >( step ) * stepSize, position, velocity );
+        Real controlEffortSquared = 0.0;
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            const Real acceleration = controlEffort[ i ] + scenario.gravitationalAcceleration[ i ];
+            position[ i ] += stepSize * velocity[ i ] + 0.5 * stepSize * stepSize * acceleration;
+            velocity[ i ] += stepSize * acceleration;
+            controlEffortSquared += controlEffort[ i ] * controlEffort[ i ];
+        }
+        result.deltaV += stepSize * std::sqrt( controlEffortSquared );
+    }
+
+    Real positionMissSquared = 0.0;
+    Real velocityMissSquared = 0.0;
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+        const Real positionMiss = position[ i ] - scenario.targetPosition[ i ];
+        const Real velocityMiss = velocity[ i ] - scenario.targetVelocity[ i ];
+        positionMissSquared += positionMiss * positionMiss;
+        velocityMissSquared += velocityMiss * velocityMiss;
+    }
+    result.terminalError += std::sqrt( positionMissSquared )
+                            + velocityErrorWeight * std::sqrt( velocityMissSquared );
+}
+
+//! Check if first result dominates second result.
+bool dominates( const GainTuningResult< Real >& first, const GainTuningResult< Real >& second )
+{
+    return first.deltaV <= second.deltaV && first.terminalError <= second.terminalError
+           && ( first.deltaV < second.deltaV || first.terminalError < second.terminalError );
+}
+
+TEST_CASE( "Test OGL gain tuner", "[gain-tuner]" )
+{
+    // Powered descent scenarios under Mars gravity, with target at the origin.
+    std::vector< GainTuningScenario< Real, Vector > > scenarios;
+    for ( unsigned int i = 0; i < 4; ++i )
+    {
+        GainTuningScenario< Real, Vector > scenario;
+        scenario.initialPosition = { { 200.0 + 50.0 * i, -100.0, 1500.0 - 100.0 * i } };
+        scenario.initialVelocity = { { -10.0, 5.0 + 2.0 * i, -75.0 } };
+        scenario.targetPosition = { { 0.0, 0.0, 0.0 } };
+        scenario.targetVelocity = { { 0.0, 0.0, 0.0 } };
+        scenario.gravitationalAcceleration = { { 0.0, 0.0, -3.7114 } };
+        scenario.finalTime = 40.0 + 5.0 * i;
+        scenario.numberOfSteps = 20 + 10 * i;
+        scenarios.push_back( scenario );
+    }
+    const Real velocityErrorWeight = 10.0;
+
+    GainTuner< Real, Vector > tuner( scenarios, velocityErrorWeight );
+
+    std::vector< Real > zeroEffortMissGains;
+    std::vector< Real > zeroEffortVelocityGains;
+    for ( unsigned int i = 0; i < 12; ++i )
+    {
+        for ( unsigned int j = 0; j < 12; ++j )
+        {
+            zeroEffortMissGains.push_back( 1.0 + 0.75 * i );
+            zeroEffortVelocityGains.push_back( -0.25 * j );
+        }
+    }
+
+    SECTION( "Test evaluation against closed-loop simulation" )
+    {
+        for ( std::size_t i = 0; i < zeroEffortMissGains.size( ); i += 13 )
+        {
+            const GainTuningResult< Real > result
+                = tuner.evaluate( zeroEffortMissGains[ i ], zeroEffortVelocityGains[ i ] );
+
+            GainTuningResult< Real > expectedResult = result;
+            expectedResult.deltaV = 0.0;
+            expectedResult.terminalError = 0.0;
+            for ( std::size_t j = 0; j < scenarios.size( ); ++j )
+            {
+                simulateScenario( scenarios[ j ], velocityErrorWeight, expectedResult );
+            }
+
+            REQUIRE( result.deltaV == Approx( expectedResult.deltaV ).epsilon( 1.0e-9 ) );
+            REQUIRE( result.terminalError
+                        == Approx( expectedResult.terminalError ).margin( 1.0e-6 ) );
+        }
+    }
+
+    SECTION( "Test Pareto front" )
+    {
+        const std::vector< GainTuningResult< Real > > paretoFront
+            = tuner.computeParetoFront( zeroEffortMissGains, zeroEffortVelocityGains, 4 );
+        REQUIRE( paretoFront.size( ) > 1 );
+        REQUIRE( tuner.getNumberOfPrunedCandidates( ) > 0 );
+
+        // Front is sorted by Delta-V and no member is dominated by another candidate.
+        for ( std::size_t i = 0; i < paretoFront.size( ); ++i )
+        {
+            if ( i > 0 )
+            {
+                REQUIRE( paretoFront[ i - 1 ].deltaV < paretoFront[ i ].deltaV );
+                REQUIRE( paretoFront[ i - 1 ].terminalError > paretoFront[ i ].terminalError );
+            }
+
+            for ( std::size_t j = 0; j < zeroEffortMissGains.size( ); ++j )
+            {
+                REQUIRE( !dominates(
+                    tuner.evaluate( zeroEffortMissGains[ j ], zeroEffortVelocityGains[ j ] ),
+                    paretoFront[ i ] ) );
+            }
+        }
+
+        // Every candidate off the front is dominated by or equal to a member of the front.
+        for ( std::size_t j = 0; j < zeroEffortMissGains.size( ); ++j )
+        {
+            const GainTuningResult< Real > result
+                = tuner.evaluate( zeroEffortMissGains[ j ], zeroEffortVelocityGains[ j ] );
+            bool isCovered = false;
+            for ( std::size_t i = 0; i < paretoFront.size( ); ++i )
+            {
+                isCovered = isCovered || dominates( paretoFront[ i ], result )
+                            || ( paretoFront[ i ].deltaV == result.deltaV
+                                 && paretoFront[ i ].terminalError == result.terminalError );
+            }
+            REQUIRE( isCovered );
+        }
+
+        // The front does not depend on the number of threads.
+        const std::vector< GainTuningResult< Real > > serialParetoFront
+            = tuner.computeParetoFront( zeroEffortMissGains, zeroEffortVelocityGains, 1 );
+        REQUIRE( serialParetoFront.size( ) == paretoFront.size( ) );
+        for ( std::size_t i = 0; i < paretoFront.size( ); ++i )
+        {
+            REQUIRE( serialParetoFront[ i ].zeroEffortMissGain
+                        == paretoFront[ i ].zeroEffortMissGain );
+            REQUIRE( serialParetoFront[ i ].zeroEffortVelocityGain
+                        == paretoFront[ i ].zeroEffortVelocityGain );
+            REQUIRE( serialParetoFront[ i ].deltaV == paretoFront[ i ].deltaV );
+            REQUIRE( serialParetoFront[ i ].terminalError == paretoFront[ i ].terminalError );
+        }
+    }
+}
+
+} // namespace tests
+} // namespace control
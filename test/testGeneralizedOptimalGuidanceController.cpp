@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <limits>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/generalizedOptimalGuidanceController.hpp"
+#include "control/optimalGuidanceController.hpp"
+
+#include "testAllocationCounter.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector;
+static const Real tolerance = 1.0e4 * std::numeric_limits< Real >::epsilon( );
+
+TEST_CASE( "Test generalized ZEM/ZEV guidance controller", "[ogl][controller]")
+{
+    const Real timeStep = 0.1;
+    const Real finalTime = 600.0;
+    const unsigned int numberOfSteps = 6000;
+
+    SECTION( "Test consistency with constant-gravity controller" )
+    {
+        Vector targetPosition( 3, 0.0 );
+        Vector targetVelocity( 3, 0.0 );
+        Vector gravitationalAcceleration( 3, 0.0 );
+        gravitationalAcceleration[ 2 ] = -1.62;
+
+        Vector position( 3 );
+        position[ 0 ] = 1500.0;
+        position[ 1 ] = -750.0;
+        position[ 2 ] = 5000.0;
+
+        Vector velocity( 3 );
+        velocity[ 0 ] = -2.0;
+        velocity[ 1 ] = 0.5;
+        velocity[ 2 ] = -10.0;
+
+        typedef ConstantGravity< Real, Vector > Gravity;
+        GeneralizedOptimalGuidanceController< Real, Vector, Gravity > generalizedController(
+            targetPosition, targetVelocity, Gravity( gravitationalAcceleration ),
+            finalTime, 10, 1.0, 0.1 );
+        OptimalGuidanceController< Real, Vector > controller(
+            targetPosition, targetVelocity, gravitationalAcceleration, finalTime );
+
+        for ( unsigned int step = 0; step < numberOfSteps; ++step )
+        {
+            const Real currentTime = step * timeStep;
+            const Vector& expectedControl = controller.computeControl( currentTime,
+                                                                       position,
+                                                                       velocity );
+            const Vector& computedControl = generalizedController.computeControl( currentTime,
+                                                                                  position,
+                                                                                  velocity );
+
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                REQUIRE( computedControl[ i ]
+                            == Approx( expectedControl[ i ] ).epsilon( tolerance )
+                                                             .margin( tolerance ) );
+            }
+
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                const Real acceleration = expectedControl[ i ] + gravitationalAcceleration[ i ];
+                position[ i ] += velocity[ i ] * timeStep
+                                 + 0.5 * acceleration * timeStep * timeStep;
+                velocity[ i ] += acceleration * timeStep;
+            }
+        }
+    }
+
+    SECTION( "Test closed-loop asteroid landing with point-mass gravity" )
+    {
+        // Landing on a spherical asteroid with a gravitational parameter similar to 433 Eros.
+        const Real gravitationalParameter = 4.463e5;
+        typedef PointMassGravity< Real, Vector > Gravity;
+        const Gravity gravity( gravitationalParameter );
+
+        Vector targetPosition( 3, 0.0 );
+        targetPosition[ 2 ] = 8.0e3;
+        Vector targetVelocity( 3, 0.0 );
+        targetVelocity[ 2 ] = -0.1;
+
+        Vector position( 3 );
+        position[ 0 ] = 4.0e3;
+        position[ 1 ] = 1.0e3;
+        position[ 2 ] = 12.0e3;
+
+        Vector velocity( 3 );
+        velocity[ 0 ] = 1.0;
+        velocity[ 1 ] = -0.5;
+        velocity[ 2 ] = 2.0;
+
+        GeneralizedOptimalGuidanceController< Real, Vector, Gravity > controller(
+            targetPosition, targetVelocity, gravity, finalTime, 200, 10.0, 0.1 );
+
+        // Reference controller that fully re-predicts the arrival state at every call.
+        GeneralizedOptimalGuidanceController< Real, Vector, Gravity > referenceController(
+            targetPosition, targetVelocity, gravity, finalTime, 200, 0.0, 0.0 );
+
+        Vector acceleration( 3 );
+        const std::size_t allocationCountBefore = getAllocationCount( );
+        for ( unsigned int step = 0; step < numberOfSteps; ++step )
+        {
+            const Real currentTime = step * timeStep;
+            const Vector& control = controller.computeControl( currentTime, position, velocity );
+            referenceController.computeControl( currentTime, position, velocity );
+
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                REQUIRE( controller.getZeroEffortMiss( )[ i ]
+                            == Approx( referenceController.getZeroEffortMiss( )[ i ] )
+                                .margin( 2.0 ) );
+                REQUIRE( controller.getZeroEffortVelocity( )[ i ]
+                            == Approx( referenceController.getZeroEffortVelocity( )[ i ] )
+                                .margin( 2.0e-2 ) );
+            }
+
+            // Propagate with semi-implicit Euler integration at a fine step.
+            const unsigned int numberOfSubsteps = 10;
+            const Real substep = timeStep / numberOfSubsteps;
+            for ( unsigned int substepIndex = 0; substepIndex < numberOfSubsteps; ++substepIndex )
+            {
+                gravity.computeAcceleration( position, acceleration );
+                for ( unsigned int i = 0; i < 3; ++i )
+                {
+                    velocity[ i ] += ( control[ i ] + acceleration[ i ] ) * substep;
+                    position[ i ] += velocity[ i ] * substep;
+                }
+            }
+        }
+        const std::size_t allocationCountAfter = getAllocationCount( );
+
+        REQUIRE( allocationCountAfter == allocationCountBefore );
+        REQUIRE( referenceController.getNumberOfPredictions( ) == numberOfSteps );
+        REQUIRE( controller.getNumberOfPredictions( ) < numberOfSteps / 15 );
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( position[ i ] == Approx( targetPosition[ i ] ).margin( 1.0 ) );
+            REQUIRE( velocity[ i ] == Approx( targetVelocity[ i ] ).margin( 1.0e-2 ) );
+        }
+    }
+}
+
+} // namespace tests
+} // namespace control
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/gravityModels.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector;
+static const Real tolerance = 100.0 * std::numeric_limits< Real >::epsilon( );
+
+static void computeScaledAcceleration( const Vector& position,
+                                       Vector& acceleration,
+                                       void* userData )
+{
+    const Real scale = *static_cast< Real* >( userData );
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+        acceleration[ i ] = scale * position[ i ];
+    }
+}
+
+TEST_CASE( "Test gravity models", "[gravity]")
+{
+    Vector position( 3 );
+    position[ 0 ] = 3.0e3;
+    position[ 1 ] = -4.0e3;
+    position[ 2 ] = 12.0e3;
+    const Real radius = 13.0e3;
+
+    Vector acceleration( 3 );
+
+    SECTION( "Test constant gravity" )
+    {
+        Vector gravitationalAcceleration( 3 );
+        gravitationalAcceleration[ 0 ] = 0.1;
+        gravitationalAcceleration[ 1 ] = -0.2;
+        gravitationalAcceleration[ 2 ] = -1.62;
+
+        const ConstantGravity< Real, Vector > gravity( gravitationalAcceleration );
+        gravity.computeAcceleration( position, acceleration );
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( acceleration[ i ] == gravitationalAcceleration[ i ] );
+        }
+    }
+
+    SECTION( "Test point-mass and J2 gravity" )
+    {
+        const Real gravitationalParameter = 4.463e5;
+
+        const PointMassGravity< Real, Vector > pointMassGravity( gravitationalParameter );
+        pointMassGravity.computeAcceleration( position, acceleration );
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( acceleration[ i ]
+                        == Approx( -gravitationalParameter * position[ i ]
+                                   / ( radius * radius * radius ) ).epsilon( tolerance ) );
+        }
+
+        // J2 gravity reduces to point-mass gravity for J2 = 0.
+        const J2Gravity< Real, Vector > sphericalGravity( gravitationalParameter, 0.0, 8.0e3 );
+        Vector sphericalAcceleration( 3 );
+        sphericalGravity.computeAcceleration( position, sphericalAcceleration );
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( sphericalAcceleration[ i ]
+                        == Approx( acceleration[ i ] ).epsilon( tolerance ) );
+        }
+
+        // Check J2 gravity against finite-difference gradient of J2 potential.
+        const Real j2Coefficient = 0.05;
+        const Real referenceRadius = 8.0e3;
+        const J2Gravity< Real, Vector > oblateGravity( gravitationalParameter,
+                                                       j2Coefficient,
+                                                       referenceRadius );
+        Vector oblateAcceleration( 3 );
+        oblateGravity.computeAcceleration( position, oblateAcceleration );
+
+        const Real stepSize = 1.0e-2;
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            Real potential[ 2 ];
+            for ( unsigned int j = 0; j < 2; ++j )
+            {
+                Vector perturbedPosition = position;
+                perturbedPosition[ i ] += ( j == 0 ? -stepSize : stepSize );
+                const Real r = std::sqrt( perturbedPosition[ 0 ] * perturbedPosition[ 0 ]
+                                          + perturbedPosition[ 1 ] * perturbedPosition[ 1 ]
+                                          + perturbedPosition[ 2 ] * perturbedPosition[ 2 ] );
+                const Real sinLatitude = perturbedPosition[ 2 ] / r;
+                potential[ j ] = gravitationalParameter / r
+                                 * ( 1.0 - j2Coefficient * ( referenceRadius / r )
+                                     * ( referenceRadius / r )
+                                     * 0.5 * ( 3.0 * sinLatitude * sinLatitude - 1.0 ) );
+            }
+
+            REQUIRE( oblateAcceleration[ i ]
+                        == Approx( ( potential[ 1 ] - potential[ 0 ] ) / ( 2.0 * stepSize ) )
+                            .epsilon( 1.0e-6 ) );
+        }
+    }
+
+    SECTION( "Test callback gravity" )
+    {
+        Real scale = -2.0;
+        const CallbackGravity< Real, Vector > gravity( &computeScaledAcceleration, &scale );
+        gravity.computeAcceleration( position, acceleration );
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( acceleration[ i ] == scale * position[ i ] );
+        }
+    }
+}
+
+} // namespace tests
+} // namespace control
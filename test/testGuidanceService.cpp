@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <thread>
+
+#include <catch.hpp>
+
+#include "control/guidanceService.hpp"
+#include "control/optimalGuidanceController.hpp"
+
+#include "testAllocationCounter.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::array< Real, 3 > Vector;
+
+TEST_CASE( "Test guidance service", "[guidance-service]" )
+{
+    const Vector targetPosition = { { 0.0, 0.0, 0.0 } };
+    const Vector targetVelocity = { { 0.0, 0.0, -0.5 } };
+    const Vector gravity = { { 0.0, 0.0, -1.62 } };
+    const Real finalTime = 30.0;
+    const Vector initialPosition = { { 150.0, -75.0, 500.0 } };
+    const Vector initialVelocity = { { -10.0, 2.5, -20.0 } };
+
+    // Navigation updates arrive at 50 Hz, commands are computed at 1 kHz.
+    const Real commandPeriod = 0.001;
+    const unsigned int numberOfCommandsPerEstimate = 20;
+
+    GuidanceService< Real > service( targetPosition, targetVelocity, gravity, finalTime );
+
+    SECTION( "Test command before first state estimate" )
+    {
+        REQUIRE( !service.update( 0.0 ) );
+        REQUIRE( service.getNumberOfCommands( ) == 0 );
+        const GuidanceCommand< Real > command = service.readCommand( );
+        REQUIRE( command.controlEffort[ 0 ] == 0.0 );
+        REQUIRE( command.controlEffort[ 1 ] == 0.0 );
+        REQUIRE( command.controlEffort[ 2 ] == 0.0 );
+    }
+
+    SECTION( "Test propagation of ZEM and ZEV between state estimates" )
+    {
+        // Without perturbations, the propagated ZEM and ZEV vectors, and hence the commands, match
+        // the commands computed from the true state at each command step.
+        OptimalGuidanceController< Real, Vector > controller(
+            targetPosition, targetVelocity, gravity, finalTime );
+        Vector position = initialPosition;
+        Vector velocity = initialVelocity;
+        REQUIRE( service.pushStateEstimate( 0.0, position, velocity ) );
+
+        bool isClose = true;
+        const std::size_t allocationCountBefore = getAllocationCount( );
+        for ( unsigned int step = 0; step < 5000; ++step )
+        {
+            const Real time = step * commandPeriod;
+            REQUIRE( service.update( time ) );
+            const GuidanceCommand< Real > command = service.readCommand( );
+            const Vector& expectedControl = controller.computeControl( time, position, velocity );
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                isClose = isClose
+                          && std::fabs( command.controlEffort[ i ] - expectedControl[ i ] )
+                             <= 1.0e-9 * ( 1.0 + std::fabs( expectedControl[ i ] ) );
+                const Real acceleration = command.controlEffort[ i ] + gravity[ i ];
+                position[ i ] += velocity[ i ] * commandPeriod
+                                 + 0.5 * acceleration * commandPeriod * commandPeriod;
+                velocity[ i ] += acceleration * commandPeriod;
+            }
+            isClose = isClose && command.time == time && command.estimateTime == 0.0;
+        }
+        const std::size_t allocationCountAfter = getAllocationCount( );
+
+        REQUIRE( isClose );
+        REQUIRE( allocationCountAfter == allocationCountBefore );
+        REQUIRE( service.getNumberOfCommands( ) == 5000 );
+        REQUIRE( service.getNumberOfStateEstimates( ) == 1 );
+    }
+
+    SECTION( "Test closed-loop landing with perturbed plant" )
+    {
+        // The plant is subject to a perturbation that is not modeled by the service, such that
+        // the propagated ZEM and ZEV vectors drift until the next state estimate arrives.
+        Vector position = initialPosition;
+        Vector velocity = initialVelocity;
+        const unsigned int numberOfSteps = 29990;
+        unsigned int numberOfPublishedCommands = 0;
+        for ( unsigned int step = 0; step < numberOfSteps; ++step )
+        {
+            const Real time = step * commandPeriod;
+            if ( step % numberOfCommandsPerEstimate == 0 )
+            {
+                REQUIRE( service.pushStateEstimate( time, position, velocity ) );
+            }
+            numberOfPublishedCommands += service.update( time ) ? 1 : 0;
+
+            const GuidanceCommand< Real > command = service.readCommand( );
+            const Vector perturbation = { { 0.05 * std::sin( time ), 0.05, -0.1 } };
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                const Real acceleration = command.controlEffort[ i ] + gravity[ i ]
+                                          + perturbation[ i ];
+                position[ i ] += velocity[ i ] * commandPeriod
+                                 + 0.5 * acceleration * commandPeriod * commandPeriod;
+                velocity[ i ] += acceleration * commandPeriod;
+            }
+        }
+
+        REQUIRE( numberOfPublishedCommands == numberOfSteps );
+
+        // The landing is stopped 10 ms before the final time, at which the vehicle is expected to
+        // be on the terminal velocity approach to the target.
+        const Real remainingTime = finalTime - numberOfSteps * commandPeriod;
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( position[ i ] == Approx( targetPosition[ i ]
+                                              - remainingTime * targetVelocity[ i ] )
+                                          .margin( 1.0e-4 ) );
+            REQUIRE( velocity[ i ] == Approx( targetVelocity[ i ] ).margin( 1.0e-2 ) );
+        }
+
+        // Close to the final time, the last command is held.
+        const std::size_t numberOfCommands = service.getNumberOfCommands( );
+        REQUIRE( !service.update( finalTime - 1.0e-4 ) );
+        REQUIRE( service.getNumberOfCommands( ) == numberOfCommands );
+    }
+
+    SECTION( "Test concurrent navigation, guidance and actuator threads" )
+    {
+        // The threads run at their own pace, without any synchronization besides the service.
+        const unsigned int numberOfEstimates = 500;
+        std::atomic< bool > isRunning( true );
+        std::atomic< unsigned int > numberOfPushedEstimates( 0 );
+
+        std::thread navigation( [ &service, &numberOfPushedEstimates, &initialPosition,
+                                  &initialVelocity, numberOfEstimates ]( )
+        {
+            for ( unsigned int k = 0; k < numberOfEstimates; ++k )
+            {
+                if ( service.pushStateEstimate( 0.01 * k, initialPosition, initialVelocity ) )
+                {
+                    numberOfPushedEstimates.fetch_add( 1, std::memory_order_relaxed );
+                }
+                std::this_thread::yield( );
+            }
+        } );
+
+        std::thread guidance( [ &service, &isRunning ]( )
+        {
+            unsigned int step = 0;
+            while ( isRunning.load( std::memory_order_acquire ) )
+            {
+                service.update( 0.001 * ( step % 20000 ) );
+                ++step;
+            }
+        } );
+
+        // Commands read by the actuator thread are consistent, i.e., not torn.
+        while ( service.getNumberOfCommands( ) == 0 )
+        { }
+        bool isConsistent = true;
+        for ( unsigned int k = 0; k < 100000; ++k )
+        {
+            const GuidanceCommand< Real > command = service.readCommand( );
+            isConsistent = isConsistent && command.timeToGo == finalTime - command.time
+                           && command.estimateTime <= 0.01 * ( numberOfEstimates - 1 );
+        }
+
+        navigation.join( );
+        isRunning.store( false, std::memory_order_release );
+        guidance.join( );
+
+        REQUIRE( isConsistent );
+        REQUIRE( numberOfPushedEstimates.load( ) > 0 );
+        REQUIRE( service.getNumberOfCommands( ) > 0 );
+    }
+}
+
+} // namespace tests
+} // namespace control
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/instrumentation.hpp"
+#include "control/optimalGuidanceController.hpp"
+#include "control/optimalGuidanceLaw.hpp"
+#include "control/thrustSaturation.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::array< Real, 3 > Vector;
+
+//! Compute total number of calls in latency histogram of probe.
+std::uint64_t computeHistogramCallCount( const InstrumentationProbe probe )
+{
+    std::uint64_t callCount = 0;
+    for ( std::size_t i = 0; i < numberOfLatencyHistogramBins; ++i )
+    {
+        callCount += getInstrumentationLatencyHistogram( probe, i );
+    }
+    return callCount;
+}
+
+TEST_CASE( "Test instrumentation hooks", "[instrumentation]" )
+{
+    const Vector zeroEffortMiss = { { -21.163, 9.887, -0.613 } };
+    const Vector zeroEffortVelocity = { { -1.244, -0.112, 3.119 } };
+    const std::vector< Real > timeToGo = { 12.516, 0.05, 3.1, 0.01 };
+
+    resetInstrumentation( );
+    setNearZeroTimeToGoThreshold( 0.1 );
+
+    SECTION( "Test latency histogram bins" )
+    {
+        REQUIRE( detail::computeLatencyHistogramBin( 0 ) == 0 );
+        REQUIRE( detail::computeLatencyHistogramBin( 1 ) == 0 );
+        REQUIRE( detail::computeLatencyHistogramBin( 2 ) == 1 );
+        REQUIRE( detail::computeLatencyHistogramBin( 1023 ) == 9 );
+        REQUIRE( detail::computeLatencyHistogramBin( 1024 ) == 10 );
+        REQUIRE( detail::computeLatencyHistogramBin( UINT64_MAX )
+                    == numberOfLatencyHistogramBins - 1 );
+    }
+
+    SECTION( "Test recording of calls and events" )
+    {
+        // Nothing is recorded while instrumentation is disabled at runtime.
+        REQUIRE( !isInstrumentationEnabled( ) );
+        Vector controlEffort;
+        computeOptimalGuidanceLaw( zeroEffortMiss, zeroEffortVelocity, 0.01, controlEffort );
+        REQUIRE( getInstrumentationCallCount( optimalGuidanceLawProbe ) == 0 );
+        REQUIRE( getInstrumentationEventCount( nearZeroTimeToGoEvent ) == 0 );
+
+        enableInstrumentation( true );
+        REQUIRE( isInstrumentationEnabled( ) );
+
+        for ( std::size_t i = 0; i < timeToGo.size( ); ++i )
+        {
+            computeOptimalGuidanceLaw(
+                zeroEffortMiss, zeroEffortVelocity, timeToGo[ i ], controlEffort );
+        }
+
+        const std::vector< Real > zeroEffortMissX( timeToGo.size( ), zeroEffortMiss[ 0 ] );
+        const std::vector< Real > zeroEffortMissY( timeToGo.size( ), zeroEffortMiss[ 1 ] );
+        const std::vector< Real > zeroEffortMissZ( timeToGo.size( ), zeroEffortMiss[ 2 ] );
+        const std::vector< Real > zeroEffortVelocityX( timeToGo.size( ), zeroEffortVelocity[ 0 ] );
+        const std::vector< Real > zeroEffortVelocityY( timeToGo.size( ), zeroEffortVelocity[ 1 ] );
+        const std::vector< Real > zeroEffortVelocityZ( timeToGo.size( ), zeroEffortVelocity[ 2 ] );
+        std::vector< Real > controlEffortX( timeToGo.size( ) );
+        std::vector< Real > controlEffortY( timeToGo.size( ) );
+        std::vector< Real > controlEffortZ( timeToGo.size( ) );
+        computeOptimalGuidanceLaw( &zeroEffortMissX[ 0 ],
+                                   &zeroEffortMissY[ 0 ],
+                                   &zeroEffortMissZ[ 0 ],
+                                   &zeroEffortVelocityX[ 0 ],
+                                   &zeroEffortVelocityY[ 0 ],
+                                   &zeroEffortVelocityZ[ 0 ],
+                                   &timeToGo[ 0 ],
+                                   timeToGo.size( ),
+                                   &controlEffortX[ 0 ],
+                                   &controlEffortY[ 0 ],
+                                   &controlEffortZ[ 0 ] );
+
+        const ThrustLimits< Real > thrustLimits( 0.0, 1.0 );
+        const unsigned char flags = computeSaturatedOptimalGuidanceLaw(
+            zeroEffortMiss, zeroEffortVelocity, timeToGo[ 3 ], thrustLimits, controlEffort );
+
+        const Vector zeroVector = { { 0.0, 0.0, 0.0 } };
+        OptimalGuidanceController< Real, Vector > controller(
+            zeroVector, zeroVector, zeroVector, 10.0 );
+        controller.computeControl( 0.0, zeroEffortMiss, zeroEffortVelocity );
+
+        enableInstrumentation( false );
+
+        // Recording after instrumentation is disabled again has no effect.
+        computeOptimalGuidanceLaw( zeroEffortMiss, zeroEffortVelocity, 0.01, controlEffort );
+
+        if ( isInstrumentationCompiledIn( ) )
+        {
+            // The controller evaluates the OGL, which is recorded as well.
+            REQUIRE( getInstrumentationCallCount( optimalGuidanceLawProbe ) == 5 );
+            REQUIRE( getInstrumentationCallCount( batchedOptimalGuidanceLawProbe ) == 1 );
+            REQUIRE( getInstrumentationCallCount( saturatedOptimalGuidanceLawProbe ) == 1 );
+            REQUIRE( getInstrumentationCallCount( optimalGuidanceControllerProbe ) == 1 );
+            REQUIRE( getInstrumentationCallCount( generalizedOptimalGuidanceControllerProbe )
+                        == 0 );
+
+            // Two near-zero TTGs from the single-sample calls, two from the batched call and one
+            // from the saturated call.
+            REQUIRE( getInstrumentationEventCount( nearZeroTimeToGoEvent ) == 5 );
+            REQUIRE( flags == maximumMagnitudeThrustSaturation );
+            REQUIRE( getInstrumentationEventCount( thrustSaturationEvent ) == 1 );
+        }
+        else
+        {
+            // Hooks are compiled out, so nothing is recorded, even if enabled at runtime.
+            REQUIRE( getInstrumentationCallCount( optimalGuidanceLawProbe ) == 0 );
+            REQUIRE( getInstrumentationCallCount( batchedOptimalGuidanceLawProbe ) == 0 );
+            REQUIRE( getInstrumentationEventCount( nearZeroTimeToGoEvent ) == 0 );
+            REQUIRE( getInstrumentationEventCount( thrustSaturationEvent ) == 0 );
+        }
+
+        for ( std::size_t i = 0; i < numberOfInstrumentationProbes; ++i )
+        {
+            const InstrumentationProbe probe = static_cast< InstrumentationProbe >( i );
+            REQUIRE( computeHistogramCallCount( probe ) == getInstrumentationCallCount( probe ) );
+        }
+
+        resetInstrumentation( );
+        for ( std::size_t i = 0; i < numberOfInstrumentationProbes; ++i )
+        {
+            const InstrumentationProbe probe = static_cast< InstrumentationProbe >( i );
+            REQUIRE( getInstrumentationCallCount( probe ) == 0 );
+            REQUIRE( getInstrumentationTotalLatency( probe ) == 0 );
+            REQUIRE( computeHistogramCallCount( probe ) == 0 );
+        }
+    }
+
+    setNearZeroTimeToGoThreshold( 0.0 );
+}
+
+} // namespace tests
+} // namespace control
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/linearQuadraticRegulator.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+typedef LinearQuadraticRegulator< Real, 6, 3 > Regulator;
+
+//! Set up discrete-time model of translational motion, i.e., a triple double integrator.
+void setUpTranslationalModel( const Real stepSize,
+                              Regulator::StateMatrix& stateMatrix,
+                              Regulator::InputMatrix& inputMatrix )
+{
+    stateMatrix.fill( 0.0 );
+    inputMatrix.fill( 0.0 );
+    for ( std::size_t i = 0; i < 3; ++i )
+    {
+        stateMatrix[ i * 6 + i ] = 1.0;
+        stateMatrix[ i * 6 + i + 3 ] = stepSize;
+        stateMatrix[ ( i + 3 ) * 6 + i + 3 ] = 1.0;
+        inputMatrix[ i * 3 + i ] = 0.5 * stepSize * stepSize;
+        inputMatrix[ ( i + 3 ) * 3 + i ] = stepSize;
+    }
+}
+
+//! Propagate state with discrete-time model.
+void propagateState( const Regulator::StateMatrix& stateMatrix,
+                     const Regulator::InputMatrix& inputMatrix,
+                     const Regulator::ControlVector& control,
+                     Regulator::StateVector& state )
+{
+    const Regulator::StateVector previousState = state;
+    for ( std::size_t i = 0; i < 6; ++i )
+    {
+        state[ i ] = 0.0;
+        for ( std::size_t j = 0; j < 6; ++j )
+        {
+            state[ i ] += stateMatrix[ i * 6 + j ] * previousState[ j ];
+        }
+        for ( std::size_t j = 0; j < 3; ++j )
+        {
+            state[ i ] += inputMatrix[ i * 3 + j ] * control[ j ];
+        }
+    }
+}
+
+TEST_CASE( "Test linear-quadratic regulator", "[lqr]" )
+{
+    SECTION( "Test steady-state gain of scalar system" )
+    {
+        // For A = B = Q = R = 1, the cost is the golden ratio and the gain is its inverse.
+        const LinearQuadraticRegulator< Real, 1, 1 >::StateMatrix one = { { 1.0 } };
+        const LinearQuadraticRegulator< Real, 1, 1 > regulator( one, one, one, one, 1.0e-15, 100 );
+        const Real goldenRatio = 0.5 * ( 1.0 + std::sqrt( 5.0 ) );
+
+        REQUIRE( regulator.isValid( ) );
+        REQUIRE( regulator.getNumberOfGains( ) == 1 );
+        REQUIRE( regulator.getNumberOfIterations( ) < 100 );
+        REQUIRE( regulator.getCostMatrix( )[ 0 ] == Approx( goldenRatio ).epsilon( 1.0e-14 ) );
+        REQUIRE( regulator.getGain( 0 )[ 0 ] == Approx( 1.0 / goldenRatio ).epsilon( 1.0e-14 ) );
+        REQUIRE( regulator.getGain( 1000 ) == regulator.getGain( 0 ) );
+
+        LinearQuadraticRegulator< Real, 1, 1 >::StateVector state = { { 2.0 } };
+        LinearQuadraticRegulator< Real, 1, 1 >::ControlVector control;
+        regulator.computeControl( 5, state, control );
+        REQUIRE( control[ 0 ] == -regulator.getGain( 0 )[ 0 ] * 2.0 );
+    }
+
+    SECTION( "Test invalid control weight" )
+    {
+        const LinearQuadraticRegulator< Real, 1, 1 >::StateMatrix one = { { 1.0 } };
+        const LinearQuadraticRegulator< Real, 1, 1 >::ControlWeightMatrix zero = { { 0.0 } };
+        const LinearQuadraticRegulator< Real, 1, 1 >::StateMatrix zeroFinalWeight = { { 0.0 } };
+
+        // With B^T P B = 0, a zero control weight makes the Riccati recursion singular.
+        REQUIRE( !LinearQuadraticRegulator< Real, 1, 1 >(
+                     one, one, one, zero, zeroFinalWeight, 1 ).isValid( ) );
+        REQUIRE( !LinearQuadraticRegulator< Real, 1, 1 >(
+                     one, one, one, one, 1.0e-15, 2 ).isValid( ) );
+    }
+
+    const Real stepSize = 1.0;
+    Regulator::StateMatrix stateMatrix;
+    Regulator::InputMatrix inputMatrix;
+    setUpTranslationalModel( stepSize, stateMatrix, inputMatrix );
+
+    Regulator::StateMatrix stateWeightMatrix;
+    stateWeightMatrix.fill( 0.0 );
+    Regulator::StateMatrix finalStateWeightMatrix;
+    finalStateWeightMatrix.fill( 0.0 );
+    Regulator::ControlWeightMatrix controlWeightMatrix;
+    controlWeightMatrix.fill( 0.0 );
+    for ( std::size_t i = 0; i < 3; ++i )
+    {
+        stateWeightMatrix[ i * 6 + i ] = 1.0;
+        stateWeightMatrix[ ( i + 3 ) * 6 + i + 3 ] = 10.0;
+        finalStateWeightMatrix[ i * 6 + i ] = 1.0e4;
+        finalStateWeightMatrix[ ( i + 3 ) * 6 + i + 3 ] = 1.0e4;
+        controlWeightMatrix[ i * 3 + i ] = 100.0;
+    }
+    controlWeightMatrix[ 1 ] = controlWeightMatrix[ 3 ] = 10.0;
+
+    const std::size_t numberOfSteps = 200;
+    const Regulator regulator( stateMatrix,
+                               inputMatrix,
+                               stateWeightMatrix,
+                               controlWeightMatrix,
+                               finalStateWeightMatrix,
+                               numberOfSteps );
+    REQUIRE( regulator.isValid( ) );
+    REQUIRE( regulator.getNumberOfGains( ) == numberOfSteps );
+    REQUIRE( regulator.getNumberOfIterations( ) == numberOfSteps );
+
+    const Regulator::StateVector initialState = { { 100.0, -50.0, 20.0, 1.0, 0.5, -0.2 } };
+
+    SECTION( "Test cache-aligned gain schedule" )
+    {
+        for ( std::size_t k = 0; k < numberOfSteps; ++k )
+        {
+            REQUIRE( reinterpret_cast< std::size_t >( regulator.getGain( k ) ) % 64 == 0 );
+        }
+        REQUIRE( regulator.getGain( numberOfSteps ) == regulator.getGain( numberOfSteps - 1 ) );
+
+        // Far from the end of the horizon, the gains converge to the steady-state gain.
+        const Regulator steadyStateRegulator(
+            stateMatrix, inputMatrix, stateWeightMatrix, controlWeightMatrix, 1.0e-14, 10000 );
+        REQUIRE( steadyStateRegulator.isValid( ) );
+        for ( std::size_t i = 0; i < 3 * 6; ++i )
+        {
+            REQUIRE( regulator.getGain( 0 )[ i ]
+                     == Approx( steadyStateRegulator.getGain( 0 )[ i ] ).margin( 1.0e-10 ) );
+        }
+    }
+
+    SECTION( "Test optimal cost of finite-horizon regulator" )
+    {
+        // The cost accumulated along the closed-loop trajectory equals x_0^T P_0 x_0.
+        Regulator::StateVector state = initialState;
+        Regulator::ControlVector control;
+        Real cost = 0.0;
+        for ( std::size_t k = 0; k < numberOfSteps; ++k )
+        {
+            regulator.computeControl( k, state, control );
+            for ( std::size_t i = 0; i < 6; ++i )
+            {
+                for ( std::size_t j = 0; j < 6; ++j )
+                {
+                    cost += state[ i ] * stateWeightMatrix[ i * 6 + j ] * state[ j ];
+                }
+            }
+            for ( std::size_t i = 0; i < 3; ++i )
+            {
+                for ( std::size_t j = 0; j < 3; ++j )
+                {
+                    cost += control[ i ] * controlWeightMatrix[ i * 3 + j ] * control[ j ];
+                }
+            }
+            propagateState( stateMatrix, inputMatrix, control, state );
+        }
+        for ( std::size_t i = 0; i < 6; ++i )
+        {
+            cost += state[ i ] * finalStateWeightMatrix[ i * 6 + i ] * state[ i ];
+        }
+
+        Real expectedCost = 0.0;
+        for ( std::size_t i = 0; i < 6; ++i )
+        {
+            for ( std::size_t j = 0; j < 6; ++j )
+            {
+                expectedCost += initialState[ i ] * regulator.getCostMatrix( )[ i * 6 + j ]
+                                * initialState[ j ];
+            }
+        }
+        REQUIRE( cost == Approx( expectedCost ).epsilon( 1.0e-10 ) );
+    }
+
+    SECTION( "Test tracking of reference state" )
+    {
+        const Regulator::StateVector referenceState = { { 10.0, 10.0, 10.0, 0.0, 0.0, 0.0 } };
+        Regulator::StateVector state = initialState;
+        Regulator::ControlVector control;
+        for ( std::size_t k = 0; k < numberOfSteps; ++k )
+        {
+            regulator.computeControl( k, state, referenceState, control );
+            propagateState( stateMatrix, inputMatrix, control, state );
+        }
+        for ( std::size_t i = 0; i < 6; ++i )
+        {
+            REQUIRE( state[ i ] == Approx( referenceState[ i ] ).margin( 1.0e-3 ) );
+        }
+    }
+
+    SECTION( "Test batch of vehicles" )
+    {
+        const std::size_t numberOfVehicles = 100;
+        std::vector< Real > states( numberOfVehicles * 6 );
+        for ( std::size_t j = 0; j < numberOfVehicles; ++j )
+        {
+            for ( std::size_t i = 0; i < 6; ++i )
+            {
+                states[ j * 6 + i ] = initialState[ i ] * ( 1.0 + 0.01 * j );
+            }
+        }
+        std::vector< Real > controls( numberOfVehicles * 3 );
+        regulator.computeControl( 7, states.data( ), numberOfVehicles, controls.data( ) );
+
+        bool isIdentical = true;
+        for ( std::size_t j = 0; j < numberOfVehicles; ++j )
+        {
+            Regulator::StateVector state;
+            for ( std::size_t i = 0; i < 6; ++i )
+            {
+                state[ i ] = states[ j * 6 + i ];
+            }
+            Regulator::ControlVector control;
+            regulator.computeControl( 7, state, control );
+            for ( std::size_t i = 0; i < 3; ++i )
+            {
+                isIdentical = isIdentical && controls[ j * 3 + i ] == control[ i ];
+            }
+        }
+        REQUIRE( isIdentical );
+    }
+}
+
+} // namespace tests
+} // namespace control
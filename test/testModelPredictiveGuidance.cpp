@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/modelPredictiveGuidance.hpp"
+#include "control/optimalGuidanceController.hpp"
+
+#include "testAllocationCounter.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector;
+
+//! Compute magnitude of 3-vector.
+Real computeMagnitude( const Vector& vector )
+{
+    return std::sqrt( vector[ 0 ] * vector[ 0 ] + vector[ 1 ] * vector[ 1 ]
+                      + vector[ 2 ] * vector[ 2 ] );
+}
+
+TEST_CASE( "Test model predictive guidance controller", "[mpc][controller]" )
+{
+    Vector targetPosition( 3, 0.0 );
+    Vector targetVelocity( 3, 0.0 );
+    targetVelocity[ 2 ] = -0.5;
+
+    Vector gravitationalAcceleration( 3, 0.0 );
+    gravitationalAcceleration[ 2 ] = -1.62;
+
+    const Real finalTime = 30.0;
+
+    Vector position( 3 );
+    position[ 0 ] = 150.0;
+    position[ 1 ] = -75.0;
+    position[ 2 ] = 500.0;
+
+    Vector velocity( 3 );
+    velocity[ 0 ] = -10.0;
+    velocity[ 1 ] = 2.5;
+    velocity[ 2 ] = -20.0;
+
+    ModelPredictiveGuidanceSettings< Real > settings;
+    settings.stepSize = 0.01;
+    settings.maximumNumberOfSteps = 500;
+    settings.maximumControlAcceleration = 100.0;
+    settings.zeroEffortMissWeight = 1.0e6;
+    settings.zeroEffortVelocityWeight = 1.0e6;
+    settings.controlWeight = 1.0;
+    settings.maximumNumberOfIterations = 50;
+    settings.tolerance = 1.0e-6;
+    settings.timeBudget = 0.0;
+    settings.minimumTimeToGo = 0.005;
+
+    OptimalGuidanceController< Real, Vector > optimalGuidanceController(
+        targetPosition, targetVelocity, gravitationalAcceleration, finalTime );
+
+    SECTION( "Test consistency with OGL without active constraints" )
+    {
+        ModelPredictiveGuidanceController< Real, Vector > controller(
+            targetPosition, targetVelocity, gravitationalAcceleration, finalTime, settings );
+        const Real currentTime = 4.2;
+        const Vector control = controller.computeControl( currentTime, position, velocity );
+        const Vector expectedControl
+            = optimalGuidanceController.computeControl( currentTime, position, velocity );
+
+        REQUIRE( controller.getStatus( ) == modelPredictiveGuidanceConverged );
+        REQUIRE( controller.getTimeToGo( ) == finalTime - currentTime );
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( controller.getZeroEffortMiss( )[ i ]
+                     == optimalGuidanceController.getZeroEffortMiss( )[ i ] );
+            REQUIRE( controller.getZeroEffortVelocity( )[ i ]
+                     == optimalGuidanceController.getZeroEffortVelocity( )[ i ] );
+
+            // The steps hold the controls at the midpoints of the linear OGL profile, so the
+            // control at the current time is extrapolated from the first two steps.
+            const std::vector< Real >& plannedControls = controller.getPlannedControls( );
+            REQUIRE( control[ i ] == plannedControls[ i ] );
+            REQUIRE( 1.5 * plannedControls[ i ] - 0.5 * plannedControls[ 3 + i ]
+                     == Approx( expectedControl[ i ] ).margin( 1.0e-5 ) );
+        }
+    }
+
+    SECTION( "Test fallback on OGL" )
+    {
+        settings.maximumNumberOfIterations = 0;
+        ModelPredictiveGuidanceController< Real, Vector > controller(
+            targetPosition, targetVelocity, gravitationalAcceleration, finalTime, settings );
+        const Vector control = controller.computeControl( 4.2, position, velocity );
+        const Vector expectedControl
+            = optimalGuidanceController.computeControl( 4.2, position, velocity );
+        REQUIRE( controller.getStatus( ) == modelPredictiveGuidanceIterationBudgetExceeded );
+        REQUIRE( controller.getNumberOfIterations( ) == 0 );
+        REQUIRE( control == expectedControl );
+
+        settings.maximumNumberOfIterations = 50;
+        settings.timeBudget = 1.0e-300;
+        ModelPredictiveGuidanceController< Real, Vector > deadlineController(
+            targetPosition, targetVelocity, gravitationalAcceleration, finalTime, settings );
+        REQUIRE( deadlineController.computeControl( 4.2, position, velocity ) == expectedControl );
+        REQUIRE( deadlineController.getStatus( ) == modelPredictiveGuidanceTimeBudgetExceeded );
+
+        const Vector terminalControl = controller.computeControl( 29.998, position, velocity );
+        Vector expectedTerminalControl( 3 );
+        computeTerminalOptimalGuidanceLaw( controller.getZeroEffortMiss( ),
+                                           controller.getZeroEffortVelocity( ),
+                                           controller.getTimeToGo( ),
+                                           settings.minimumTimeToGo,
+                                           expectedTerminalControl );
+        REQUIRE( terminalControl == expectedTerminalControl );
+        REQUIRE( controller.getStatus( ) == modelPredictiveGuidanceTerminalPhase );
+    }
+
+    SECTION( "Test closed-loop landing with saturated control" )
+    {
+        // The OGL commands up to about 3.5 m/s^2 close to touchdown, such that the constraint is
+        // active over the last part of the descent.
+        settings.maximumControlAcceleration = 3.0;
+        ModelPredictiveGuidanceController< Real, Vector > controller(
+            targetPosition, targetVelocity, gravitationalAcceleration, finalTime, settings );
+
+        const Real timeStep = 0.01;
+        const unsigned int numberOfSteps = 3000;
+        unsigned int numberOfConvergedSteps = 0;
+        unsigned int numberOfSaturatedSteps = 0;
+        unsigned int numberOfWarmStartIterations = 0;
+        unsigned int maximumNumberOfWarmStartIterations = 0;
+        Real maximumControlAcceleration = 0.0;
+
+        const std::size_t allocationCountBefore = getAllocationCount( );
+        for ( unsigned int step = 0; step < numberOfSteps; ++step )
+        {
+            const Vector& control = controller.computeControl( step * timeStep,
+                                                               position,
+                                                               velocity );
+            if ( controller.getStatus( ) == modelPredictiveGuidanceConverged )
+            {
+                ++numberOfConvergedSteps;
+                const Real magnitude = computeMagnitude( control );
+                maximumControlAcceleration = magnitude > maximumControlAcceleration
+                                             ? magnitude : maximumControlAcceleration;
+                if ( magnitude > settings.maximumControlAcceleration * 0.9999999 )
+                {
+                    ++numberOfSaturatedSteps;
+                }
+                if ( step > 0 )
+                {
+                    const unsigned int iterations = controller.getNumberOfIterations( );
+                    numberOfWarmStartIterations += iterations;
+                    maximumNumberOfWarmStartIterations
+                        = iterations > maximumNumberOfWarmStartIterations
+                          ? iterations : maximumNumberOfWarmStartIterations;
+                }
+            }
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                const Real acceleration = control[ i ] + gravitationalAcceleration[ i ];
+                position[ i ] += velocity[ i ] * timeStep
+                                 + 0.5 * acceleration * timeStep * timeStep;
+                velocity[ i ] += acceleration * timeStep;
+            }
+        }
+        const std::size_t allocationCountAfter = getAllocationCount( );
+
+        REQUIRE( allocationCountAfter == allocationCountBefore );
+        REQUIRE( numberOfConvergedSteps == numberOfSteps );
+        REQUIRE( numberOfSaturatedSteps > 1000 );
+        REQUIRE( maximumControlAcceleration <= settings.maximumControlAcceleration * 1.0000001 );
+
+        // Warm-started calls typically need at most one iteration. Once the constraint becomes
+        // active, the line search may need more, depending on round-off in the dual function, but
+        // a warm-started call should not come close to exhausting the iteration budget.
+        REQUIRE( numberOfWarmStartIterations < numberOfSteps );
+        REQUIRE( 2 * maximumNumberOfWarmStartIterations < settings.maximumNumberOfIterations );
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( position[ i ] == Approx( targetPosition[ i ] ).margin( 1.0e-4 ) );
+            REQUIRE( velocity[ i ] == Approx( targetVelocity[ i ] ).margin( 1.0e-4 ) );
+        }
+    }
+}
+
+} // namespace tests
+} // namespace control
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <array>
+
+#include <catch.hpp>
+
+#include "control/monteCarloCampaign.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::array< Real, 3 > Vector;
+
+TEST_CASE( "Test Monte Carlo campaign", "[monte-carlo]" )
+{
+    // Powered descent from 1500 m altitude under Mars gravity, with target at the origin.
+    MonteCarloDispersion< Real, Vector > dispersion;
+    dispersion.initialPosition = { { 200.0, -100.0, 1500.0 } };
+    dispersion.initialPositionStandardDeviation = { { 50.0, 50.0, 50.0 } };
+    dispersion.initialVelocity = { { -10.0, 5.0, -75.0 } };
+    dispersion.initialVelocityStandardDeviation = { { 2.0, 2.0, 2.0 } };
+    dispersion.gravitationalAcceleration = { { 0.0, 0.0, -3.7114 } };
+    dispersion.gravitationalAccelerationStandardDeviation = { { 0.01, 0.01, 0.01 } };
+    dispersion.zeroEffortMissGain = 6.0;
+    dispersion.zeroEffortMissGainStandardDeviation = 0.1;
+    dispersion.zeroEffortVelocityGain = -2.0;
+    dispersion.zeroEffortVelocityGainStandardDeviation = 0.05;
+    dispersion.positionNoiseStandardDeviation = { { 0.01, 0.01, 0.01 } };
+    dispersion.velocityNoiseStandardDeviation = { { 0.001, 0.001, 0.001 } };
+
+    const Vector targetPosition = { { 0.0, 0.0, 0.0 } };
+    const Vector targetVelocity = { { 0.0, 0.0, 0.0 } };
+    const Real finalTime = 40.0;
+    const std::size_t numberOfSteps = 400;
+
+    const MonteCarloCampaign< Real, Vector > campaign(
+        dispersion, targetPosition, targetVelocity, finalTime, numberOfSteps );
+
+    const std::size_t numberOfTrajectories = 500;
+    const std::uint64_t seed = 12345;
+
+    SECTION( "Test reproducibility irrespective of number of threads" )
+    {
+        const MonteCarloStatistics< Real > serial = campaign.run( numberOfTrajectories, seed, 1 );
+        const unsigned int numberOfThreads[ 3 ] = { 0, 3, 8 };
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            const MonteCarloStatistics< Real > parallel
+                = campaign.run( numberOfTrajectories, seed, numberOfThreads[ i ] );
+
+            REQUIRE( parallel.positionMiss.getNumberOfSamples( ) == numberOfTrajectories );
+            REQUIRE( parallel.positionMiss.getMean( ) == serial.positionMiss.getMean( ) );
+            REQUIRE( parallel.positionMiss.getVariance( ) == serial.positionMiss.getVariance( ) );
+            REQUIRE( parallel.velocityMiss.getMean( ) == serial.velocityMiss.getMean( ) );
+            REQUIRE( parallel.deltaV.getMean( ) == serial.deltaV.getMean( ) );
+            REQUIRE( parallel.deltaV.getMaximum( ) == serial.deltaV.getMaximum( ) );
+        }
+
+        // Single trajectories can be reproduced in isolation.
+        const MonteCarloTrajectoryResult< Real > first = campaign.simulateTrajectory( seed, 17 );
+        const MonteCarloTrajectoryResult< Real > second = campaign.simulateTrajectory( seed, 17 );
+        REQUIRE( first.positionMiss == second.positionMiss );
+        REQUIRE( first.deltaV == second.deltaV );
+
+        // Different seeds give different campaigns.
+        const MonteCarloStatistics< Real > otherSeed
+            = campaign.run( numberOfTrajectories, seed + 1 );
+        REQUIRE( otherSeed.deltaV.getMean( ) != serial.deltaV.getMean( ) );
+    }
+
+    SECTION( "Test reproducibility irrespective of chunk size" )
+    {
+        const MonteCarloStatistics< Real > reference
+            = campaign.run( numberOfTrajectories, seed, 1, 64 );
+        const MonteCarloStatistics< Real > statistics
+            = campaign.run( numberOfTrajectories, seed, 8, 7 );
+        REQUIRE( statistics.positionMiss.getNumberOfSamples( ) == numberOfTrajectories );
+        REQUIRE( statistics.deltaV.getMaximum( ) == reference.deltaV.getMaximum( ) );
+
+        // A zero chunk size is treated as one trajectory per chunk.
+        const MonteCarloStatistics< Real > unitChunkStatistics
+            = campaign.run( numberOfTrajectories, seed, 2, 0 );
+        REQUIRE( unitChunkStatistics.positionMiss.getNumberOfSamples( ) == numberOfTrajectories );
+        REQUIRE( unitChunkStatistics.deltaV.getMaximum( ) == reference.deltaV.getMaximum( ) );
+
+        // In deterministic mode, the results are reduced in blocks of fixed size, such that the
+        // statistics are bit-identical; otherwise, they only differ by the order of the merges.
+        if ( isDeterministicModeEnabled( ) )
+        {
+            REQUIRE( statistics.positionMiss.getMean( ) == reference.positionMiss.getMean( ) );
+            REQUIRE( statistics.positionMiss.getVariance( )
+                     == reference.positionMiss.getVariance( ) );
+            REQUIRE( statistics.velocityMiss.getMean( ) == reference.velocityMiss.getMean( ) );
+            REQUIRE( statistics.deltaV.getMean( ) == reference.deltaV.getMean( ) );
+        }
+        else
+        {
+            REQUIRE( statistics.positionMiss.getMean( )
+                     == Approx( reference.positionMiss.getMean( ) ).epsilon( 1.0e-12 ) );
+            REQUIRE( statistics.positionMiss.getVariance( )
+                     == Approx( reference.positionMiss.getVariance( ) ).epsilon( 1.0e-10 ) );
+            REQUIRE( statistics.velocityMiss.getMean( )
+                     == Approx( reference.velocityMiss.getMean( ) ).epsilon( 1.0e-12 ) );
+            REQUIRE( statistics.deltaV.getMean( )
+                     == Approx( reference.deltaV.getMean( ) ).epsilon( 1.0e-12 ) );
+        }
+    }
+
+    SECTION( "Test terminal statistics" )
+    {
+        const MonteCarloStatistics< Real > statistics = campaign.run( numberOfTrajectories, seed );
+
+        // The closed-loop OGL must reach the target, up to the effect of the sensor noise, which is
+        // amplified by the OGL premultipliers as the TTG goes to zero.
+        REQUIRE( statistics.positionMiss.getMean( ) < 0.5 );
+        REQUIRE( statistics.velocityMiss.getMean( ) < 5.0 );
+        REQUIRE( statistics.deltaV.getMinimum( ) > 0.0 );
+        REQUIRE( statistics.deltaV.getStandardDeviation( ) > 0.0 );
+    }
+}
+
+} // namespace tests
+} // namespace control
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <limits>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/optimalGuidanceController.hpp"
+
+#include "testAllocationCounter.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector;
+static const Real tolerance = 100.0 * std::numeric_limits< Real >::epsilon( );
+
+TEST_CASE( "Test Optimal Guidance controller", "[ogl][controller]")
+{
+    Vector targetPosition( 3 );
+    targetPosition[ 0 ] = 0.0;
+    targetPosition[ 1 ] = 0.0;
+    targetPosition[ 2 ] = 0.0;
+
+    Vector targetVelocity( 3 );
+    targetVelocity[ 0 ] = 0.0;
+    targetVelocity[ 1 ] = 0.0;
+    targetVelocity[ 2 ] = -0.5;
+
+    Vector gravitationalAcceleration( 3 );
+    gravitationalAcceleration[ 0 ] = 0.0;
+    gravitationalAcceleration[ 1 ] = 0.0;
+    gravitationalAcceleration[ 2 ] = -1.62;
+
+    const Real finalTime = 30.0;
+
+    Vector position( 3 );
+    position[ 0 ] = 150.0;
+    position[ 1 ] = -75.0;
+    position[ 2 ] = 500.0;
+
+    Vector velocity( 3 );
+    velocity[ 0 ] = -10.0;
+    velocity[ 1 ] = 2.5;
+    velocity[ 2 ] = -20.0;
+
+    OptimalGuidanceController< Real, Vector > controller( targetPosition,
+                                                          targetVelocity,
+                                                          gravitationalAcceleration,
+                                                          finalTime );
+
+    SECTION( "Test consistency with OGL" )
+    {
+        const Real currentTime = 4.2;
+        const Real timeToGo = finalTime - currentTime;
+
+        Vector zeroEffortMiss( 3 );
+        Vector zeroEffortVelocity( 3 );
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            zeroEffortMiss[ i ] = targetPosition[ i ]
+                                  - ( position[ i ] + velocity[ i ] * timeToGo
+                                      + 0.5 * gravitationalAcceleration[ i ]
+                                        * timeToGo * timeToGo );
+            zeroEffortVelocity[ i ] = targetVelocity[ i ]
+                                      - ( velocity[ i ]
+                                          + gravitationalAcceleration[ i ] * timeToGo );
+        }
+
+        const Vector expectedControl = computeOptimalGuidanceLaw( zeroEffortMiss,
+                                                                  zeroEffortVelocity,
+                                                                  timeToGo );
+
+        const Vector computedControl = controller.computeControl( currentTime,
+                                                                  position,
+                                                                  velocity );
+
+        REQUIRE( controller.getTimeToGo( ) == timeToGo );
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( controller.getZeroEffortMiss( )[ i ]
+                        == Approx( zeroEffortMiss[ i ] ).epsilon( tolerance ) );
+            REQUIRE( controller.getZeroEffortVelocity( )[ i ]
+                        == Approx( zeroEffortVelocity[ i ] ).epsilon( tolerance ) );
+            REQUIRE( computedControl[ i ]
+                        == Approx( expectedControl[ i ] ).epsilon( tolerance ) );
+        }
+    }
+
+    SECTION( "Test closed-loop landing" )
+    {
+        // Propagate the closed-loop trajectory using the exact solution for a constant
+        // acceleration over each time step, with the control authority held constant.
+        const Real timeStep = 0.01;
+        const unsigned int numberOfSteps = 3000;
+
+        const std::size_t allocationCountBefore = getAllocationCount( );
+        for ( unsigned int step = 0; step < numberOfSteps; ++step )
+        {
+            const Vector& control = controller.computeControl( step * timeStep,
+                                                               position,
+                                                               velocity );
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                const Real acceleration = control[ i ] + gravitationalAcceleration[ i ];
+                position[ i ] += velocity[ i ] * timeStep
+                                 + 0.5 * acceleration * timeStep * timeStep;
+                velocity[ i ] += acceleration * timeStep;
+            }
+        }
+        const std::size_t allocationCountAfter = getAllocationCount( );
+
+        REQUIRE( allocationCountAfter == allocationCountBefore );
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( position[ i ] == Approx( targetPosition[ i ] ).margin( 1.0e-3 ) );
+            REQUIRE( velocity[ i ] == Approx( targetVelocity[ i ] ).margin( 1.0e-2 ) );
+        }
+    }
+}
+
+} // namespace tests
+} // namespace control
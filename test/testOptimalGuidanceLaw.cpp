@@ -6,12 +6,16 @@
 
 #include <iostream>
 
+#include <array>
 #include <limits>
 #include <vector>
 
 #include <catch.hpp>
 
 #include "control/optimalGuidanceLaw.hpp"
+#include "control/simd.hpp"
+
+#include "testAllocationCounter.hpp"
 
 namespace control
 {
@@ -56,6 +60,442 @@ TEST_CASE( "Test Optimal Guidance Law (OGL)", "[ogl]")
                         == Approx( expectedControl[ i ] ).epsilon( tolerance ) );
         }
     }
+
+    SECTION( "Test arbitrary case with fixed-size vector" )
+    {
+        typedef std::array< Real, 3 > FixedSizeVector;
+        REQUIRE( IsFixedSizeVector3< FixedSizeVector >::value );
+        REQUIRE( !IsFixedSizeVector3< Vector >::value );
+
+        const Real timeToGo = 12.516;
+
+        const FixedSizeVector zeroEffortMiss = { { -21.163, 9.887, -0.613 } };
+        const FixedSizeVector zeroEffortVelocity = { { -1.244, -0.112, 3.119 } };
+        const FixedSizeVector expectedControl
+            = { { -0.611797225534058, 0.396587823003621, -0.521881100532641 } };
+
+        const FixedSizeVector computedControl = computeOptimalGuidanceLaw( zeroEffortMiss,
+                                                                           zeroEffortVelocity,
+                                                                           timeToGo );
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( computedControl[ i ]
+                        == Approx( expectedControl[ i ] ).epsilon( tolerance ) );
+        }
+    }
+
+    SECTION( "Test compile-time evaluation" )
+    {
+        typedef std::array< Real, 3 > FixedSizeVector;
+
+        static constexpr Real timeToGo = 12.516;
+        static constexpr FixedSizeVector zeroEffortMiss = { { -21.163, 9.887, -0.613 } };
+        static constexpr FixedSizeVector zeroEffortVelocity = { { -1.244, -0.112, 3.119 } };
+
+        // Verification table computed at compile-time, for the optimal and arbitrary gains.
+        static constexpr std::array< FixedSizeVector, 2 > computedControlTable
+            = { { computeOptimalGuidanceLaw( zeroEffortMiss, zeroEffortVelocity, timeToGo ),
+                  computeOptimalGuidanceLaw(
+                    zeroEffortMiss, zeroEffortVelocity, timeToGo, 3.0, -1.0 ) } };
+
+        static_assert( computeZeroEffortMissPremultiplier( 2.0 ) == 1.5,
+                       "ZEM premultiplier must be evaluated at compile-time" );
+        static_assert( computeZeroEffortVelocityPremultiplier( 2.0 ) == -1.0,
+                       "ZEV premultiplier must be evaluated at compile-time" );
+        static_assert( computedControlTable[ 0 ][ 0 ] == 2.0 * computedControlTable[ 1 ][ 0 ],
+                       "OGL must be evaluated at compile-time" );
+
+        FixedSizeVector expectedControl;
+        computeOptimalGuidanceLaw( zeroEffortMiss,
+                                   zeroEffortVelocity,
+                                   timeToGo,
+                                   expectedControl );
+
+        // Outside deterministic mode, the run-time evaluation may be contracted into fused
+        // multiply-add instructions, whereas the constant evaluation is not.
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            if ( isDeterministicModeEnabled( ) )
+            {
+                REQUIRE( computedControlTable[ 0 ][ i ] == expectedControl[ i ] );
+            }
+            else
+            {
+                REQUIRE( computedControlTable[ 0 ][ i ]
+                            == Approx( expectedControl[ i ] ).epsilon( tolerance ) );
+            }
+        }
+    }
+
+    SECTION( "Test in-place arbitrary case" )
+    {
+        const Real timeToGo = 12.516;
+
+        Vector zeroEffortMiss( 3 );
+        zeroEffortMiss[ 0 ] = -21.163;
+        zeroEffortMiss[ 1 ] = 9.887;
+        zeroEffortMiss[ 2 ] = -0.613;
+
+        Vector zeroEffortVelocity( 3 );
+        zeroEffortVelocity[ 0 ] = -1.244;
+        zeroEffortVelocity[ 1 ] = -0.112;
+        zeroEffortVelocity[ 2 ] = 3.119;
+
+        Vector expectedControl( 3 );
+        expectedControl[ 0 ] = -0.611797225534058;
+        expectedControl[ 1 ] = 0.396587823003621;
+        expectedControl[ 2 ] = -0.521881100532641;
+
+        Vector computedControl( 3 );
+
+        const std::size_t allocationCountBefore = getAllocationCount( );
+        computeOptimalGuidanceLaw( zeroEffortMiss,
+                                   zeroEffortVelocity,
+                                   timeToGo,
+                                   computedControl );
+        const std::size_t allocationCountAfter = getAllocationCount( );
+
+        REQUIRE( allocationCountAfter == allocationCountBefore );
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( computedControl[ i ]
+                        == Approx( expectedControl[ i ] ).epsilon( tolerance ) );
+        }
+
+        // Check that output vector can be the same object as input vector.
+        computeOptimalGuidanceLaw( zeroEffortMiss,
+                                   zeroEffortVelocity,
+                                   timeToGo,
+                                   zeroEffortMiss );
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            if ( isDeterministicModeEnabled( ) )
+            {
+                REQUIRE( zeroEffortMiss[ i ] == computedControl[ i ] );
+            }
+            else
+            {
+                REQUIRE( zeroEffortMiss[ i ]
+                            == Approx( computedControl[ i ] ).epsilon( tolerance ) );
+            }
+        }
+    }
+
+    SECTION( "Test batched arbitrary case" )
+    {
+        // The number of samples is chosen such that the SIMD kernels also process a partial
+        // packet.
+        const unsigned int numberOfSamples = 37;
+
+        Vector timeToGo( numberOfSamples );
+        Vector zeroEffortMissX( numberOfSamples );
+        Vector zeroEffortMissY( numberOfSamples );
+        Vector zeroEffortMissZ( numberOfSamples );
+        Vector zeroEffortVelocityX( numberOfSamples );
+        Vector zeroEffortVelocityY( numberOfSamples );
+        Vector zeroEffortVelocityZ( numberOfSamples );
+        Vector gainsZeroEffortMiss( numberOfSamples );
+        Vector gainsZeroEffortVelocity( numberOfSamples );
+        for ( unsigned int i = 0; i < numberOfSamples; ++i )
+        {
+            timeToGo[ i ] = 12.516 + i;
+            zeroEffortMissX[ i ] = -21.163 + 0.5 * i;
+            zeroEffortMissY[ i ] = 9.887 - 0.25 * i;
+            zeroEffortMissZ[ i ] = -0.613 * ( i + 1 );
+            zeroEffortVelocityX[ i ] = -1.244 + 0.1 * i;
+            zeroEffortVelocityY[ i ] = -0.112 * ( i + 1 );
+            zeroEffortVelocityZ[ i ] = 3.119 - 0.3 * i;
+            gainsZeroEffortMiss[ i ] = 6.0 + i;
+            gainsZeroEffortVelocity[ i ] = -2.0 - 0.5 * i;
+        }
+
+        const SimdInstructionSet defaultInstructionSet = getSimdInstructionSet( );
+        const SimdInstructionSet instructionSets[ 4 ] = { scalarInstructionSet,
+                                                          avx2InstructionSet,
+                                                          avx512InstructionSet,
+                                                          neonInstructionSet };
+
+        for ( unsigned int j = 0; j < 4; ++j )
+        {
+            if ( !setSimdInstructionSet( instructionSets[ j ] ) )
+            {
+                continue;
+            }
+
+            Vector controlEffortX( numberOfSamples );
+            Vector controlEffortY( numberOfSamples );
+            Vector controlEffortZ( numberOfSamples );
+            computeOptimalGuidanceLaw( &zeroEffortMissX[ 0 ],
+                                       &zeroEffortMissY[ 0 ],
+                                       &zeroEffortMissZ[ 0 ],
+                                       &zeroEffortVelocityX[ 0 ],
+                                       &zeroEffortVelocityY[ 0 ],
+                                       &zeroEffortVelocityZ[ 0 ],
+                                       &timeToGo[ 0 ],
+                                       numberOfSamples,
+                                       &controlEffortX[ 0 ],
+                                       &controlEffortY[ 0 ],
+                                       &controlEffortZ[ 0 ] );
+
+            REQUIRE( controlEffortX[ 0 ] == Approx( -0.611797225534058 ).epsilon( tolerance ) );
+            REQUIRE( controlEffortY[ 0 ] == Approx( 0.396587823003621 ).epsilon( tolerance ) );
+            REQUIRE( controlEffortZ[ 0 ] == Approx( -0.521881100532641 ).epsilon( tolerance ) );
+
+            Vector controlEffortPerSampleGainsX( numberOfSamples );
+            Vector controlEffortPerSampleGainsY( numberOfSamples );
+            Vector controlEffortPerSampleGainsZ( numberOfSamples );
+            computeOptimalGuidanceLaw( &zeroEffortMissX[ 0 ],
+                                       &zeroEffortMissY[ 0 ],
+                                       &zeroEffortMissZ[ 0 ],
+                                       &zeroEffortVelocityX[ 0 ],
+                                       &zeroEffortVelocityY[ 0 ],
+                                       &zeroEffortVelocityZ[ 0 ],
+                                       &timeToGo[ 0 ],
+                                       numberOfSamples,
+                                       &controlEffortPerSampleGainsX[ 0 ],
+                                       &controlEffortPerSampleGainsY[ 0 ],
+                                       &controlEffortPerSampleGainsZ[ 0 ],
+                                       &gainsZeroEffortMiss[ 0 ],
+                                       &gainsZeroEffortVelocity[ 0 ] );
+
+            for ( unsigned int i = 0; i < numberOfSamples; ++i )
+            {
+                Vector zeroEffortMiss( 3 );
+                zeroEffortMiss[ 0 ] = zeroEffortMissX[ i ];
+                zeroEffortMiss[ 1 ] = zeroEffortMissY[ i ];
+                zeroEffortMiss[ 2 ] = zeroEffortMissZ[ i ];
+
+                Vector zeroEffortVelocity( 3 );
+                zeroEffortVelocity[ 0 ] = zeroEffortVelocityX[ i ];
+                zeroEffortVelocity[ 1 ] = zeroEffortVelocityY[ i ];
+                zeroEffortVelocity[ 2 ] = zeroEffortVelocityZ[ i ];
+
+                const Vector expectedControl = computeOptimalGuidanceLaw( zeroEffortMiss,
+                                                                          zeroEffortVelocity,
+                                                                          timeToGo[ i ] );
+                const Vector expectedControlPerSampleGains
+                    = computeOptimalGuidanceLaw( zeroEffortMiss,
+                                                 zeroEffortVelocity,
+                                                 timeToGo[ i ],
+                                                 gainsZeroEffortMiss[ i ],
+                                                 gainsZeroEffortVelocity[ i ] );
+
+                // In deterministic mode, all kernels are bit-identical to the single-sample
+                // function; otherwise, even the scalar kernel may be contracted differently.
+                if ( isDeterministicModeEnabled( ) )
+                {
+                    REQUIRE( controlEffortX[ i ] == expectedControl[ 0 ] );
+                    REQUIRE( controlEffortY[ i ] == expectedControl[ 1 ] );
+                    REQUIRE( controlEffortZ[ i ] == expectedControl[ 2 ] );
+
+                    REQUIRE( controlEffortPerSampleGainsX[ i ]
+                                == expectedControlPerSampleGains[ 0 ] );
+                    REQUIRE( controlEffortPerSampleGainsY[ i ]
+                                == expectedControlPerSampleGains[ 1 ] );
+                    REQUIRE( controlEffortPerSampleGainsZ[ i ]
+                                == expectedControlPerSampleGains[ 2 ] );
+                }
+                else
+                {
+                    REQUIRE( controlEffortX[ i ]
+                                == Approx( expectedControl[ 0 ] ).epsilon( tolerance ) );
+                    REQUIRE( controlEffortY[ i ]
+                                == Approx( expectedControl[ 1 ] ).epsilon( tolerance ) );
+                    REQUIRE( controlEffortZ[ i ]
+                                == Approx( expectedControl[ 2 ] ).epsilon( tolerance ) );
+
+                    REQUIRE( controlEffortPerSampleGainsX[ i ]
+                                == Approx( expectedControlPerSampleGains[ 0 ] )
+                                    .epsilon( tolerance ) );
+                    REQUIRE( controlEffortPerSampleGainsY[ i ]
+                                == Approx( expectedControlPerSampleGains[ 1 ] )
+                                    .epsilon( tolerance ) );
+                    REQUIRE( controlEffortPerSampleGainsZ[ i ]
+                                == Approx( expectedControlPerSampleGains[ 2 ] )
+                                    .epsilon( tolerance ) );
+                }
+            }
+        }
+
+        setSimdInstructionSet( defaultInstructionSet );
+    }
+
+    SECTION( "Test terminal-phase handling" )
+    {
+        static_assert( computeTerminalZeroEffortMissPremultiplier( 2.0, 1.0 ) == 1.5,
+                       "Terminal ZEM premultiplier must be evaluated at compile-time" );
+        static_assert( computeTerminalZeroEffortMissPremultiplier( 0.5, 1.0 ) == 3.0,
+                       "Terminal ZEM premultiplier must be weighted below the TTG floor" );
+        static_assert( computeTerminalZeroEffortVelocityPremultiplier( 0.5, 1.0 ) == -2.0,
+                       "Terminal ZEV premultiplier must apply the TTG floor" );
+
+        Vector zeroEffortMiss( 3 );
+        zeroEffortMiss[ 0 ] = -21.163;
+        zeroEffortMiss[ 1 ] = 9.887;
+        zeroEffortMiss[ 2 ] = -0.613;
+
+        Vector zeroEffortVelocity( 3 );
+        zeroEffortVelocity[ 0 ] = -1.244;
+        zeroEffortVelocity[ 1 ] = -0.112;
+        zeroEffortVelocity[ 2 ] = 3.119;
+
+        const Real minimumTimeToGo = 0.5;
+        Vector computedControl( 3 );
+
+        // Above the TTG floor, the OGL is unchanged.
+        computeTerminalOptimalGuidanceLaw(
+            zeroEffortMiss, zeroEffortVelocity, 12.516, minimumTimeToGo, computedControl );
+        const Vector expectedControl
+            = computeOptimalGuidanceLaw( zeroEffortMiss, zeroEffortVelocity, 12.516 );
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            if ( isDeterministicModeEnabled( ) )
+            {
+                REQUIRE( computedControl[ i ] == expectedControl[ i ] );
+            }
+            else
+            {
+                REQUIRE( computedControl[ i ]
+                            == Approx( expectedControl[ i ] ).epsilon( tolerance ) );
+            }
+        }
+
+        // At and beyond the final time, the law reduces to a bounded ZEV-only law.
+        const Real timeToGo[ 3 ] = { 0.0, -1.0e-12, -2.0 };
+        for ( unsigned int j = 0; j < 3; ++j )
+        {
+            computeTerminalOptimalGuidanceLaw(
+                zeroEffortMiss, zeroEffortVelocity, timeToGo[ j ], minimumTimeToGo,
+                computedControl );
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                REQUIRE( computedControl[ i ]
+                            == Approx( -2.0 * zeroEffortVelocity[ i ] / minimumTimeToGo ) );
+            }
+        }
+
+        // The law is continuous at the TTG floor.
+        Vector controlBelowFloor( 3 );
+        Vector controlAboveFloor( 3 );
+        computeTerminalOptimalGuidanceLaw( zeroEffortMiss, zeroEffortVelocity,
+                                           minimumTimeToGo * ( 1.0 - 1.0e-9 ), minimumTimeToGo,
+                                           controlBelowFloor );
+        computeTerminalOptimalGuidanceLaw( zeroEffortMiss, zeroEffortVelocity,
+                                           minimumTimeToGo * ( 1.0 + 1.0e-9 ), minimumTimeToGo,
+                                           controlAboveFloor );
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( controlBelowFloor[ i ] == Approx( controlAboveFloor[ i ] ).epsilon( 1.0e-6 ) );
+        }
+
+        // The number of samples is chosen such that the SIMD kernels also process a partial
+        // packet, with TTGs above, at and below the TTG floor.
+        const unsigned int numberOfSamples = 37;
+        Vector batchTimeToGo( numberOfSamples );
+        Vector zeroEffortMissX( numberOfSamples );
+        Vector zeroEffortMissY( numberOfSamples );
+        Vector zeroEffortMissZ( numberOfSamples );
+        Vector zeroEffortVelocityX( numberOfSamples );
+        Vector zeroEffortVelocityY( numberOfSamples );
+        Vector zeroEffortVelocityZ( numberOfSamples );
+        Vector gainsZeroEffortMiss( numberOfSamples );
+        Vector gainsZeroEffortVelocity( numberOfSamples );
+        for ( unsigned int i = 0; i < numberOfSamples; ++i )
+        {
+            batchTimeToGo[ i ] = 2.0 - 0.0625 * i;
+            zeroEffortMissX[ i ] = -21.163 + 0.5 * i;
+            zeroEffortMissY[ i ] = 9.887 - 0.25 * i;
+            zeroEffortMissZ[ i ] = -0.613 * ( i + 1 );
+            zeroEffortVelocityX[ i ] = -1.244 + 0.1 * i;
+            zeroEffortVelocityY[ i ] = -0.112 * ( i + 1 );
+            zeroEffortVelocityZ[ i ] = 3.119 - 0.3 * i;
+            gainsZeroEffortMiss[ i ] = 6.0 + i;
+            gainsZeroEffortVelocity[ i ] = -2.0 - 0.5 * i;
+        }
+
+        const SimdInstructionSet defaultInstructionSet = getSimdInstructionSet( );
+        const SimdInstructionSet instructionSets[ 4 ] = { scalarInstructionSet,
+                                                          avx2InstructionSet,
+                                                          avx512InstructionSet,
+                                                          neonInstructionSet };
+
+        for ( unsigned int j = 0; j < 4; ++j )
+        {
+            if ( !setSimdInstructionSet( instructionSets[ j ] ) )
+            {
+                continue;
+            }
+
+            for ( unsigned int perSampleGains = 0; perSampleGains < 2; ++perSampleGains )
+            {
+                Vector controlEffortX( numberOfSamples );
+                Vector controlEffortY( numberOfSamples );
+                Vector controlEffortZ( numberOfSamples );
+                if ( perSampleGains )
+                {
+                    computeTerminalOptimalGuidanceLaw(
+                        &zeroEffortMissX[ 0 ], &zeroEffortMissY[ 0 ], &zeroEffortMissZ[ 0 ],
+                        &zeroEffortVelocityX[ 0 ], &zeroEffortVelocityY[ 0 ],
+                        &zeroEffortVelocityZ[ 0 ], &batchTimeToGo[ 0 ], numberOfSamples,
+                        minimumTimeToGo,
+                        &controlEffortX[ 0 ], &controlEffortY[ 0 ], &controlEffortZ[ 0 ],
+                        &gainsZeroEffortMiss[ 0 ], &gainsZeroEffortVelocity[ 0 ] );
+                }
+                else
+                {
+                    computeTerminalOptimalGuidanceLaw(
+                        &zeroEffortMissX[ 0 ], &zeroEffortMissY[ 0 ], &zeroEffortMissZ[ 0 ],
+                        &zeroEffortVelocityX[ 0 ], &zeroEffortVelocityY[ 0 ],
+                        &zeroEffortVelocityZ[ 0 ], &batchTimeToGo[ 0 ], numberOfSamples,
+                        minimumTimeToGo,
+                        &controlEffortX[ 0 ], &controlEffortY[ 0 ], &controlEffortZ[ 0 ] );
+                }
+
+                for ( unsigned int i = 0; i < numberOfSamples; ++i )
+                {
+                    Vector sampleZeroEffortMiss( 3 );
+                    sampleZeroEffortMiss[ 0 ] = zeroEffortMissX[ i ];
+                    sampleZeroEffortMiss[ 1 ] = zeroEffortMissY[ i ];
+                    sampleZeroEffortMiss[ 2 ] = zeroEffortMissZ[ i ];
+
+                    Vector sampleZeroEffortVelocity( 3 );
+                    sampleZeroEffortVelocity[ 0 ] = zeroEffortVelocityX[ i ];
+                    sampleZeroEffortVelocity[ 1 ] = zeroEffortVelocityY[ i ];
+                    sampleZeroEffortVelocity[ 2 ] = zeroEffortVelocityZ[ i ];
+
+                    Vector sampleControl( 3 );
+                    computeTerminalOptimalGuidanceLaw(
+                        sampleZeroEffortMiss, sampleZeroEffortVelocity, batchTimeToGo[ i ],
+                        minimumTimeToGo, sampleControl,
+                        perSampleGains ? gainsZeroEffortMiss[ i ] : 6.0,
+                        perSampleGains ? gainsZeroEffortVelocity[ i ] : -2.0 );
+
+                    // In deterministic mode, all kernels are bit-identical to the single-sample
+                    // function; otherwise, even the scalar kernel may be contracted differently.
+                    if ( isDeterministicModeEnabled( ) )
+                    {
+                        REQUIRE( controlEffortX[ i ] == sampleControl[ 0 ] );
+                        REQUIRE( controlEffortY[ i ] == sampleControl[ 1 ] );
+                        REQUIRE( controlEffortZ[ i ] == sampleControl[ 2 ] );
+                    }
+                    else
+                    {
+                        REQUIRE( controlEffortX[ i ]
+                                    == Approx( sampleControl[ 0 ] ).epsilon( tolerance ) );
+                        REQUIRE( controlEffortY[ i ]
+                                    == Approx( sampleControl[ 1 ] ).epsilon( tolerance ) );
+                        REQUIRE( controlEffortZ[ i ]
+                                    == Approx( sampleControl[ 2 ] ).epsilon( tolerance ) );
+                    }
+                }
+            }
+        }
+
+        setSimdInstructionSet( defaultInstructionSet );
+    }
 }
 
 } // namespace tests
@@ -53,6 +53,42 @@ TEST_CASE( "Test Optimal Guidance Law (OGL)", "[ogl]")
                         == Approx( expectedControl[ i ] ).epsilon( tolerance ) );
         }
     }
+
+    SECTION( "Test arbitrary case with fixed-size vector" )
+    {
+        typedef Eigen::Matrix< Real, 3, 1 > FixedSizeVector;
+        REQUIRE( IsFixedSizeVector3< FixedSizeVector >::value );
+        REQUIRE( !IsFixedSizeVector3< Vector >::value );
+
+        const Real timeToGo = 12.516;
+
+        const FixedSizeVector zeroEffortMiss( -21.163, 9.887, -0.613 );
+        const FixedSizeVector zeroEffortVelocity( -1.244, -0.112, 3.119 );
+        const FixedSizeVector expectedControl( -0.611797225534058,
+                                               0.396587823003621,
+                                               -0.521881100532641 );
+
+        const FixedSizeVector computedControl = computeOptimalGuidanceLaw( zeroEffortMiss,
+                                                                           zeroEffortVelocity,
+                                                                           timeToGo );
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( computedControl[ i ]
+                        == Approx( expectedControl[ i ] ).epsilon( tolerance ) );
+        }
+
+        FixedSizeVector computedControlInPlace;
+        computeOptimalGuidanceLaw( zeroEffortMiss,
+                                   zeroEffortVelocity,
+                                   timeToGo,
+                                   computedControlInPlace );
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( computedControlInPlace[ i ] == computedControl[ i ] );
+        }
+    }
 }
 
 } // namespace tests
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <catch.hpp>
+
+// Any implicit promotion from single- to double-precision in the library headers is turned into a
+// compile error for this translation unit, which instantiates the single-precision code paths.
+#if defined( __GNUC__ )
+#pragma GCC diagnostic push
+#pragma GCC diagnostic error "-Wdouble-promotion"
+#endif
+
+#include "control/optimalGuidanceController.hpp"
+#include "control/optimalGuidanceLaw.hpp"
+#include "control/simd.hpp"
+
+#if defined( __GNUC__ )
+#pragma GCC diagnostic pop
+#endif
+
+namespace control
+{
+namespace tests
+{
+
+typedef std::vector< float > Vector;
+typedef std::array< float, 3 > FixedSizeVector;
+static const double tolerance = 100.0 * std::numeric_limits< float >::epsilon( );
+
+//! Check that single-precision result is within tolerance of double-precision reference value.
+bool isWithinTolerance( const float computed, const double expected )
+{
+    return std::fabs( static_cast< double >( computed ) - expected )
+            <= tolerance * std::fabs( expected );
+}
+
+TEST_CASE( "Test Optimal Guidance Law (OGL) in single- and mixed-precision", "[ogl]" )
+{
+    // Double-precision reference values, taken from testOptimalGuidanceLaw.cpp.
+    const double expectedControl[ 3 ]
+        = { -0.611797225534058, 0.396587823003621, -0.521881100532641 };
+
+    const float timeToGo = 12.516f;
+    const FixedSizeVector zeroEffortMiss = { { -21.163f, 9.887f, -0.613f } };
+    const FixedSizeVector zeroEffortVelocity = { { -1.244f, -0.112f, 3.119f } };
+
+    SECTION( "Test single-precision with generic vector" )
+    {
+        Vector zeroEffortMissVector( zeroEffortMiss.begin( ), zeroEffortMiss.end( ) );
+        Vector zeroEffortVelocityVector( zeroEffortVelocity.begin( ), zeroEffortVelocity.end( ) );
+
+        const Vector computedControl = computeOptimalGuidanceLaw( zeroEffortMissVector,
+                                                                  zeroEffortVelocityVector,
+                                                                  timeToGo );
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( isWithinTolerance( computedControl[ i ], expectedControl[ i ] ) );
+        }
+    }
+
+    SECTION( "Test single-precision with fixed-size vector" )
+    {
+        FixedSizeVector computedControl = { { 0.0f, 0.0f, 0.0f } };
+        computeOptimalGuidanceLaw( zeroEffortMiss, zeroEffortVelocity, timeToGo, computedControl );
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( isWithinTolerance( computedControl[ i ], expectedControl[ i ] ) );
+        }
+    }
+
+    SECTION( "Test mixed-precision with fixed-size vector" )
+    {
+        // Mixed-precision accumulates in double-precision, so the result must be equal to the
+        // double-precision result for the same (single-precision) inputs, rounded once. Outside
+        // deterministic mode, the two double-precision evaluations may be contracted into fused
+        // multiply-add instructions differently, which can change the rounding by one unit.
+        typedef std::array< double, 3 > DoubleVector;
+        const DoubleVector zeroEffortMissDouble
+            = { { zeroEffortMiss[ 0 ], zeroEffortMiss[ 1 ], zeroEffortMiss[ 2 ] } };
+        const DoubleVector zeroEffortVelocityDouble
+            = { { zeroEffortVelocity[ 0 ], zeroEffortVelocity[ 1 ], zeroEffortVelocity[ 2 ] } };
+        const DoubleVector expectedControlDouble
+            = computeOptimalGuidanceLaw( zeroEffortMissDouble,
+                                         zeroEffortVelocityDouble,
+                                         static_cast< double >( timeToGo ) );
+
+        const FixedSizeVector computedControl
+            = computeOptimalGuidanceLaw< double >( zeroEffortMiss,
+                                                   zeroEffortVelocity,
+                                                   static_cast< double >( timeToGo ) );
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            const float roundedControl = static_cast< float >( expectedControlDouble[ i ] );
+            if ( isDeterministicModeEnabled( ) )
+            {
+                REQUIRE( computedControl[ i ] == roundedControl );
+            }
+            else
+            {
+                REQUIRE( std::fabs( computedControl[ i ] - roundedControl )
+                         <= std::numeric_limits< float >::epsilon( ) * std::fabs( roundedControl ) );
+            }
+            REQUIRE( isWithinTolerance( computedControl[ i ], expectedControl[ i ] ) );
+        }
+    }
+
+    SECTION( "Test single-precision batched case for all SIMD instruction sets" )
+    {
+        const unsigned int numberOfSamples = 37;
+
+        Vector timeToGoBatch( numberOfSamples, timeToGo );
+        Vector zeroEffortMissX( numberOfSamples, zeroEffortMiss[ 0 ] );
+        Vector zeroEffortMissY( numberOfSamples, zeroEffortMiss[ 1 ] );
+        Vector zeroEffortMissZ( numberOfSamples, zeroEffortMiss[ 2 ] );
+        Vector zeroEffortVelocityX( numberOfSamples, zeroEffortVelocity[ 0 ] );
+        Vector zeroEffortVelocityY( numberOfSamples, zeroEffortVelocity[ 1 ] );
+        Vector zeroEffortVelocityZ( numberOfSamples, zeroEffortVelocity[ 2 ] );
+
+        const SimdInstructionSet defaultInstructionSet = getSimdInstructionSet( );
+        const SimdInstructionSet instructionSets[ 4 ] = { scalarInstructionSet,
+                                                          avx2InstructionSet,
+                                                          avx512InstructionSet,
+                                                          neonInstructionSet };
+
+        for ( unsigned int j = 0; j < 4; ++j )
+        {
+            if ( !setSimdInstructionSet( instructionSets[ j ] ) )
+            {
+                continue;
+            }
+
+            Vector controlEffortX( numberOfSamples );
+            Vector controlEffortY( numberOfSamples );
+            Vector controlEffortZ( numberOfSamples );
+            computeOptimalGuidanceLaw( &zeroEffortMissX[ 0 ],
+                                       &zeroEffortMissY[ 0 ],
+                                       &zeroEffortMissZ[ 0 ],
+                                       &zeroEffortVelocityX[ 0 ],
+                                       &zeroEffortVelocityY[ 0 ],
+                                       &zeroEffortVelocityZ[ 0 ],
+                                       &timeToGoBatch[ 0 ],
+                                       numberOfSamples,
+                                       &controlEffortX[ 0 ],
+                                       &controlEffortY[ 0 ],
+                                       &controlEffortZ[ 0 ] );
+
+            for ( unsigned int i = 0; i < numberOfSamples; ++i )
+            {
+                REQUIRE( isWithinTolerance( controlEffortX[ i ], expectedControl[ 0 ] ) );
+                REQUIRE( isWithinTolerance( controlEffortY[ i ], expectedControl[ 1 ] ) );
+                REQUIRE( isWithinTolerance( controlEffortZ[ i ], expectedControl[ 2 ] ) );
+            }
+        }
+
+        setSimdInstructionSet( defaultInstructionSet );
+    }
+
+    SECTION( "Test single-precision controller" )
+    {
+        const FixedSizeVector targetPosition = { { 0.0f, 0.0f, 0.0f } };
+        const FixedSizeVector targetVelocity = { { 0.0f, 0.0f, 0.0f } };
+        const FixedSizeVector gravitationalAcceleration = { { 0.0f, 0.0f, 0.0f } };
+
+        OptimalGuidanceController< float, FixedSizeVector > controller( targetPosition,
+                                                                        targetVelocity,
+                                                                        gravitationalAcceleration,
+                                                                        timeToGo );
+
+        // Without gravity and with the target at the origin, ZEM = -r - t_go v and ZEV = -v.
+        const FixedSizeVector velocity
+            = { { -zeroEffortVelocity[ 0 ], -zeroEffortVelocity[ 1 ], -zeroEffortVelocity[ 2 ] } };
+        FixedSizeVector position;
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            position[ i ] = -zeroEffortMiss[ i ] - timeToGo * velocity[ i ];
+        }
+
+        const FixedSizeVector& computedControl = controller.computeControl( 0.0f,
+                                                                            position,
+                                                                            velocity );
+
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( isWithinTolerance( computedControl[ i ], expectedControl[ i ] ) );
+        }
+    }
+}
+
+} // namespace tests
+} // namespace control
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <array>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/optimalGuidanceLaw.hpp"
+#include "control/optimalGuidanceSchedule.hpp"
+
+#include "testAllocationCounter.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::vector< Real > Vector;
+
+TEST_CASE( "Test Optimal Guidance Law (OGL) schedule", "[ogl]" )
+{
+    Vector zeroEffortMiss( 3 );
+    zeroEffortMiss[ 0 ] = -21.163;
+    zeroEffortMiss[ 1 ] = 9.887;
+    zeroEffortMiss[ 2 ] = -0.613;
+
+    Vector zeroEffortVelocity( 3 );
+    zeroEffortVelocity[ 0 ] = -1.244;
+    zeroEffortVelocity[ 1 ] = -0.112;
+    zeroEffortVelocity[ 2 ] = 3.119;
+
+    SECTION( "Test schedule for arbitrary TTG grid" )
+    {
+        Vector timeToGo( 4 );
+        timeToGo[ 0 ] = 12.516;
+        timeToGo[ 1 ] = 7.25;
+        timeToGo[ 2 ] = 3.1;
+        timeToGo[ 3 ] = 0.5;
+
+        const OptimalGuidanceSchedule< Real > schedule( timeToGo, 5.0, -1.5 );
+        REQUIRE( schedule.getNumberOfSteps( ) == timeToGo.size( ) );
+
+        Vector computedControl( 3 );
+        for ( std::size_t i = 0; i < schedule.getNumberOfSteps( ); ++i )
+        {
+            REQUIRE( schedule.getZeroEffortMissPremultiplier( i )
+                        == computeZeroEffortMissPremultiplier( timeToGo[ i ], 5.0 ) );
+            REQUIRE( schedule.getZeroEffortVelocityPremultiplier( i )
+                        == computeZeroEffortVelocityPremultiplier( timeToGo[ i ], -1.5 ) );
+
+            const std::size_t allocationCountBefore = getAllocationCount( );
+            schedule.computeControl( i, zeroEffortMiss, zeroEffortVelocity, computedControl );
+            const std::size_t allocationCountAfter = getAllocationCount( );
+            REQUIRE( allocationCountAfter == allocationCountBefore );
+
+            // The schedule is bit-identical to evaluating the OGL directly.
+            const Vector expectedControl = computeOptimalGuidanceLaw( zeroEffortMiss,
+                                                                      zeroEffortVelocity,
+                                                                      timeToGo[ i ],
+                                                                      5.0,
+                                                                      -1.5 );
+            for ( unsigned int j = 0; j < 3; ++j )
+            {
+                REQUIRE( computedControl[ j ] == expectedControl[ j ] );
+            }
+        }
+    }
+
+    SECTION( "Test schedule for uniform TTG grid with fixed-size vector" )
+    {
+        typedef std::array< Real, 3 > FixedSizeVector;
+
+        const Real initialTimeToGo = 12.516;
+        const Real stepSize = 0.125;
+        const std::size_t numberOfSteps = 100;
+
+        const OptimalGuidanceSchedule< Real > schedule( initialTimeToGo, stepSize, numberOfSteps );
+        REQUIRE( schedule.getNumberOfSteps( ) == numberOfSteps );
+
+        const FixedSizeVector zeroEffortMissFixed
+            = { { zeroEffortMiss[ 0 ], zeroEffortMiss[ 1 ], zeroEffortMiss[ 2 ] } };
+        const FixedSizeVector zeroEffortVelocityFixed
+            = { { zeroEffortVelocity[ 0 ], zeroEffortVelocity[ 1 ], zeroEffortVelocity[ 2 ] } };
+
+        for ( std::size_t i = 0; i < numberOfSteps; ++i )
+        {
+            FixedSizeVector computedControl;
+            schedule.computeControl(
+                i, zeroEffortMissFixed, zeroEffortVelocityFixed, computedControl );
+
+            FixedSizeVector expectedControl;
+            computeOptimalGuidanceLaw( zeroEffortMissFixed,
+                                       zeroEffortVelocityFixed,
+                                       initialTimeToGo - static_cast< Real >( i ) * stepSize,
+                                       expectedControl );
+
+            for ( unsigned int j = 0; j < 3; ++j )
+            {
+                REQUIRE( computedControl[ j ] == expectedControl[ j ] );
+            }
+        }
+
+        // Check snapshot of the OGL at the first step.
+        FixedSizeVector computedControl;
+        schedule.computeControl( 0, zeroEffortMissFixed, zeroEffortVelocityFixed, computedControl );
+        REQUIRE( computedControl[ 0 ] == Approx( -0.611797225534058 ) );
+        REQUIRE( computedControl[ 1 ] == Approx( 0.396587823003621 ) );
+        REQUIRE( computedControl[ 2 ] == Approx( -0.521881100532641 ) );
+    }
+}
+
+} // namespace tests
+} // namespace control
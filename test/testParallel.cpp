@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/parallel.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+TEST_CASE( "Test parallel execution of chunks", "[parallel]" )
+{
+    REQUIRE( getNumberOfThreads( 3 ) == 3 );
+    REQUIRE( getNumberOfThreads( 0 ) >= 1 );
+
+    const std::size_t numberOfChunks = 1000;
+    const unsigned int numberOfThreads[ 4 ] = { 0, 1, 4, 16 };
+
+    for ( unsigned int i = 0; i < 4; ++i )
+    {
+        // Each chunk must be processed exactly once.
+        std::vector< unsigned int > counts( numberOfChunks, 0 );
+        parallelForChunks( numberOfChunks,
+                           numberOfThreads[ i ],
+                           [ &counts ]( std::size_t chunk ) { ++counts[ chunk ]; } );
+
+        for ( std::size_t j = 0; j < numberOfChunks; ++j )
+        {
+            REQUIRE( counts[ j ] == 1 );
+        }
+    }
+
+    // An empty range must not invoke the function.
+    bool isInvoked = false;
+    parallelForChunks( 0, 4, [ &isInvoked ]( std::size_t ) { isInvoked = true; } );
+    REQUIRE( !isInvoked );
+}
+
+} // namespace tests
+} // namespace control
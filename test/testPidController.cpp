@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/pidController.hpp"
+
+#include "testAllocationCounter.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+
+TEST_CASE( "Test PID controller", "[pid][controller]" )
+{
+    const Real stepSize = 0.01;
+    PidSettings< Real > settings = { 2.0, 0.5, 0.1, 0.0, -1.0, 1.0 };
+
+    SECTION( "Test proportional, integral and derivative terms" )
+    {
+        PidController< Real > controller( settings, stepSize );
+        const Real control = controller.computeControl( 0.2 );
+        REQUIRE( controller.getIntegral( ) == 0.5 * stepSize * 0.2 );
+        REQUIRE( controller.getDerivative( ) == Approx( 0.1 * 0.2 / stepSize ) );
+        REQUIRE( control == 1.0 );
+
+        controller.reset( 0.2 );
+        const Real resetControl = controller.computeControl( 0.2 );
+        REQUIRE( resetControl
+                 == 2.0 * 0.2 + controller.getIntegral( ) + controller.getDerivative( ) );
+        REQUIRE( controller.getDerivative( ) == 0.0 );
+    }
+
+    SECTION( "Test derivative filter" )
+    {
+        // The response of the filtered derivative to an error step decays with T_f / ( T_f + h ).
+        settings.derivativeFilterTimeConstant = 0.09;
+        PidController< Real > controller( settings, stepSize );
+        controller.computeControl( 0.1 );
+        const Real initialDerivative = controller.getDerivative( );
+        REQUIRE( initialDerivative == Approx( 0.1 * 0.1 / ( 0.09 + stepSize ) ) );
+        for ( unsigned int step = 1; step <= 10; ++step )
+        {
+            controller.computeControl( 0.1 );
+            REQUIRE( controller.getDerivative( )
+                     == Approx( initialDerivative * std::pow( 0.9, step ) ) );
+        }
+    }
+
+    SECTION( "Test anti-windup" )
+    {
+        // With a large error, the integral term is clamped to the output limit instead of winding
+        // up, such that the output leaves saturation as soon as the error changes sign.
+        settings.derivativeGain = 0.0;
+        PidController< Real > controller( settings, stepSize );
+        for ( unsigned int step = 0; step < 10000; ++step )
+        {
+            REQUIRE( controller.computeControl( 10.0 ) == 1.0 );
+        }
+        REQUIRE( controller.getIntegral( ) == 1.0 );
+        REQUIRE( controller.computeControl( -0.5 ) < 0.0 );
+    }
+
+    SECTION( "Test closed-loop regulation of double integrator with constant disturbance" )
+    {
+        settings.proportionalGain = 4.0;
+        settings.integralGain = 1.0;
+        settings.derivativeGain = 4.0;
+        settings.derivativeFilterTimeConstant = 0.02;
+        PidController< Real > controller( settings, stepSize );
+
+        const Real setpoint = 1.0;
+        const Real disturbance = -0.2;
+        Real position = 0.0;
+        Real velocity = 0.0;
+        controller.reset( setpoint - position );
+        for ( unsigned int step = 0; step < 3000; ++step )
+        {
+            const Real acceleration = controller.computeControl( setpoint - position )
+                                      + disturbance;
+            position += velocity * stepSize + 0.5 * acceleration * stepSize * stepSize;
+            velocity += acceleration * stepSize;
+        }
+
+        // The integral term cancels the disturbance in steady state.
+        REQUIRE( position == Approx( setpoint ).margin( 1.0e-3 ) );
+        REQUIRE( velocity == Approx( 0.0 ).margin( 1.0e-3 ) );
+        REQUIRE( controller.getIntegral( ) == Approx( -disturbance ).margin( 1.0e-3 ) );
+    }
+}
+
+TEST_CASE( "Test multi-channel PID controller", "[pid][controller][batch]" )
+{
+    const Real stepSize = 0.01;
+
+    // The number of channels is not a multiple of any packet size, to exercise the padded tail.
+    const std::size_t numberOfChannels = 37;
+    std::vector< PidSettings< Real > > settings( numberOfChannels );
+    for ( std::size_t i = 0; i < numberOfChannels; ++i )
+    {
+        const PidSettings< Real > channelSettings = { 1.0 + 0.1 * i,
+                                                      0.5 + 0.05 * i,
+                                                      0.01 * i,
+                                                      0.001 * ( i % 5 ),
+                                                      -0.5 - 0.01 * i,
+                                                      0.5 + 0.02 * i };
+        settings[ i ] = channelSettings;
+    }
+
+    MultiChannelPidController< Real > controller( settings, stepSize );
+    REQUIRE( controller.getNumberOfChannels( ) == numberOfChannels );
+
+    std::vector< PidController< Real > > referenceControllers;
+    for ( std::size_t i = 0; i < numberOfChannels; ++i )
+    {
+        referenceControllers.push_back( PidController< Real >( settings[ i ], stepSize ) );
+    }
+
+    std::vector< Real > errors( numberOfChannels );
+    std::vector< Real > controls( numberOfChannels );
+    const unsigned int numberOfUpdates = 500;
+
+    SECTION( "Test bit-identity of scalar kernel with single-channel controller" )
+    {
+        const SimdInstructionSet instructionSet = getSimdInstructionSet( );
+        REQUIRE( setSimdInstructionSet( scalarInstructionSet ) );
+
+        bool isIdentical = true;
+        for ( unsigned int step = 0; step < numberOfUpdates; ++step )
+        {
+            for ( std::size_t i = 0; i < numberOfChannels; ++i )
+            {
+                errors[ i ] = std::sin( 0.01 * step * ( 1.0 + i ) ) * ( 0.5 + 0.1 * i );
+            }
+            controller.computeControl( errors.data( ), controls.data( ) );
+            for ( std::size_t i = 0; i < numberOfChannels; ++i )
+            {
+                const Real expectedControl
+                    = referenceControllers[ i ].computeControl( errors[ i ] );
+                isIdentical = isIdentical && controls[ i ] == expectedControl
+                              && controller.getIntegral( i )
+                                 == referenceControllers[ i ].getIntegral( );
+            }
+        }
+        REQUIRE( isIdentical );
+
+        REQUIRE( setSimdInstructionSet( instructionSet ) );
+    }
+
+    SECTION( "Test SIMD kernel against single-channel controller" )
+    {
+        bool isClose = true;
+        bool isBounded = true;
+        const std::size_t allocationCountBefore = getAllocationCount( );
+        for ( unsigned int step = 0; step < numberOfUpdates; ++step )
+        {
+            for ( std::size_t i = 0; i < numberOfChannels; ++i )
+            {
+                errors[ i ] = std::sin( 0.01 * step * ( 1.0 + i ) ) * ( 0.5 + 0.1 * i );
+            }
+            controller.computeControl( errors.data( ), controls.data( ) );
+            for ( std::size_t i = 0; i < numberOfChannels; ++i )
+            {
+                const Real expectedControl
+                    = referenceControllers[ i ].computeControl( errors[ i ] );
+                isClose = isClose && std::fabs( controls[ i ] - expectedControl ) <= 1.0e-12;
+                isBounded = isBounded && controls[ i ] >= settings[ i ].minimumOutput
+                            && controls[ i ] <= settings[ i ].maximumOutput;
+            }
+        }
+        const std::size_t allocationCountAfter = getAllocationCount( );
+
+        REQUIRE( allocationCountAfter == allocationCountBefore );
+        REQUIRE( isClose );
+        REQUIRE( isBounded );
+
+        // Resetting with the current errors removes the derivative kick at the next update.
+        controller.reset( errors.data( ) );
+        controller.computeControl( errors.data( ), controls.data( ) );
+        for ( std::size_t i = 0; i < numberOfChannels; ++i )
+        {
+            REQUIRE( controller.getDerivative( i ) == 0.0 );
+            REQUIRE( controller.getIntegral( i ) == Approx( settings[ i ].integralGain * stepSize
+                                                            * errors[ i ] ) );
+        }
+    }
+}
+
+} // namespace tests
+} // namespace control
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstdint>
+
+#include <catch.hpp>
+
+#include "control/randomNumberGenerator.hpp"
+#include "control/statistics.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+
+TEST_CASE( "Test counter-based random number generator", "[random]" )
+{
+    SECTION( "Test reproducibility of streams" )
+    {
+        CounterBasedRandomNumberGenerator< Real > first( 42, 7 );
+        CounterBasedRandomNumberGenerator< Real > second( 42, 7 );
+        CounterBasedRandomNumberGenerator< Real > otherStream( 42, 8 );
+        CounterBasedRandomNumberGenerator< Real > otherSeed( 43, 7 );
+
+        unsigned int numberOfEqualValues = 0;
+        for ( unsigned int i = 0; i < 100; ++i )
+        {
+            const std::uint64_t value = first.generate( );
+            REQUIRE( value == second.generate( ) );
+            numberOfEqualValues += ( value == otherStream.generate( ) );
+            numberOfEqualValues += ( value == otherSeed.generate( ) );
+        }
+        REQUIRE( numberOfEqualValues == 0 );
+    }
+
+    SECTION( "Test uniform and normal distributions" )
+    {
+        CounterBasedRandomNumberGenerator< Real > generator( 1, 0 );
+        RunningStatistics< Real > uniform;
+        RunningStatistics< Real > normal;
+        for ( unsigned int i = 0; i < 100000; ++i )
+        {
+            uniform.add( generator.generateUniform( ) );
+            normal.add( generator.generateNormal( 3.0, 2.0 ) );
+        }
+
+        REQUIRE( uniform.getMinimum( ) > 0.0 );
+        REQUIRE( uniform.getMaximum( ) < 1.0 );
+        REQUIRE( uniform.getMean( ) == Approx( 0.5 ).margin( 1.0e-2 ) );
+        REQUIRE( uniform.getVariance( ) == Approx( 1.0 / 12.0 ).margin( 1.0e-2 ) );
+        REQUIRE( normal.getMean( ) == Approx( 3.0 ).margin( 5.0e-2 ) );
+        REQUIRE( normal.getStandardDeviation( ) == Approx( 2.0 ).margin( 5.0e-2 ) );
+    }
+}
+
+} // namespace tests
+} // namespace control
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/ringBuffer.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+TEST_CASE( "Test single-producer, single-consumer ring buffer", "[ring-buffer]" )
+{
+    SECTION( "Test capacity and ordering" )
+    {
+        SingleProducerSingleConsumerRingBuffer< int > ringBuffer( 5 );
+        REQUIRE( ringBuffer.getCapacity( ) == 8 );
+        REQUIRE( SingleProducerSingleConsumerRingBuffer< int >( 0 ).getCapacity( ) == 1 );
+
+        int value = 0;
+        REQUIRE( !ringBuffer.tryPop( value ) );
+
+        for ( int i = 0; i < 8; ++i )
+        {
+            REQUIRE( ringBuffer.tryPush( i ) );
+        }
+        REQUIRE( !ringBuffer.tryPush( 8 ) );
+        REQUIRE( ringBuffer.getSize( ) == 8 );
+
+        // Elements are popped in first-in, first-out order, also after wrapping around.
+        for ( int i = 0; i < 20; ++i )
+        {
+            REQUIRE( ringBuffer.tryPop( value ) );
+            REQUIRE( value == i );
+            REQUIRE( ringBuffer.tryPush( i + 8 ) );
+        }
+        REQUIRE( ringBuffer.getSize( ) == 8 );
+    }
+
+    SECTION( "Test concurrent producer and consumer" )
+    {
+        SingleProducerSingleConsumerRingBuffer< std::size_t > ringBuffer( 64 );
+        const std::size_t numberOfElements = 200000;
+
+        std::vector< std::size_t > poppedElements;
+        poppedElements.reserve( numberOfElements );
+        std::thread consumer( [ &ringBuffer, &poppedElements, numberOfElements ]( )
+        {
+            std::size_t value = 0;
+            while ( poppedElements.size( ) < numberOfElements )
+            {
+                if ( ringBuffer.tryPop( value ) )
+                {
+                    poppedElements.push_back( value );
+                }
+            }
+        } );
+
+        for ( std::size_t i = 0; i < numberOfElements; ++i )
+        {
+            while ( !ringBuffer.tryPush( i ) )
+            { }
+        }
+        consumer.join( );
+
+        bool isOrdered = true;
+        for ( std::size_t i = 0; i < numberOfElements; ++i )
+        {
+            isOrdered = isOrdered && poppedElements[ i ] == i;
+        }
+        REQUIRE( isOrdered );
+        REQUIRE( ringBuffer.getSize( ) == 0 );
+    }
+}
+
+} // namespace tests
+} // namespace control
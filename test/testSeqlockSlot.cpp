@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/seqlockSlot.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+//! Value with redundant fields, to detect torn reads.
+struct SeqlockTestValue
+{
+    std::size_t counter;
+    double values[ 5 ];
+};
+
+TEST_CASE( "Test single-writer, multiple-reader seqlock slot", "[seqlock]" )
+{
+    SECTION( "Test store and load" )
+    {
+        const SeqlockTestValue initialValue = { 3, { 1.0, 2.0, 3.0, 4.0, 5.0 } };
+        SeqlockSlot< SeqlockTestValue > slot( initialValue );
+        REQUIRE( slot.getNumberOfStores( ) == 0 );
+
+        SeqlockTestValue value = slot.load( );
+        REQUIRE( value.counter == 3 );
+        REQUIRE( value.values[ 4 ] == 5.0 );
+
+        const SeqlockTestValue storedValue = { 7, { -1.0, -2.0, -3.0, -4.0, -5.0 } };
+        slot.store( storedValue );
+        REQUIRE( slot.getNumberOfStores( ) == 1 );
+        REQUIRE( slot.tryLoad( value ) );
+        REQUIRE( value.counter == 7 );
+        for ( unsigned int i = 0; i < 5; ++i )
+        {
+            REQUIRE( value.values[ i ] == storedValue.values[ i ] );
+        }
+
+        // Values whose size is not a multiple of the word size are stored completely.
+        SeqlockSlot< char > characterSlot( 'a' );
+        characterSlot.store( 'b' );
+        REQUIRE( characterSlot.load( ) == 'b' );
+    }
+
+    SECTION( "Test concurrent writer and readers" )
+    {
+        const SeqlockTestValue initialValue = { 0, { 0.0, 1.0, 2.0, 3.0, 4.0 } };
+        SeqlockSlot< SeqlockTestValue > slot( initialValue );
+        const std::size_t numberOfStores = 200000;
+        const unsigned int numberOfReaders = 2;
+
+        std::atomic< bool > isWriting( true );
+        std::vector< char > isConsistent( numberOfReaders, 1 );
+        std::vector< std::thread > readers;
+        for ( unsigned int j = 0; j < numberOfReaders; ++j )
+        {
+            readers.push_back( std::thread( [ &slot, &isWriting, &isConsistent, j ]( )
+            {
+                // Each read value is consistent and no older than the previously read value.
+                std::size_t previousCounter = 0;
+                while ( isWriting.load( std::memory_order_acquire ) )
+                {
+                    const SeqlockTestValue value = slot.load( );
+                    bool isValid = value.counter >= previousCounter;
+                    for ( unsigned int i = 0; i < 5; ++i )
+                    {
+                        const double expectedValue = static_cast< double >( value.counter + i );
+                        isValid = isValid && value.values[ i ] == expectedValue;
+                    }
+                    isConsistent[ j ] = isConsistent[ j ] && isValid;
+                    previousCounter = value.counter;
+                }
+            } ) );
+        }
+
+        for ( std::size_t k = 1; k <= numberOfStores; ++k )
+        {
+            SeqlockTestValue value;
+            value.counter = k;
+            for ( unsigned int i = 0; i < 5; ++i )
+            {
+                value.values[ i ] = static_cast< double >( k + i );
+            }
+            slot.store( value );
+        }
+        isWriting.store( false, std::memory_order_release );
+
+        for ( unsigned int j = 0; j < numberOfReaders; ++j )
+        {
+            readers[ j ].join( );
+        }
+        for ( unsigned int j = 0; j < numberOfReaders; ++j )
+        {
+            REQUIRE( isConsistent[ j ] );
+        }
+        REQUIRE( slot.getNumberOfStores( ) == numberOfStores );
+        REQUIRE( slot.load( ).counter == numberOfStores );
+    }
+}
+
+} // namespace tests
+} // namespace control
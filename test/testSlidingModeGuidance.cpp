@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/optimalGuidanceLaw.hpp"
+#include "control/simd.hpp"
+#include "control/slidingModeGuidance.hpp"
+
+#include "testAllocationCounter.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::array< Real, 3 > Vector;
+
+TEST_CASE( "Test Optimal Sliding-mode Guidance (OSG)", "[osg]" )
+{
+    const Vector zeroEffortMiss = { { -21.163, 9.887, -0.613 } };
+    const Vector zeroEffortVelocity = { { -1.244, -0.112, 3.119 } };
+    const Real timeToGo = 12.516;
+
+    const Vector optimalControl
+        = computeOptimalGuidanceLaw( zeroEffortMiss, zeroEffortVelocity, timeToGo );
+
+    SECTION( "Test switching term" )
+    {
+        // The OGL is recovered for a zero sliding gain.
+        Vector controlEffort;
+        computeSlidingModeOptimalGuidanceLaw(
+            zeroEffortMiss, zeroEffortVelocity, timeToGo, 0.0, 1.0, controlEffort );
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( controlEffort[ i ] == optimalControl[ i ] );
+        }
+
+        // The sliding variables are ( -13.378, 10.588, -20.132 ), such that the switching term
+        // is linear inside the boundary layer and saturates outside of it.
+        const Real slidingGain = 0.3;
+        const Real boundaryLayerThickness = 15.0;
+        computeSlidingModeOptimalGuidanceLaw( zeroEffortMiss, zeroEffortVelocity, timeToGo,
+                                              slidingGain, boundaryLayerThickness,
+                                              controlEffort );
+        for ( unsigned int i = 0; i < 2; ++i )
+        {
+            const Real slidingVariable
+                = zeroEffortMiss[ i ] - 0.5 * timeToGo * zeroEffortVelocity[ i ];
+            REQUIRE( std::fabs( slidingVariable ) < boundaryLayerThickness );
+            REQUIRE( controlEffort[ i ] == Approx( optimalControl[ i ]
+                                                   + slidingGain * slidingVariable
+                                                     / boundaryLayerThickness ) );
+        }
+        REQUIRE( controlEffort[ 2 ] == Approx( optimalControl[ 2 ] - slidingGain ) );
+
+        // The output vector may be the same object as the input vectors.
+        Vector aliasedControl = zeroEffortMiss;
+        computeSlidingModeOptimalGuidanceLaw( aliasedControl, zeroEffortVelocity, timeToGo,
+                                              slidingGain, boundaryLayerThickness,
+                                              aliasedControl );
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            // Outside deterministic mode, the compiler may contract the aliased and non-aliased
+            // calls into fused multiply-add instructions differently.
+            if ( isDeterministicModeEnabled( ) )
+            {
+                REQUIRE( aliasedControl[ i ] == controlEffort[ i ] );
+            }
+            else
+            {
+                REQUIRE( aliasedControl[ i ] == Approx( controlEffort[ i ] ).epsilon( 1.0e-12 ) );
+            }
+        }
+    }
+
+    SECTION( "Test batched OSG" )
+    {
+        // Number of samples spans multiple blocks and is not a multiple of any packet size.
+        const std::size_t numberOfSamples = 1001;
+        std::vector< Real > zeroEffortMissX( numberOfSamples );
+        std::vector< Real > zeroEffortMissY( numberOfSamples );
+        std::vector< Real > zeroEffortMissZ( numberOfSamples );
+        std::vector< Real > zeroEffortVelocityX( numberOfSamples );
+        std::vector< Real > zeroEffortVelocityY( numberOfSamples );
+        std::vector< Real > zeroEffortVelocityZ( numberOfSamples );
+        std::vector< Real > timeToGoBatch( numberOfSamples );
+        for ( std::size_t i = 0; i < numberOfSamples; ++i )
+        {
+            const Real scale = 0.25 + 0.005 * static_cast< Real >( i );
+            zeroEffortMissX[ i ] = scale * zeroEffortMiss[ 0 ];
+            zeroEffortMissY[ i ] = zeroEffortMiss[ 1 ] - 0.02 * static_cast< Real >( i % 100 );
+            zeroEffortMissZ[ i ] = scale * zeroEffortMiss[ 2 ];
+            zeroEffortVelocityX[ i ] = scale * zeroEffortVelocity[ 0 ];
+            zeroEffortVelocityY[ i ] = zeroEffortVelocity[ 1 ];
+            zeroEffortVelocityZ[ i ] = zeroEffortVelocity[ 2 ] - 0.01 * static_cast< Real >( i );
+            timeToGoBatch[ i ] = timeToGo - 0.01 * static_cast< Real >( i );
+        }
+
+        const Real slidingGain = 0.3;
+        const Real boundaryLayerThickness = 15.0;
+
+        std::vector< Vector > expectedControl( numberOfSamples );
+        for ( std::size_t i = 0; i < numberOfSamples; ++i )
+        {
+            const Vector sampleZeroEffortMiss
+                = { { zeroEffortMissX[ i ], zeroEffortMissY[ i ], zeroEffortMissZ[ i ] } };
+            const Vector sampleZeroEffortVelocity
+                = { { zeroEffortVelocityX[ i ], zeroEffortVelocityY[ i ],
+                      zeroEffortVelocityZ[ i ] } };
+            computeSlidingModeOptimalGuidanceLaw( sampleZeroEffortMiss, sampleZeroEffortVelocity,
+                                                  timeToGoBatch[ i ], slidingGain,
+                                                  boundaryLayerThickness, expectedControl[ i ] );
+        }
+
+        std::vector< Real > controlEffortX( numberOfSamples );
+        std::vector< Real > controlEffortY( numberOfSamples );
+        std::vector< Real > controlEffortZ( numberOfSamples );
+
+        const SimdInstructionSet defaultInstructionSet = getSimdInstructionSet( );
+        const SimdInstructionSet instructionSets[ 4 ] = { scalarInstructionSet,
+                                                          avx2InstructionSet,
+                                                          avx512InstructionSet,
+                                                          neonInstructionSet };
+        for ( unsigned int j = 0; j < 4; ++j )
+        {
+            if ( !setSimdInstructionSet( instructionSets[ j ] ) )
+            {
+                continue;
+            }
+
+            const std::size_t allocationCountBefore = getAllocationCount( );
+            computeSlidingModeOptimalGuidanceLaw(
+                &zeroEffortMissX[ 0 ], &zeroEffortMissY[ 0 ], &zeroEffortMissZ[ 0 ],
+                &zeroEffortVelocityX[ 0 ], &zeroEffortVelocityY[ 0 ], &zeroEffortVelocityZ[ 0 ],
+                &timeToGoBatch[ 0 ], numberOfSamples, slidingGain, boundaryLayerThickness,
+                &controlEffortX[ 0 ], &controlEffortY[ 0 ], &controlEffortZ[ 0 ] );
+            const std::size_t allocationCountAfter = getAllocationCount( );
+            REQUIRE( allocationCountAfter == allocationCountBefore );
+
+            // The scalar kernel, and in deterministic mode all kernels, are bit-identical to the
+            // single-sample function; otherwise, the SIMD kernels differ by rounding only.
+            const Real tolerance
+                = instructionSets[ j ] == scalarInstructionSet || isDeterministicModeEnabled( )
+                  ? 0.0 : 1.0e-12;
+            bool isClose = true;
+            for ( std::size_t i = 0; i < numberOfSamples; ++i )
+            {
+                isClose = isClose
+                          && std::fabs( controlEffortX[ i ] - expectedControl[ i ][ 0 ] )
+                             <= tolerance
+                          && std::fabs( controlEffortY[ i ] - expectedControl[ i ][ 1 ] )
+                             <= tolerance
+                          && std::fabs( controlEffortZ[ i ] - expectedControl[ i ][ 2 ] )
+                             <= tolerance;
+            }
+            REQUIRE( isClose );
+        }
+
+        REQUIRE( setSimdInstructionSet( defaultInstructionSet ) );
+    }
+}
+
+TEST_CASE( "Test closed-loop OSG with bounded perturbation", "[osg][closed-loop]" )
+{
+    // Lunar landing with a guidance period that is coarse compared to the variation of the
+    // perturbing acceleration, which is not modeled in the ZEM and ZEV vectors.
+    const Vector gravity = { { 0.0, 0.0, -1.62 } };
+    const Vector targetVelocity = { { 0.0, 0.0, -0.5 } };
+    const Real finalTime = 30.0;
+    const Real guidancePeriod = 0.5;
+    const unsigned int numberOfSubsteps = 20;
+    const Real stepSize = guidancePeriod / numberOfSubsteps;
+    const unsigned int numberOfGuidanceSteps = 60;
+    const Real perturbationAmplitude = 0.3;
+
+    Real finalPositionError[ 2 ] = { 0.0, 0.0 };
+    for ( unsigned int j = 0; j < 2; ++j )
+    {
+        const Real slidingGain = j == 0 ? 0.0 : 1.0;
+        Vector position = { { 150.0, -75.0, 500.0 } };
+        Vector velocity = { { -10.0, 2.5, -20.0 } };
+        for ( unsigned int step = 0; step < numberOfGuidanceSteps; ++step )
+        {
+            const Real time = step * guidancePeriod;
+            const Real timeToGo = finalTime - time;
+            Vector zeroEffortMiss;
+            Vector zeroEffortVelocity;
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                zeroEffortMiss[ i ] = -0.5 * timeToGo * timeToGo * gravity[ i ] - position[ i ]
+                                      - timeToGo * velocity[ i ];
+                zeroEffortVelocity[ i ] = targetVelocity[ i ] - timeToGo * gravity[ i ]
+                                          - velocity[ i ];
+            }
+
+            Vector controlEffort;
+            computeSlidingModeOptimalGuidanceLaw( zeroEffortMiss, zeroEffortVelocity, timeToGo,
+                                                  slidingGain, 1.0, controlEffort );
+
+            for ( unsigned int substep = 0; substep < numberOfSubsteps; ++substep )
+            {
+                const Real substepTime = time + substep * stepSize;
+                const Vector perturbation
+                    = { { perturbationAmplitude * ( 1.0 + std::sin( substepTime ) ),
+                          -perturbationAmplitude * std::cos( 0.5 * substepTime ),
+                          -1.5 * perturbationAmplitude } };
+                for ( unsigned int i = 0; i < 3; ++i )
+                {
+                    const Real acceleration = controlEffort[ i ] + gravity[ i ] + perturbation[ i ];
+                    position[ i ] += velocity[ i ] * stepSize
+                                     + 0.5 * acceleration * stepSize * stepSize;
+                    velocity[ i ] += acceleration * stepSize;
+                }
+            }
+        }
+
+        finalPositionError[ j ] = std::sqrt( position[ 0 ] * position[ 0 ]
+                                             + position[ 1 ] * position[ 1 ]
+                                             + position[ 2 ] * position[ 2 ] );
+    }
+
+    // The switching term rejects part of the perturbation between guidance updates.
+    REQUIRE( finalPositionError[ 1 ] < 0.75 * finalPositionError[ 0 ] );
+    REQUIRE( finalPositionError[ 1 ] < 0.03 );
+}
+
+} // namespace tests
+} // namespace control
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <cmath>
+
+#include <catch.hpp>
+
+#include "control/statistics.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+
+TEST_CASE( "Test running statistics", "[statistics]" )
+{
+    const Real samples[ 8 ] = { 2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0 };
+
+    SECTION( "Test empty statistics" )
+    {
+        const RunningStatistics< Real > statistics;
+        REQUIRE( statistics.getNumberOfSamples( ) == 0 );
+        REQUIRE( statistics.getMean( ) == 0.0 );
+        REQUIRE( statistics.getVariance( ) == 0.0 );
+    }
+
+    SECTION( "Test adding samples" )
+    {
+        RunningStatistics< Real > statistics;
+        for ( unsigned int i = 0; i < 8; ++i )
+        {
+            statistics.add( samples[ i ] );
+        }
+
+        REQUIRE( statistics.getNumberOfSamples( ) == 8 );
+        REQUIRE( statistics.getMean( ) == Approx( 5.0 ) );
+        REQUIRE( statistics.getVariance( ) == Approx( 32.0 / 7.0 ) );
+        REQUIRE( statistics.getStandardDeviation( ) == Approx( std::sqrt( 32.0 / 7.0 ) ) );
+        REQUIRE( statistics.getMinimum( ) == 2.0 );
+        REQUIRE( statistics.getMaximum( ) == 9.0 );
+    }
+
+    SECTION( "Test merging partial statistics" )
+    {
+        RunningStatistics< Real > first;
+        RunningStatistics< Real > second;
+        const RunningStatistics< Real > empty;
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            first.add( samples[ i ] );
+        }
+        for ( unsigned int i = 3; i < 8; ++i )
+        {
+            second.add( samples[ i ] );
+        }
+
+        RunningStatistics< Real > merged;
+        merged.merge( first );
+        merged.merge( empty );
+        merged.merge( second );
+
+        REQUIRE( merged.getNumberOfSamples( ) == 8 );
+        REQUIRE( merged.getMean( ) == Approx( 5.0 ) );
+        REQUIRE( merged.getVariance( ) == Approx( 32.0 / 7.0 ) );
+        REQUIRE( merged.getMinimum( ) == 2.0 );
+        REQUIRE( merged.getMaximum( ) == 9.0 );
+    }
+}
+
+} // namespace tests
+} // namespace control
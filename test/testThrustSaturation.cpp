@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/optimalGuidanceLaw.hpp"
+#include "control/simd.hpp"
+#include "control/thrustSaturation.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::array< Real, 3 > Vector;
+
+//! Compute norm of vector.
+Real computeNorm( const Vector& vector )
+{
+    return std::sqrt( vector[ 0 ] * vector[ 0 ] + vector[ 1 ] * vector[ 1 ]
+                      + vector[ 2 ] * vector[ 2 ] );
+}
+
+TEST_CASE( "Test thrust-saturated Optimal Guidance Law (OGL)", "[ogl]" )
+{
+    const Vector zeroEffortMiss = { { -21.163, 9.887, -0.613 } };
+    const Vector zeroEffortVelocity = { { -1.244, -0.112, 3.119 } };
+    const Real timeToGo = 12.516;
+
+    const Vector unsaturatedControl
+        = computeOptimalGuidanceLaw( zeroEffortMiss, zeroEffortVelocity, timeToGo );
+    const Real unsaturatedMagnitude = computeNorm( unsaturatedControl );
+
+    SECTION( "Test magnitude limits" )
+    {
+        Vector controlEffort;
+
+        // Inactive limits leave the OGL unchanged. Outside deterministic mode, the compiler may
+        // contract the saturated and plain OGL into fused multiply-add instructions differently.
+        const ThrustLimits< Real > inactiveLimits( 0.0, 10.0 );
+        REQUIRE( computeSaturatedOptimalGuidanceLaw(
+                    zeroEffortMiss, zeroEffortVelocity, timeToGo, inactiveLimits, controlEffort )
+                 == noThrustSaturation );
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            if ( isDeterministicModeEnabled( ) )
+            {
+                REQUIRE( controlEffort[ i ] == unsaturatedControl[ i ] );
+            }
+            else
+            {
+                REQUIRE( controlEffort[ i ]
+                         == Approx( unsaturatedControl[ i ] ).epsilon( 1.0e-12 ) );
+            }
+        }
+
+        // Maximum and minimum magnitude preserve the direction.
+        const Real limits[ 2 ][ 2 ] = { { 0.0, 0.5 * unsaturatedMagnitude },
+                                        { 2.0 * unsaturatedMagnitude, 10.0 } };
+        const unsigned char expectedFlags[ 2 ] = { maximumMagnitudeThrustSaturation,
+                                                   minimumMagnitudeThrustSaturation };
+        const Real expectedScale[ 2 ] = { 0.5, 2.0 };
+        for ( unsigned int j = 0; j < 2; ++j )
+        {
+            const ThrustLimits< Real > thrustLimits( limits[ j ][ 0 ], limits[ j ][ 1 ] );
+            REQUIRE( computeSaturatedOptimalGuidanceLaw(
+                        zeroEffortMiss, zeroEffortVelocity, timeToGo, thrustLimits, controlEffort )
+                     == expectedFlags[ j ] );
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                REQUIRE( controlEffort[ i ]
+                            == Approx( expectedScale[ j ] * unsaturatedControl[ i ] ) );
+            }
+        }
+
+        // Zero control authority is left unchanged by the minimum magnitude.
+        const Vector zeroVector = { { 0.0, 0.0, 0.0 } };
+        const ThrustLimits< Real > minimumLimits( 1.0, 10.0 );
+        REQUIRE( computeSaturatedOptimalGuidanceLaw(
+                    zeroVector, zeroVector, timeToGo, minimumLimits, controlEffort )
+                 == noThrustSaturation );
+        REQUIRE( computeNorm( controlEffort ) == 0.0 );
+    }
+
+    SECTION( "Test pointing cone" )
+    {
+        const Vector pointingAxis = { { -2.0, 0.0, 0.0 } };
+        const Real maximumPointingAngle = 0.5;
+        const ThrustLimits< Real > thrustLimits( 0.0, 10.0, pointingAxis, maximumPointingAngle );
+
+        Vector controlEffort;
+        REQUIRE( computeSaturatedOptimalGuidanceLaw(
+                    zeroEffortMiss, zeroEffortVelocity, timeToGo, thrustLimits, controlEffort )
+                 == pointingConeThrustSaturation );
+
+        // The control authority lies on the cone and is the projection of the OGL onto the cone,
+        // i.e., the residual is perpendicular to the projected control authority.
+        const Real magnitude = computeNorm( controlEffort );
+        REQUIRE( magnitude > 0.0 );
+        REQUIRE( -controlEffort[ 0 ] / magnitude == Approx( std::cos( maximumPointingAngle ) ) );
+        Real residualDotControl = 0.0;
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            residualDotControl += ( unsaturatedControl[ i ] - controlEffort[ i ] )
+                                  * controlEffort[ i ];
+        }
+        REQUIRE( residualDotControl == Approx( 0.0 ).margin( 1.0e-12 ) );
+        REQUIRE( std::atan2( controlEffort[ 2 ], controlEffort[ 1 ] )
+                    == Approx( std::atan2( unsaturatedControl[ 2 ], unsaturatedControl[ 1 ] ) ) );
+
+        // Control authority inside the cone is unchanged.
+        const Vector insideControl = { { -1.0, 0.1, -0.1 } };
+        Real insideControlX = insideControl[ 0 ];
+        Real insideControlY = insideControl[ 1 ];
+        Real insideControlZ = insideControl[ 2 ];
+        REQUIRE( thrustLimits.apply( insideControlX, insideControlY, insideControlZ )
+                    == noThrustSaturation );
+        REQUIRE( insideControlX == insideControl[ 0 ] );
+        REQUIRE( insideControlY == insideControl[ 1 ] );
+        REQUIRE( insideControlZ == insideControl[ 2 ] );
+
+        // Control authority pointing away from the cone is projected onto its apex.
+        Real awayControlX = 1.0;
+        Real awayControlY = 0.1;
+        Real awayControlZ = 0.0;
+        REQUIRE( thrustLimits.apply( awayControlX, awayControlY, awayControlZ )
+                    == pointingConeThrustSaturation );
+        REQUIRE( awayControlX == 0.0 );
+        REQUIRE( awayControlY == 0.0 );
+        REQUIRE( awayControlZ == 0.0 );
+
+        // The maximum magnitude is applied after the projection onto the cone.
+        const ThrustLimits< Real > combinedLimits( 0.0, 0.5 * magnitude, pointingAxis,
+                                                   maximumPointingAngle );
+        Vector combinedControl;
+        REQUIRE( computeSaturatedOptimalGuidanceLaw( zeroEffortMiss, zeroEffortVelocity, timeToGo,
+                                                     combinedLimits, combinedControl )
+                 == ( pointingConeThrustSaturation | maximumMagnitudeThrustSaturation ) );
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            REQUIRE( combinedControl[ i ] == Approx( 0.5 * controlEffort[ i ] ) );
+        }
+    }
+
+    SECTION( "Test batched thrust-saturated OGL" )
+    {
+        // Number of samples spans multiple blocks.
+        const std::size_t numberOfSamples = 600;
+        std::vector< Real > zeroEffortMissX( numberOfSamples );
+        std::vector< Real > zeroEffortMissY( numberOfSamples );
+        std::vector< Real > zeroEffortMissZ( numberOfSamples );
+        std::vector< Real > zeroEffortVelocityX( numberOfSamples );
+        std::vector< Real > zeroEffortVelocityY( numberOfSamples );
+        std::vector< Real > zeroEffortVelocityZ( numberOfSamples );
+        std::vector< Real > timeToGoBatch( numberOfSamples );
+        std::vector< Real > gainsZeroEffortMiss( numberOfSamples );
+        std::vector< Real > gainsZeroEffortVelocity( numberOfSamples );
+        for ( std::size_t i = 0; i < numberOfSamples; ++i )
+        {
+            const Real scale = 0.25 + 0.01 * static_cast< Real >( i );
+            zeroEffortMissX[ i ] = scale * zeroEffortMiss[ 0 ];
+            zeroEffortMissY[ i ] = scale * zeroEffortMiss[ 1 ];
+            zeroEffortMissZ[ i ] = zeroEffortMiss[ 2 ] + 0.1 * static_cast< Real >( i % 50 );
+            zeroEffortVelocityX[ i ] = zeroEffortVelocity[ 0 ];
+            zeroEffortVelocityY[ i ] = scale * zeroEffortVelocity[ 1 ];
+            zeroEffortVelocityZ[ i ] = zeroEffortVelocity[ 2 ];
+            timeToGoBatch[ i ] = timeToGo - 0.01 * static_cast< Real >( i );
+            gainsZeroEffortMiss[ i ] = 6.0 - 0.001 * static_cast< Real >( i );
+            gainsZeroEffortVelocity[ i ] = -2.0 + 0.001 * static_cast< Real >( i );
+        }
+
+        const Vector pointingAxis = { { 0.0, 0.0, 1.0 } };
+        const ThrustLimits< Real > thrustLimits( 0.6, 1.0, pointingAxis, 1.2 );
+
+        const SimdInstructionSet defaultInstructionSet = getSimdInstructionSet( );
+        const SimdInstructionSet instructionSets[ 4 ] = { scalarInstructionSet,
+                                                          avx2InstructionSet,
+                                                          avx512InstructionSet,
+                                                          neonInstructionSet };
+        for ( unsigned int j = 0; j < 4; ++j )
+        {
+            if ( !setSimdInstructionSet( instructionSets[ j ] ) )
+            {
+                continue;
+            }
+
+            for ( unsigned int perSampleGains = 0; perSampleGains < 2; ++perSampleGains )
+            {
+                std::vector< Real > controlEffortX( numberOfSamples );
+                std::vector< Real > controlEffortY( numberOfSamples );
+                std::vector< Real > controlEffortZ( numberOfSamples );
+                std::vector< unsigned char > saturationFlags( numberOfSamples );
+
+                const std::size_t numberOfSaturatedSamples = perSampleGains
+                    ? computeSaturatedOptimalGuidanceLaw(
+                        &zeroEffortMissX[ 0 ], &zeroEffortMissY[ 0 ], &zeroEffortMissZ[ 0 ],
+                        &zeroEffortVelocityX[ 0 ], &zeroEffortVelocityY[ 0 ],
+                        &zeroEffortVelocityZ[ 0 ], &timeToGoBatch[ 0 ], numberOfSamples,
+                        thrustLimits, &controlEffortX[ 0 ], &controlEffortY[ 0 ],
+                        &controlEffortZ[ 0 ], &saturationFlags[ 0 ],
+                        &gainsZeroEffortMiss[ 0 ], &gainsZeroEffortVelocity[ 0 ] )
+                    : computeSaturatedOptimalGuidanceLaw(
+                        &zeroEffortMissX[ 0 ], &zeroEffortMissY[ 0 ], &zeroEffortMissZ[ 0 ],
+                        &zeroEffortVelocityX[ 0 ], &zeroEffortVelocityY[ 0 ],
+                        &zeroEffortVelocityZ[ 0 ], &timeToGoBatch[ 0 ], numberOfSamples,
+                        thrustLimits, &controlEffortX[ 0 ], &controlEffortY[ 0 ],
+                        &controlEffortZ[ 0 ], &saturationFlags[ 0 ] );
+
+                std::size_t expectedNumberOfSaturatedSamples = 0;
+                unsigned char combinedFlags = noThrustSaturation;
+                for ( std::size_t i = 0; i < numberOfSamples; ++i )
+                {
+                    const Vector sampleZeroEffortMiss
+                        = { { zeroEffortMissX[ i ], zeroEffortMissY[ i ], zeroEffortMissZ[ i ] } };
+                    const Vector sampleZeroEffortVelocity = { { zeroEffortVelocityX[ i ],
+                                                                zeroEffortVelocityY[ i ],
+                                                                zeroEffortVelocityZ[ i ] } };
+                    Vector expectedControl;
+                    const unsigned char expectedFlags = computeSaturatedOptimalGuidanceLaw(
+                        sampleZeroEffortMiss, sampleZeroEffortVelocity, timeToGoBatch[ i ],
+                        thrustLimits, expectedControl,
+                        perSampleGains ? gainsZeroEffortMiss[ i ] : 6.0,
+                        perSampleGains ? gainsZeroEffortVelocity[ i ] : -2.0 );
+                    expectedNumberOfSaturatedSamples += expectedFlags != noThrustSaturation;
+                    combinedFlags |= expectedFlags;
+
+                    if ( instructionSets[ j ] == scalarInstructionSet
+                         || isDeterministicModeEnabled( ) )
+                    {
+                        // The scalar kernel, and in deterministic mode all kernels, are
+                        // bit-identical to the single-sample function.
+                        REQUIRE( saturationFlags[ i ] == expectedFlags );
+                        REQUIRE( controlEffortX[ i ] == expectedControl[ 0 ] );
+                        REQUIRE( controlEffortY[ i ] == expectedControl[ 1 ] );
+                        REQUIRE( controlEffortZ[ i ] == expectedControl[ 2 ] );
+                    }
+                    else
+                    {
+                        REQUIRE( controlEffortX[ i ]
+                                    == Approx( expectedControl[ 0 ] ).epsilon( 1.0e-12 ) );
+                        REQUIRE( controlEffortY[ i ]
+                                    == Approx( expectedControl[ 1 ] ).epsilon( 1.0e-12 ) );
+                        REQUIRE( controlEffortZ[ i ]
+                                    == Approx( expectedControl[ 2 ] ).epsilon( 1.0e-12 ) );
+                    }
+                }
+
+                // All types of saturation occur, and the count matches the flags.
+                REQUIRE( combinedFlags == ( maximumMagnitudeThrustSaturation
+                                            | minimumMagnitudeThrustSaturation
+                                            | pointingConeThrustSaturation ) );
+                if ( instructionSets[ j ] == scalarInstructionSet || isDeterministicModeEnabled( ) )
+                {
+                    REQUIRE( numberOfSaturatedSamples == expectedNumberOfSaturatedSamples );
+                }
+                std::size_t numberOfFlaggedSamples = 0;
+                for ( std::size_t i = 0; i < numberOfSamples; ++i )
+                {
+                    numberOfFlaggedSamples += saturationFlags[ i ] != noThrustSaturation;
+                }
+                REQUIRE( numberOfSaturatedSamples == numberOfFlaggedSamples );
+            }
+        }
+
+        setSimdInstructionSet( defaultInstructionSet );
+    }
+}
+
+} // namespace tests
+} // namespace control
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <array>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/optimalGuidanceLaw.hpp"
+#include "control/simd.hpp"
+#include "control/timeToGoSolver.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::array< Real, 3 > Vector;
+
+//! Compute cost-to-go of energy-optimal guidance with final-time weight, for given TTG.
+Real computeCostToGo( const Vector& position,
+                      const Vector& velocity,
+                      const Vector& gravitationalAcceleration,
+                      const Real timeWeight,
+                      const Real timeToGo )
+{
+    Real zeroEffortMissSquared = 0.0;
+    Real zeroEffortMissDotZeroEffortVelocity = 0.0;
+    Real zeroEffortVelocitySquared = 0.0;
+    for ( unsigned int i = 0; i < 3; ++i )
+    {
+        const Real zeroEffortMiss = -position[ i ] - velocity[ i ] * timeToGo
+                                    - 0.5 * gravitationalAcceleration[ i ] * timeToGo * timeToGo;
+        const Real zeroEffortVelocity = -velocity[ i ] - gravitationalAcceleration[ i ] * timeToGo;
+        zeroEffortMissSquared += zeroEffortMiss * zeroEffortMiss;
+        zeroEffortMissDotZeroEffortVelocity += zeroEffortMiss * zeroEffortVelocity;
+        zeroEffortVelocitySquared += zeroEffortVelocity * zeroEffortVelocity;
+    }
+
+    return timeWeight * timeToGo
+           + 6.0 * zeroEffortMissSquared / ( timeToGo * timeToGo * timeToGo )
+           - 6.0 * zeroEffortMissDotZeroEffortVelocity / ( timeToGo * timeToGo )
+           + 2.0 * zeroEffortVelocitySquared / timeToGo;
+}
+
+TEST_CASE( "Test optimal Time-To-Go (TTG) solver", "[ttg]" )
+{
+    // Powered descent under Mars gravity, with target at the origin.
+    const Vector position = { { 200.0, -100.0, 1500.0 } };
+    const Vector velocity = { { -10.0, 5.0, -75.0 } };
+    const Vector targetPosition = { { 0.0, 0.0, 0.0 } };
+    const Vector targetVelocity = { { 0.0, 0.0, 0.0 } };
+    const Vector gravitationalAcceleration = { { 0.0, 0.0, -3.7114 } };
+    const Real timeWeight = 2.0;
+
+    SECTION( "Test optimality of cold-started solution" )
+    {
+        const Real timeToGo = computeOptimalTimeToGo( position,
+                                                      velocity,
+                                                      targetPosition,
+                                                      targetVelocity,
+                                                      gravitationalAcceleration,
+                                                      timeWeight );
+        REQUIRE( timeToGo > 0.0 );
+
+        // The cost-to-go must be stationary and minimal at the optimal TTG.
+        const Real perturbation = 1.0e-3 * timeToGo;
+        const Real cost = computeCostToGo(
+            position, velocity, gravitationalAcceleration, timeWeight, timeToGo );
+        const Real costBefore = computeCostToGo(
+            position, velocity, gravitationalAcceleration, timeWeight, timeToGo - perturbation );
+        const Real costAfter = computeCostToGo(
+            position, velocity, gravitationalAcceleration, timeWeight, timeToGo + perturbation );
+        REQUIRE( cost < costBefore );
+        REQUIRE( cost < costAfter );
+        REQUIRE( ( costAfter - costBefore ) / ( 2.0 * perturbation )
+                    == Approx( 0.0 ).margin( 1.0e-4 * cost / timeToGo ) );
+
+        // At the target, the optimal TTG is zero.
+        REQUIRE( computeOptimalTimeToGo( targetPosition,
+                                         targetVelocity,
+                                         targetPosition,
+                                         targetVelocity,
+                                         gravitationalAcceleration,
+                                         timeWeight ) == 0.0 );
+    }
+
+    SECTION( "Test warm-started solver along closed-loop trajectory" )
+    {
+        TimeToGoSolver< Real, Vector > solver(
+            targetPosition, targetVelocity, gravitationalAcceleration, timeWeight );
+
+        Vector currentPosition = position;
+        Vector currentVelocity = velocity;
+        const Real initialTimeToGo = solver.solve( 0.0, currentPosition, currentVelocity );
+        const unsigned int numberOfColdIterations = solver.getNumberOfIterations( );
+
+        // Along the optimal trajectory, the optimal final time is constant.
+        const Real stepSize = 0.01;
+        const unsigned int numberOfSteps = 1000;
+        for ( unsigned int step = 0; step < numberOfSteps; ++step )
+        {
+            const Real currentTime = step * stepSize;
+            const Real timeToGo = solver.solve( currentTime, currentPosition, currentVelocity );
+
+            if ( step > 0 )
+            {
+                REQUIRE( solver.getNumberOfIterations( ) <= 2 );
+                REQUIRE( currentTime + timeToGo
+                            == Approx( initialTimeToGo ).epsilon( 1.0e-4 ) );
+            }
+
+            Vector zeroEffortMiss;
+            Vector zeroEffortVelocity;
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                zeroEffortMiss[ i ] = targetPosition[ i ] - currentPosition[ i ]
+                                      - currentVelocity[ i ] * timeToGo
+                                      - 0.5 * gravitationalAcceleration[ i ] * timeToGo * timeToGo;
+                zeroEffortVelocity[ i ] = targetVelocity[ i ] - currentVelocity[ i ]
+                                          - gravitationalAcceleration[ i ] * timeToGo;
+            }
+
+            Vector controlEffort;
+            computeOptimalGuidanceLaw(
+                zeroEffortMiss, zeroEffortVelocity, timeToGo, controlEffort );
+
+            for ( unsigned int i = 0; i < 3; ++i )
+            {
+                const Real acceleration = controlEffort[ i ] + gravitationalAcceleration[ i ];
+                currentPosition[ i ] += stepSize * currentVelocity[ i ]
+                                        + 0.5 * stepSize * stepSize * acceleration;
+                currentVelocity[ i ] += stepSize * acceleration;
+            }
+        }
+
+        REQUIRE( numberOfColdIterations > 2 );
+
+        // After a reset, the solver is cold-started again.
+        solver.reset( );
+        solver.solve( 0.0, position, velocity );
+        REQUIRE( solver.getNumberOfIterations( ) == numberOfColdIterations );
+    }
+
+    SECTION( "Test batched solver" )
+    {
+        const unsigned int numberOfSamples = 16;
+        std::vector< Real > positionX( numberOfSamples );
+        std::vector< Real > positionY( numberOfSamples );
+        std::vector< Real > positionZ( numberOfSamples );
+        std::vector< Real > velocityX( numberOfSamples );
+        std::vector< Real > velocityY( numberOfSamples );
+        std::vector< Real > velocityZ( numberOfSamples );
+        for ( unsigned int i = 0; i < numberOfSamples; ++i )
+        {
+            positionX[ i ] = position[ 0 ] + 10.0 * i;
+            positionY[ i ] = position[ 1 ] - 5.0 * i;
+            positionZ[ i ] = position[ 2 ] + 20.0 * i;
+            velocityX[ i ] = velocity[ 0 ] + 0.5 * i;
+            velocityY[ i ] = velocity[ 1 ];
+            velocityZ[ i ] = velocity[ 2 ] - 1.0 * i;
+        }
+
+        std::vector< Real > timeToGo( numberOfSamples, 0.0 );
+        computeOptimalTimeToGo( &positionX[ 0 ], &positionY[ 0 ], &positionZ[ 0 ],
+                                &velocityX[ 0 ], &velocityY[ 0 ], &velocityZ[ 0 ],
+                                numberOfSamples,
+                                targetPosition,
+                                targetVelocity,
+                                gravitationalAcceleration,
+                                timeWeight,
+                                &timeToGo[ 0 ] );
+
+        for ( unsigned int i = 0; i < numberOfSamples; ++i )
+        {
+            const Vector samplePosition = { { positionX[ i ], positionY[ i ], positionZ[ i ] } };
+            const Vector sampleVelocity = { { velocityX[ i ], velocityY[ i ], velocityZ[ i ] } };
+            const Real sampleTimeToGo = computeOptimalTimeToGo( samplePosition,
+                                                                sampleVelocity,
+                                                                targetPosition,
+                                                                targetVelocity,
+                                                                gravitationalAcceleration,
+                                                                timeWeight );
+
+            // Outside deterministic mode, the compiler may contract the batched and single-sample
+            // paths into fused multiply-add instructions differently.
+            if ( isDeterministicModeEnabled( ) )
+            {
+                REQUIRE( timeToGo[ i ] == sampleTimeToGo );
+            }
+            else
+            {
+                REQUIRE( timeToGo[ i ] == Approx( sampleTimeToGo ).epsilon( 1.0e-12 ) );
+            }
+        }
+    }
+}
+
+} // namespace tests
+} // namespace control
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2016 Kartik Kumar, Dinamica Srl (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <catch.hpp>
+
+#include "control/optimalGuidanceLaw.hpp"
+#include "control/trajectoryLogger.hpp"
+
+namespace control
+{
+namespace tests
+{
+
+typedef double Real;
+typedef std::array< Real, 3 > Vector;
+
+//! Get size of file in bytes.
+long getFileSize( const std::string& filePath )
+{
+    std::FILE* file = std::fopen( filePath.c_str( ), "rb" );
+    std::fseek( file, 0, SEEK_END );
+    const long size = std::ftell( file );
+    std::fclose( file );
+    return size;
+}
+
+//! Write log of descent trajectory, retrying until each record has been accepted.
+template< typename LogReal >
+std::vector< GuidanceLogRecord< LogReal > > writeLog( const std::string& filePath,
+                                                      const TrajectoryLogCompression compression,
+                                                      const std::size_t numberOfSteps )
+{
+    std::vector< GuidanceLogRecord< LogReal > > records;
+    TrajectoryLogger< LogReal > logger( filePath, compression, 256, 1000 );
+    REQUIRE( logger.isOpen( ) );
+
+    const Real finalTime = 40.0;
+    for ( std::size_t step = 0; step < numberOfSteps; ++step )
+    {
+        const Real time = finalTime * step / numberOfSteps;
+        const Real timeToGo = finalTime - time;
+        const Vector zeroEffortMiss
+            = { { -200.0 * timeToGo / finalTime, 100.0 * std::sin( time ), -1500.0 + time } };
+        const Vector zeroEffortVelocity = { { 10.0, -5.0 * std::cos( time ), 75.0 - time } };
+        const Vector controlEffort
+            = computeOptimalGuidanceLaw( zeroEffortMiss, zeroEffortVelocity, timeToGo );
+
+        while ( !logger.log( static_cast< LogReal >( time ),
+                             static_cast< LogReal >( timeToGo ),
+                             zeroEffortMiss,
+                             zeroEffortVelocity,
+                             controlEffort ) )
+        { }
+
+        GuidanceLogRecord< LogReal > record;
+        record.time = static_cast< LogReal >( time );
+        record.timeToGo = static_cast< LogReal >( timeToGo );
+        for ( unsigned int i = 0; i < 3; ++i )
+        {
+            record.zeroEffortMiss[ i ] = static_cast< LogReal >( zeroEffortMiss[ i ] );
+            record.zeroEffortVelocity[ i ] = static_cast< LogReal >( zeroEffortVelocity[ i ] );
+            record.controlEffort[ i ] = static_cast< LogReal >( controlEffort[ i ] );
+        }
+        records.push_back( record );
+    }
+
+    REQUIRE( logger.close( ) );
+    REQUIRE( !logger.isOpen( ) );
+    REQUIRE( logger.getNumberOfWrittenRecords( ) == numberOfSteps );
+    REQUIRE( !logger.log( records[ 0 ] ) );
+    return records;
+}
+
+//! Check that records read from log are bit-identical to logged records.
+template< typename LogReal >
+void checkLog( const std::string& filePath,
+               const std::vector< GuidanceLogRecord< LogReal > >& expectedRecords )
+{
+    std::vector< GuidanceLogRecord< LogReal > > records;
+    REQUIRE( readTrajectoryLog( filePath, records ) );
+    REQUIRE( records.size( ) == expectedRecords.size( ) );
+
+    bool isIdentical = true;
+    for ( std::size_t i = 0; i < records.size( ); ++i )
+    {
+        isIdentical = isIdentical && records[ i ].time == expectedRecords[ i ].time
+                      && records[ i ].timeToGo == expectedRecords[ i ].timeToGo;
+        for ( unsigned int j = 0; j < 3; ++j )
+        {
+            isIdentical = isIdentical
+                && records[ i ].zeroEffortMiss[ j ] == expectedRecords[ i ].zeroEffortMiss[ j ]
+                && records[ i ].zeroEffortVelocity[ j ]
+                   == expectedRecords[ i ].zeroEffortVelocity[ j ]
+                && records[ i ].controlEffort[ j ] == expectedRecords[ i ].controlEffort[ j ];
+        }
+    }
+    REQUIRE( isIdentical );
+}
+
+TEST_CASE( "Test trajectory logger", "[trajectory-logger]" )
+{
+    const std::string uncompressedFilePath = "testTrajectoryLoggerUncompressed.ctlg";
+    const std::string compressedFilePath = "testTrajectoryLoggerCompressed.ctlg";
+
+    // The number of steps is not a multiple of the block size, such that the last block is partial.
+    const std::size_t numberOfSteps = 4321;
+
+    SECTION( "Test round trip in double-precision" )
+    {
+        const std::vector< GuidanceLogRecord< Real > > uncompressedRecords
+            = writeLog< Real >( uncompressedFilePath, uncompressedTrajectoryLog, numberOfSteps );
+        const std::vector< GuidanceLogRecord< Real > > compressedRecords
+            = writeLog< Real >( compressedFilePath, xorDeltaTrajectoryLog, numberOfSteps );
+
+        checkLog( uncompressedFilePath, uncompressedRecords );
+        checkLog( compressedFilePath, compressedRecords );
+
+        // Each uncompressed block consists of the record count and the columns with their sizes.
+        const std::size_t numberOfBlocks = 5;
+        const std::size_t recordSize = sizeof( GuidanceLogRecord< Real > );
+        REQUIRE( getFileSize( uncompressedFilePath )
+                    == static_cast< long >( 8 + numberOfBlocks * ( 4 + 11 * 4 )
+                                            + numberOfSteps * recordSize ) );
+        REQUIRE( getFileSize( compressedFilePath ) < getFileSize( uncompressedFilePath ) );
+
+        // Logs cannot be read with a different real type.
+        std::vector< GuidanceLogRecord< float > > floatRecords;
+        REQUIRE( !readTrajectoryLog( compressedFilePath, floatRecords ) );
+    }
+
+    SECTION( "Test round trip in single-precision" )
+    {
+        checkLog( compressedFilePath,
+                  writeLog< float >( compressedFilePath, xorDeltaTrajectoryLog, numberOfSteps ) );
+    }
+
+    SECTION( "Test malformed and truncated logs" )
+    {
+        std::vector< GuidanceLogRecord< Real > > records;
+        REQUIRE( !readTrajectoryLog( "nonExistentTrajectoryLog.ctlg", records ) );
+
+        writeLog< Real >( compressedFilePath, xorDeltaTrajectoryLog, numberOfSteps );
+        const long size = getFileSize( compressedFilePath );
+        std::vector< unsigned char > bytes( size );
+        std::FILE* file = std::fopen( compressedFilePath.c_str( ), "rb" );
+        REQUIRE( std::fread( &bytes[ 0 ], 1, bytes.size( ), file ) == bytes.size( ) );
+        std::fclose( file );
+
+        file = std::fopen( uncompressedFilePath.c_str( ), "wb" );
+        std::fwrite( &bytes[ 0 ], 1, bytes.size( ) - 3, file );
+        std::fclose( file );
+        REQUIRE( !readTrajectoryLog( uncompressedFilePath, records ) );
+
+        // A corrupt record count is rejected without allocating the records.
+        std::vector< unsigned char > corruptBytes( bytes );
+        for ( unsigned int i = 8; i < 12; ++i )
+        {
+            corruptBytes[ i ] = 0xff;
+        }
+        file = std::fopen( uncompressedFilePath.c_str( ), "wb" );
+        std::fwrite( &corruptBytes[ 0 ], 1, corruptBytes.size( ), file );
+        std::fclose( file );
+        REQUIRE( !readTrajectoryLog( uncompressedFilePath, records ) );
+
+        bytes[ 0 ] = 'X';
+        file = std::fopen( uncompressedFilePath.c_str( ), "wb" );
+        std::fwrite( &bytes[ 0 ], 1, bytes.size( ), file );
+        std::fclose( file );
+        REQUIRE( !readTrajectoryLog( uncompressedFilePath, records ) );
+    }
+
+    std::remove( uncompressedFilePath.c_str( ) );
+    std::remove( compressedFilePath.c_str( ) );
+}
+
+} // namespace tests
+} // namespace control